@@ -0,0 +1,86 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/IAlgorithm_fwd.h"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** AlgorithmGraph : runs algorithms asynchronously on a pool of threads,
+ * ordering them by the workspaces they use.
+
+  Each submitted algorithm waits for the algorithms submitted before it that
+  write a workspace it reads, or that read or write a workspace it writes.
+  Workspaces are identified by the names held by the algorithm's workspace
+  properties when it is submitted, so the properties must be set first.
+  Algorithms that do not depend on each other, for example the reduction of
+  different banks, run at the same time. As an input workspace may not exist
+  until an earlier algorithm has run, submit() can set property values that
+  are only checked when the algorithm runs.
+
+  submit() returns a future holding the result of execute(), or the exception
+  it threw. If an algorithm fails, the algorithms depending on it are not run
+  and their futures hold an exception instead.
+
+  When several threads are used, loops inside the algorithms run serially, as
+  in a ThreadPool, so that the threads do not compete for the cores.
+*/
+class MANTID_API_DLL AlgorithmGraph {
+public:
+  explicit AlgorithmGraph(const int numThreads = 0);
+  ~AlgorithmGraph();
+  AlgorithmGraph(const AlgorithmGraph &) = delete;
+  AlgorithmGraph &operator=(const AlgorithmGraph &) = delete;
+
+  std::shared_future<bool>
+  submit(const IAlgorithm_sptr &algorithm,
+         const std::map<std::string, std::string> &properties = {});
+  void wait();
+  /// @return the number of threads running algorithms
+  size_t numThreads() const { return m_threads.size(); }
+
+private:
+  struct Node;
+  using Node_sptr = std::shared_ptr<Node>;
+  /// The unfinished algorithms that last used a workspace
+  struct WorkspaceUsers {
+    std::weak_ptr<Node> writer;
+    std::vector<std::weak_ptr<Node>> readers;
+  };
+
+  void addDependencies(const Node_sptr &node);
+  void runNodes();
+  bool execute(Node &node);
+  void finish(Node &node, const bool succeeded);
+
+  std::mutex m_mutex;
+  /// Signalled when an algorithm becomes ready or the graph is destroyed
+  std::condition_variable m_readyChanged;
+  /// Signalled when all algorithms have finished
+  std::condition_variable m_finished;
+  std::deque<Node_sptr> m_ready;
+  std::unordered_map<std::string, WorkspaceUsers> m_workspaceUsers;
+  size_t m_numUnfinished = 0;
+  bool m_stopping = false;
+  std::vector<std::thread> m_threads;
+};
+
+} // namespace API
+} // namespace Mantid
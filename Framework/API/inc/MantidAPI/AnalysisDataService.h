@@ -16,6 +16,10 @@
 
 #include <Poco/AutoPtr.h>
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 namespace Mantid {
 
 namespace API {
@@ -39,6 +43,12 @@ class WorkspaceGroup;
     @author L C Chapon, ISIS, Rutherford Appleton Laboratory
 
     Modified to inherit from DataService
+
+    A limit can be set on the memory used by the workspaces. Above it, the
+    data of the least recently used workspaces that are not held elsewhere is
+    moved to disk, see SpilledWorkspace, and read back when they are next
+    retrieved. getObjects() and topLevelItems() return the SpilledWorkspace
+    standing in for such a workspace.
 */
 class MANTID_API_DLL AnalysisDataServiceImpl final
     : public Kernel::DataService<API::Workspace> {
@@ -84,8 +94,45 @@ public:
     boost::shared_ptr<const WorkspaceGroup> getWorkspaceGroup() const;
   };
 
+  /// WorkspaceSpilledNotification is sent after the data of a workspace has
+  /// been moved to disk to keep within the memory limit. object() returns the
+  /// SpilledWorkspace that stands in for it.
+  class WorkspaceSpilledNotification : public DataServiceNotification {
+  public:
+    /// Constructor
+    WorkspaceSpilledNotification(const std::string &name,
+                                 const boost::shared_ptr<Workspace> &obj)
+        : DataServiceNotification(name, obj) {}
+  };
+
+  /// WorkspaceRestoredNotification is sent after a spilled workspace has been
+  /// read back from disk
+  class WorkspaceRestoredNotification : public DataServiceNotification {
+  public:
+    /// Constructor
+    WorkspaceRestoredNotification(const std::string &name,
+                                  const boost::shared_ptr<Workspace> &obj)
+        : DataServiceNotification(name, obj) {}
+  };
+
   //@}
 
+  /// Memory used by the workspaces in the service
+  struct MemoryStatistics {
+    /// The memory limit in bytes, 0 if there is none
+    size_t limit = 0;
+    /// Memory used by the workspaces in memory, in bytes
+    size_t inMemory = 0;
+    /// Memory the spilled workspaces use once read back, in bytes
+    size_t onDisk = 0;
+    /// Number of workspaces whose data is on disk
+    size_t numSpilled = 0;
+    /// Number of times the data of a workspace was moved to disk
+    size_t numSpills = 0;
+    /// Number of times a spilled workspace was read back
+    size_t numRestores = 0;
+  };
+
 public:
   /// Return the list of illegal characters as one string
   const std::string &illegalCharacters() const;
@@ -107,6 +154,8 @@ public:
   virtual void rename(const std::string &oldName, const std::string &newName);
   /// Overridden remove member to delete its name held by the workspace itself
   virtual void remove(const std::string &name);
+  /// Retrieve a workspace, reading it back from disk if it was spilled
+  Workspace_sptr retrieve(const std::string &name) const;
 
   /** Retrieve a workspace and cast it to the given WSTYPE
    *
@@ -120,8 +169,7 @@ public:
     // Get as a bare workspace
     try {
       // Cast to the desired type and return that.
-      return boost::dynamic_pointer_cast<WSTYPE>(
-          Kernel::DataService<API::Workspace>::retrieve(name));
+      return boost::dynamic_pointer_cast<WSTYPE>(retrieve(name));
 
     } catch (Kernel::Exception::NotFoundError &) {
       throw;
@@ -144,7 +192,19 @@ public:
   std::map<std::string, Workspace_sptr> topLevelItems() const;
   void shutdown() override;
 
+  /** @name Methods to limit the memory used by the workspaces */
+  //@{
+  void setMemoryLimit(const size_t bytes);
+  size_t memoryLimit() const;
+  void setSpillDirectory(const std::string &directory);
+  MemoryStatistics memoryStatistics() const;
+  //@}
+
 private:
+  void touch(const Workspace *workspace) const;
+  Workspace_sptr restore(const std::string &name) const;
+  void applyMemoryLimit(const Workspace *keep);
+  size_t spill(const std::string &name, const Workspace_sptr &workspace);
   /// Checks the name is valid, throwing if not
   void verifyName(const std::string &name,
                   const boost::shared_ptr<API::WorkspaceGroup> &workspace);
@@ -161,6 +221,22 @@ private:
 
   /// The string of illegal characters
   std::string m_illegalChars;
+  /// Memory the workspaces may use before some are spilled, 0 for no limit
+  std::atomic<size_t> m_memoryLimit;
+  /// Directory of the spilled data, the temporary directory if empty
+  std::string m_spillDirectory;
+  /// Serializes spilling and restoring workspaces
+  mutable std::recursive_mutex m_spillMutex;
+  /// Guards m_lastAccess and m_accessCount
+  mutable std::mutex m_accessMutex;
+  /// When each workspace was last added or retrieved, while there is a limit
+  mutable std::unordered_map<const Workspace *, uint64_t> m_lastAccess;
+  /// Counts the accesses, ordering m_lastAccess
+  mutable uint64_t m_accessCount;
+  /// Number of times the data of a workspace was moved to disk
+  std::atomic<size_t> m_numSpills;
+  /// Number of times a spilled workspace was read back
+  mutable std::atomic<size_t> m_numRestores;
 };
 
 using AnalysisDataService =
@@ -220,6 +296,16 @@ using GroupUpdatedNotification =
 using GroupUpdatedNotification_ptr =
     const Poco::AutoPtr<AnalysisDataServiceImpl::GroupUpdatedNotification> &;
 
+using WorkspaceSpilledNotification =
+    AnalysisDataServiceImpl::WorkspaceSpilledNotification;
+using WorkspaceSpilledNotification_ptr = const Poco::AutoPtr<
+    AnalysisDataServiceImpl::WorkspaceSpilledNotification> &;
+
+using WorkspaceRestoredNotification =
+    AnalysisDataServiceImpl::WorkspaceRestoredNotification;
+using WorkspaceRestoredNotification_ptr = const Poco::AutoPtr<
+    AnalysisDataServiceImpl::WorkspaceRestoredNotification> &;
+
 } // Namespace API
 } // Namespace Mantid
 
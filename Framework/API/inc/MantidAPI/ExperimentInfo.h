@@ -15,6 +15,7 @@
 #include "MantidKernel/V3D.h"
 #include "MantidKernel/cow_ptr.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace Mantid {
@@ -169,6 +170,7 @@ public:
 
   void invalidateSpectrumDefinition(const size_t index);
   void updateSpectrumDefinitionIfNecessary(const size_t index) const;
+  size_t spectrumDefinitionInvalidationCount() const;
 
 protected:
   size_t numberOfDetectorGroups() const;
@@ -224,6 +226,9 @@ private:
   // This vector stores boolean flags but uses char to do so since
   // std::vector<bool> is not thread-safe.
   mutable std::vector<char> m_spectrumDefinitionNeedsUpdate;
+  /// Counts calls marking spectrum definitions as outdated. Atomic since
+  /// definitions of different spectra may be invalidated concurrently.
+  std::atomic<size_t> m_spectrumDefinitionInvalidationCount{0};
 };
 
 /// Shared pointer to ExperimentInfo
@@ -97,6 +97,10 @@ private:
   void setGlobalNumericLocaleToC();
   /// Silence NeXus output
   void disableNexusOutput();
+  /// Enable tracing if the config names a trace file
+  void setTracingFileToConfigValue();
+  /// Limit the memory used by the workspaces if the config sets a limit
+  void setWorkspaceMemoryLimitToConfigValue();
   /// Starts asynchronous tasks that are done as part of Start-up
   void asynchronousStartupTasks();
   /// Setup Usage Reporting if enabled
@@ -13,6 +13,8 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Mantid {
@@ -78,6 +80,18 @@ public:
   // returning a single detector for a spectrum will not be possible anymore.
   const Geometry::IDetector &detector(const size_t index) const;
 
+  /// L2, 2-theta, signed 2-theta, azimuthal angle, position and DIFC of all
+  /// spectra. Values are NaN where the corresponding method would throw.
+  struct CachedGeometry {
+    std::vector<double> l2;
+    std::vector<double> twoTheta;
+    std::vector<double> signedTwoTheta;
+    std::vector<double> azimuthal;
+    std::vector<Kernel::V3D> position;
+    std::vector<double> difc;
+  };
+  const CachedGeometry &cachedGeometry() const;
+
   // This does not really belong into SpectrumInfo, but it seems to be useful
   // while Instrument-2.0 does not exist.
   Kernel::V3D sourcePosition() const;
@@ -102,6 +116,13 @@ private:
   mutable std::vector<boost::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+
+  /// Guards the lazily computed cache below
+  mutable std::mutex m_cacheMutex;
+  mutable std::unique_ptr<CachedGeometry> m_cachedGeometry;
+  mutable size_t m_cachedGeometryRevision = 0;
+  mutable size_t m_cachedInvalidationCount = 0;
+  mutable size_t m_cachedSpectrumDefinitionRevision = 0;
 };
 
 using SpectrumInfoIt = SpectrumInfoIterator<SpectrumInfo>;
@@ -0,0 +1,60 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidAPI/Workspace.h"
+
+namespace Mantid {
+namespace API {
+
+/** SpilledWorkspace : stands in the AnalysisDataService for a workspace whose
+  data has been moved to disk to free memory.
+
+  spill() writes the histograms of the workspace to a file as raw binary and
+  replaces them by empty ones. The rest of the workspace, e.g. the instrument,
+  the logs and the history, stays in memory. restore() reads the histograms
+  back. The file is deleted with the SpilledWorkspace.
+
+  Only MatrixWorkspaces that store their histograms, i.e. not event
+  workspaces, can be spilled. The workspace must not be used by anything else
+  while it is spilled.
+*/
+class MANTID_API_DLL SpilledWorkspace final : public Workspace {
+public:
+  static bool canSpill(const Workspace &workspace);
+
+  explicit SpilledWorkspace(MatrixWorkspace_sptr workspace);
+  ~SpilledWorkspace() override;
+
+  void spill(const std::string &filename);
+  MatrixWorkspace_sptr restore();
+  /// @return true if the data of the workspace is on disk
+  bool isSpilled() const { return !m_filename.empty(); }
+  /// @return the memory used by the workspace when restored, in bytes
+  size_t restoredMemorySize() const { return m_restoredMemorySize; }
+
+  const std::string id() const override { return "SpilledWorkspace"; }
+  const std::string toString() const override;
+  const std::string getTitle() const override;
+  size_t getMemorySize() const override;
+
+private:
+  SpilledWorkspace *doClone() const override;
+  SpilledWorkspace *doCloneEmpty() const override;
+  void removeFile();
+
+  /// The workspace, without its histograms while spilled
+  MatrixWorkspace_sptr m_workspace;
+  /// The file holding the histograms, empty if not spilled
+  std::string m_filename;
+  size_t m_restoredMemorySize;
+};
+
+} // namespace API
+} // namespace Mantid
@@ -11,6 +11,7 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidKernel/EnvironmentHistory.h"
+#include "MantidKernel/cow_ptr.h"
 #include <ctime>
 #include <set>
 
@@ -88,8 +89,9 @@ private:
   std::set<int> findHistoryEntries(::NeXus::File *file);
   /// The environment of the workspace
   const Kernel::EnvironmentHistory m_environment;
-  /// The algorithms which have been called on the workspace
-  Mantid::API::AlgorithmHistories m_algorithms;
+  /// The algorithms which have been called on the workspace, shared between
+  /// copies of the history until one of them is modified
+  Kernel::cow_ptr<AlgorithmHistories> m_algorithms;
 };
 
 MANTID_API_DLL std::ostream &operator<<(std::ostream &,
@@ -9,14 +9,17 @@
 #include "MantidAPI/DllConfig.h"
 #include "MantidGeometry/IDTypes.h"
 #include "MantidKernel/V3D.h"
-// Boost graphing
-#ifndef Q_MOC_RUN
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/shared_ptr.hpp>
+
+#include <array>
+#include <map>
+#include <memory>
 #include <unordered_map>
-#endif
+#include <vector>
 
 namespace Mantid {
+namespace Kernel {
+template <size_t N> class KDTree;
+}
 namespace Geometry {
 class Instrument;
 class IDetector;
@@ -31,25 +34,16 @@ class SpectrumInfo;
  * instrument geometry. This class can be queried through calls to the
  * getNeighbours() function on a Detector object.
  *
- * This class uses the ANN Library, from David M Mount and Sunil Arya which
- * is incorporated into Mantid's Kernel module. Mantid uses version 1.1.2
- * of this library.
- * ANN is available from <http://www.cs.umd.edu/~mount/ANN/> and is released
- * under the GNU LGPL.
- *
- * Known potential issue: boost's graph has an issue that may cause compilation
- * errors in some circumstances in the current version of boost used by
- * Mantid (1.43) based on tr1::tie. This issue is fixed in later versions
- * of boost, but should in theory be guarded against by this file only being
- * included in ParameterMap.
- *
- *
+ * The spectrum positions are indexed by a Kernel::KDTree which is built once
+ * on construction. Changing the number of neighbours or querying by radius
+ * reuses the tree.
  */
 class MANTID_API_DLL WorkspaceNearestNeighbours {
 public:
   WorkspaceNearestNeighbours(int nNeighbours, const SpectrumInfo &spectrumInfo,
                              std::vector<specnum_t> spectrumNumbers,
                              bool ignoreMaskedDetectors = false);
+  ~WorkspaceNearestNeighbours();
 
   // Neighbouring spectra by radius
   std::map<specnum_t, Mantid::Kernel::V3D>
@@ -67,39 +61,38 @@ private:
   /// Vector of spectrum numbers
   const std::vector<specnum_t> m_spectrumNumbers;
 
-  /// typedef for Graph object used to hold the calculated information
-  using Graph = boost::adjacency_list<
-      boost::vecS, boost::vecS, boost::directedS,
-      boost::property<boost::vertex_name_t, int64_t>,
-      boost::property<boost::edge_name_t, Mantid::Kernel::V3D>>;
-  /// Vertex descriptor object for Graph
-  using Vertex = boost::graph_traits<Graph>::vertex_descriptor;
-  /// map object of int to Graph Vertex descriptor
-  using MapIV = std::unordered_map<specnum_t, Vertex>;
-
-  /// Construct the graph based on the given number of neighbours and the
-  /// current instument and spectra-detector mapping
+  /// Build the search tree over the positions of the valid spectra
+  void buildTree();
+  /// Find the given number of nearest neighbours for every spectrum
   void build(const int noNeighbours);
-  /// Query the graph for the default number of nearest neighbours to specified
-  /// detector
+  /// Query for the default number of nearest neighbours to specified
+  /// spectrum
   std::map<specnum_t, Mantid::Kernel::V3D>
   defaultNeighbours(const specnum_t spectrum) const;
+  /// Query the search tree for the spectra within a radius of the specified
+  /// spectrum
+  std::map<specnum_t, Mantid::Kernel::V3D>
+  radiusNeighbours(const specnum_t spectrum, const double radius) const;
+  /// Return the point number of a spectrum in the search tree
+  size_t pointNumber(const specnum_t spectrum) const;
   /// The current number of nearest neighbours
   int m_noNeighbours;
   /// The largest value of the distance to a nearest neighbour
   double m_cutoff;
-  /// map between the DetectorID and the Graph node descriptor
-  MapIV m_specToVertex;
-  /// boost::graph object
-  Graph m_graph;
-  /// property map holding the node's related DetectorID's
-  boost::property_map<Graph, boost::vertex_name_t>::type m_vertexID;
-  /// property map holding the edge's related Distance value.
-  boost::property_map<Graph, boost::edge_name_t>::type m_edgeLength;
+  /// Spectrum numbers of the points in the search tree
+  std::vector<specnum_t> m_pointSpectra;
+  /// Real space positions of the points in the search tree
+  std::vector<Kernel::V3D> m_pointPositions;
+  /// Scaled positions of the points in the search tree
+  std::vector<std::array<double, 3>> m_scaledPositions;
+  /// map between the spectrum number and the point number in the tree
+  std::unordered_map<specnum_t, size_t> m_specToPoint;
+  /// The point numbers of the nearest neighbours, m_noNeighbours per point
+  std::vector<size_t> m_neighbourPoints;
+  /// The search tree over the scaled point positions
+  std::unique_ptr<Kernel::KDTree<3>> m_tree;
   /// V3D for scaling
   Kernel::V3D m_scale;
-  /// Cached radius value. used to avoid uncessary recalculations.
-  mutable double m_radius;
   /// Flag indicating that masked detectors should be ignored
   bool m_bIgnoreMaskedDetectors;
 };
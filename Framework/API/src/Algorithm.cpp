@@ -23,6 +23,7 @@
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/Timer.h"
+#include "MantidKernel/Tracing.h"
 #include "MantidKernel/UsageService.h"
 
 #include "MantidParallel/Communicator.h"
@@ -489,6 +490,10 @@ void Algorithm::unlockWorkspaces() {
  */
 
 bool Algorithm::executeInternal() {
+  Kernel::TraceSpan traceSpan(m_isChildAlgorithm
+                                  ? Kernel::Tracing::Category::ChildAlgorithm
+                                  : Kernel::Tracing::Category::Algorithm,
+                              name());
   Timer timer;
   AlgorithmManager::Instance().notifyAlgorithmStarting(this->getAlgorithmID());
   {
@@ -0,0 +1,238 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/IAlgorithm.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Property.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using Mantid::Kernel::Direction;
+
+namespace Mantid {
+namespace API {
+
+/// A submitted algorithm and the algorithms waiting for it
+struct AlgorithmGraph::Node {
+  explicit Node(IAlgorithm_sptr alg)
+      : algorithm(std::move(alg)), future(result.get_future().share()) {}
+  IAlgorithm_sptr algorithm;
+  std::promise<bool> result;
+  std::shared_future<bool> future;
+  /// Number of unfinished algorithms this one waits for
+  size_t numDependencies = 0;
+  bool dependencyFailed = false;
+  bool finished = false;
+  /// The algorithms waiting for this one
+  std::vector<Node_sptr> dependents;
+};
+
+/** Start the threads that run the algorithms
+ * @param numThreads :: number of algorithms to run at the same time;
+ *        0 (default) uses the thread budget of MultiThreaded.h
+ */
+AlgorithmGraph::AlgorithmGraph(const int numThreads) {
+  const int count =
+      numThreads > 0 ? numThreads : Kernel::parallelThreadBudget();
+  m_threads.reserve(static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    m_threads.emplace_back(&AlgorithmGraph::runNodes, this);
+  }
+}
+
+/// Waits for all submitted algorithms to finish
+AlgorithmGraph::~AlgorithmGraph() {
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_readyChanged.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+/** Run an algorithm once the algorithms it depends on have finished. It must
+ * not be changed until it has run.
+ * @param algorithm :: the initialized algorithm to run
+ * @param properties :: values of properties to set first. Workspaces are
+ *        looked up when the algorithm runs, so they need not exist yet.
+ * @return a future holding the return value of execute(), or the exception
+ *         thrown by the algorithm or raised because a dependency failed
+ * @throw std::invalid_argument if the algorithm is null or a property value
+ *        other than a workspace name is invalid
+ */
+std::shared_future<bool>
+AlgorithmGraph::submit(const IAlgorithm_sptr &algorithm,
+                       const std::map<std::string, std::string> &properties) {
+  if (!algorithm) {
+    throw std::invalid_argument("AlgorithmGraph::submit() - Null algorithm");
+  }
+  for (const auto &property : properties) {
+    auto *prop = algorithm->getPointerToProperty(property.first);
+    if (dynamic_cast<IWorkspaceProperty *>(prop)) {
+      // Validated by execute(), once the workspace exists
+      prop->setValue(property.second);
+    } else {
+      algorithm->setPropertyValue(property.first, property.second);
+    }
+  }
+  auto node = std::make_shared<Node>(algorithm);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    addDependencies(node);
+    ++m_numUnfinished;
+    if (node->numDependencies == 0) {
+      m_ready.emplace_back(node);
+    }
+  }
+  m_readyChanged.notify_one();
+  return node->future;
+}
+
+/** Block until all submitted algorithms have finished. Must not be called by
+ * a submitted algorithm.
+ */
+void AlgorithmGraph::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_finished.wait(lock, [this]() { return m_numUnfinished == 0; });
+}
+
+/** Make a new algorithm wait for the unfinished algorithms using the same
+ * workspaces and record the workspaces it uses. Called with the mutex held.
+ * @param node :: the new algorithm
+ */
+void AlgorithmGraph::addDependencies(const Node_sptr &node) {
+  std::vector<std::string> reads, writes;
+  for (const auto *prop : node->algorithm->getProperties()) {
+    if (!dynamic_cast<const IWorkspaceProperty *>(prop)) {
+      continue;
+    }
+    const auto name = prop->value();
+    if (name.empty()) {
+      continue;
+    }
+    if (prop->direction() != Direction::Output) {
+      reads.emplace_back(name);
+    }
+    if (prop->direction() != Direction::Input) {
+      writes.emplace_back(name);
+    }
+  }
+
+  auto dependOn = [&node](const std::weak_ptr<Node> &user) {
+    const auto other = user.lock();
+    if (!other || other->finished || other == node) {
+      return;
+    }
+    // The dependencies of a node are added together, so a duplicate is last
+    if (other->dependents.empty() || other->dependents.back() != node) {
+      other->dependents.emplace_back(node);
+      ++node->numDependencies;
+    }
+  };
+  for (const auto &name : reads) {
+    dependOn(m_workspaceUsers[name].writer);
+  }
+  for (const auto &name : writes) {
+    const auto &users = m_workspaceUsers[name];
+    dependOn(users.writer);
+    for (const auto &reader : users.readers) {
+      dependOn(reader);
+    }
+  }
+
+  for (const auto &name : reads) {
+    auto &readers = m_workspaceUsers[name].readers;
+    readers.erase(std::remove_if(readers.begin(), readers.end(),
+                                 [](const std::weak_ptr<Node> &reader) {
+                                   return reader.expired();
+                                 }),
+                  readers.end());
+    readers.emplace_back(node);
+  }
+  for (const auto &name : writes) {
+    auto &users = m_workspaceUsers[name];
+    users.writer = node;
+    users.readers.clear();
+  }
+}
+
+/// Run ready algorithms until the graph is destroyed
+void AlgorithmGraph::runNodes() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_readyChanged.wait(lock,
+                        [this]() { return m_stopping || !m_ready.empty(); });
+    if (m_ready.empty()) {
+      return;
+    }
+    auto node = std::move(m_ready.front());
+    m_ready.pop_front();
+    lock.unlock();
+    const bool succeeded = execute(*node);
+    lock.lock();
+    finish(*node, succeeded);
+  }
+}
+
+/** Run an algorithm unless one of its dependencies failed, and set its result
+ * @param node :: the algorithm to run
+ * @return true if the algorithm ran and execute() returned true
+ */
+bool AlgorithmGraph::execute(Node &node) {
+  if (node.dependencyFailed) {
+    node.result.set_exception(std::make_exception_ptr(std::runtime_error(
+        node.algorithm->name() +
+        " was not run because an algorithm it depends on failed")));
+    return false;
+  }
+  bool succeeded = false;
+  try {
+    if (numThreads() > 1) {
+      Kernel::ParallelTaskScope serialLoops;
+      succeeded = node.algorithm->execute();
+    } else {
+      succeeded = node.algorithm->execute();
+    }
+  } catch (...) {
+    node.result.set_exception(std::current_exception());
+    return false;
+  }
+  node.result.set_value(succeeded);
+  return succeeded;
+}
+
+/** Release the algorithms waiting for one that finished. Called with the
+ * mutex held.
+ * @param node :: the finished algorithm
+ * @param succeeded :: false if its dependents should not be run
+ */
+void AlgorithmGraph::finish(Node &node, const bool succeeded) {
+  node.finished = true;
+  for (auto &dependent : node.dependents) {
+    if (!succeeded) {
+      dependent->dependencyFailed = true;
+    }
+    if (--dependent->numDependencies == 0) {
+      m_ready.emplace_back(std::move(dependent));
+      m_readyChanged.notify_one();
+    }
+  }
+  node.dependents.clear();
+  // Release the workspaces held by its properties
+  node.algorithm.reset();
+  if (--m_numUnfinished == 0) {
+    m_finished.notify_all();
+  }
+}
+
+} // namespace API
+} // namespace Mantid
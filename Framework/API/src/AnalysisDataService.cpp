@@ -5,12 +5,25 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/SpilledWorkspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+
+#include <algorithm>
 #include <iterator>
 #include <sstream>
+#include <unordered_set>
 
 namespace Mantid {
 namespace API {
+namespace {
+/// The DataService base class already has a member called g_log
+Kernel::Logger g_spillLog("AnalysisDataService");
+} // namespace
 
 //-------------------------------------------------------------------------
 // Nested class methods
@@ -80,6 +93,10 @@ void AnalysisDataServiceImpl::add(
   if (workspace)
     workspace->setName(name);
   Kernel::DataService<API::Workspace>::add(name, workspace);
+  if (m_memoryLimit > 0) {
+    touch(workspace.get());
+    applyMemoryLimit(workspace.get());
+  }
 
   // if a group is added add its members as well
   if (!group)
@@ -120,6 +137,10 @@ void AnalysisDataServiceImpl::addOrReplace(
   if (workspace)
     workspace->setName(name);
   Kernel::DataService<API::Workspace>::addOrReplace(name, workspace);
+  if (m_memoryLimit > 0) {
+    touch(workspace.get());
+    applyMemoryLimit(workspace.get());
+  }
 
   if (!group)
     return;
@@ -149,7 +170,8 @@ void AnalysisDataServiceImpl::addOrReplace(
 void AnalysisDataServiceImpl::rename(const std::string &oldName,
                                      const std::string &newName) {
 
-  auto oldWorkspace = retrieve(oldName);
+  // A spilled workspace is renamed without reading it back
+  auto oldWorkspace = Kernel::DataService<API::Workspace>::retrieve(oldName);
   auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(oldWorkspace);
   if (group && group->containsInChildren(newName)) {
     throw std::invalid_argument(
@@ -158,7 +180,7 @@ void AnalysisDataServiceImpl::rename(const std::string &oldName,
 
   Kernel::DataService<API::Workspace>::rename(oldName, newName);
   // Attach the new name to the workspace
-  auto ws = retrieve(newName);
+  auto ws = Kernel::DataService<API::Workspace>::retrieve(newName);
   ws->setName(newName);
 }
 
@@ -170,7 +192,7 @@ void AnalysisDataServiceImpl::rename(const std::string &oldName,
 void AnalysisDataServiceImpl::remove(const std::string &name) {
   Workspace_sptr ws;
   try {
-    ws = retrieve(name);
+    ws = Kernel::DataService<API::Workspace>::retrieve(name);
   } catch (const Kernel::Exception::NotFoundError &) {
     // do nothing - remove will do what's needed
   }
@@ -180,6 +202,26 @@ void AnalysisDataServiceImpl::remove(const std::string &name) {
   }
 }
 
+/**
+ * Retrieve a workspace. If its data was moved to disk to keep within the
+ * memory limit it is read back, which may spill other workspaces.
+ * @param name :: name of the workspace
+ * @return a pointer to the workspace
+ * @throw Kernel::Exception::NotFoundError if the workspace does not exist
+ * @throw std::runtime_error if the data of the workspace cannot be read back
+ */
+Workspace_sptr
+AnalysisDataServiceImpl::retrieve(const std::string &name) const {
+  auto workspace = Kernel::DataService<API::Workspace>::retrieve(name);
+  if (dynamic_cast<const SpilledWorkspace *>(workspace.get())) {
+    return restore(name);
+  }
+  if (m_memoryLimit > 0) {
+    touch(workspace.get());
+  }
+  return workspace;
+}
+
 /**
  * @brief Given a list of names retrieve the corresponding workspace handles
  * @param names A list of names of workspaces, if any does not exist then
@@ -324,7 +366,9 @@ AnalysisDataServiceImpl::topLevelItems() const {
   for (const auto &topLevelName : topLevelNames) {
     try {
       const std::string &name = topLevelName;
-      auto ws = this->retrieve(topLevelName);
+      // Spilled workspaces are not read back
+      auto ws =
+          Kernel::DataService<API::Workspace>::retrieve(topLevelName);
       topLevel.emplace(name, ws);
       if (auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(ws)) {
         group->reportMembers(groupMembers);
@@ -348,6 +392,54 @@ AnalysisDataServiceImpl::topLevelItems() const {
 
 void AnalysisDataServiceImpl::shutdown() { clear(); }
 
+/**
+ * Set the memory the workspaces may use before the least recently used ones
+ * are spilled to disk. Only MatrixWorkspaces that are not event workspaces
+ * and are held by nothing but the service, e.g. not by a group or a running
+ * algorithm, can be spilled.
+ * @param bytes :: the limit in bytes, 0 for no limit
+ */
+void AnalysisDataServiceImpl::setMemoryLimit(const size_t bytes) {
+  m_memoryLimit = bytes;
+  if (bytes == 0) {
+    std::lock_guard<std::mutex> lock(m_accessMutex);
+    m_lastAccess.clear();
+  } else {
+    applyMemoryLimit(nullptr);
+  }
+}
+
+/// @return the memory the workspaces may use in bytes, 0 if unlimited
+size_t AnalysisDataServiceImpl::memoryLimit() const { return m_memoryLimit; }
+
+/**
+ * @param directory :: directory to write spilled data to. If empty, the
+ * temporary directory is used.
+ */
+void AnalysisDataServiceImpl::setSpillDirectory(const std::string &directory) {
+  std::lock_guard<std::recursive_mutex> lock(m_spillMutex);
+  m_spillDirectory = directory;
+}
+
+/// @return the memory used by the workspaces and the spilling so far
+AnalysisDataServiceImpl::MemoryStatistics
+AnalysisDataServiceImpl::memoryStatistics() const {
+  MemoryStatistics statistics;
+  statistics.limit = m_memoryLimit;
+  statistics.numSpills = m_numSpills;
+  statistics.numRestores = m_numRestores;
+  std::lock_guard<std::recursive_mutex> lock(m_spillMutex);
+  for (const auto &workspace : getObjects(Kernel::DataServiceHidden::Include)) {
+    statistics.inMemory += workspace->getMemorySize();
+    const auto *spilled = dynamic_cast<SpilledWorkspace *>(workspace.get());
+    if (spilled && spilled->isSpilled()) {
+      ++statistics.numSpilled;
+      statistics.onDisk += spilled->restoredMemorySize();
+    }
+  }
+  return statistics;
+}
+
 //-------------------------------------------------------------------------
 // Private methods
 //-------------------------------------------------------------------------
@@ -358,7 +450,8 @@ void AnalysisDataServiceImpl::shutdown() { clear(); }
 AnalysisDataServiceImpl::AnalysisDataServiceImpl()
     : Mantid::Kernel::DataService<Mantid::API::Workspace>(
           "AnalysisDataService"),
-      m_illegalChars() {}
+      m_illegalChars(), m_memoryLimit(0), m_accessCount(0), m_numSpills(0),
+      m_numRestores(0) {}
 
 // The following is commented using /// rather than /** to stop the compiler
 // complaining
@@ -405,5 +498,171 @@ void AnalysisDataServiceImpl::verifyName(
   }
 }
 
+/**
+ * Record that a workspace has just been used
+ * @param workspace :: the workspace
+ */
+void AnalysisDataServiceImpl::touch(const Workspace *workspace) const {
+  std::lock_guard<std::mutex> lock(m_accessMutex);
+  m_lastAccess[workspace] = ++m_accessCount;
+}
+
+/**
+ * Read a spilled workspace back from disk and put it in place of its
+ * SpilledWorkspace
+ * @param name :: name of the workspace
+ * @return the workspace
+ */
+Workspace_sptr
+AnalysisDataServiceImpl::restore(const std::string &name) const {
+  // Users of the service cannot tell a workspace from its stand-in, so
+  // swapping them does not change the service as they see it
+  auto &self = const_cast<AnalysisDataServiceImpl &>(*this);
+  Workspace_sptr workspace;
+  {
+    std::lock_guard<std::recursive_mutex> lock(m_spillMutex);
+    // Another thread may have restored it while this one waited
+    const auto current = Kernel::DataService<API::Workspace>::retrieve(name);
+    const auto spilled = boost::dynamic_pointer_cast<SpilledWorkspace>(current);
+    if (!spilled) {
+      return current;
+    }
+    workspace = spilled->restore();
+    workspace->setName(name);
+    if (!self.exchange(name, current, workspace)) {
+      // It was replaced or removed meanwhile
+      return retrieve(name);
+    }
+    ++m_numRestores;
+  }
+  g_spillLog.debug() << "Read " << name << " back from disk\n";
+  touch(workspace.get());
+  self.notificationCenter.postNotification(
+      new WorkspaceRestoredNotification(name, workspace));
+  self.applyMemoryLimit(workspace.get());
+  return workspace;
+}
+
+/**
+ * Spill the least recently used workspaces until the workspaces in memory fit
+ * within the memory limit
+ * @param keep :: a workspace that must stay in memory, may be null
+ */
+void AnalysisDataServiceImpl::applyMemoryLimit(const Workspace *keep) {
+  const size_t limit = m_memoryLimit;
+  if (limit == 0) {
+    return;
+  }
+  // A thread already applying the limit will account for this workspace
+  std::unique_lock<std::recursive_mutex> lock(m_spillMutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return;
+  }
+
+  struct Candidate {
+    std::string name;
+    Workspace_sptr workspace;
+    uint64_t lastAccess;
+  };
+  std::vector<Candidate> candidates;
+  std::unordered_set<const Workspace *> present;
+  size_t inMemory = 0;
+  for (const auto &name : getObjectNames(Kernel::DataServiceSort::Unsorted,
+                                         Kernel::DataServiceHidden::Include)) {
+    Workspace_sptr workspace;
+    try {
+      workspace = Kernel::DataService<API::Workspace>::retrieve(name);
+    } catch (const Kernel::Exception::NotFoundError &) {
+      continue;
+    }
+    inMemory += workspace->getMemorySize();
+    present.insert(workspace.get());
+    if (workspace.get() != keep && SpilledWorkspace::canSpill(*workspace)) {
+      candidates.push_back({name, std::move(workspace), 0});
+    }
+  }
+  {
+    std::lock_guard<std::mutex> accessLock(m_accessMutex);
+    for (auto &candidate : candidates) {
+      const auto access = m_lastAccess.find(candidate.workspace.get());
+      if (access != m_lastAccess.end()) {
+        candidate.lastAccess = access->second;
+      }
+    }
+    // Forget the workspaces that are no longer in the service
+    for (auto it = m_lastAccess.begin(); it != m_lastAccess.end();) {
+      if (present.count(it->first) == 0) {
+        it = m_lastAccess.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  if (inMemory <= limit) {
+    return;
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate &lhs, const Candidate &rhs) {
+              return lhs.lastAccess < rhs.lastAccess;
+            });
+  for (auto &candidate : candidates) {
+    if (inMemory <= limit) {
+      break;
+    }
+    inMemory -= std::min(inMemory, spill(candidate.name, candidate.workspace));
+    candidate.workspace.reset();
+  }
+  if (inMemory > limit) {
+    g_spillLog.debug() << "Workspaces use " << inMemory / 1024
+                       << " kB, above the memory limit, but the others are "
+                          "in use and cannot be spilled\n";
+  }
+}
+
+/**
+ * Move the data of a workspace to disk, unless it is used outside the
+ * service
+ * @param name :: name of the workspace
+ * @param workspace :: the workspace, held only by the service and the caller
+ * if it is not in use
+ * @return the memory freed in bytes
+ */
+size_t AnalysisDataServiceImpl::spill(const std::string &name,
+                                      const Workspace_sptr &workspace) {
+  auto standIn = boost::make_shared<SpilledWorkspace>(
+      boost::static_pointer_cast<MatrixWorkspace>(workspace));
+  // The service, the caller and the stand-in hold the workspace. Swapping
+  // first means that no one can use it while it is written.
+  if (!exchange(name, workspace, standIn, 3)) {
+    return 0;
+  }
+  standIn->setName(name);
+  const size_t size = workspace->getMemorySize();
+
+  auto directory = m_spillDirectory;
+  if (directory.empty()) {
+    directory = Kernel::ConfigService::Instance().getTempDir();
+  }
+  Poco::Path path(directory);
+  path.makeDirectory();
+  path.setFileName("mantid_" + std::to_string(Poco::Process::id()) + "_" +
+                   std::to_string(m_numSpills + 1) + ".spill");
+  try {
+    standIn->spill(path.toString());
+  } catch (const std::exception &error) {
+    g_spillLog.warning() << "Unable to move " << name
+                         << " to disk: " << error.what() << '\n';
+    exchange(name, standIn, workspace);
+    return 0;
+  }
+  ++m_numSpills;
+  g_spillLog.debug() << "Moved " << name << " to disk to free "
+                     << size / 1024 << " kB\n";
+  notificationCenter.postNotification(
+      new WorkspaceSpilledNotification(name, standIn));
+  return size - std::min(size, standIn->getMemorySize());
+}
+
 } // Namespace API
 } // Namespace Mantid
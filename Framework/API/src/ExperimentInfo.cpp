@@ -18,6 +18,7 @@
 #include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentCache.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
 #include "MantidGeometry/Instrument/ParComponentFactory.h"
 #include "MantidGeometry/Instrument/ParameterFactory.h"
@@ -52,6 +53,7 @@
 #include <Poco/SAX/SAXParser.h>
 #include <nexus/NeXusException.hpp>
 #include <tuple>
+#include <utility>
 
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -458,7 +460,7 @@ void ExperimentInfo::populateInstrumentParameters() {
       continue;
     }
   }
-  for (const auto &item : paramMapForPosAndRot) {
+  for (const auto &item : std::as_const(paramMapForPosAndRot)) {
     if (isPositionParameter(item.second->name())) {
       const auto newRelPos = item.second->value<V3D>();
       updatePosition(componentInfo, item.first, newRelPos);
@@ -471,7 +473,7 @@ void ExperimentInfo::populateInstrumentParameters() {
   }
   // Special case RectangularDetector: Parameters scalex and scaley affect pixel
   // positions.
-  for (const auto &item : paramMap) {
+  for (const auto &item : std::as_const(paramMap)) {
     if (isScaleParameter(item.second->name()))
       adjustPositionsFromScaleFactor(componentInfo, item.first,
                                      item.second->name(),
@@ -1109,6 +1111,7 @@ void ExperimentInfo::invalidateSpectrumDefinition(const size_t index) {
   // This uses a vector of char, such that flags for different indices can be
   // set from different threads (std::vector<bool> is not thread-safe).
   m_spectrumDefinitionNeedsUpdate.at(index) = 1;
+  ++m_spectrumDefinitionInvalidationCount;
 }
 
 void ExperimentInfo::updateSpectrumDefinitionIfNecessary(
@@ -1117,6 +1120,13 @@ void ExperimentInfo::updateSpectrumDefinitionIfNecessary(
     updateCachedDetectorGrouping(index);
 }
 
+/** Returns a counter that changes whenever spectrum definitions are marked as
+ * outdated. Caches derived from the spectrum definitions can compare it with
+ * the value they were computed for instead of checking every spectrum. */
+size_t ExperimentInfo::spectrumDefinitionInvalidationCount() const {
+  return m_spectrumDefinitionInvalidationCount;
+}
+
 /** Sets up a default detector grouping.
  *
  * The purpose of this method is to work around potential issues of MDWorkspaces
@@ -1144,6 +1154,7 @@ void ExperimentInfo::cacheDefaultDetectorGrouping() const {
 void ExperimentInfo::invalidateAllSpectrumDefinitions() {
   std::fill(m_spectrumDefinitionNeedsUpdate.begin(),
             m_spectrumDefinitionNeedsUpdate.end(), 1);
+  ++m_spectrumDefinitionInvalidationCount;
 }
 
 /** Save the object to an open NeXus file.
@@ -1340,8 +1351,14 @@ void ExperimentInfo::setInstumentFromXML(const std::string &nxFilename,
       // If it does, just use the one from the one stored there
       instr = InstrumentDataService::Instance().retrieve(instrumentNameMangled);
     } else {
-      // Really create the instrument
-      instr = parser.parseXML(nullptr);
+      // Use an instrument built by an earlier process if there is one
+      const InstrumentCache cache;
+      instr = cache.load(instrumentNameMangled);
+      if (!instr) {
+        // Really create the instrument
+        instr = parser.parseXML(nullptr);
+        cache.save(*instr, instrumentNameMangled);
+      }
       // Parse the instrument tree (internally create ComponentInfo and
       // DetectorInfo). This is an optimization that avoids duplicate parsing
       // of the instrument tree when loading multiple workspaces with the same
@@ -15,6 +15,7 @@
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyManagerDataService.h"
+#include "MantidKernel/Tracing.h"
 #include "MantidKernel/UsageService.h"
 
 #include <boost/algorithm/string/split.hpp>
@@ -153,6 +154,8 @@ FrameworkManagerImpl::FrameworkManagerImpl()
   loadPlugins();
   disableNexusOutput();
   setNumOMPThreadsToConfigValue();
+  setTracingFileToConfigValue();
+  setWorkspaceMemoryLimitToConfigValue();
 
 #ifdef MPI_BUILD
   g_log.notice() << "This MPI process is rank: "
@@ -183,6 +186,39 @@ void FrameworkManagerImpl::setNumOMPThreadsToConfigValue() {
   }
 }
 
+/**
+ * Enable tracing if the config names a file to write the trace to. The
+ * MANTID_TRACE_FILE environment variable takes precedence.
+ */
+void FrameworkManagerImpl::setTracingFileToConfigValue() {
+  if (!Kernel::Tracing::outputFile().empty())
+    return;
+  const auto filename =
+      Kernel::ConfigService::Instance().getString("tracing.file");
+  if (!filename.empty()) {
+    g_log.notice() << "Writing a trace of the session to " << filename
+                   << " at shutdown\n";
+    Kernel::Tracing::setOutputFile(filename);
+  }
+}
+
+/**
+ * Limit the memory used by the workspaces in the AnalysisDataService if the
+ * config sets a limit, spilling the least recently used ones to disk above it
+ */
+void FrameworkManagerImpl::setWorkspaceMemoryLimitToConfigValue() {
+  auto &config = Kernel::ConfigService::Instance();
+  const auto limitMB =
+      config.getValue<double>("workspaces.memoryLimitMB").get_value_or(0.);
+  if (limitMB <= 0.)
+    return;
+  auto &ads = AnalysisDataService::Instance();
+  ads.setSpillDirectory(config.getString("workspaces.spillDirectory"));
+  ads.setMemoryLimit(static_cast<size_t>(limitMB * 1024. * 1024.));
+  g_log.information() << "Workspaces beyond " << limitMB
+                      << " MB will be moved to disk when not in use\n";
+}
+
 /**
  * Set the number of OpenMP cores to use based on the config value
  * @param nthreads :: The maximum number of threads to use
@@ -190,6 +226,7 @@ void FrameworkManagerImpl::setNumOMPThreadsToConfigValue() {
 void FrameworkManagerImpl::setNumOMPThreads(const int nthreads) {
   g_log.debug() << "Setting maximum number of threads to " << nthreads << "\n";
   PARALLEL_SET_NUM_THREADS(nthreads);
+  Kernel::setParallelThreadBudget(nthreads);
   if (m_globalTbbControl) {
     m_globalTbbControl
         .reset(); // Have to reset to change the number of threads at runtime
@@ -225,6 +262,7 @@ void FrameworkManagerImpl::clear() {
 
 void FrameworkManagerImpl::shutdown() {
   Kernel::UsageService::Instance().shutdown();
+  Kernel::Tracing::flush();
   // Ensure we don't run into static init ordering issues with TBB
   m_globalTbbControl.reset();
   clear();
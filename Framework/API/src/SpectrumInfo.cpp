@@ -8,6 +8,7 @@
 #include "MantidAPI/ExperimentInfo.h"
 #include "MantidAPI/SpectrumInfoIterator.h"
 #include "MantidBeamline/SpectrumInfo.h"
+#include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidKernel/Exception.h"
@@ -16,6 +17,8 @@
 
 #include <algorithm>
 #include <boost/make_shared.hpp>
+#include <cmath>
+#include <limits>
 
 namespace Mantid {
 namespace API {
@@ -147,6 +150,109 @@ const Geometry::IDetector &SpectrumInfo::detector(const size_t index) const {
   return getDetector(index);
 }
 
+/** Returns the geometry of all spectra.
+ *
+ * The values are averaged over the detectors of each spectrum in the same way
+ * as l2(), twoTheta(), signedTwoTheta(), azimuthal() and position() do. DIFC
+ * is the uncalibrated TOF to d-spacing factor, 1/tofToDSpacingFactor(), of the
+ * spectrum. The values are computed for all spectra on the first call and
+ * cached until detectors or other components are moved, or the grouping of
+ * detectors into spectra changes. Entries are NaN for spectra without
+ * detectors, and all but L2 and the position are NaN for monitors. Throws
+ * under the same conditions as DetectorInfo::cachedGeometry() for
+ * non-scanning instruments. */
+const SpectrumInfo::CachedGeometry &SpectrumInfo::cachedGeometry() const {
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  const auto revision = m_detectorInfo.geometryRevision();
+  // Spectrum definitions change either directly, or by being marked outdated
+  // and updated lazily, e.g. after detector IDs of a spectrum were changed.
+  // Both are tracked by counters, so checking the cache does not need to look
+  // at every spectrum.
+  const auto invalidationCount =
+      m_experimentInfo.spectrumDefinitionInvalidationCount();
+  if (m_cachedGeometry && m_cachedGeometryRevision == revision &&
+      m_cachedInvalidationCount == invalidationCount &&
+      m_cachedSpectrumDefinitionRevision ==
+          m_spectrumInfo.spectrumDefinitionRevision())
+    return *m_cachedGeometry;
+
+  const auto &spectrumDefinitions = sharedSpectrumDefinitions();
+  const auto spectrumDefinitionRevision =
+      m_spectrumInfo.spectrumDefinitionRevision();
+
+  const size_t numberOfSpectra = size();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  auto geometry = std::make_unique<CachedGeometry>();
+  geometry->l2.resize(numberOfSpectra, nan);
+  geometry->twoTheta.resize(numberOfSpectra, nan);
+  geometry->signedTwoTheta.resize(numberOfSpectra, nan);
+  geometry->azimuthal.resize(numberOfSpectra, nan);
+  geometry->position.resize(numberOfSpectra, Kernel::V3D(nan, nan, nan));
+  geometry->difc.resize(numberOfSpectra, nan);
+
+  const double l1 = this->l1();
+  const bool scanning = m_detectorInfo.isScanning();
+  // Per detector values come from the cache of DetectorInfo unless detectors
+  // are scanning, which it does not support.
+  const auto *detectorGeometry =
+      scanning ? nullptr : &m_detectorInfo.cachedGeometry();
+  const auto computeSpectrum = [&](const size_t i) {
+    const auto &spectrumDefinition = (*spectrumDefinitions)[i];
+    if (spectrumDefinition.size() == 0)
+      return;
+    double l2{0.0};
+    double twoTheta{0.0};
+    double signedTwoTheta{0.0};
+    double azimuthal{0.0};
+    Kernel::V3D position;
+    for (const auto &index : spectrumDefinition) {
+      position += m_detectorInfo.position(index);
+      if (detectorGeometry) {
+        l2 += detectorGeometry->l2[index.first];
+        twoTheta += detectorGeometry->twoTheta[index.first];
+        signedTwoTheta += detectorGeometry->signedTwoTheta[index.first];
+        azimuthal += detectorGeometry->azimuthal[index.first];
+        continue;
+      }
+      l2 += m_detectorInfo.l2(index);
+      if (m_detectorInfo.isMonitor(index)) {
+        twoTheta = signedTwoTheta = azimuthal = nan;
+        continue;
+      }
+      twoTheta += m_detectorInfo.twoTheta(index);
+      signedTwoTheta += m_detectorInfo.signedTwoTheta(index);
+      azimuthal += m_detectorInfo.azimuthal(index);
+    }
+    const auto count = static_cast<double>(spectrumDefinition.size());
+    l2 /= count;
+    twoTheta /= count;
+    geometry->l2[i] = l2;
+    geometry->twoTheta[i] = twoTheta;
+    geometry->signedTwoTheta[i] = signedTwoTheta / count;
+    geometry->azimuthal[i] = azimuthal / count;
+    geometry->position[i] = position / count;
+    if (!std::isnan(twoTheta))
+      geometry->difc[i] =
+          1. / Geometry::Conversion::tofToDSpacingFactor(l1, l2, twoTheta, 0.);
+  };
+  if (scanning) {
+    // The scalar methods used for scanning detectors may throw, which must not
+    // happen inside a parallel region.
+    for (size_t i = 0; i < numberOfSpectra; ++i)
+      computeSpectrum(i);
+  } else {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(numberOfSpectra); ++i)
+      computeSpectrum(static_cast<size_t>(i));
+  }
+
+  m_cachedGeometry = std::move(geometry);
+  m_cachedGeometryRevision = revision;
+  m_cachedInvalidationCount = invalidationCount;
+  m_cachedSpectrumDefinitionRevision = spectrumDefinitionRevision;
+  return *m_cachedGeometry;
+}
+
 /// Returns the source position.
 Kernel::V3D SpectrumInfo::sourcePosition() const {
   return m_detectorInfo.sourcePosition();
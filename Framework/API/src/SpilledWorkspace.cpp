@@ -0,0 +1,253 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/SpilledWorkspace.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+
+#include <Poco/File.h>
+
+#include <fstream>
+
+using Mantid::HistogramData::BinEdges;
+using Mantid::HistogramData::Histogram;
+using Mantid::HistogramData::HistogramDx;
+using Mantid::HistogramData::HistogramE;
+using Mantid::HistogramData::HistogramX;
+using Mantid::HistogramData::HistogramY;
+using Mantid::HistogramData::Points;
+
+namespace Mantid {
+namespace API {
+
+namespace {
+/// Identifies the file layout written by spill()
+constexpr uint32_t FILE_VERSION = 1;
+
+/// Describe how a histogram is stored in the file
+enum HistogramFlags : uint8_t { SharedX = 1, HasDx = 2, SharedDx = 4 };
+
+template <typename T> void write(std::ostream &out, const T value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> T read(std::istream &in) {
+  T value{};
+  in.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return value;
+}
+
+void writeValues(std::ostream &out, const std::vector<double> &values) {
+  out.write(reinterpret_cast<const char *>(values.data()),
+            static_cast<std::streamsize>(values.size() * sizeof(double)));
+}
+
+template <typename T>
+Kernel::cow_ptr<T> readValues(std::istream &in, const size_t size) {
+  auto values = Kernel::make_cow<T>(size);
+  if (size > 0) {
+    in.read(reinterpret_cast<char *>(&values.access()[0]),
+            static_cast<std::streamsize>(size * sizeof(double)));
+  }
+  return values;
+}
+
+/// Delete a file, ignoring errors as it may not have been created
+void removeQuietly(const std::string &filename) {
+  try {
+    Poco::File(filename).remove();
+  } catch (const Poco::Exception &) {
+  }
+}
+
+/// @throw std::runtime_error if the histogram cannot be restored from a file
+void checkCanBeWritten(const Histogram &histogram) {
+  if (!histogram.sharedY() || !histogram.sharedE() ||
+      histogram.yMode() == Histogram::YMode::Uninitialized) {
+    throw std::runtime_error("Cannot spill a histogram without data");
+  }
+}
+} // namespace
+
+/**
+ * @param workspace :: a workspace
+ * @return true if the data of the workspace can be moved to disk
+ */
+bool SpilledWorkspace::canSpill(const Workspace &workspace) {
+  return dynamic_cast<const MatrixWorkspace *>(&workspace) &&
+         !dynamic_cast<const IEventWorkspace *>(&workspace);
+}
+
+/**
+ * Hold a workspace, still in memory, so that it can be spilled
+ * @param workspace :: a workspace for which canSpill() is true
+ */
+SpilledWorkspace::SpilledWorkspace(MatrixWorkspace_sptr workspace)
+    : m_workspace(std::move(workspace)),
+      m_restoredMemorySize(m_workspace->getMemorySize()) {}
+
+SpilledWorkspace::~SpilledWorkspace() { removeFile(); }
+
+/**
+ * Write the histograms of the workspace to a file and free them. Shared X
+ * and Dx data are written once and are shared again when restored.
+ * @param filename :: the file to create
+ * @throw std::runtime_error if the file cannot be written, in which case the
+ * workspace is unchanged
+ */
+void SpilledWorkspace::spill(const std::string &filename) {
+  if (isSpilled()) {
+    return;
+  }
+  auto &workspace = *m_workspace;
+  const size_t numHistograms = workspace.getNumberHistograms();
+  m_restoredMemorySize = workspace.getMemorySize();
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  try {
+    if (!out) {
+      throw std::runtime_error("Unable to create " + filename);
+    }
+    write(out, FILE_VERSION);
+    write(out, static_cast<uint64_t>(numHistograms));
+    Kernel::cow_ptr<HistogramX> previousX(nullptr);
+    Kernel::cow_ptr<HistogramDx> previousDx(nullptr);
+    for (size_t i = 0; i < numHistograms; ++i) {
+      const auto histogram = workspace.histogram(i);
+      checkCanBeWritten(histogram);
+      uint8_t flags = 0;
+      if (histogram.sharedX() == previousX)
+        flags |= SharedX;
+      if (histogram.sharedDx()) {
+        flags |= HasDx;
+        if (histogram.sharedDx() == previousDx)
+          flags |= SharedDx;
+      }
+      write(out, static_cast<uint8_t>(histogram.xMode()));
+      write(out, static_cast<uint8_t>(histogram.yMode()));
+      write(out, flags);
+      if (!(flags & SharedX)) {
+        write(out, static_cast<uint64_t>(histogram.x().size()));
+        writeValues(out, histogram.x().rawData());
+      }
+      write(out, static_cast<uint64_t>(histogram.y().size()));
+      writeValues(out, histogram.y().rawData());
+      writeValues(out, histogram.e().rawData());
+      if ((flags & HasDx) && !(flags & SharedDx)) {
+        writeValues(out, histogram.dx().rawData());
+      }
+      previousX = histogram.sharedX();
+      previousDx = histogram.sharedDx();
+    }
+    out.close();
+    if (!out) {
+      throw std::runtime_error("Unable to write " + filename);
+    }
+  } catch (...) {
+    out.close();
+    removeQuietly(filename);
+    throw;
+  }
+  m_filename = filename;
+
+  // Replace the histograms by empty ones sharing the same storage
+  const auto emptyY = Kernel::make_cow<HistogramY>(0);
+  const auto emptyE = Kernel::make_cow<HistogramE>(0);
+  for (size_t i = 0; i < numHistograms; ++i) {
+    const auto histogram = workspace.histogram(i);
+    Histogram empty(histogram.xMode(), histogram.yMode());
+    empty.setSharedY(emptyY);
+    empty.setSharedE(emptyE);
+    workspace.setHistogram(i, std::move(empty));
+  }
+}
+
+/**
+ * Read the histograms back into the workspace and delete the file
+ * @return the workspace
+ * @throw std::runtime_error if the file cannot be read, in which case
+ * restore() may be called again
+ */
+MatrixWorkspace_sptr SpilledWorkspace::restore() {
+  if (!isSpilled()) {
+    return m_workspace;
+  }
+  auto &workspace = *m_workspace;
+  const size_t numHistograms = workspace.getNumberHistograms();
+  std::ifstream in(m_filename, std::ios::binary);
+  if (!in || read<uint32_t>(in) != FILE_VERSION ||
+      read<uint64_t>(in) != numHistograms) {
+    throw std::runtime_error("Unable to read spilled workspace from " +
+                             m_filename);
+  }
+  Kernel::cow_ptr<HistogramX> x(nullptr);
+  Kernel::cow_ptr<HistogramDx> dx(nullptr);
+  for (size_t i = 0; i < numHistograms; ++i) {
+    const auto xMode = static_cast<Histogram::XMode>(read<uint8_t>(in));
+    const auto yMode = static_cast<Histogram::YMode>(read<uint8_t>(in));
+    const auto flags = read<uint8_t>(in);
+    if (!(flags & SharedX)) {
+      x = readValues<HistogramX>(in, read<uint64_t>(in));
+    }
+    const auto size = read<uint64_t>(in);
+    const auto y = readValues<HistogramY>(in, size);
+    const auto e = readValues<HistogramE>(in, size);
+    if (!(flags & HasDx)) {
+      dx = Kernel::cow_ptr<HistogramDx>(nullptr);
+    } else if (!(flags & SharedDx)) {
+      dx = readValues<HistogramDx>(in, size);
+    }
+    if (!in) {
+      throw std::runtime_error("Unable to read spilled workspace from " +
+                               m_filename);
+    }
+    Histogram histogram = xMode == Histogram::XMode::BinEdges
+                              ? Histogram(BinEdges(x))
+                              : Histogram(Points(x));
+    histogram.setYMode(yMode);
+    histogram.setSharedY(y);
+    histogram.setSharedE(e);
+    histogram.setSharedDx(dx);
+    workspace.setHistogram(i, std::move(histogram));
+  }
+  in.close();
+  removeFile();
+  return m_workspace;
+}
+
+const std::string SpilledWorkspace::toString() const {
+  return "SpilledWorkspace\nTitle: " + getTitle() +
+         "\nThe data has been saved to disk to free memory. It is read back "
+         "when the workspace is next retrieved.\n";
+}
+
+const std::string SpilledWorkspace::getTitle() const {
+  return m_workspace->getTitle();
+}
+
+/// @return the memory used by the workspace without the spilled data
+size_t SpilledWorkspace::getMemorySize() const {
+  return m_workspace->getMemorySize();
+}
+
+SpilledWorkspace *SpilledWorkspace::doClone() const {
+  throw std::runtime_error("Cloning of SpilledWorkspace is not implemented.");
+}
+
+SpilledWorkspace *SpilledWorkspace::doCloneEmpty() const {
+  throw std::runtime_error("Cloning of SpilledWorkspace is not implemented.");
+}
+
+/// Delete the file holding the data, if any
+void SpilledWorkspace::removeFile() {
+  if (!m_filename.empty()) {
+    removeQuietly(m_filename);
+    m_filename.clear();
+  }
+}
+
+} // namespace API
+} // namespace Mantid
@@ -15,7 +15,6 @@
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/functional/hash.hpp>
 #if BOOST_VERSION == 106900
 #ifndef BOOST_PENDING_INTEGER_LOG2_HPP
 #define BOOST_PENDING_INTEGER_LOG2_HPP
@@ -29,6 +28,9 @@
 #include "Poco/DateTime.h"
 #include <Poco/DateTimeParser.h>
 
+#include <algorithm>
+#include <unordered_set>
+
 using boost::algorithm::split;
 using Mantid::Kernel::EnvironmentHistory;
 
@@ -37,25 +39,11 @@ namespace API {
 namespace {
 /// static logger object
 Kernel::Logger g_log("WorkspaceHistory");
-struct AlgorithmHistorySearch {
-  bool operator()(const AlgorithmHistory_sptr &lhs,
-                  const AlgorithmHistory_sptr &rhs) {
-    return (*lhs) < (*rhs);
-  }
-};
-struct AlgorithmHistoryHasher {
-  size_t operator()(const AlgorithmHistory_sptr &x) const {
-    std::size_t nameAsSeed = std::hash<std::string>{}(x->name());
-    boost::hash_combine(nameAsSeed, x->executionDate().totalNanoseconds());
-    return nameAsSeed;
-  }
-};
-struct AlgorithmHistoryComparator {
-  bool operator()(const AlgorithmHistory_sptr &a,
-                  const AlgorithmHistory_sptr &b) const {
-    return a->uuid() == b->uuid();
-  }
-};
+/// @return true if lhs was executed before rhs
+bool executedBefore(const AlgorithmHistory_sptr &lhs,
+                    const AlgorithmHistory_sptr &rhs) {
+  return (*lhs) < (*rhs);
+}
 } // namespace
 
 /// Default Constructor
@@ -69,14 +57,12 @@ WorkspaceHistory::~WorkspaceHistory() = default;
   @param A :: WorkspaceHistory Item to copy
  */
 WorkspaceHistory::WorkspaceHistory(const WorkspaceHistory &A)
-    : m_environment(A.m_environment) {
-  m_algorithms = A.m_algorithms;
-}
+    : m_environment(A.m_environment), m_algorithms(A.m_algorithms) {}
 
 /// Returns a const reference to the algorithmHistory
 const Mantid::API::AlgorithmHistories &
 WorkspaceHistory::getAlgorithmHistories() const {
-  return m_algorithms;
+  return *m_algorithms;
 }
 /// Returns a const reference to the EnvironmentHistory
 const Kernel::EnvironmentHistory &
@@ -84,60 +70,85 @@ WorkspaceHistory::getEnvironmentHistory() const {
   return m_environment;
 }
 
-/// Append the algorithm history from another WorkspaceHistory into this one
+/** Append the algorithm history from another WorkspaceHistory into this one.
+ * The result is ordered by execution and contains each algorithm once.
+ *
+ * Histories that are already shared or that only extend each other, as when
+ * an algorithm adds the history of its input to its output, are merged
+ * without copying the list.
+ * @param otherHistory :: the history to merge into this one
+ */
 void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
-  // Don't copy one's own history onto oneself
-  if (this == &otherHistory) {
+  const auto &mine = *m_algorithms;
+  const auto &other = *otherHistory.m_algorithms;
+  // Nothing to do if both share the list, e.g. for our own history
+  if (m_algorithms == otherHistory.m_algorithms) {
+    return;
+  }
+  // If one list starts with the other the longer one is the result
+  if (mine.size() >= other.size()) {
+    if (std::equal(other.cbegin(), other.cend(), mine.cbegin())) {
+      return;
+    }
+  } else if (std::equal(mine.cbegin(), mine.cend(), other.cbegin())) {
+    m_algorithms = otherHistory.m_algorithms;
     return;
   }
 
-  // Merge the histories
-  const AlgorithmHistories &otherAlgorithms =
-      otherHistory.getAlgorithmHistories();
-
-  for (const auto &algHistory : otherAlgorithms) {
-    this->addHistory(algHistory);
+  // Append the other list if it only holds later algorithms
+  if (executedBefore(mine.back(), other.front())) {
+    auto &algorithms = m_algorithms.access();
+    algorithms.insert(algorithms.end(), other.cbegin(), other.cend());
+    return;
   }
 
-  using UniqueAlgorithmHistories =
-      std::unordered_set<AlgorithmHistory_sptr, AlgorithmHistoryHasher,
-                         AlgorithmHistoryComparator>;
-  // It is faster to default construct a set/unordered_set and insert the
-  // elements than use the range-based constructor directly.
-  // See https://stackoverflow.com/a/24477023:
-  //   "the constructor actually construct a new node for every element, before
-  //   checking its value to determine if it should actually be inserted."
-  UniqueAlgorithmHistories uniqueHistories;
-  for (const auto &algorithmHistory : m_algorithms) {
-    uniqueHistories.insert(algorithmHistory);
+  // General case: merge the two ordered lists, skipping algorithms that are
+  // in both
+  std::unordered_set<std::string> uuids;
+  uuids.reserve(mine.size() + other.size());
+  for (const auto &algorithm : mine) {
+    uuids.insert(algorithm->uuid());
   }
-  m_algorithms.assign(std::begin(uniqueHistories), std::end(uniqueHistories));
-  std::sort(std::begin(m_algorithms), std::end(m_algorithms),
-            AlgorithmHistorySearch());
+  AlgorithmHistories merged;
+  merged.reserve(mine.size() + other.size());
+  auto next = mine.cbegin();
+  for (const auto &algorithm : other) {
+    if (!uuids.insert(algorithm->uuid()).second) {
+      continue;
+    }
+    while (next != mine.cend() && !executedBefore(algorithm, *next)) {
+      merged.emplace_back(*next++);
+    }
+    merged.emplace_back(algorithm);
+  }
+  merged.insert(merged.end(), next, mine.cend());
+  m_algorithms = boost::make_shared<AlgorithmHistories>(std::move(merged));
 }
 
 /// Append an AlgorithmHistory to this WorkspaceHistory
 void WorkspaceHistory::addHistory(AlgorithmHistory_sptr algHistory) {
   // Assume it is always sorted as algorithm history should only be inserted in
   // the correct order
-  m_algorithms.emplace_back(std::move(algHistory));
+  m_algorithms.access().emplace_back(std::move(algHistory));
 }
 
 /*
  Return the history length
  */
-size_t WorkspaceHistory::size() const { return m_algorithms.size(); }
+size_t WorkspaceHistory::size() const { return m_algorithms->size(); }
 
 /**
  * Query if the history is empty or not
  * @returns True if the list is empty, false otherwise
  */
-bool WorkspaceHistory::empty() const { return m_algorithms.empty(); }
+bool WorkspaceHistory::empty() const { return m_algorithms->empty(); }
 
 /**
  * Empty the list of algorithm history objects.
  */
-void WorkspaceHistory::clearHistory() { m_algorithms.clear(); }
+void WorkspaceHistory::clearHistory() {
+  m_algorithms = boost::make_shared<AlgorithmHistories>();
+}
 
 /**
  * Retrieve an algorithm history by index
@@ -151,7 +162,7 @@ WorkspaceHistory::getAlgorithmHistory(const size_t index) const {
     throw std::out_of_range(
         "WorkspaceHistory::getAlgorithmHistory() - Index out of range");
   }
-  return *std::next(m_algorithms.cbegin(), index);
+  return (*m_algorithms)[index];
 }
 
 /**
@@ -180,7 +191,7 @@ WorkspaceHistory::getAlgorithm(const size_t index) const {
  * @returns A shared pointer to the algorithm
  */
 boost::shared_ptr<IAlgorithm> WorkspaceHistory::lastAlgorithm() const {
-  if (m_algorithms.empty()) {
+  if (m_algorithms->empty()) {
     throw std::out_of_range(
         "WorkspaceHistory::lastAlgorithm() - History contains no algorithms.");
   }
@@ -195,7 +206,7 @@ boost::shared_ptr<IAlgorithm> WorkspaceHistory::lastAlgorithm() const {
 void WorkspaceHistory::printSelf(std::ostream &os, const int indent) const {
   os << std::string(indent, ' ') << m_environment << '\n';
   os << std::string(indent, ' ') << "Histories:\n";
-  for (const auto &algorithm : m_algorithms) {
+  for (const auto &algorithm : *m_algorithms) {
     os << '\n';
     algorithm->printSelf(os, indent + 2);
   }
@@ -230,7 +241,7 @@ void WorkspaceHistory::saveNexus(::NeXus::File *file) const {
 
   // Algorithm History
   int algCount = 0;
-  for (const auto &algorithm : m_algorithms) {
+  for (const auto &algorithm : *m_algorithms) {
     algorithm->saveNexus(file, algCount);
   }
 
@@ -502,7 +513,7 @@ std::ostream &operator<<(std::ostream &os, const WorkspaceHistory &WH) {
 }
 
 bool WorkspaceHistory::operator==(const WorkspaceHistory &otherHistory) const {
-  return m_algorithms == otherHistory.m_algorithms;
+  return *m_algorithms == *otherHistory.m_algorithms;
 }
 
 } // namespace API
@@ -9,10 +9,10 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
-// Nearest neighbours library
-#include "MantidKernel/ANN/ANN.h"
 #include "MantidKernel/Exception.h"
-#include "MantidKernel/Timer.h"
+#include "MantidKernel/KDTree.h"
+
+#include <algorithm>
 
 namespace Mantid {
 using namespace Geometry;
@@ -20,6 +20,23 @@ namespace API {
 using Kernel::V3D;
 using Mantid::detid_t;
 
+namespace {
+using Tree = Kernel::KDTree<3>;
+
+/// Remove the neighbours at zero distance, i.e. the point itself and any
+/// coincident points, and keep at most maxNeighbours of the rest.
+void dropCoincident(Tree::Neighbours &neighbours, const size_t maxNeighbours) {
+  neighbours.erase(std::remove_if(neighbours.begin(), neighbours.end(),
+                                  [](const Tree::Neighbour &neighbour) {
+                                    return neighbour.distanceSq == 0.;
+                                  }),
+                   neighbours.end());
+  if (neighbours.size() > maxNeighbours) {
+    neighbours.resize(maxNeighbours);
+  }
+}
+} // namespace
+
 /**
  * Constructor
  * @param nNeighbours :: Number of neighbours to use
@@ -36,11 +53,14 @@ WorkspaceNearestNeighbours::WorkspaceNearestNeighbours(
     : m_spectrumInfo(spectrumInfo),
       m_spectrumNumbers(std::move(spectrumNumbers)),
       m_noNeighbours(nNeighbours),
-      m_cutoff(std::numeric_limits<double>::lowest()), m_radius(0.),
+      m_cutoff(std::numeric_limits<double>::lowest()),
       m_bIgnoreMaskedDetectors(ignoreMaskedDetectors) {
+  this->buildTree();
   this->build(m_noNeighbours);
 }
 
+WorkspaceNearestNeighbours::~WorkspaceNearestNeighbours() = default;
+
 /**
  * Returns a map of the spectrum numbers to the distances for the nearest
  * neighbours.
@@ -69,39 +89,23 @@ WorkspaceNearestNeighbours::neighboursInRadius(const specnum_t spectrum,
         "NearestNeighbours::neighbours - Invalid radius parameter.");
   }
 
-  std::map<specnum_t, V3D> result;
   if (radius == 0.0) {
     const int eightNearest = 8;
     if (m_noNeighbours != eightNearest) {
-      // Note: Should be able to do this better but time constraints for the
-      // moment mean that
-      // it is necessary.
-      // Cast is necessary as the user should see this as a const member
+      // Cast is necessary as the user should see this as a const member.
+      // Rebuilding only queries the existing tree.
       const_cast<WorkspaceNearestNeighbours *>(this)->build(eightNearest);
     }
-    result = defaultNeighbours(spectrum);
-  } else if (radius > m_cutoff && m_radius != radius) {
-    // We might have to see how efficient this ends up being.
-    int neighbours = m_noNeighbours + 1;
-    while (true) {
-      try {
-        const_cast<WorkspaceNearestNeighbours *>(this)->build(neighbours);
-      } catch (std::invalid_argument &) {
-        break;
-      }
-      if (radius < m_cutoff)
-        break;
-      else
-        neighbours += 1;
-    }
+    return defaultNeighbours(spectrum);
   }
-  m_radius = radius;
-
-  std::map<detid_t, V3D> nearest = defaultNeighbours(spectrum);
-  for (std::map<specnum_t, V3D>::const_iterator cit = nearest.begin();
-       cit != nearest.end(); ++cit) {
-    if (cit->second.norm() <= radius) {
-      result[cit->first] = cit->second;
+  if (radius > m_cutoff) {
+    // Beyond the reach of the precomputed neighbours: query the tree.
+    return radiusNeighbours(spectrum, radius);
+  }
+  std::map<specnum_t, V3D> result;
+  for (const auto &neighbour : defaultNeighbours(spectrum)) {
+    if (neighbour.second.norm() <= radius) {
+      result.emplace(neighbour);
     }
   }
   return result;
@@ -111,27 +115,14 @@ WorkspaceNearestNeighbours::neighboursInRadius(const specnum_t spectrum,
 // Private member functions
 //--------------------------------------------------------------------------
 /**
- * Builds a map based on the given number of neighbours
- * @param noNeighbours :: The number of nearest neighbours to use to build
- * the graph
+ * Builds the search tree over the positions of the valid spectra
  */
-void WorkspaceNearestNeighbours::build(const int noNeighbours) {
+void WorkspaceNearestNeighbours::buildTree() {
   const auto indices = getSpectraDetectors();
   if (indices.empty()) {
     throw std::runtime_error(
         "NearestNeighbours::build - Cannot find any spectra");
   }
-  const auto nspectra =
-      static_cast<int>(indices.size()); // ANN only deals with integers
-  if (noNeighbours >= nspectra) {
-    throw std::invalid_argument(
-        "NearestNeighbours::build - Invalid number of neighbours");
-  }
-
-  // Clear current
-  m_graph.clear();
-  m_specToVertex.clear();
-  m_noNeighbours = noNeighbours;
 
   BoundingBox bbox;
   // Base the scaling on the first detector, should be adequate but we can look
@@ -139,62 +130,65 @@ void WorkspaceNearestNeighbours::build(const int noNeighbours) {
   const auto &firstDet = m_spectrumInfo.detector(indices.front());
   firstDet.getBoundingBox(bbox);
   m_scale = V3D(bbox.width());
-  ANNpointArray dataPoints = annAllocPts(nspectra, 3);
-  MapIV pointNoToVertex;
 
-  int pointNo = 0;
-  for (const auto i : indices) {
+  const auto nspectra = indices.size();
+  m_pointSpectra.resize(nspectra);
+  m_pointPositions.resize(nspectra);
+  m_specToPoint.reserve(nspectra);
+  m_scaledPositions.resize(nspectra);
+  for (size_t pointNo = 0; pointNo < nspectra; ++pointNo) {
+    const auto i = indices[pointNo];
     const specnum_t spectrum = m_spectrumNumbers[i];
-    V3D pos = m_spectrumInfo.position(i) / m_scale;
-    dataPoints[pointNo][0] = pos.X();
-    dataPoints[pointNo][1] = pos.Y();
-    dataPoints[pointNo][2] = pos.Z();
-    Vertex vertex = boost::add_vertex(spectrum, m_graph);
-    pointNoToVertex[pointNo] = vertex;
-    m_specToVertex[spectrum] = vertex;
-    ++pointNo;
+    const V3D pos = m_spectrumInfo.position(i) / m_scale;
+    m_scaledPositions[pointNo] = {{pos.X(), pos.Y(), pos.Z()}};
+    // The distances are reported in real space
+    m_pointPositions[pointNo] = pos * m_scale;
+    m_pointSpectra[pointNo] = spectrum;
+    m_specToPoint[spectrum] = pointNo;
+  }
+  m_tree = std::make_unique<Tree>(m_scaledPositions);
+}
+
+/**
+ * Finds the given number of neighbours for every spectrum
+ * @param noNeighbours :: The number of nearest neighbours to find
+ */
+void WorkspaceNearestNeighbours::build(const int noNeighbours) {
+  const auto nspectra = m_pointSpectra.size();
+  if (noNeighbours < 0 || static_cast<size_t>(noNeighbours) >= nspectra) {
+    throw std::invalid_argument(
+        "NearestNeighbours::build - Invalid number of neighbours");
   }
+  m_noNeighbours = noNeighbours;
+  const auto k = static_cast<size_t>(noNeighbours);
+
+  // Ask for one extra neighbour as the point itself is always found.
+  auto allNeighbours = m_tree->batchNearest(m_scaledPositions, k + 1);
 
-  auto annTree = std::make_unique<ANNkd_tree>(dataPoints, nspectra, 3);
-  pointNo = 0;
-  // Run the nearest neighbour search on each detector, reusing the arrays
-  // Set size initially to avoid array index error when testing in debug mode
-  std::vector<ANNidx> nnIndexList(m_noNeighbours);
-  std::vector<ANNdist> nnDistList(m_noNeighbours);
-
-  for (const auto idx : indices) {
-    ANNpoint scaledPos = dataPoints[pointNo];
-    annTree->annkSearch(scaledPos,      // Point to search nearest neighbours of
-                        m_noNeighbours, // Number of neighbours to find (8)
-                        nnIndexList.data(), // Index list of results
-                        nnDistList.data(), // List of distances to each of these
-                        0.0 // Error bound (?) is this the radius to search in?
-    );
-    // The distances that are returned are in our scaled coordinate
-    // system. We store the real space ones.
-    const V3D realPos = V3D(scaledPos[0], scaledPos[1], scaledPos[2]) * m_scale;
-    for (int i = 0; i < m_noNeighbours; i++) {
-      ANNidx index = nnIndexList[i];
-      V3D neighbour = V3D(dataPoints[index][0], dataPoints[index][1],
-                          dataPoints[index][2]) *
-                      m_scale;
-      V3D distance = neighbour - realPos;
-      double separation = distance.norm();
-      boost::add_edge(m_specToVertex[m_spectrumNumbers[idx]], // from
-                      pointNoToVertex[index],                 // to
-                      distance, m_graph);
+  m_neighbourPoints.assign(nspectra * k, 0);
+  m_cutoff = std::numeric_limits<double>::lowest();
+  for (size_t pointNo = 0; pointNo < nspectra; ++pointNo) {
+    auto &neighbours = allNeighbours[pointNo];
+    dropCoincident(neighbours, k);
+    if (neighbours.size() < k) {
+      // Several points coincide with this one: search further.
+      neighbours = m_tree->nearest(m_scaledPositions[pointNo], nspectra);
+      dropCoincident(neighbours, k);
+    }
+    for (size_t i = 0; i < neighbours.size(); ++i) {
+      const auto neighbourNo = neighbours[i].index;
+      m_neighbourPoints[pointNo * k + i] = neighbourNo;
+      const double separation =
+          (m_pointPositions[neighbourNo] - m_pointPositions[pointNo]).norm();
       if (separation > m_cutoff) {
         m_cutoff = separation;
       }
     }
-    pointNo++;
+    // Should all other points coincide, pad with the point itself.
+    for (size_t i = neighbours.size(); i < k; ++i) {
+      m_neighbourPoints[pointNo * k + i] = pointNo;
+    }
   }
-  annDeallocPts(dataPoints);
-  annClose();
-  pointNoToVertex.clear();
-
-  m_vertexID = get(boost::vertex_name, m_graph);
-  m_edgeLength = get(boost::edge_name, m_graph);
 }
 
 /**
@@ -206,25 +200,64 @@ void WorkspaceNearestNeighbours::build(const int noNeighbours) {
  */
 std::map<specnum_t, V3D>
 WorkspaceNearestNeighbours::defaultNeighbours(const specnum_t spectrum) const {
-  auto vertex = m_specToVertex.find(spectrum);
-
-  if (vertex != m_specToVertex.end()) {
-    std::map<specnum_t, V3D> result;
-    std::pair<Graph::adjacency_iterator, Graph::adjacency_iterator> adjacent =
-        boost::adjacent_vertices(vertex->second, m_graph);
-    Graph::adjacency_iterator adjIt;
-    for (adjIt = adjacent.first; adjIt != adjacent.second; adjIt++) {
-      Vertex nearest = (*adjIt);
-      auto nrSpec = specnum_t(m_vertexID[nearest]);
-      std::pair<Graph::edge_descriptor, bool> nrEd =
-          boost::edge(vertex->second, nearest, m_graph);
-      result[nrSpec] = m_edgeLength[nrEd.first];
+  const auto pointNo = pointNumber(spectrum);
+  const auto k = static_cast<size_t>(m_noNeighbours);
+  std::map<specnum_t, V3D> result;
+  for (size_t i = 0; i < k; ++i) {
+    const auto neighbourNo = m_neighbourPoints[pointNo * k + i];
+    if (neighbourNo == pointNo) {
+      continue;
+    }
+    result[m_pointSpectra[neighbourNo]] =
+        m_pointPositions[neighbourNo] - m_pointPositions[pointNo];
+  }
+  return result;
+}
+
+/**
+ * Returns a map of the spectrum numbers to the detectors within a radius
+ * and their distance from the detector specified in the argument.
+ * @param spectrum :: The spectrum number
+ * @param radius :: The radius in real space
+ * @return map of detID to distance
+ * @throw NotFoundError if detector ID is not recognised
+ */
+std::map<specnum_t, V3D>
+WorkspaceNearestNeighbours::radiusNeighbours(const specnum_t spectrum,
+                                             const double radius) const {
+  const auto pointNo = pointNumber(spectrum);
+  // The tree works in scaled coordinates. Search a sphere enclosing the real
+  // space sphere and filter the candidates afterwards.
+  const double minScale = std::min({m_scale.X(), m_scale.Y(), m_scale.Z()});
+  const auto candidates =
+      m_tree->withinRadius(m_scaledPositions[pointNo], radius / minScale);
+  std::map<specnum_t, V3D> result;
+  for (const auto &candidate : candidates) {
+    if (candidate.distanceSq == 0.) {
+      continue;
+    }
+    const V3D distance =
+        m_pointPositions[candidate.index] - m_pointPositions[pointNo];
+    if (distance.norm() <= radius) {
+      result[m_pointSpectra[candidate.index]] = distance;
     }
-    return result;
-  } else {
+  }
+  return result;
+}
+
+/**
+ * Returns the point number of the given spectrum in the search tree
+ * @param spectrum :: The spectrum number
+ * @return the point number
+ * @throw NotFoundError if the spectrum is not in the tree
+ */
+size_t WorkspaceNearestNeighbours::pointNumber(const specnum_t spectrum) const {
+  const auto point = m_specToPoint.find(spectrum);
+  if (point == m_specToPoint.end()) {
     throw Mantid::Kernel::Exception::NotFoundError(
         "NearestNeighbours: Unable to find spectrum in vertex map", spectrum);
   }
+  return point->second;
 }
 
 /// Returns the list of valid spectrum indices
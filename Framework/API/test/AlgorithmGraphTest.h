@@ -0,0 +1,201 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace Mantid::API;
+using namespace Mantid::Kernel;
+
+namespace {
+/// Names of the output workspaces in the order the algorithms started
+std::vector<std::string> g_started;
+std::mutex g_startedMutex;
+/// Number of algorithms that are waiting for each other
+int g_rendezvousCount = 0;
+std::condition_variable g_rendezvous;
+
+/// Adds 1 to the first value of the input, or creates a workspace holding 0
+class GraphStepAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "GraphStepAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Cat"; }
+  const std::string summary() const override { return "Test summary"; }
+
+  void init() override {
+    declareProperty(std::make_unique<WorkspaceProperty<>>(
+        "InputWorkspace", "", Direction::Input, PropertyMode::Optional));
+    declareProperty(std::make_unique<WorkspaceProperty<>>(
+        "OutputWorkspace", "", Direction::Output));
+    declareProperty("DelayMs", 0);
+    declareProperty("Rendezvous", 0);
+    declareProperty("Fail", false);
+  }
+
+  void exec() override {
+    {
+      std::unique_lock<std::mutex> lock(g_startedMutex);
+      g_started.emplace_back(getPropertyValue("OutputWorkspace"));
+      // Wait until the given number of algorithms are running
+      const int rendezvous = getProperty("Rendezvous");
+      if (rendezvous > 0) {
+        ++g_rendezvousCount;
+        g_rendezvous.notify_all();
+        if (!g_rendezvous.wait_for(lock, std::chrono::seconds(10), [&]() {
+              return g_rendezvousCount >= rendezvous;
+            }))
+          throw std::runtime_error("The algorithms did not run concurrently");
+      }
+    }
+    const int delay = getProperty("DelayMs");
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    if (getProperty("Fail"))
+      throw std::runtime_error("Failed on purpose");
+
+    MatrixWorkspace_const_sptr input = getProperty("InputWorkspace");
+    auto output = boost::make_shared<WorkspaceTester>();
+    output->initialize(1, 1, 1);
+    output->dataY(0)[0] = input ? input->readY(0)[0] + 1. : 0.;
+    setProperty("OutputWorkspace", output);
+  }
+};
+
+IAlgorithm_sptr createStep(const int delayMs = 0) {
+  auto alg = boost::make_shared<GraphStepAlgorithm>();
+  alg->initialize();
+  alg->setRethrows(true);
+  alg->setProperty("DelayMs", delayMs);
+  return alg;
+}
+
+/// Submit a step reading input, unless empty, and writing output
+std::shared_future<bool> submitStep(AlgorithmGraph &graph,
+                                    const std::string &input,
+                                    const std::string &output,
+                                    const int delayMs = 0) {
+  std::map<std::string, std::string> properties{{"OutputWorkspace", output}};
+  if (!input.empty())
+    properties.emplace("InputWorkspace", input);
+  return graph.submit(createStep(delayMs), properties);
+}
+
+double firstValue(const std::string &name) {
+  return AnalysisDataService::Instance()
+      .retrieveWS<MatrixWorkspace>(name)
+      ->readY(0)[0];
+}
+} // namespace
+
+class AlgorithmGraphTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmGraphTest *createSuite() { return new AlgorithmGraphTest(); }
+  static void destroySuite(AlgorithmGraphTest *suite) { delete suite; }
+
+  AlgorithmGraphTest() { FrameworkManager::Instance(); }
+
+  void setUp() override {
+    g_started.clear();
+    g_rendezvousCount = 0;
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_submit_null_algorithm_throws() {
+    AlgorithmGraph graph(1);
+    TS_ASSERT_THROWS(graph.submit(IAlgorithm_sptr()),
+                     const std::invalid_argument &);
+  }
+
+  void test_submit_invalid_property_value_throws() {
+    AlgorithmGraph graph(1);
+    TS_ASSERT_THROWS(graph.submit(createStep(), {{"DelayMs", "soon"}}),
+                     const std::invalid_argument &);
+  }
+
+  void test_default_number_of_threads() {
+    AlgorithmGraph graph;
+    TS_ASSERT_LESS_THAN_EQUALS(1, graph.numThreads());
+  }
+
+  void test_chain_runs_in_order() {
+    AlgorithmGraph graph(4);
+    auto first = submitStep(graph, "", "a", 50);
+    auto second = submitStep(graph, "a", "b", 20);
+    auto third = submitStep(graph, "b", "c");
+    TS_ASSERT(third.get());
+    TS_ASSERT(first.get());
+    TS_ASSERT(second.get());
+    TS_ASSERT_EQUALS(firstValue("c"), 2.);
+    TS_ASSERT_EQUALS(g_started, std::vector<std::string>({"a", "b", "c"}));
+  }
+
+  void test_independent_algorithms_run_concurrently() {
+    AlgorithmGraph graph(2);
+    std::vector<std::shared_future<bool>> results;
+    for (const auto &name : {"bank1", "bank2"}) {
+      auto alg = createStep();
+      alg->setProperty("Rendezvous", 2);
+      alg->setPropertyValue("OutputWorkspace", name);
+      results.emplace_back(graph.submit(alg));
+    }
+    for (auto &result : results) {
+      TS_ASSERT_THROWS_NOTHING(TS_ASSERT(result.get()));
+    }
+  }
+
+  void test_writer_waits_for_earlier_readers() {
+    AlgorithmGraph graph(4);
+    submitStep(graph, "", "a");
+    submitStep(graph, "a", "b", 50);
+    // Overwrites a, so must wait until b has read it
+    submitStep(graph, "", "a");
+    graph.wait();
+    TS_ASSERT_EQUALS(g_started, std::vector<std::string>({"a", "b", "a"}));
+    TS_ASSERT_EQUALS(firstValue("b"), 1.);
+  }
+
+  void test_failure_skips_dependents() {
+    AlgorithmGraph graph(2);
+    auto failed = graph.submit(createStep(20), {{"OutputWorkspace", "a"},
+                                                {"Fail", "1"}});
+    auto skipped = submitStep(graph, "a", "b");
+    auto skippedToo = submitStep(graph, "b", "c");
+    auto independent = submitStep(graph, "", "d");
+
+    TS_ASSERT_THROWS_EQUALS(failed.get(), const std::runtime_error &e,
+                            std::string(e.what()), "Failed on purpose");
+    TS_ASSERT_THROWS(skipped.get(), const std::runtime_error &);
+    TS_ASSERT_THROWS(skippedToo.get(), const std::runtime_error &);
+    TS_ASSERT(independent.get());
+    TS_ASSERT(!AnalysisDataService::Instance().doesExist("b"));
+    TS_ASSERT(!AnalysisDataService::Instance().doesExist("c"));
+  }
+
+  void test_destructor_waits_for_algorithms() {
+    {
+      AlgorithmGraph graph(2);
+      submitStep(graph, "", "a", 20);
+      submitStep(graph, "a", "b");
+    }
+    TS_ASSERT_EQUALS(firstValue("b"), 1.);
+  }
+};
@@ -9,7 +9,10 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/SpilledWorkspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include "MantidTestHelpers/FakeObjects.h"
+#include <Poco/NObserver.h>
 #include <boost/make_shared.hpp>
 
 using namespace Mantid::Kernel;
@@ -30,6 +33,39 @@ private:
   }
 };
 using MockWorkspace_sptr = boost::shared_ptr<MockWorkspace>;
+
+/// Records the names of spilled and restored workspaces
+class SpillObserver {
+public:
+  SpillObserver()
+      : m_spilledObserver(*this, &SpillObserver::handleSpilled),
+        m_restoredObserver(*this, &SpillObserver::handleRestored) {
+    AnalysisDataService::Instance().notificationCenter.addObserver(
+        m_spilledObserver);
+    AnalysisDataService::Instance().notificationCenter.addObserver(
+        m_restoredObserver);
+  }
+  ~SpillObserver() {
+    AnalysisDataService::Instance().notificationCenter.removeObserver(
+        m_spilledObserver);
+    AnalysisDataService::Instance().notificationCenter.removeObserver(
+        m_restoredObserver);
+  }
+  void handleSpilled(WorkspaceSpilledNotification_ptr notification) {
+    spilled.emplace_back(notification->objectName());
+  }
+  void handleRestored(WorkspaceRestoredNotification_ptr notification) {
+    restored.emplace_back(notification->objectName());
+  }
+  std::vector<std::string> spilled;
+  std::vector<std::string> restored;
+
+private:
+  Poco::NObserver<SpillObserver, WorkspaceSpilledNotification>
+      m_spilledObserver;
+  Poco::NObserver<SpillObserver, WorkspaceRestoredNotification>
+      m_restoredObserver;
+};
 } // namespace
 
 class AnalysisDataServiceTest : public CxxTest::TestSuite {
@@ -46,6 +82,8 @@ public:
 
   void setUp() override { ads.clear(); }
 
+  void tearDown() override { ads.setMemoryLimit(0); }
+
   void
   test_IsValid_Returns_An_Empty_String_For_A_Valid_Name_When_All_CharsAre_Allowed() {
     TS_ASSERT_EQUALS(ads.isValid("CamelCase"), "");
@@ -523,7 +561,77 @@ public:
     TS_ASSERT_THROWS(ads.addToGroup("ws1", "ws1"), const std::runtime_error &);
   }
 
+  void test_memory_limit_spills_least_recently_used_workspace() {
+    SpillObserver observer;
+    const size_t size = addSpillableToADS("a", 1.);
+    ads.setMemoryLimit(5 * size / 2);
+    addSpillableToADS("b", 2.);
+    ads.retrieve("a");
+    addSpillableToADS("c", 3.);
+    TS_ASSERT_EQUALS(observer.spilled, std::vector<std::string>{"b"});
+    TS_ASSERT(boost::dynamic_pointer_cast<SpilledWorkspace>(
+        ads.getObjects(DataServiceHidden::Include)[1]));
+
+    auto stats = ads.memoryStatistics();
+    TS_ASSERT_EQUALS(stats.limit, 5 * size / 2);
+    TS_ASSERT_EQUALS(stats.numSpilled, 1);
+    TS_ASSERT_EQUALS(stats.numSpills, 1);
+    TS_ASSERT_EQUALS(stats.onDisk, size);
+    TS_ASSERT_LESS_THAN_EQUALS(stats.inMemory, 5 * size / 2);
+  }
+
+  void test_retrieve_reads_spilled_workspace_back() {
+    SpillObserver observer;
+    const size_t size = addSpillableToADS("a", 1.);
+    ads.setMemoryLimit(3 * size / 2);
+    addSpillableToADS("b", 2.);
+    TS_ASSERT_EQUALS(observer.spilled, std::vector<std::string>{"a"});
+
+    auto a = ads.retrieveWS<MatrixWorkspace>("a");
+    TS_ASSERT(a);
+    TS_ASSERT_EQUALS(a->getName(), "a");
+    TS_ASSERT_EQUALS(a->y(0)[0], 1.);
+    TS_ASSERT_EQUALS(observer.restored, std::vector<std::string>{"a"});
+    // Reading a back made room by spilling b
+    TS_ASSERT_EQUALS(observer.spilled, std::vector<std::string>({"a", "b"}));
+    TS_ASSERT_EQUALS(ads.retrieveWS<MatrixWorkspace>("b")->y(0)[0], 2.);
+    TS_ASSERT_EQUALS(ads.memoryStatistics().numRestores, 2);
+  }
+
+  void test_workspaces_in_use_are_not_spilled() {
+    SpillObserver observer;
+    const size_t size = addSpillableToADS("a", 1.);
+    auto a = ads.retrieve("a");
+    ads.setMemoryLimit(size);
+    addSpillableToADS("b", 2.);
+    TS_ASSERT(observer.spilled.empty());
+    TS_ASSERT_EQUALS(ads.memoryStatistics().numSpilled, 0);
+  }
+
+  void test_spilled_workspace_can_be_renamed_and_removed() {
+    const size_t size = addSpillableToADS("a", 1.);
+    ads.setMemoryLimit(size / 2);
+    TS_ASSERT_EQUALS(ads.memoryStatistics().numSpilled, 1);
+    ads.rename("a", "renamed");
+    TS_ASSERT_EQUALS(ads.memoryStatistics().numSpilled, 1);
+    ads.setMemoryLimit(0);
+    auto renamed = ads.retrieve("renamed");
+    TS_ASSERT_EQUALS(renamed->getName(), "renamed");
+    ads.remove("renamed");
+    TS_ASSERT_EQUALS(ads.memoryStatistics().inMemory, 0);
+  }
+
 private:
+  /// Add a MatrixWorkspace held only by the ADS and return its size
+  size_t addSpillableToADS(const std::string &name, const double value) {
+    auto workspace = boost::make_shared<WorkspaceTester>();
+    workspace->initialize(1, 1001, 1000);
+    workspace->mutableY(0)[0] = value;
+    const auto size = workspace->getMemorySize();
+    ads.add(name, std::move(workspace));
+    return size;
+  }
+
   /// If replace=true then usea addOrReplace
   void doAddingOnInvalidNameTests(bool replace) {
     const std::string illegalChars = " +-/*\\%<>&|^~=!@()[]{},:.`$'\"?";
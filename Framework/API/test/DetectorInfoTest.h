@@ -15,6 +15,7 @@
 #include "MantidTestHelpers/InstrumentCreationHelper.h"
 
 #include <algorithm>
+#include <cmath>
 
 using namespace Mantid;
 using namespace Mantid::Kernel;
@@ -163,6 +164,74 @@ public:
     TS_ASSERT_THROWS(detectorInfo.signedTwoTheta(4), const std::logic_error &);
   }
 
+  void test_cachedGeometry() {
+    const auto &detectorInfo = m_workspace.detectorInfo();
+    const auto &geometry = detectorInfo.cachedGeometry();
+    TS_ASSERT_EQUALS(geometry.l2.size(), 5);
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_EQUALS(geometry.l2[i], detectorInfo.l2(i));
+      TS_ASSERT_EQUALS(geometry.twoTheta[i], detectorInfo.twoTheta(i));
+      TS_ASSERT_EQUALS(geometry.signedTwoTheta[i],
+                       detectorInfo.signedTwoTheta(i));
+      TS_ASSERT_EQUALS(geometry.azimuthal[i], detectorInfo.azimuthal(i));
+    }
+    // Monitors
+    for (size_t i = 3; i < 5; ++i) {
+      TS_ASSERT_EQUALS(geometry.l2[i], detectorInfo.l2(i));
+      TS_ASSERT(std::isnan(geometry.twoTheta[i]));
+      TS_ASSERT(std::isnan(geometry.signedTwoTheta[i]));
+      TS_ASSERT(std::isnan(geometry.azimuthal[i]));
+    }
+  }
+
+  void test_cachedGeometry_updated_after_setPosition() {
+    auto &detectorInfo = m_workspace.mutableDetectorInfo();
+    const double oldL2 = detectorInfo.cachedGeometry().l2[0];
+    const auto oldPos = detectorInfo.position(0);
+    detectorInfo.setPosition(0, V3D(0.0, 0.0, 7.0));
+    TS_ASSERT_EQUALS(detectorInfo.cachedGeometry().l2[0], 7.0);
+    TS_ASSERT_EQUALS(detectorInfo.cachedGeometry().twoTheta[0], 0.0);
+    detectorInfo.setPosition(0, oldPos);
+    TS_ASSERT_EQUALS(detectorInfo.cachedGeometry().l2[0], oldL2);
+  }
+
+  void test_cachedGeometry_updated_after_sample_move() {
+    const auto &detectorInfo = m_workspace.detectorInfo();
+    auto &componentInfo = m_workspace.mutableComponentInfo();
+    TS_ASSERT_EQUALS(detectorInfo.cachedGeometry().l2[1], 5.0);
+    const auto oldPos = componentInfo.samplePosition();
+    componentInfo.setPosition(componentInfo.sample(), V3D(0.0, 0.0, 1.0));
+    TS_ASSERT_EQUALS(detectorInfo.cachedGeometry().l2[1], 4.0);
+    componentInfo.setPosition(componentInfo.sample(), oldPos);
+    TS_ASSERT_EQUALS(detectorInfo.cachedGeometry().l2[1], 5.0);
+  }
+
+  void test_solidAngles() {
+    const auto &detectorInfo = m_workspace.detectorInfo();
+    const auto &solidAngles = detectorInfo.solidAngles();
+    TS_ASSERT_EQUALS(solidAngles.size(), 5);
+    const auto samplePos = detectorInfo.samplePosition();
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT(solidAngles[i] > 0.0);
+      TS_ASSERT_EQUALS(solidAngles[i],
+                       detectorInfo.detector(i).solidAngle(samplePos));
+    }
+    // Monitors
+    TS_ASSERT(std::isnan(solidAngles[3]));
+    TS_ASSERT(std::isnan(solidAngles[4]));
+  }
+
+  void test_solidAngles_updated_after_setPosition() {
+    auto &detectorInfo = m_workspace.mutableDetectorInfo();
+    const double oldSolidAngle = detectorInfo.solidAngles()[1];
+    const auto oldPos = detectorInfo.position(1);
+    detectorInfo.setPosition(1, V3D(0.0, 0.0, 10.0));
+    TS_ASSERT_DELTA(detectorInfo.solidAngles()[1], oldSolidAngle / 4.0,
+                    1e-3 * oldSolidAngle);
+    detectorInfo.setPosition(1, oldPos);
+    TS_ASSERT_EQUALS(detectorInfo.solidAngles()[1], oldSolidAngle);
+  }
+
   void test_position() {
     const auto &detectorInfo = m_workspace.detectorInfo();
     TS_ASSERT_EQUALS(detectorInfo.position(0), V3D(0.0, -0.1, 5.0));
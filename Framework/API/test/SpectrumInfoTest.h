@@ -19,6 +19,8 @@
 #include "MantidTestHelpers/FakeObjects.h"
 #include "MantidTestHelpers/InstrumentCreationHelper.h"
 
+#include <cmath>
+
 using namespace Mantid;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
@@ -291,6 +293,87 @@ public:
     detectorInfo.setPosition(1, oldPos);
   }
 
+  void test_cachedGeometry() {
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    const auto &geometry = spectrumInfo.cachedGeometry();
+    TS_ASSERT_EQUALS(geometry.l2.size(), 5);
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_EQUALS(geometry.l2[i], spectrumInfo.l2(i));
+      TS_ASSERT_EQUALS(geometry.twoTheta[i], spectrumInfo.twoTheta(i));
+      TS_ASSERT_EQUALS(geometry.signedTwoTheta[i],
+                       spectrumInfo.signedTwoTheta(i));
+      TS_ASSERT_EQUALS(geometry.azimuthal[i], spectrumInfo.azimuthal(i));
+      TS_ASSERT_EQUALS(geometry.position[i], spectrumInfo.position(i));
+      TS_ASSERT_DELTA(geometry.difc[i],
+                      1. / Conversion::tofToDSpacingFactor(
+                               spectrumInfo.l1(), spectrumInfo.l2(i),
+                               spectrumInfo.twoTheta(i), 0.),
+                      1e-9);
+    }
+    // Monitors
+    for (size_t i = 3; i < 5; ++i) {
+      TS_ASSERT_EQUALS(geometry.l2[i], spectrumInfo.l2(i));
+      TS_ASSERT_EQUALS(geometry.position[i], spectrumInfo.position(i));
+      TS_ASSERT(std::isnan(geometry.twoTheta[i]));
+      TS_ASSERT(std::isnan(geometry.signedTwoTheta[i]));
+      TS_ASSERT(std::isnan(geometry.azimuthal[i]));
+      TS_ASSERT(std::isnan(geometry.difc[i]));
+    }
+  }
+
+  void test_grouped_cachedGeometry() {
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    const auto &geometry = spectrumInfo.cachedGeometry();
+    for (const auto i : {GroupOfDets2And3, GroupOfDets1And2}) {
+      TS_ASSERT_EQUALS(geometry.l2[i], spectrumInfo.l2(i));
+      TS_ASSERT_EQUALS(geometry.twoTheta[i], spectrumInfo.twoTheta(i));
+      TS_ASSERT_EQUALS(geometry.position[i], spectrumInfo.position(i));
+    }
+    // Partial monitor
+    TS_ASSERT_EQUALS(geometry.l2[GroupOfDets1And4],
+                     spectrumInfo.l2(GroupOfDets1And4));
+    TS_ASSERT(std::isnan(geometry.twoTheta[GroupOfDets1And4]));
+  }
+
+  void test_cachedGeometry_tracks_changes() {
+    auto &detectorInfo = m_grouped.mutableDetectorInfo();
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    const auto oldPos = detectorInfo.position(1);
+    const auto oldL2 = spectrumInfo.cachedGeometry().l2[GroupOfDets2And3];
+    detectorInfo.setPosition(1, V3D(0.0, -0.1, 5.0));
+    TS_ASSERT_EQUALS(spectrumInfo.cachedGeometry().position[GroupOfDets2And3],
+                     V3D(0.0, 0.0, 5.0));
+    detectorInfo.setPosition(1, oldPos);
+    TS_ASSERT_EQUALS(spectrumInfo.cachedGeometry().l2[GroupOfDets2And3], oldL2);
+
+    // Changed grouping is seen once the spectrum definitions are updated
+    m_grouped.getSpectrum(GroupOfDets2And3).setDetectorIDs({3});
+    TS_ASSERT_EQUALS(
+        m_grouped.spectrumInfo().cachedGeometry().position[GroupOfDets2And3],
+        V3D(0.0, 0.1, 5.0));
+    m_grouped.getSpectrum(GroupOfDets2And3).setDetectorIDs({2, 3});
+    TS_ASSERT_EQUALS(
+        m_grouped.spectrumInfo().cachedGeometry().position[GroupOfDets2And3],
+        V3D(0.0, 0.1 / 2.0, 5.0));
+  }
+
+  void test_cachedGeometry_of_held_SpectrumInfo_tracks_regrouping() {
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    TS_ASSERT_EQUALS(spectrumInfo.cachedGeometry().position[GroupOfDets2And3],
+                     V3D(0.0, 0.1 / 2.0, 5.0));
+    // Regroup without obtaining the SpectrumInfo from the workspace again
+    m_grouped.getSpectrum(GroupOfDets2And3).setDetectorIDs({3});
+    const auto &geometry = spectrumInfo.cachedGeometry();
+    TS_ASSERT_EQUALS(geometry.position[GroupOfDets2And3], V3D(0.0, 0.1, 5.0));
+    TS_ASSERT_EQUALS(geometry.l2[GroupOfDets2And3],
+                     spectrumInfo.l2(GroupOfDets2And3));
+    TS_ASSERT_EQUALS(geometry.twoTheta[GroupOfDets2And3],
+                     spectrumInfo.twoTheta(GroupOfDets2And3));
+    m_grouped.getSpectrum(GroupOfDets2And3).setDetectorIDs({2, 3});
+    TS_ASSERT_EQUALS(spectrumInfo.cachedGeometry().position[GroupOfDets2And3],
+                     V3D(0.0, 0.1 / 2.0, 5.0));
+  }
+
   void test_hasDetectors() {
     const auto &spectrumInfo = m_workspace.spectrumInfo();
     TS_ASSERT(spectrumInfo.hasDetectors(0));
@@ -0,0 +1,122 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/SpilledWorkspace.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+using namespace Mantid::API;
+using namespace Mantid::HistogramData;
+
+class SpilledWorkspaceTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SpilledWorkspaceTest *createSuite() {
+    return new SpilledWorkspaceTest();
+  }
+  static void destroySuite(SpilledWorkspaceTest *suite) { delete suite; }
+
+  SpilledWorkspaceTest() {
+    Poco::Path path(Mantid::Kernel::ConfigService::Instance().getTempDir());
+    path.makeDirectory();
+    path.setFileName("SpilledWorkspaceTest.spill");
+    m_filename = path.toString();
+  }
+
+  void tearDown() override {
+    Poco::File file(m_filename);
+    if (file.exists())
+      file.remove();
+  }
+
+  void test_canSpill() {
+    TS_ASSERT(SpilledWorkspace::canSpill(WorkspaceTester()));
+    TS_ASSERT(!SpilledWorkspace::canSpill(TableWorkspaceTester()));
+  }
+
+  void test_spill_frees_the_histograms() {
+    auto workspace = createWorkspace();
+    const auto memorySize = workspace->getMemorySize();
+    SpilledWorkspace spilled(workspace);
+    TS_ASSERT(!spilled.isSpilled());
+    TS_ASSERT_EQUALS(spilled.getMemorySize(), memorySize);
+
+    spilled.spill(m_filename);
+    TS_ASSERT(spilled.isSpilled());
+    TS_ASSERT(Poco::File(m_filename).exists());
+    TS_ASSERT_EQUALS(spilled.restoredMemorySize(), memorySize);
+    TS_ASSERT_LESS_THAN(spilled.getMemorySize(), memorySize);
+    TS_ASSERT_EQUALS(workspace->y(0).size(), 0);
+  }
+
+  void test_restore_reads_the_histograms_back() {
+    auto workspace = createWorkspace();
+    SpilledWorkspace spilled(workspace);
+    spilled.spill(m_filename);
+    const auto restored = spilled.restore();
+
+    TS_ASSERT_EQUALS(restored, workspace);
+    TS_ASSERT(!spilled.isSpilled());
+    TS_ASSERT(!Poco::File(m_filename).exists());
+    TS_ASSERT_EQUALS(restored->histogram(0).xMode(),
+                     Histogram::XMode::BinEdges);
+    TS_ASSERT_EQUALS(restored->histogram(0).yMode(),
+                     Histogram::YMode::Counts);
+    TS_ASSERT_EQUALS(restored->x(2).rawData(), std::vector<double>({1, 2, 4}));
+    TS_ASSERT_EQUALS(restored->y(1).rawData(), std::vector<double>({1, 2}));
+    TS_ASSERT_EQUALS(restored->e(2).rawData(), std::vector<double>({4, 5}));
+    // Shared X data is shared again
+    TS_ASSERT_EQUALS(restored->sharedX(0), restored->sharedX(1));
+    TS_ASSERT_EQUALS(restored->sharedX(1), restored->sharedX(2));
+    TS_ASSERT(!restored->hasDx(0));
+    TS_ASSERT(restored->hasDx(1));
+    TS_ASSERT_EQUALS(restored->dx(1).rawData(), std::vector<double>({.1, .2}));
+  }
+
+  void test_file_is_deleted_with_the_stand_in() {
+    {
+      SpilledWorkspace spilled(createWorkspace());
+      spilled.spill(m_filename);
+      TS_ASSERT(Poco::File(m_filename).exists());
+    }
+    TS_ASSERT(!Poco::File(m_filename).exists());
+  }
+
+  void test_failed_spill_leaves_the_workspace_unchanged() {
+    auto workspace = createWorkspace();
+    SpilledWorkspace spilled(workspace);
+    TS_ASSERT_THROWS(spilled.spill("/no/such/directory/workspace.spill"),
+                     const std::runtime_error &);
+    TS_ASSERT(!spilled.isSpilled());
+    TS_ASSERT_EQUALS(workspace->y(1).rawData(), std::vector<double>({1, 2}));
+  }
+
+private:
+  /// Three spectra sharing X, the second one with Dx
+  MatrixWorkspace_sptr createWorkspace() {
+    auto workspace = boost::make_shared<WorkspaceTester>();
+    workspace->initialize(3, 3, 2);
+    const auto x = Mantid::Kernel::make_cow<HistogramX>(
+        std::vector<double>{1, 2, 4});
+    for (size_t i = 0; i < 3; ++i) {
+      workspace->setSharedX(i, x);
+      workspace->mutableY(i) = {static_cast<double>(i), i + 1.};
+      workspace->mutableE(i) = {i * 2., i * 2. + 1};
+    }
+    workspace->setPointStandardDeviations(1, std::vector<double>{.1, .2});
+    return workspace;
+  }
+
+  std::string m_filename;
+};
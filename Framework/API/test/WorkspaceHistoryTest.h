@@ -135,6 +135,88 @@ public:
     TS_ASSERT_THROWS(emptyHistory.lastAlgorithm(), const std::out_of_range &);
     TS_ASSERT_THROWS(emptyHistory.getAlgorithm(1), const std::out_of_range &);
   }
+
+  void test_Copy_Shares_Algorithm_Histories_Until_Modified() {
+    WorkspaceHistory history;
+    history.addHistory(createHistory("First", 1));
+    WorkspaceHistory copy(history);
+    TS_ASSERT_EQUALS(&copy.getAlgorithmHistories(),
+                     &history.getAlgorithmHistories());
+
+    copy.addHistory(createHistory("Second", 2));
+    TS_ASSERT_EQUALS(history.size(), 1);
+    TS_ASSERT_EQUALS(copy.size(), 2);
+    TS_ASSERT_EQUALS(copy.getAlgorithmHistory(0),
+                     history.getAlgorithmHistory(0));
+  }
+
+  void test_Adding_Extended_History_Shares_It() {
+    WorkspaceHistory input;
+    input.addHistory(createHistory("First", 1));
+    WorkspaceHistory output(input);
+    output.addHistory(createHistory("Second", 2));
+
+    input.addHistory(output);
+    TS_ASSERT_EQUALS(&input.getAlgorithmHistories(),
+                     &output.getAlgorithmHistories());
+    TS_ASSERT_EQUALS(input.size(), 2);
+  }
+
+  void test_Adding_Start_Of_History_Changes_Nothing() {
+    WorkspaceHistory history;
+    history.addHistory(createHistory("First", 1));
+    history.addHistory(createHistory("Second", 2));
+    WorkspaceHistory start;
+    start.addHistory(history.getAlgorithmHistories().front());
+    const auto *algorithms = &history.getAlgorithmHistories();
+
+    history.addHistory(start);
+    history.addHistory(history);
+    TS_ASSERT_EQUALS(history.size(), 2);
+    TS_ASSERT_EQUALS(&history.getAlgorithmHistories(), algorithms);
+  }
+
+  void test_Adding_Later_History_Appends_It() {
+    WorkspaceHistory history;
+    history.addHistory(createHistory("First", 1));
+    WorkspaceHistory later;
+    later.addHistory(createHistory("Second", 2));
+    later.addHistory(createHistory("Third", 3));
+
+    history.addHistory(later);
+    TS_ASSERT_EQUALS(history.size(), 3);
+    TS_ASSERT_EQUALS(history.getAlgorithmHistory(2)->name(), "Third");
+    TS_ASSERT_EQUALS(later.size(), 2);
+  }
+
+  void test_Adding_Overlapping_History_Merges_In_Execution_Order() {
+    const auto shared = createHistory("Shared", 3);
+    WorkspaceHistory lhs;
+    lhs.addHistory(createHistory("LHS1", 1));
+    lhs.addHistory(shared);
+    lhs.addHistory(createHistory("LHS5", 5));
+    WorkspaceHistory rhs;
+    rhs.addHistory(createHistory("RHS2", 2));
+    rhs.addHistory(shared);
+    rhs.addHistory(createHistory("RHS4", 4));
+
+    lhs.addHistory(rhs);
+    const std::vector<std::string> expected{"LHS1", "RHS2", "Shared", "RHS4",
+                                            "LHS5"};
+    TS_ASSERT_EQUALS(lhs.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      TS_ASSERT_EQUALS(lhs.getAlgorithmHistory(i)->name(), expected[i]);
+    }
+    TS_ASSERT_EQUALS(rhs.size(), 3);
+  }
+
+private:
+  AlgorithmHistory_sptr createHistory(const std::string &name,
+                                      const std::size_t execCount) {
+    return boost::make_shared<AlgorithmHistory>(
+        name, 1, "uuid-" + name,
+        Mantid::Types::Core::DateAndTime::defaultTime(), 1.0, execCount);
+  }
 };
 
 class WorkspaceHistoryTestPerformance : public CxxTest::TestSuite {
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidAPI/DistributedAlgorithm.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/Unit.h"
@@ -105,6 +106,7 @@ protected:
 
   /// Internal function to gather detector specific L2, theta and efixed values
   bool getDetectorValues(const API::SpectrumInfo &spectrumInfo,
+                         const API::SpectrumInfo::CachedGeometry &geometry,
                          const Kernel::Unit &outputUnit, int emode,
                          const API::MatrixWorkspace &ws, const bool signedTheta,
                          int64_t wsIndex, double &efixed, double &l2,
@@ -131,5 +131,16 @@ private:
   std::vector<Indexing::SpectrumNumber> m_validGroups;
 };
 
+namespace DiffractionFocussing2Helpers {
+MANTID_ALGORITHMS_DLL void addRangeWeights(const std::vector<double> &edges,
+                                           const double low, const double high,
+                                           std::vector<double> &weights,
+                                           std::vector<int> &fullyCovered);
+MANTID_ALGORITHMS_DLL void
+addFullyCoveredWeights(const std::vector<double> &edges,
+                       const std::vector<int> &fullyCovered,
+                       std::vector<double> &weights);
+} // namespace DiffractionFocussing2Helpers
+
 } // namespace Algorithms
 } // namespace Mantid
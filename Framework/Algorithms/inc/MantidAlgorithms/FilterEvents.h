@@ -175,6 +175,8 @@ private:
   std::set<int> m_targetWorkspaceIndexSet;
   int m_maxTargetIndex;
   Kernel::TimeSplitterType m_splitters;
+  /// The splitters of m_splitters for looking up event times
+  Kernel::TimeSplitter m_timeSplitter;
   std::map<int, DataObjects::EventWorkspace_sptr> m_outputWorkspacesMap;
   std::vector<std::string> m_wsNames;
 
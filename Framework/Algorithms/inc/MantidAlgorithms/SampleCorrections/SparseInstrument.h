@@ -10,10 +10,14 @@
 #include "MantidAlgorithms/DllConfig.h"
 
 #include <array>
+#include <string>
 #include <tuple>
 #include <utility>
 
 namespace Mantid {
+namespace API {
+class Sample;
+}
 namespace Algorithms {
 class DetectorGridDefinition;
 }
@@ -56,6 +60,22 @@ MANTID_ALGORITHMS_DLL HistogramData::Histogram
 interpolateFromDetectorGrid(const double lat, const double lon,
                             const API::MatrixWorkspace &ws,
                             const std::array<size_t, 4> &indices);
+MANTID_ALGORITHMS_DLL std::array<double, 4>
+bilinearWeights(const double lat, const double lon,
+                const Algorithms::DetectorGridDefinition &grid,
+                const std::array<size_t, 4> &indices);
+MANTID_ALGORITHMS_DLL HistogramData::Histogram
+bilinearInterpolateFromDetectorGrid(
+    const double lat, const double lon, const API::MatrixWorkspace &ws,
+    const Algorithms::DetectorGridDefinition &grid,
+    const std::array<size_t, 4> &indices);
+MANTID_ALGORITHMS_DLL std::string
+simulationChecksum(const API::MatrixWorkspace &sparseWS,
+                   const API::Sample &sample, const std::string &parameters);
+MANTID_ALGORITHMS_DLL bool loadSimulation(const std::string &filename,
+                                          API::MatrixWorkspace &sparseWS);
+MANTID_ALGORITHMS_DLL void saveSimulation(const std::string &filename,
+                                          const API::MatrixWorkspace &sparseWS);
 MANTID_ALGORITHMS_DLL std::unique_ptr<const Algorithms::DetectorGridDefinition>
 createDetectorGridDefinition(const API::MatrixWorkspace &modelWS,
                              const size_t rows, const size_t columns);
@@ -389,6 +389,7 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
 
 /** Get the L2, theta and efixed values for a workspace index
  * @param spectrumInfo :: SpectrumInfo of the workspace
+ * @param geometry :: The cached geometry of spectrumInfo
  * @param outputUnit :: The output unit
  * @param emode :: The energy mode
  * @param ws :: The workspace
@@ -399,23 +400,23 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
  * @param twoTheta :: the returned two theta angle
  * @returns true if lookup successful, false on error
  */
-bool ConvertUnits::getDetectorValues(const API::SpectrumInfo &spectrumInfo,
-                                     const Kernel::Unit &outputUnit, int emode,
-                                     const MatrixWorkspace &ws,
-                                     const bool signedTheta, int64_t wsIndex,
-                                     double &efixed, double &l2,
-                                     double &twoTheta) {
+bool ConvertUnits::getDetectorValues(
+    const API::SpectrumInfo &spectrumInfo,
+    const API::SpectrumInfo::CachedGeometry &geometry,
+    const Kernel::Unit &outputUnit, int emode, const MatrixWorkspace &ws,
+    const bool signedTheta, int64_t wsIndex, double &efixed, double &l2,
+    double &twoTheta) {
   if (!spectrumInfo.hasDetectors(wsIndex))
     return false;
 
-  l2 = spectrumInfo.l2(wsIndex);
+  l2 = geometry.l2[wsIndex];
 
   if (!spectrumInfo.isMonitor(wsIndex)) {
     // The scattering angle for this detector (in radians).
     if (signedTheta)
-      twoTheta = spectrumInfo.signedTwoTheta(wsIndex);
+      twoTheta = geometry.signedTwoTheta[wsIndex];
     else
-      twoTheta = spectrumInfo.twoTheta(wsIndex);
+      twoTheta = geometry.twoTheta[wsIndex];
     // If an indirect instrument, try getting Efixed from the geometry
     if (emode == 2 && efixed == EMPTY_DBL()) // indirect
     {
@@ -521,8 +522,9 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   double checkl2;
   double checktwoTheta;
   size_t checkIndex = 0;
-  if (getDetectorValues(spectrumInfo, *outputUnit, emode, *inputWS, signedTheta,
-                        checkIndex, checkefixed, checkl2, checktwoTheta)) {
+  if (getDetectorValues(spectrumInfo, spectrumInfo.cachedGeometry(),
+                        *outputUnit, emode, *inputWS, signedTheta, checkIndex,
+                        checkefixed, checkl2, checktwoTheta)) {
     const double checkdelta = 0.0;
     // copy the X values for the check
     auto checkXValues = inputWS->readX(checkIndex);
@@ -541,6 +543,8 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   assert(static_cast<bool>(eventWS) == m_inputEvents); // Sanity check
 
   auto &outSpectrumInfo = outputWS->mutableSpectrumInfo();
+  // Fetched once, the loop below does not move detectors or regroup spectra
+  const auto &outGeometry = outSpectrumInfo.cachedGeometry();
   // Loop over the histograms (detector spectra)
   for (int64_t i = 0; i < numberOfSpectra_i; ++i) {
     double efixed = efixedProp;
@@ -548,8 +552,8 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
     // Now get the detector object for this histogram
     double l2;
     double twoTheta;
-    if (getDetectorValues(outSpectrumInfo, *outputUnit, emode, *outputWS,
-                          signedTheta, i, efixed, l2, twoTheta)) {
+    if (getDetectorValues(outSpectrumInfo, outGeometry, *outputUnit, emode,
+                          *outputWS, signedTheta, i, efixed, l2, twoTheta)) {
 
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
@@ -58,7 +58,8 @@ void CopyInstrumentParameters::exec() {
 
     // Get legacy ParameterMap, i.e., including masking, positions, rotations
     // stored in map (instead of DetectorInfo).
-    const auto &givParams = inst1->makeLegacyParameterMap();
+    const ParameterMap_const_sptr givParams =
+        inst1->makeLegacyParameterMap();
     for (const auto &item : *givParams) {
       IComponent *oldComponent = item.first;
 
@@ -21,9 +21,11 @@
 #include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <iterator>
 #include <numeric>
+#include <unordered_map>
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
@@ -38,6 +40,69 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(DiffractionFocussing2)
 
+namespace DiffractionFocussing2Helpers {
+/**
+ * Add the overlap of the range [low, high] with each bin to the bin weights.
+ * The bins lying completely inside the range are only counted in a difference
+ * array so adding a range takes O(log(nbins)), their widths are added once all
+ * ranges are in by addFullyCoveredWeights.
+ * @param edges :: the bin edges
+ * @param low :: the start of the range
+ * @param high :: the end of the range
+ * @param weights :: the bin weights to add the partial overlaps to
+ * @param fullyCovered :: the difference array of the number of ranges
+ * covering each bin completely
+ */
+void addRangeWeights(const std::vector<double> &edges, const double low,
+                     const double high, std::vector<double> &weights,
+                     std::vector<int> &fullyCovered) {
+  if (!(high > low))
+    return;
+  const auto firstAbove = std::upper_bound(edges.cbegin(), edges.cend(), low);
+  const auto lastBelow = std::lower_bound(edges.cbegin(), edges.cend(), high);
+  if (firstAbove == edges.cend() || lastBelow == edges.cbegin())
+    return;
+  // The first and last bins overlapping the range
+  const auto first = static_cast<size_t>(
+      std::max(std::distance(edges.cbegin(), firstAbove) - 1,
+               std::ptrdiff_t{0}));
+  const auto last = std::min(
+      static_cast<size_t>(std::distance(edges.cbegin(), lastBelow) - 1),
+      weights.size() - 1);
+  const auto addOverlap = [&](const size_t bin) {
+    const double overlap =
+        std::min(high, edges[bin + 1]) - std::max(low, edges[bin]);
+    if (overlap > 0.)
+      weights[bin] += overlap;
+  };
+  addOverlap(first);
+  if (last != first)
+    addOverlap(last);
+  if (last > first + 1) {
+    ++fullyCovered[first + 1];
+    --fullyCovered[last];
+  }
+}
+
+/**
+ * Add the widths of the bins times the number of ranges covering them
+ * completely to the bin weights.
+ * @param edges :: the bin edges
+ * @param fullyCovered :: the difference array filled by addRangeWeights
+ * @param weights :: the bin weights
+ */
+void addFullyCoveredWeights(const std::vector<double> &edges,
+                            const std::vector<int> &fullyCovered,
+                            std::vector<double> &weights) {
+  int coverage = 0;
+  for (size_t i = 0; i < weights.size(); ++i) {
+    coverage += fullyCovered[i];
+    if (coverage != 0)
+      weights[i] += coverage * (edges[i + 1] - edges[i]);
+  }
+}
+} // namespace DiffractionFocussing2Helpers
+
 /** Initialisation method. Declares properties to be used in algorithm.
  *
  */
@@ -91,6 +156,7 @@ void DiffractionFocussing2::cleanup() {
  *  @throw std::runtime_error If the rebinning process fails
  */
 void DiffractionFocussing2::exec() {
+  using namespace DiffractionFocussing2Helpers;
   // retrieve the properties
   std::string groupingFileName = getProperty("GroupingFileName");
   groupWS = getProperty("GroupingWorkspace");
@@ -176,7 +242,7 @@ void DiffractionFocussing2::exec() {
   // them once.
   // Helgrind will show a race-condition but the data is completely unused so it
   // is irrelevant
-  MantidVec weights_default(1, 1.0), emptyVec(1, 0.0), EOutDummy(nPoints);
+  MantidVec EOutDummy(nPoints);
 
   Progress prog(this, 0.2, 1.0, static_cast<int>(totalHistProcess) + nGroups);
 
@@ -206,6 +272,12 @@ void DiffractionFocussing2::exec() {
     // Initialize the group's weight vector here and the dummy vector used for
     // accumulating errors.
     MantidVec groupWgt(nPoints, 0.0);
+    // The number of unmasked spectra covering each output bin completely, as
+    // a difference array
+    std::vector<int> fullyCovered(nPoints, 0);
+    // Spectra sharing the same X values are summed before being rebinned
+    std::unordered_map<const HistogramData::HistogramX *, size_t> xSets;
+    std::vector<std::vector<size_t>> sharedXIndices;
 
     // loop through the contributing histograms
     const std::vector<size_t> &indices = m_wsIndices[outWorkspaceIndex];
@@ -214,24 +286,14 @@ void DiffractionFocussing2::exec() {
       size_t inWorkspaceIndex = indices[i];
       // This is the input spectrum
       const auto &inSpec = m_matrixInputW->getSpectrum(inWorkspaceIndex);
-      // Get reference to its old X,Y,and E.
+      // Get reference to its old X
       auto &Xin = inSpec.x();
-      auto &Yin = inSpec.y();
-      auto &Ein = inSpec.e();
       outSpec.addDetectorIDs(inSpec.getDetectorIDs());
 
-      try {
-        // TODO This should be implemented in Histogram as rebin
-        Mantid::Kernel::VectorHelper::rebinHistogram(
-            Xin.rawData(), Yin.rawData(), Ein.rawData(), Xout.rawData(), Yout,
-            Eout, true);
-      } catch (...) {
-        // Should never happen because Xout is constructed to envelop all of the
-        // Xin vectors
-        std::ostringstream mess;
-        mess << "Error in rebinning process for spectrum:" << inWorkspaceIndex;
-        throw std::runtime_error(mess.str());
-      }
+      const auto xSet = xSets.emplace(&Xin, sharedXIndices.size());
+      if (xSet.second)
+        sharedXIndices.emplace_back();
+      sharedXIndices[xSet.first->second].emplace_back(inWorkspaceIndex);
 
       // Check for masked bins in this spectrum
       if (m_matrixInputW->hasMaskedBins(i)) {
@@ -271,53 +333,65 @@ void DiffractionFocussing2::exec() {
       } else // If no masked bins we want to add 1 to the weight of the output
              // bins that this input covers
       {
-        // Initialized within the loop to avoid having to wrap writing to it
-        // with a PARALLEL_CRITICAL sections
-        MantidVec limits(2);
-
         if (eventXMin > 0. && eventXMax > 0.) {
-          limits[0] = eventXMin;
-          limits[1] = eventXMax;
+          addRangeWeights(Xout.rawData(), eventXMin, eventXMax, groupWgt,
+                          fullyCovered);
         } else {
-          limits[0] = Xin.front();
-          limits[1] = Xin.back();
+          addRangeWeights(Xout.rawData(), Xin.front(), Xin.back(), groupWgt,
+                          fullyCovered);
         }
-
-        // Rebin the weights - note that this is a distribution
-        VectorHelper::rebin(limits, weights_default, emptyVec, Xout.rawData(),
-                            groupWgt, EOutDummy, true, true);
       }
       prog.report();
     } // end of loop for input spectra
+    addFullyCoveredWeights(Xout.rawData(), fullyCovered, groupWgt);
 
-    // Calculate the bin widths
-    std::vector<double> widths(Xout.size());
-    std::adjacent_difference(Xout.begin(), Xout.end(), widths.begin());
-
-    // Take the square root of the errors
-    std::transform(Eout.begin(), Eout.end(), Eout.begin(),
-                   static_cast<double (*)(double)>(sqrt));
-
-    // Multiply the data and errors by the bin widths because the rebin
-    // function, when used
-    // in the fashion above for the weights, doesn't put it back in
-    std::transform(Yout.begin(), Yout.end(), widths.begin() + 1, Yout.begin(),
-                   std::multiplies<double>());
-    std::transform(Eout.begin(), Eout.end(), widths.begin() + 1, Eout.begin(),
-                   std::multiplies<double>());
-
-    // Now need to normalise the data (and errors) by the weights
-    std::transform(Yout.begin(), Yout.end(), groupWgt.begin(), Yout.begin(),
-                   std::divides<double>());
-    std::transform(Eout.begin(), Eout.end(), groupWgt.begin(), Eout.begin(),
-                   std::divides<double>());
-    // Now multiply by the number of spectra in the group
-    std::for_each(Yout.begin(), Yout.end(), [groupSize](double &val) {
-      val *= static_cast<double>(groupSize);
-    });
-    std::for_each(Eout.begin(), Eout.end(), [groupSize](double &val) {
-      val *= static_cast<double>(groupSize);
-    });
+    // Rebin the data, summing the spectra sharing the same X values first.
+    // Yout and Eout receive the counts and the variances.
+    for (const auto &sharedIndices : sharedXIndices) {
+      const auto &firstSpec =
+          m_matrixInputW->getSpectrum(sharedIndices.front());
+      try {
+        // TODO This should be implemented in Histogram as rebin
+        if (sharedIndices.size() == 1) {
+          VectorHelper::rebinHistogram(
+              firstSpec.x().rawData(), firstSpec.y().rawData(),
+              firstSpec.e().rawData(), Xout.rawData(), Yout, Eout, true);
+          continue;
+        }
+        const size_t nBins = firstSpec.y().size();
+        MantidVec ySum(nBins, 0.0), varianceSum(nBins, 0.0);
+        for (const auto inWorkspaceIndex : sharedIndices) {
+          const auto &inSpec = m_matrixInputW->getSpectrum(inWorkspaceIndex);
+          const double *Yin = inSpec.y().rawData().data();
+          const double *Ein = inSpec.e().rawData().data();
+          for (size_t j = 0; j < nBins; ++j) {
+            ySum[j] += Yin[j];
+            varianceSum[j] += Ein[j] * Ein[j];
+          }
+        }
+        VectorHelper::rebinHistogramVariances(firstSpec.x().rawData(), ySum,
+                                              varianceSum, Xout.rawData(),
+                                              Yout, Eout, true);
+      } catch (...) {
+        // Should never happen because Xout is constructed to envelop all of the
+        // Xin vectors
+        std::ostringstream mess;
+        mess << "Error in rebinning process for spectrum:"
+             << sharedIndices.front();
+        throw std::runtime_error(mess.str());
+      }
+    }
+
+    // Take the square root of the variances, multiply the data and errors by
+    // the bin widths because the rebin function, when used in the fashion
+    // above for the weights, doesn't put it back in, normalise them by the
+    // weights and multiply them by the number of spectra in the group
+    for (size_t j = 0; j < Yout.size(); ++j) {
+      const double scale = static_cast<double>(groupSize) *
+                           (Xout[j + 1] - Xout[j]) / groupWgt[j];
+      Yout[j] *= scale;
+      Eout[j] = std::sqrt(Eout[j]) * scale;
+    }
 
     prog.report();
     PARALLEL_END_INTERUPT_REGION
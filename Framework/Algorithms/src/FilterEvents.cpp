@@ -63,10 +63,10 @@ FilterEvents::FilterEvents()
     : m_eventWS(), m_splittersWorkspace(), m_splitterTableWorkspace(),
       m_matrixSplitterWS(), m_detCorrectWorkspace(),
       m_useSplittersWorkspace(false), m_useArbTableSplitters(false),
-      m_targetWorkspaceIndexSet(), m_splitters(), m_outputWorkspacesMap(),
-      m_wsNames(), m_detTofOffsets(), m_detTofFactors(),
-      m_filterByPulseTime(false), m_informationWS(), m_hasInfoWS(),
-      m_progress(0.), m_outputWSNameBase(), m_toGroupWS(false),
+      m_targetWorkspaceIndexSet(), m_splitters(), m_timeSplitter(),
+      m_outputWorkspacesMap(), m_wsNames(), m_detTofOffsets(),
+      m_detTofFactors(), m_filterByPulseTime(false), m_informationWS(),
+      m_hasInfoWS(), m_progress(0.), m_outputWSNameBase(), m_toGroupWS(false),
       m_vecSplitterTime(), m_vecSplitterGroup(), m_splitSampleLogs(false),
       m_useDBSpectrum(false), m_dbWSIndex(-1), m_tofCorrType(NoneCorrect),
       m_specSkipType(), m_vecSkip(), m_isSplittersRelativeTime(false),
@@ -844,6 +844,7 @@ void FilterEvents::processSplittersWorkspace() {
   if (!inorder) {
     std::sort(m_splitters.begin(), m_splitters.end());
   }
+  m_timeSplitter = Kernel::TimeSplitter(m_splitters);
 
   // 4. Add extra workgroup index for unfiltered events
   m_targetWorkspaceIndexSet.insert(-1);
@@ -1723,12 +1724,12 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
       // Perform the filtering (using the splitting function and just one
       // output)
       if (m_filterByPulseTime) {
-        input_el.splitByPulseTime(m_splitters, outputs);
+        input_el.splitByPulseTime(m_timeSplitter, outputs);
       } else if (m_tofCorrType != NoneCorrect) {
-        input_el.splitByFullTime(m_splitters, outputs, true,
+        input_el.splitByFullTime(m_timeSplitter, outputs, true,
                                  m_detTofFactors[iws], m_detTofOffsets[iws]);
       } else {
-        input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
+        input_el.splitByFullTime(m_timeSplitter, outputs, false, 1.0, 0.0);
       }
     }
 
@@ -7,6 +7,7 @@
 #include "MantidAlgorithms/MonteCarloAbsorption.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/ExperimentInfo.h"
+#include "MantidAPI/FileProperty.h"
 #include "MantidAPI/InstrumentValidator.h"
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumInfo.h"
@@ -27,10 +28,13 @@
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/DeltaEMode.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MersenneTwister.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <Poco/Path.h>
+
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -44,6 +48,8 @@ constexpr int DEFAULT_NEVENTS = 1000;
 constexpr int DEFAULT_SEED = 123456789;
 constexpr int DEFAULT_LATITUDINAL_DETS = 5;
 constexpr int DEFAULT_LONGITUDINAL_DETS = 10;
+const std::string INVERSE_DISTANCE_INTERPOLATION("InverseDistance");
+const std::string BILINEAR_INTERPOLATION("Bilinear");
 
 /// Energy (meV) to wavelength (angstroms)
 inline double toWavelength(double energy) {
@@ -139,6 +145,26 @@ void MonteCarloAbsorption::init() {
       "NumberOfDetectorColumns",
       std::make_unique<EnabledWhenProperty>(
           "SparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
+  declareProperty(
+      "SparseInstrumentInterpolation", INVERSE_DISTANCE_INTERPOLATION,
+      boost::make_shared<StringListValidator>(std::vector<std::string>{
+          INVERSE_DISTANCE_INTERPOLATION, BILINEAR_INTERPOLATION}),
+      "Method used to interpolate the sparse instrument results to the "
+      "real detectors.");
+  setPropertySettings(
+      "SparseInstrumentInterpolation",
+      std::make_unique<EnabledWhenProperty>(
+          "SparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
+  declareProperty(
+      std::make_unique<FileProperty>("SparseInstrumentCacheDirectory", "",
+                                     FileProperty::OptionalDirectory),
+      "If given, the sparse instrument simulation results are stored in "
+      "this directory and reused by subsequent runs with identical sample, "
+      "environment, beam, wavelength points and simulation parameters.");
+  setPropertySettings(
+      "SparseInstrumentCacheDirectory",
+      std::make_unique<EnabledWhenProperty>(
+          "SparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
 
   // Control the number of attempts made to generate a random point in the
   // object
@@ -238,12 +264,31 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
   }
   std::unique_ptr<const DetectorGridDefinition> detGrid;
   MatrixWorkspace_uptr sparseWS;
+  std::string cacheFilename;
   if (useSparseInstrument) {
     const int latitudinalDets = getProperty("NumberOfDetectorRows");
     const int longitudinalDets = getProperty("NumberOfDetectorColumns");
     detGrid = SparseInstrument::createDetectorGridDefinition(
         inputWS, latitudinalDets, longitudinalDets);
     sparseWS = SparseInstrument::createSparseWS(inputWS, *detGrid, nlambda);
+    const std::string cacheDirectory =
+        getPropertyValue("SparseInstrumentCacheDirectory");
+    if (!cacheDirectory.empty()) {
+      // Interpolation only applies to the cached results, leave it out
+      std::ostringstream parameters;
+      parameters << nevents << ' ' << resimulateTracksForDiffWavelengths << ' '
+                 << seed << ' ' << maxScatterPtAttempts;
+      const auto checksum = SparseInstrument::simulationChecksum(
+          *sparseWS, inputWS.sample(), parameters.str());
+      cacheFilename =
+          Poco::Path(cacheDirectory).append(checksum + ".mcsparse").toString();
+      if (SparseInstrument::loadSimulation(cacheFilename, *sparseWS)) {
+        g_log.information() << "Reusing cached sparse instrument simulation "
+                            << cacheFilename << '\n';
+        interpolateFromSparse(*outputWS, *sparseWS, interpolateOpt, *detGrid);
+        return outputWS;
+      }
+    }
   }
   MatrixWorkspace &simulationWS = useSparseInstrument ? *sparseWS : *outputWS;
   const MatrixWorkspace &instrumentWS =
@@ -299,6 +344,14 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
   PARALLEL_CHECK_INTERUPT_REGION
 
   if (useSparseInstrument) {
+    if (!cacheFilename.empty()) {
+      try {
+        SparseInstrument::saveSimulation(cacheFilename, simulationWS);
+      } catch (std::runtime_error &e) {
+        g_log.warning() << "Failed to cache sparse instrument simulation: "
+                        << e.what() << '\n';
+      }
+    }
     interpolateFromSparse(*outputWS, simulationWS, interpolateOpt, *detGrid);
   }
 
@@ -352,6 +405,9 @@ void MonteCarloAbsorption::interpolateFromSparse(
   const auto &spectrumInfo = targetWS.spectrumInfo();
   const auto samplePos = spectrumInfo.samplePosition();
   const auto refFrame = targetWS.getInstrument()->getReferenceFrame();
+  const bool bilinear =
+      getPropertyValue("SparseInstrumentInterpolation") ==
+      BILINEAR_INTERPOLATION;
   PARALLEL_FOR_IF(Kernel::threadSafe(targetWS, sparseWS))
   for (int64_t i = 0; i < static_cast<decltype(i)>(spectrumInfo.size()); ++i) {
     PARALLEL_START_INTERUPT_REGION
@@ -361,8 +417,10 @@ void MonteCarloAbsorption::interpolateFromSparse(
         SparseInstrument::geographicalAngles(detPos, *refFrame);
     const auto nearestIndices = detGrid.nearestNeighbourIndices(lat, lon);
     const auto spatiallyInterpHisto =
-        SparseInstrument::interpolateFromDetectorGrid(lat, lon, sparseWS,
-                                                      nearestIndices);
+        bilinear ? SparseInstrument::bilinearInterpolateFromDetectorGrid(
+                       lat, lon, sparseWS, detGrid, nearestIndices)
+                 : SparseInstrument::interpolateFromDetectorGrid(
+                       lat, lon, sparseWS, nearestIndices);
     if (spatiallyInterpHisto.size() > 1) {
       auto targetHisto = targetWS.histogram(i);
       interpOpt.applyInPlace(spatiallyInterpHisto, targetHisto);
@@ -15,9 +15,12 @@
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/ParallelFor.h"
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <unordered_map>
+
 namespace Mantid {
 namespace Algorithms {
 
@@ -34,8 +37,39 @@ using HistogramData::BinEdges;
 using HistogramData::Frequencies;
 using HistogramData::FrequencyStandardDeviations;
 using HistogramData::Histogram;
+using HistogramData::HistogramX;
+using HistogramData::RebinMap;
 using HistogramData::Exception::InvalidBinEdgesError;
 
+namespace {
+/**
+ * Compute the bin overlaps once for each X shared by several spectra. Spectra
+ * with their own X are rebinned directly as a map would not be reused.
+ * @param workspace :: the workspace to rebin
+ * @param binEdges :: the new bin edges
+ * @return the maps by X
+ */
+std::unordered_map<const HistogramX *, std::unique_ptr<const RebinMap>>
+createRebinMaps(const MatrixWorkspace &workspace, const BinEdges &binEdges) {
+  std::unordered_map<const HistogramX *, size_t> firstUse;
+  std::unordered_map<const HistogramX *, std::unique_ptr<const RebinMap>> maps;
+  for (size_t i = 0; i < workspace.getNumberHistograms(); ++i) {
+    const auto x = workspace.sharedX(i).get();
+    if (firstUse.emplace(x, i).second || maps.count(x) > 0) {
+      continue;
+    }
+    try {
+      maps.emplace(x, std::make_unique<const RebinMap>(
+                          workspace.binEdges(firstUse[x]), binEdges));
+    } catch (InvalidBinEdgesError &) {
+      // Reported when the spectra are rebinned
+      maps.emplace(x, nullptr);
+    }
+  }
+  return maps;
+}
+} // namespace
+
 //---------------------------------------------------------------------------------------------
 // Public static methods
 //---------------------------------------------------------------------------------------------
@@ -185,24 +219,31 @@ void Rebin::exec() {
       // Initialize progress reporting.
       Progress prog(this, 0.0, 1.0, histnumber);
 
-      // Go through all the histograms and set the data
-      PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
-      for (int i = 0; i < histnumber; ++i) {
-        PARALLEL_START_INTERUPT_REGION
-        // Get a const event list reference. eventInputWS->dataY() doesn't work.
-        const EventList &el = eventInputWS->getSpectrum(i);
-        MantidVec y_data, e_data;
-        // The EventList takes care of histogramming.
-        el.generateHistogram(XValues_new.rawData(), y_data, e_data);
-
-        // Copy the data over.
-        outputWS->mutableY(i) = std::move(y_data);
-        outputWS->mutableE(i) = std::move(e_data);
-
-        // Report progress
-        prog.report(name());
-        PARALLEL_END_INTERUPT_REGION
-      }
+      // Go through all the histograms and set the data, balancing the threads
+      // by the number of events in each spectrum
+      std::vector<size_t> numEvents(histnumber);
+      for (int i = 0; i < histnumber; ++i)
+        numEvents[i] = eventInputWS->getSpectrum(i).getNumberEvents();
+      Kernel::parallelForWeighted(
+          numEvents,
+          [&](const size_t i) {
+            PARALLEL_START_INTERUPT_REGION
+            // Get a const event list reference. eventInputWS->dataY() doesn't
+            // work.
+            const EventList &el = eventInputWS->getSpectrum(i);
+            MantidVec y_data, e_data;
+            // The EventList takes care of histogramming.
+            el.generateHistogram(XValues_new.rawData(), y_data, e_data);
+
+            // Copy the data over.
+            outputWS->mutableY(i) = std::move(y_data);
+            outputWS->mutableE(i) = std::move(e_data);
+
+            // Report progress
+            prog.report(name());
+            PARALLEL_END_INTERUPT_REGION
+          },
+          Kernel::threadSafe(*inputWS, *outputWS));
       PARALLEL_CHECK_INTERUPT_REGION
 
       // Copy all the axes
@@ -249,6 +290,7 @@ void Rebin::exec() {
       outputWS->replaceAxis(
           1, std::unique_ptr<Axis>(inputWS->getAxis(1)->clone(outputWS.get())));
     bool ignoreBinErrors = getProperty("IgnoreBinErrors");
+    const auto rebinMaps = createRebinMaps(*inputWS, XValues_new);
 
     Progress prog(this, 0.0, 1.0, histnumber);
     PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
@@ -256,8 +298,15 @@ void Rebin::exec() {
       PARALLEL_START_INTERUPT_REGION
 
       try {
-        outputWS->setHistogram(
-            hist, HistogramData::rebin(inputWS->histogram(hist), XValues_new));
+        const auto rebinMap = rebinMaps.find(inputWS->sharedX(hist).get());
+        if (rebinMap != rebinMaps.end() && rebinMap->second) {
+          outputWS->setHistogram(
+              hist, rebinMap->second->rebin(inputWS->histogram(hist)));
+        } else {
+          outputWS->setHistogram(hist, HistogramData::rebin(
+                                           inputWS->histogram(hist),
+                                           XValues_new));
+        }
       } catch (InvalidBinEdgesError &) {
         if (ignoreBinErrors)
           outputWS->setBinEdges(hist, XValues_new);
@@ -10,8 +10,11 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidHistogramData/Exception.h"
 #include "MantidHistogramData/Rebin.h"
 
+#include <map>
+
 namespace Mantid {
 namespace Algorithms {
 
@@ -20,6 +23,43 @@ using DataObjects::EventWorkspace;
 using DataObjects::EventWorkspace_const_sptr;
 using HistogramData::Counts;
 using HistogramData::CountStandardDeviations;
+using HistogramData::HistogramX;
+using HistogramData::RebinMap;
+
+namespace {
+using RebinMaps = std::map<std::pair<const HistogramX *, const HistogramX *>,
+                           std::unique_ptr<const RebinMap>>;
+
+/**
+ * Compute the bin overlaps once for each pair of old and new X shared by
+ * several spectra
+ * @param toRebin :: the workspace to rebin
+ * @param binEdges :: gives the new bin edges of a spectrum
+ * @return the maps by old and new X
+ */
+template <typename BinEdgesOf>
+RebinMaps createRebinMaps(const MatrixWorkspace &toRebin,
+                          const BinEdgesOf &binEdges) {
+  std::map<std::pair<const HistogramX *, const HistogramX *>, size_t> firstUse;
+  RebinMaps maps;
+  for (size_t i = 0; i < toRebin.getNumberHistograms(); ++i) {
+    const auto &edges = binEdges(i);
+    const auto key = std::make_pair(toRebin.sharedX(i).get(),
+                                    edges.cowData().get());
+    if (firstUse.emplace(key, i).second || maps.count(key) > 0) {
+      continue;
+    }
+    try {
+      maps.emplace(key, std::make_unique<const RebinMap>(
+                            toRebin.binEdges(firstUse[key]), edges));
+    } catch (HistogramData::Exception::InvalidBinEdgesError &) {
+      // Reported when the spectra are rebinned
+      maps.emplace(key, nullptr);
+    }
+  }
+  return maps;
+}
+} // namespace
 
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(RebinToWorkspace)
@@ -130,17 +170,31 @@ void RebinToWorkspace::rebin(MatrixWorkspace_sptr &toRebin,
   const bool matchingX =
       (toRebin->getNumberHistograms() != toMatch->getNumberHistograms());
 
+  const auto binEdges = [&toMatch, matchingX](const size_t i) {
+    return toMatch->binEdges(matchingX ? 0 : i);
+  };
+  RebinMaps rebinMaps;
+  if (!m_isEvents) {
+    rebinMaps = createRebinMaps(*toRebin, binEdges);
+  }
+
   // rebin
   PARALLEL_FOR_IF(Kernel::threadSafe(*toMatch, *outputWS))
   for (int i = 0; i < numHist; ++i) {
     PARALLEL_START_INTERUPT_REGION
-    const auto &edges = matchingX ? toMatch->histogram(0).binEdges()
-                                  : toMatch->histogram(i).binEdges();
+    const auto edges = binEdges(i);
     if (m_isEvents) {
       outputWSEvents->getSpectrum(i).setHistogram(edges);
     } else {
-      outputWS->setHistogram(
-          i, HistogramData::rebin(toRebin->histogram(i), edges));
+      const auto rebinMap = rebinMaps.find(
+          std::make_pair(toRebin->sharedX(i).get(), edges.cowData().get()));
+      if (rebinMap != rebinMaps.end() && rebinMap->second) {
+        outputWS->setHistogram(i,
+                               rebinMap->second->rebin(toRebin->histogram(i)));
+      } else {
+        outputWS->setHistogram(
+            i, HistogramData::rebin(toRebin->histogram(i), edges));
+      }
     }
     prog.report();
     PARALLEL_END_INTERUPT_REGION
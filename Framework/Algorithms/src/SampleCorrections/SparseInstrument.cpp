@@ -8,6 +8,7 @@
 
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/Run.h"
+#include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAlgorithms/SampleCorrections/DetectorGridDefinition.h"
 #include "MantidDataObjects/Workspace2D.h"
@@ -16,13 +17,24 @@
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/SampleEnvironment.h"
+#include "MantidGeometry/Objects/BoundingBox.h"
 #include "MantidGeometry/Objects/CSGObject.h"
 #include "MantidGeometry/Objects/ShapeFactory.h"
 #include "MantidHistogramData/HistogramIterator.h"
+#include "MantidKernel/BinaryStreamReader.h"
+#include "MantidKernel/BinaryStreamWriter.h"
+#include "MantidKernel/ChecksumHelper.h"
+#include "MantidKernel/Material.h"
 
 #include <Poco/DOM/AutoPtr.h>
 #include <Poco/DOM/Document.h>
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
 namespace {
 /** Check all detectors have the same EFixed value.
  *  @param eFixed An EFixedProvider object.
@@ -39,6 +51,31 @@ bool constantIndirectEFixed(const Mantid::API::ExperimentInfo &info,
   }
   return true;
 }
+
+/// Identifies a file written by saveSimulation
+const std::string SIMULATION_FILE_TAG("MantidSparseSimulation");
+/// Bump this if the layout of the simulation file changes
+constexpr int32_t SIMULATION_FILE_VERSION = 1;
+
+/** Append a description of a shape to a stream.
+ *  @param out A stream to append to.
+ *  @param shape A shape to describe.
+ */
+void describeShape(std::ostream &out, const Mantid::Geometry::IObject &shape) {
+  const auto csgShape =
+      dynamic_cast<const Mantid::Geometry::CSGObject *>(&shape);
+  if (csgShape) {
+    out << csgShape->getShapeXML() << '\n';
+  } else {
+    // Mesh shapes have no textual definition: use their extents instead.
+    const auto &bbox = shape.getBoundingBox();
+    out << bbox.minPoint() << bbox.maxPoint() << shape.volume() << '\n';
+  }
+  const auto &material = shape.material();
+  out << material.name() << ' ' << material.numberDensity() << ' '
+      << material.totalScatterXSection() << ' ' << material.absorbXSection()
+      << '\n';
+}
 } // namespace
 
 namespace Mantid {
@@ -351,6 +388,185 @@ interpolateFromDetectorGrid(const double lat, const double lon,
   return h;
 }
 
+/** Calculate the bilinear interpolation weights of the four grid points
+ *  surrounding a point.
+ *  @param lat Latitude of the interpolated point.
+ *  @param lon Longitude of the interpolated point.
+ *  @param grid The detector grid.
+ *  @param indices Indices to the surrounding grid points as returned by
+ *  DetectorGridDefinition::nearestNeighbourIndices.
+ *  @return An array of weights summing up to unity.
+ */
+std::array<double, 4>
+bilinearWeights(const double lat, const double lon,
+                const Algorithms::DetectorGridDefinition &grid,
+                const std::array<size_t, 4> &indices) {
+  const size_t row = indices[0] % grid.numberRows();
+  const size_t col = indices[0] / grid.numberRows();
+  const double lat0 = grid.latitudeAt(row);
+  const double lon0 = grid.longitudeAt(col);
+  // Clamp the fractions to handle points slightly outside the grid.
+  const double t = std::clamp(
+      (lat - lat0) / (grid.latitudeAt(row + 1) - lat0), 0.0, 1.0);
+  const double u = std::clamp(
+      (lon - lon0) / (grid.longitudeAt(col + 1) - lon0), 0.0, 1.0);
+  return {{(1.0 - t) * (1.0 - u), t * (1.0 - u), (1.0 - t) * u, t * u}};
+}
+
+/** Spatially interpolate a single histogram from four surrounding grid
+ *  detectors using bilinear interpolation in latitude and longitude.
+ *  @param lat Latitude of the interpolated detector.
+ *  @param lon Longitude of the interpolated detector.
+ *  @param ws A workspace containing the detectors used for the interpolation.
+ *  @param grid The detector grid of ws.
+ *  @param indices Indices to the surrounding grid detectors.
+ *  @return An interpolated histogram.
+ */
+HistogramData::Histogram bilinearInterpolateFromDetectorGrid(
+    const double lat, const double lon, const API::MatrixWorkspace &ws,
+    const Algorithms::DetectorGridDefinition &grid,
+    const std::array<size_t, 4> &indices) {
+  auto h = ws.histogram(0);
+  const auto weights = bilinearWeights(lat, lon, grid, indices);
+  h.mutableY() = weights[0] * ws.y(indices[0]);
+  for (size_t i = 1; i < 4; ++i) {
+    h.mutableY() += weights[i] * ws.y(indices[i]);
+  }
+  return h;
+}
+
+/** Calculate a checksum identifying a sparse instrument simulation.
+ *  The checksum covers the sparse detector grid, the wavelength points, the
+ *  beam, the sample and its environment, and any extra parameters.
+ *  @param sparseWS A sparse instrument workspace as returned by
+ *  createSparseWS.
+ *  @param sample The sample used in the simulation.
+ *  @param parameters Other parameters affecting the simulation.
+ *  @return A SHA-1 checksum.
+ */
+std::string simulationChecksum(const API::MatrixWorkspace &sparseWS,
+                               const API::Sample &sample,
+                               const std::string &parameters) {
+  std::ostringstream description;
+  description << std::setprecision(17);
+  description << parameters << '\n';
+  // Wavelength points are the same for all histograms.
+  for (const auto x : sparseWS.x(0)) {
+    description << x << ' ';
+  }
+  description << '\n';
+  const auto &spectrumInfo = sparseWS.spectrumInfo();
+  for (size_t i = 0; i < spectrumInfo.size(); ++i) {
+    description << spectrumInfo.position(i);
+  }
+  description << '\n';
+  const auto instrument = sparseWS.getInstrument();
+  const auto refFrame = instrument->getReferenceFrame();
+  description << refFrame->pointingUp() << ' '
+              << refFrame->pointingAlongBeam() << ' '
+              << refFrame->getHandedness() << '\n';
+  const auto source = instrument->getSource();
+  description << source->getPos();
+  for (const auto &beamParam : {"beam-width", "beam-height"}) {
+    for (const auto value : source->getNumberParameter(beamParam)) {
+      description << ' ' << value;
+    }
+  }
+  description << '\n';
+  const auto eMode = sparseWS.getEMode();
+  description << Kernel::DeltaEMode::asString(eMode);
+  if (eMode != Kernel::DeltaEMode::Elastic) {
+    description << ' '
+                << sparseWS.getEFixed(sparseWS.detectorInfo().detectorIDs()[0]);
+  }
+  description << '\n';
+  describeShape(description, sample.getShape());
+  if (sample.hasEnvironment()) {
+    const auto &environment = sample.getEnvironment();
+    description << environment.name() << '\n';
+    for (size_t i = 0; i < environment.nelements(); ++i) {
+      describeShape(description, environment.getComponent(i));
+    }
+  }
+  return Kernel::ChecksumHelper::sha1FromString(description.str());
+}
+
+/** Read the simulated values of a sparse instrument workspace from a file.
+ *  @param filename Full path to a file written by saveSimulation.
+ *  @param sparseWS A workspace to fill with the simulated values.
+ *  @return True if the file was read, false if it does not exist or does not
+ *  match the workspace.
+ */
+bool loadSimulation(const std::string &filename,
+                    API::MatrixWorkspace &sparseWS) {
+  std::ifstream in(filename, std::ios_base::binary);
+  if (!in) {
+    return false;
+  }
+  try {
+    Kernel::BinaryStreamReader reader(in);
+    std::string tag;
+    reader.read(tag, SIMULATION_FILE_TAG.size());
+    if (tag != SIMULATION_FILE_TAG) {
+      return false;
+    }
+    int32_t version, nhists, npoints;
+    reader >> version >> nhists >> npoints;
+    if (version != SIMULATION_FILE_VERSION ||
+        static_cast<size_t>(nhists) != sparseWS.getNumberHistograms() ||
+        static_cast<size_t>(npoints) != sparseWS.blocksize()) {
+      return false;
+    }
+    std::vector<double> values;
+    for (size_t i = 0; i < sparseWS.getNumberHistograms(); ++i) {
+      reader.read(values, npoints);
+      sparseWS.mutableY(i) = values;
+      reader.read(values, npoints);
+      sparseWS.mutableE(i) = values;
+    }
+  } catch (std::exception &) {
+    // Truncated or otherwise corrupt file.
+    return false;
+  }
+  return !in.fail();
+}
+
+/** Write the simulated values of a sparse instrument workspace to a file.
+ *  @param filename Full path to the output file.
+ *  @param sparseWS A workspace containing the simulated values.
+ *  @throw std::runtime_error If the file cannot be written.
+ */
+void saveSimulation(const std::string &filename,
+                    const API::MatrixWorkspace &sparseWS) {
+  // Write to a temporary file first so concurrent readers never see a
+  // partially written file.
+  const std::string tmpFilename = filename + ".tmp";
+  {
+    std::ofstream out(tmpFilename, std::ios_base::binary);
+    if (!out) {
+      throw std::runtime_error("Cannot open " + tmpFilename +
+                               " for writing.");
+    }
+    Kernel::BinaryStreamWriter writer(out);
+    const auto nhists = static_cast<int32_t>(sparseWS.getNumberHistograms());
+    const auto npoints = static_cast<int32_t>(sparseWS.blocksize());
+    writer.write(SIMULATION_FILE_TAG, SIMULATION_FILE_TAG.size());
+    writer << SIMULATION_FILE_VERSION << nhists << npoints;
+    for (size_t i = 0; i < sparseWS.getNumberHistograms(); ++i) {
+      writer.write(sparseWS.y(i).rawData(), npoints);
+      writer.write(sparseWS.e(i).rawData(), npoints);
+    }
+    if (!out) {
+      throw std::runtime_error("Failed to write " + tmpFilename + ".");
+    }
+  }
+  if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+    std::remove(tmpFilename.c_str());
+    throw std::runtime_error("Failed to move " + tmpFilename + " to " +
+                             filename + ".");
+  }
+}
+
 /** Creates a detector grid definition for a sparse instrument.
  *  @param modelWS A workspace the sparse instrument approximates.
  *  @param rows Number of rows in the detector grid.
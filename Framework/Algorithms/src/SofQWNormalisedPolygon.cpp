@@ -570,6 +570,7 @@ void SofQWNormalisedPolygon::initAngularCachesPSD(
   m_twoThetaUppers.resize(nHistos);
 
   const auto &spectrumInfo = workspace.spectrumInfo();
+  const auto &twoThetas = spectrumInfo.cachedGeometry().twoTheta;
 
   for (size_t i = 0; i < nHistos; ++i) {
     m_progress->report("Calculating detector angular widths");
@@ -587,7 +588,7 @@ void SofQWNormalisedPolygon::initAngularCachesPSD(
     double thetaWidth = std::numeric_limits<double>::lowest();
 
     // Find theta and phi widths
-    const double theta = spectrumInfo.twoTheta(i);
+    const double theta = twoThetas[i];
 
     const specnum_t deltaPlus1 = inSpec + 1;
     const specnum_t deltaMinus1 = inSpec - 1;
@@ -167,6 +167,7 @@ void SofQWPolygon::initThetaCache(const API::MatrixWorkspace &workspace) {
   double minTheta(DBL_MAX), maxTheta(-DBL_MAX);
 
   const auto &spectrumInfo = workspace.spectrumInfo();
+  const auto &twoThetas = spectrumInfo.cachedGeometry().twoTheta;
   for (int64_t i = 0; i < static_cast<int64_t>(nhist); ++i) {
     m_progress->report("Calculating detector angles");
     m_thetaPts[i] = -1.0; // Indicates a detector to skip
@@ -179,7 +180,7 @@ void SofQWPolygon::initThetaCache(const API::MatrixWorkspace &workspace) {
       continue;
     }
     ++ndets;
-    const double theta = spectrumInfo.twoTheta(i);
+    const double theta = twoThetas[i];
     m_thetaPts[i] = theta;
     minTheta = std::min(minTheta, theta);
     maxTheta = std::max(maxTheta, theta);
@@ -19,6 +19,7 @@
 #include "MantidKernel/UnitFactory.h"
 
 #include <atomic>
+#include <cmath>
 
 namespace Mantid {
 namespace Algorithms {
@@ -109,10 +110,21 @@ protected:
 };
 
 struct GenericShape : public SolidAngleCalculator {
-  using SolidAngleCalculator::SolidAngleCalculator;
+  /// The cached solid angles of all detectors are used if useCache is true
+  GenericShape(const ComponentInfo &componentInfo,
+               const DetectorInfo &detectorInfo, const std::string &method,
+               const double pixelArea, const bool useCache)
+      : SolidAngleCalculator(componentInfo, detectorInfo, method, pixelArea),
+        m_solidAngles(useCache ? &detectorInfo.solidAngles() : nullptr) {}
   double solidAngle(size_t index) const override {
+    // Not cached if it cannot be computed, let the detector report why
+    if (m_solidAngles && !std::isnan((*m_solidAngles)[index]))
+      return (*m_solidAngles)[index];
     return m_detectorInfo.detector(index).solidAngle(m_samplePos);
   }
+
+private:
+  const std::vector<double> *m_solidAngles;
 };
 
 struct Rectangle : public SolidAngleCalculator {
@@ -253,8 +265,14 @@ void SolidAngle::exec() {
 
   std::unique_ptr<SolidAngleCalculator> solidAngleCalculator;
   if (method == GENERIC_SHAPE) {
+    // The cache covers every detector of the instrument, so it only pays off
+    // if the requested spectra use a large part of them
+    size_t requestedDetectors = 0;
+    for (int j = m_MinSpec; j <= m_MaxSpec; ++j)
+      requestedDetectors += spectrumInfo.spectrumDefinition(j).size();
+    const bool useCache = 2 * requestedDetectors >= detectorInfo.size();
     solidAngleCalculator = std::make_unique<GenericShape>(
-        componentInfo, detectorInfo, method, pixelArea);
+        componentInfo, detectorInfo, method, pixelArea, useCache);
   } else if (method == RECTANGLE) {
     solidAngleCalculator = std::make_unique<Rectangle>(
         componentInfo, detectorInfo, method, pixelArea);
@@ -623,6 +623,8 @@ void SumSpectra::execEvent(MatrixWorkspace_sptr outputWorkspace,
   outputEL.clearDetectorIDs();
 
   const auto &spectrumInfo = inputWorkspace->spectrumInfo();
+  std::vector<const EventList *> inputLists;
+  inputLists.reserve(m_indices.size());
   // Loop over spectra
   for (const auto i : m_indices) {
     if (spectrumInfo.hasDetectors(i)) {
@@ -637,15 +639,16 @@ void SumSpectra::execEvent(MatrixWorkspace_sptr outputWorkspace,
     }
     numSpectra++;
 
-    // Add the event lists with the operator
     const EventList &inputEL = inputWorkspace->getSpectrum(i);
     if (inputEL.empty()) {
       ++numZeros;
     }
-    outputEL += inputEL;
+    inputLists.emplace_back(&inputEL);
 
     progress.report();
   }
+  // Add all the event lists in one go, keeping their order if they are sorted
+  outputEL.mergeEventLists(inputLists);
 }
 
 } // namespace Algorithms
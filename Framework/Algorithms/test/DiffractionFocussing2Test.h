@@ -101,6 +101,49 @@ public:
     dotestEventWorkspace(false, 1, false);
   }
 
+  void test_addRangeWeights_partial_bin_overlap() {
+    using namespace DiffractionFocussing2Helpers;
+    const std::vector<double> edges{0., 1., 2., 3., 4.};
+    std::vector<double> weights(4, 0.);
+    std::vector<int> fullyCovered(4, 0);
+    // Partial first and last bins, two bins covered completely
+    addRangeWeights(edges, 0.5, 3.25, weights, fullyCovered);
+    // Inside a single bin
+    addRangeWeights(edges, 1.25, 1.75, weights, fullyCovered);
+    addFullyCoveredWeights(edges, fullyCovered, weights);
+    const std::vector<double> expected{0.5, 1.5, 1., 0.25};
+    for (size_t i = 0; i < expected.size(); ++i)
+      TS_ASSERT_DELTA(weights[i], expected[i], 1e-12);
+  }
+
+  void test_addRangeWeights_range_beyond_edges() {
+    using namespace DiffractionFocussing2Helpers;
+    const std::vector<double> edges{0., 1., 2., 3., 4.};
+    std::vector<double> weights(4, 0.);
+    std::vector<int> fullyCovered(4, 0);
+    addRangeWeights(edges, -1., 5., weights, fullyCovered);
+    addFullyCoveredWeights(edges, fullyCovered, weights);
+    for (const auto weight : weights)
+      TS_ASSERT_DELTA(weight, 1., 1e-12);
+  }
+
+  void test_addRangeWeights_empty_range() {
+    using namespace DiffractionFocussing2Helpers;
+    const std::vector<double> edges{0., 1., 2., 3., 4.};
+    std::vector<double> weights(4, 0.);
+    std::vector<int> fullyCovered(4, 0);
+    addRangeWeights(edges, 2., 2., weights, fullyCovered);
+    addRangeWeights(edges, 3., 1., weights, fullyCovered);
+    // Outside the bins
+    addRangeWeights(edges, -2., -1., weights, fullyCovered);
+    addRangeWeights(edges, 5., 6., weights, fullyCovered);
+    addFullyCoveredWeights(edges, fullyCovered, weights);
+    for (const auto weight : weights)
+      TS_ASSERT_EQUALS(weight, 0.);
+    for (const auto count : fullyCovered)
+      TS_ASSERT_EQUALS(count, 0);
+  }
+
   void dotestEventWorkspace(bool inplace, size_t numgroups,
                             bool preserveEvents = true,
                             int bankWidthInPixels = 16) {
@@ -8,6 +8,7 @@
 
 #include "MantidAlgorithms/SampleCorrections/SparseInstrument.h"
 
+#include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAlgorithms/SampleCorrections/DetectorGridDefinition.h"
 #include "MantidDataObjects/Workspace2D.h"
@@ -16,8 +17,12 @@
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidHistogramData/Histogram.h"
 #include "MantidHistogramData/LinearGenerator.h"
+#include "MantidKernel/Material.h"
+#include "MantidKernel/PhysicalConstants.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
+#include <Poco/TemporaryFile.h>
 #include <cxxtest/TestSuite.h>
 
 using namespace Mantid::Algorithms::SparseInstrument;
@@ -231,6 +236,117 @@ public:
     }
   }
 
+  void test_bilinearWeights() {
+    const DetectorGridDefinition grid(0.0, 1.0, 3, 0.0, 2.0, 5);
+    auto indices = grid.nearestNeighbourIndices(0.0, 0.0);
+    auto weights = bilinearWeights(0.0, 0.0, grid, indices);
+    TS_ASSERT_EQUALS(weights[0], 1.0)
+    TS_ASSERT_EQUALS(weights[1], 0.0)
+    TS_ASSERT_EQUALS(weights[2], 0.0)
+    TS_ASSERT_EQUALS(weights[3], 0.0)
+    indices = grid.nearestNeighbourIndices(0.25, 0.75);
+    weights = bilinearWeights(0.25, 0.75, grid, indices);
+    TS_ASSERT_DELTA(weights[0], 0.25, 1e-12)
+    TS_ASSERT_DELTA(weights[1], 0.25, 1e-12)
+    TS_ASSERT_DELTA(weights[2], 0.25, 1e-12)
+    TS_ASSERT_DELTA(weights[3], 0.25, 1e-12)
+    indices = grid.nearestNeighbourIndices(1.0, 2.0);
+    weights = bilinearWeights(1.0, 2.0, grid, indices);
+    TS_ASSERT_DELTA(weights[0], 0.0, 1e-12)
+    TS_ASSERT_DELTA(weights[1], 0.0, 1e-12)
+    TS_ASSERT_DELTA(weights[2], 0.0, 1e-12)
+    TS_ASSERT_DELTA(weights[3], 1.0, 1e-12)
+  }
+
+  void test_bilinearInterpolateFromDetectorGrid() {
+    using namespace WorkspaceCreationHelper;
+    auto ws = create2DWorkspaceWithRectangularInstrument(1, 2, 7);
+    auto grid = createDetectorGridDefinition(*ws, 3, 6);
+    const size_t wavelengths = 3;
+    auto sparseWS = createSparseWS(*ws, *grid, wavelengths);
+    // A field linear in latitude and longitude is reproduced exactly.
+    const auto field = [](const double lat, const double lon) {
+      return 2.0 * lat - 3.0 * lon + 1.0;
+    };
+    for (size_t col = 0; col < grid->numberColumns(); ++col) {
+      for (size_t row = 0; row < grid->numberRows(); ++row) {
+        const auto index = col * grid->numberRows() + row;
+        sparseWS->mutableY(index) =
+            field(grid->latitudeAt(row), grid->longitudeAt(col));
+      }
+    }
+    const double lat = 0.3 * grid->latitudeAt(1) + 0.7 * grid->latitudeAt(2);
+    const double lon = 0.6 * grid->longitudeAt(3) + 0.4 * grid->longitudeAt(4);
+    const auto indices = grid->nearestNeighbourIndices(lat, lon);
+    const auto h = bilinearInterpolateFromDetectorGrid(lat, lon, *sparseWS,
+                                                       *grid, indices);
+    TS_ASSERT_EQUALS(h.size(), wavelengths)
+    for (size_t i = 0; i < h.size(); ++i) {
+      TS_ASSERT_DELTA(h.y()[i], field(lat, lon), 1e-10)
+    }
+  }
+
+  void test_simulationChecksum_changesWithInputs() {
+    using namespace WorkspaceCreationHelper;
+    using Mantid::Kernel::Material;
+    auto ws = create2DWorkspaceWithRectangularInstrument(1, 2, 7);
+    auto shape = ComponentCreationHelper::createSphere(0.01);
+    shape->setMaterial(Material(
+        "Vanadium", Mantid::PhysicalConstants::getNeutronAtom(23, 0), 0.072));
+    ws->mutableSample().setShape(shape);
+    auto grid = createDetectorGridDefinition(*ws, 3, 6);
+    auto sparseWS = createSparseWS(*ws, *grid, 3);
+    const auto checksum = simulationChecksum(*sparseWS, ws->sample(), "1");
+    TS_ASSERT_EQUALS(simulationChecksum(*sparseWS, ws->sample(), "1"),
+                     checksum)
+    TS_ASSERT_DIFFERS(simulationChecksum(*sparseWS, ws->sample(), "2"),
+                      checksum)
+    auto otherSparseWS = createSparseWS(*ws, *grid, 4);
+    TS_ASSERT_DIFFERS(simulationChecksum(*otherSparseWS, ws->sample(), "1"),
+                      checksum)
+    auto otherShape = ComponentCreationHelper::createSphere(0.01);
+    otherShape->setMaterial(Material(
+        "Vanadium", Mantid::PhysicalConstants::getNeutronAtom(23, 0), 0.05));
+    ws->mutableSample().setShape(otherShape);
+    TS_ASSERT_DIFFERS(simulationChecksum(*sparseWS, ws->sample(), "1"),
+                      checksum)
+  }
+
+  void test_saveSimulation_loadSimulation_roundtrip() {
+    using namespace WorkspaceCreationHelper;
+    auto ws = create2DWorkspaceWithRectangularInstrument(1, 2, 7);
+    auto grid = createDetectorGridDefinition(*ws, 3, 4);
+    auto sparseWS = createSparseWS(*ws, *grid, 5);
+    for (size_t i = 0; i < sparseWS->getNumberHistograms(); ++i) {
+      auto &ys = sparseWS->mutableY(i);
+      auto &es = sparseWS->mutableE(i);
+      for (size_t j = 0; j < ys.size(); ++j) {
+        ys[j] = static_cast<double>(i) + 0.1 * static_cast<double>(j);
+        es[j] = 0.01 * ys[j];
+      }
+    }
+    Poco::TemporaryFile file;
+    saveSimulation(file.path(), *sparseWS);
+    auto loadedWS = createSparseWS(*ws, *grid, 5);
+    TS_ASSERT(loadSimulation(file.path(), *loadedWS))
+    for (size_t i = 0; i < sparseWS->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(loadedWS->y(i).rawData(), sparseWS->y(i).rawData())
+      TS_ASSERT_EQUALS(loadedWS->e(i).rawData(), sparseWS->e(i).rawData())
+    }
+    // Size mismatch is rejected.
+    auto otherWS = createSparseWS(*ws, *grid, 6);
+    TS_ASSERT(!loadSimulation(file.path(), *otherWS))
+  }
+
+  void test_loadSimulation_missingFile() {
+    using namespace WorkspaceCreationHelper;
+    auto ws = create2DWorkspaceWithRectangularInstrument(1, 2, 7);
+    auto grid = createDetectorGridDefinition(*ws, 3, 4);
+    auto sparseWS = createSparseWS(*ws, *grid, 5);
+    Poco::TemporaryFile file;
+    TS_ASSERT(!loadSimulation(file.path(), *sparseWS))
+  }
+
   void test_inverseDistanceWeights() {
     std::array<double, 4> ds{{0.3, 0.3, 0.0, 0.3}};
     auto weights = inverseDistanceWeights(ds);
@@ -50,11 +50,15 @@ private:
   const int64_t m_sampleIndex = -1;
   DetectorInfo *m_detectorInfo; // Geometry::DetectorInfo is the owner.
   /// The default initialisation is a single interval, i.e. no scan
-  std::vector<std::pair<int64_t, int64_t>> m_scanIntervals{{0, 1}};
+  Kernel::cow_ptr<std::vector<std::pair<int64_t, int64_t>>> m_scanIntervals{
+      boost::make_shared<std::vector<std::pair<int64_t, int64_t>>>(
+          1, std::pair<int64_t, int64_t>(0, 1))};
   /// For (component index, time index) -> linear index conversions
   Kernel::cow_ptr<std::vector<std::vector<size_t>>> m_indexMap{nullptr};
   /// For linear index -> (detector index, time index) conversions
   Kernel::cow_ptr<std::vector<std::pair<size_t, size_t>>> m_indices{nullptr};
+  /// Incremented whenever component positions, rotations or scales change
+  size_t m_geometryRevision = 0;
   void failIfDetectorInfoScanning() const;
   size_t linearIndex(const std::pair<size_t, size_t> &index) const;
   void initScanIntervals();
@@ -108,7 +112,7 @@ public:
   }
 
   const Eigen::Vector3d &position(const size_t componentIndex) const;
-  const Eigen::Vector3d &position(const std::pair<size_t, size_t> &index) const;
+  Eigen::Vector3d position(const std::pair<size_t, size_t> &index) const;
   Eigen::Quaterniond rotation(const size_t componentIndex) const;
   Eigen::Quaterniond rotation(const std::pair<size_t, size_t> &index) const;
   Eigen::Vector3d relativePosition(const size_t componentIndex) const;
@@ -147,6 +151,8 @@ public:
   const std::vector<std::pair<int64_t, int64_t>> &scanIntervals() const;
   void setScanInterval(const std::pair<int64_t, int64_t> &interval);
   void merge(const ComponentInfo &other);
+  size_t geometryRevision() const;
+  size_t fullGeometryRevision() const;
 
   class Range {
   private:
@@ -173,6 +179,8 @@ public:
   Range componentRangeInSubtree(const size_t index) const;
 
 private:
+  const Eigen::Vector3d &
+  positionAtFirstTimeIndex(const size_t componentIndex) const;
   void doSetPosition(const std::pair<size_t, size_t> &index,
                      const Eigen::Vector3d &newPosition,
                      const ComponentInfo::Range &detectorRange);
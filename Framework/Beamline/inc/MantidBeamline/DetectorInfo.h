@@ -68,16 +68,19 @@ public:
   void setMasked(const std::pair<size_t, size_t> &index, bool masked);
   bool hasMaskedDetectors() const;
   const Eigen::Vector3d &position(const size_t index) const;
-  const Eigen::Vector3d &position(const std::pair<size_t, size_t> &index) const;
+  Eigen::Vector3d position(const std::pair<size_t, size_t> &index) const;
   const Eigen::Quaterniond &rotation(const size_t index) const;
-  const Eigen::Quaterniond &
-  rotation(const std::pair<size_t, size_t> &index) const;
+  Eigen::Quaterniond rotation(const std::pair<size_t, size_t> &index) const;
   void setPosition(const size_t index, const Eigen::Vector3d &position);
   void setPosition(const std::pair<size_t, size_t> &index,
                    const Eigen::Vector3d &position);
   void setRotation(const size_t index, const Eigen::Quaterniond &rotation);
   void setRotation(const std::pair<size_t, size_t> &index,
                    const Eigen::Quaterniond &rotation);
+  void transformDetectors(const size_t begin, const size_t end,
+                          const size_t timeIndex,
+                          const Eigen::Quaterniond &rotation,
+                          const Eigen::Vector3d &translation);
 
   size_t scanCount() const;
   const std::vector<std::pair<int64_t, int64_t>> scanIntervals() const;
@@ -87,6 +90,7 @@ public:
   double l1() const;
   const Eigen::Vector3d &sourcePosition() const;
   const Eigen::Vector3d &samplePosition() const;
+  size_t geometryRevision() const;
 
   /** The `merge()` operation was made private in `DetectorInfo`, and only
    * accessible through `ComponentInfo` (via this `friend` declaration)
@@ -98,10 +102,41 @@ public:
   friend class ComponentInfo;
 
 private:
+  /// A rotation followed by a translation of the detectors with indices in
+  /// [begin, end)
+  struct Transformation {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    size_t begin;
+    size_t end;
+    Eigen::Quaterniond rotation;
+    Eigen::Vector3d translation;
+  };
+  using Transformations =
+      std::vector<Transformation, Eigen::aligned_allocator<Transformation>>;
+
+  /** Positions and rotations of all detectors at a time index other than 0.
+   *
+   * Positions and rotations are stored in blocks of size() entries, block 0
+   * being time index 0. A scan point either owns its block, or refers to a
+   * block shared with time index 0 or other scan points and describes moved
+   * banks by transformations applied to it. Scans of moving banks thus need
+   * little memory until detectors are set individually, which copies the
+   * block of that time index. */
+  struct ScanPoint {
+    size_t block{0};
+    bool ownsBlock{false};
+    Transformations transformations;
+  };
+
   size_t linearIndex(const std::pair<size_t, size_t> &index) const;
   void checkNoTimeDependence() const;
   void checkSizes(const DetectorInfo &other) const;
   void merge(const DetectorInfo &other, const std::vector<bool> &merge);
+  size_t blockOffset(const size_t timeIndex);
+  size_t appendBlock(const DetectorInfo &source, const size_t offset,
+                     const Transformations &transformations);
+  void unshareFirstBlock();
+  bool hasFirstBlock(const DetectorInfo &other, const size_t offset) const;
 
   Kernel::cow_ptr<std::vector<bool>> m_isMonitor{nullptr};
   Kernel::cow_ptr<std::vector<bool>> m_isMasked{nullptr};
@@ -109,8 +144,14 @@ private:
   Kernel::cow_ptr<std::vector<Eigen::Quaterniond,
                               Eigen::aligned_allocator<Eigen::Quaterniond>>>
       m_rotations{nullptr};
+  /// Time indices 1 and higher, empty unless the beamline is scanning
+  Kernel::cow_ptr<std::vector<ScanPoint>> m_scanPoints{nullptr};
+  /// Whether scan points may refer to block 0
+  bool m_firstBlockShared = false;
 
   ComponentInfo *m_componentInfo = nullptr; // Geometry::ComponentInfo owner
+  /// Incremented whenever detector positions or rotations change
+  size_t m_geometryRevision = 0;
 };
 
 /** Returns the number of detectors in the instrument.
@@ -125,9 +166,9 @@ inline size_t DetectorInfo::size() const {
 
 /// Returns true if the beamline has scanning detectors.
 inline bool DetectorInfo::isScanning() const {
-  if (!m_positions)
+  if (!m_scanPoints)
     return false;
-  return size() != m_positions->size();
+  return !m_scanPoints->empty();
 }
 
 /** Returns the position of the detector with given detector index.
@@ -140,9 +181,16 @@ inline const Eigen::Vector3d &DetectorInfo::position(const size_t index) const {
 }
 
 /// Returns the position of the detector with given index.
-inline const Eigen::Vector3d &
+inline Eigen::Vector3d
 DetectorInfo::position(const std::pair<size_t, size_t> &index) const {
-  return (*m_positions)[linearIndex(index)];
+  if (index.second == 0)
+    return (*m_positions)[index.first];
+  const auto &scanPoint = (*m_scanPoints)[index.second - 1];
+  const auto &stored = (*m_positions)[scanPoint.block * size() + index.first];
+  for (const auto &transformation : scanPoint.transformations)
+    if (index.first >= transformation.begin && index.first < transformation.end)
+      return transformation.rotation * stored + transformation.translation;
+  return stored;
 }
 
 /** Returns the rotation of the detector with given detector index.
@@ -156,9 +204,16 @@ DetectorInfo::rotation(const size_t index) const {
 }
 
 /// Returns the rotation of the detector with given index.
-inline const Eigen::Quaterniond &
+inline Eigen::Quaterniond
 DetectorInfo::rotation(const std::pair<size_t, size_t> &index) const {
-  return (*m_rotations)[linearIndex(index)];
+  if (index.second == 0)
+    return (*m_rotations)[index.first];
+  const auto &scanPoint = (*m_scanPoints)[index.second - 1];
+  const auto &stored = (*m_rotations)[scanPoint.block * size() + index.first];
+  for (const auto &transformation : scanPoint.transformations)
+    if (index.first >= transformation.begin && index.first < transformation.end)
+      return transformation.rotation * stored;
+  return stored;
 }
 
 /** Set the position of the detector with given detector index.
@@ -169,12 +224,15 @@ inline void DetectorInfo::setPosition(const size_t index,
                                       const Eigen::Vector3d &position) {
   checkNoTimeDependence();
   m_positions.access()[index] = position;
+  ++m_geometryRevision;
 }
 
 /// Set the position of the detector with given index.
 inline void DetectorInfo::setPosition(const std::pair<size_t, size_t> &index,
                                       const Eigen::Vector3d &position) {
-  m_positions.access()[linearIndex(index)] = position;
+  const auto offset = blockOffset(index.second);
+  m_positions.access()[offset + index.first] = position;
+  ++m_geometryRevision;
 }
 
 /** Set the rotation of the detector with given detector index.
@@ -185,12 +243,15 @@ inline void DetectorInfo::setRotation(const size_t index,
                                       const Eigen::Quaterniond &rotation) {
   checkNoTimeDependence();
   m_rotations.access()[index] = rotation.normalized();
+  ++m_geometryRevision;
 }
 
 /// Set the rotation of the detector with given index.
 inline void DetectorInfo::setRotation(const std::pair<size_t, size_t> &index,
                                       const Eigen::Quaterniond &rotation) {
-  m_rotations.access()[linearIndex(index)] = rotation.normalized();
+  const auto offset = blockOffset(index.second);
+  m_rotations.access()[offset + index.first] = rotation.normalized();
+  ++m_geometryRevision;
 }
 
 /// Throws if this has time-dependent data.
@@ -206,7 +267,8 @@ DetectorInfo::linearIndex(const std::pair<size_t, size_t> &index) const {
   // The most common case are beamlines with static detectors. In that case the
   // time index is always 0 and we avoid expensive map lookups. Linear indices
   // are ordered such that the first block contains everything for time index 0
-  // so even in the time dependent case no translation is necessary.
+  // so even in the time dependent case no translation is necessary. Only mask
+  // flags are stored like this, positions and rotations use scan points.
   if (index.second == 0)
     return index.first;
   else
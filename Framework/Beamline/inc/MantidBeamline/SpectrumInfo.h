@@ -9,6 +9,8 @@
 #include "MantidBeamline/DllConfig.h"
 #include "MantidKernel/cow_ptr.h"
 
+#include <atomic>
+
 namespace Mantid {
 class SpectrumDefinition;
 namespace Beamline {
@@ -44,6 +46,10 @@ public:
   SpectrumInfo(const size_t numberOfDetectors);
   SpectrumInfo(
       Kernel::cow_ptr<std::vector<SpectrumDefinition>> spectrumDefinition);
+  SpectrumInfo(const SpectrumInfo &other);
+  SpectrumInfo(SpectrumInfo &&other);
+  SpectrumInfo &operator=(const SpectrumInfo &other);
+  SpectrumInfo &operator=(SpectrumInfo &&other);
 
   size_t size() const;
 
@@ -51,9 +57,12 @@ public:
   void setSpectrumDefinition(const size_t index, SpectrumDefinition def);
   const Kernel::cow_ptr<std::vector<SpectrumDefinition>> &
   sharedSpectrumDefinitions() const;
+  size_t spectrumDefinitionRevision() const;
 
 private:
   Kernel::cow_ptr<std::vector<SpectrumDefinition>> m_spectrumDefinition;
+  /// Atomic since definitions of different spectra are set concurrently.
+  std::atomic<size_t> m_spectrumDefinitionRevision{0};
 };
 
 } // namespace Beamline
@@ -29,6 +29,18 @@ void checkScanInterval(const std::pair<int64_t, int64_t> &interval) {
         "ComponentInfo: cannot set scan interval with start >= end");
 }
 } // namespace
+
+/// Returns true if the detector indices in range are [begin, end)
+bool isContiguous(const ComponentInfo::Range &range, size_t &begin,
+                  size_t &end) {
+  if (range.empty())
+    return false;
+  const auto minmax = std::minmax_element(range.begin(), range.end());
+  begin = *minmax.first;
+  end = *minmax.second + 1;
+  return end - begin ==
+         static_cast<size_t>(std::distance(range.begin(), range.end()));
+}
 } // namespace
 
 ComponentInfo::ComponentInfo()
@@ -189,7 +201,7 @@ ComponentInfo::position(const size_t componentIndex) const {
   return (*m_positions)[rangesIndex];
 }
 
-const Eigen::Vector3d &
+Eigen::Vector3d
 ComponentInfo::position(const std::pair<size_t, size_t> &index) const {
 
   const auto componentIndex = index.first;
@@ -221,6 +233,15 @@ ComponentInfo::rotation(const std::pair<size_t, size_t> &index) const {
   return (*m_rotations)[linearIndex({rangesIndex, index.second})];
 }
 
+/// Returns the stored position of the component at time index 0, which is
+/// never derived from a transformation of scan points.
+const Eigen::Vector3d &
+ComponentInfo::positionAtFirstTimeIndex(const size_t componentIndex) const {
+  if (isDetector(componentIndex))
+    return (*m_detectorInfo->m_positions)[componentIndex];
+  return (*m_positions)[compOffsetIndex(componentIndex)];
+}
+
 /**
  * Extract the position of a component relative to it's parent
  *
@@ -277,17 +298,26 @@ void ComponentInfo::doSetPosition(const std::pair<size_t, size_t> &index,
 
   const auto componentIndex = index.first;
   const auto timeIndex = index.second;
-  const Eigen::Vector3d offset = newPosition - position(componentIndex);
-  for (const auto &subIndex : detectorRange) {
-    m_detectorInfo->setPosition(
-        {subIndex, timeIndex},
-        m_detectorInfo->position({subIndex, timeIndex}) + offset);
+  const Eigen::Vector3d offset = newPosition - position(index);
+  size_t begin;
+  size_t end;
+  if (m_detectorInfo->isScanning() && !isDetector(componentIndex) &&
+      isContiguous(detectorRange, begin, end)) {
+    m_detectorInfo->transformDetectors(
+        begin, end, timeIndex, Eigen::Quaterniond::Identity(), offset);
+  } else {
+    for (const auto &subIndex : detectorRange) {
+      m_detectorInfo->setPosition(
+          {subIndex, timeIndex},
+          m_detectorInfo->position({subIndex, timeIndex}) + offset);
+    }
   }
 
   for (const auto &subIndex : componentRangeInSubtree(componentIndex)) {
     size_t offsetIndex = compOffsetIndex(subIndex);
-    m_positions.access()[offsetIndex] += offset;
+    m_positions.access()[linearIndex({offsetIndex, timeIndex})] += offset;
   }
+  ++m_geometryRevision;
 }
 
 void ComponentInfo::doSetRotation(const std::pair<size_t, size_t> &index,
@@ -302,12 +332,22 @@ void ComponentInfo::doSetRotation(const std::pair<size_t, size_t> &index,
       (newRotation * currentRotInv).normalized();
   auto transform = Eigen::Matrix3d(rotDelta);
 
-  for (const auto &subDetIndex : detectorRange) {
-    auto oldPos = m_detectorInfo->position({subDetIndex, timeIndex});
-    auto newPos = transform * (oldPos - compPos) + compPos;
-    auto newRot = rotDelta * m_detectorInfo->rotation({subDetIndex, timeIndex});
-    m_detectorInfo->setPosition({subDetIndex, timeIndex}, newPos);
-    m_detectorInfo->setRotation({subDetIndex, timeIndex}, newRot);
+  size_t begin;
+  size_t end;
+  if (m_detectorInfo->isScanning() &&
+      isContiguous(detectorRange, begin, end)) {
+    // Scan points record the rotation of a bank instead of its detectors
+    m_detectorInfo->transformDetectors(begin, end, timeIndex, rotDelta,
+                                       compPos - rotDelta * compPos);
+  } else {
+    for (const auto &subDetIndex : detectorRange) {
+      auto oldPos = m_detectorInfo->position({subDetIndex, timeIndex});
+      auto newPos = transform * (oldPos - compPos) + compPos;
+      auto newRot =
+          rotDelta * m_detectorInfo->rotation({subDetIndex, timeIndex});
+      m_detectorInfo->setPosition({subDetIndex, timeIndex}, newPos);
+      m_detectorInfo->setRotation({subDetIndex, timeIndex}, newRot);
+    }
   }
 
   for (const auto &subCompIndex : componentRangeInSubtree(componentIndex)) {
@@ -320,6 +360,7 @@ void ComponentInfo::doSetRotation(const std::pair<size_t, size_t> &index,
     m_rotations.access()[linearIndex({childCompIndexOffset, timeIndex})] =
         newRot.normalized();
   }
+  ++m_geometryRevision;
 }
 
 /**
@@ -488,7 +529,7 @@ const Eigen::Vector3d &ComponentInfo::sourcePosition() const {
   }
   // Getting position with time index to bypass scanning check. Sources are not
   // scanned.
-  return position({static_cast<size_t>(m_sourceIndex), 0});
+  return positionAtFirstTimeIndex(static_cast<size_t>(m_sourceIndex));
 }
 
 const Eigen::Vector3d &ComponentInfo::samplePosition() const {
@@ -497,7 +538,7 @@ const Eigen::Vector3d &ComponentInfo::samplePosition() const {
   }
   // Getting position with time index to bypass scanning check. Samples are not
   // scanned.
-  return position({static_cast<size_t>(m_sampleIndex), 0});
+  return positionAtFirstTimeIndex(static_cast<size_t>(m_sampleIndex));
 }
 
 size_t ComponentInfo::source() const {
@@ -563,6 +604,7 @@ size_t ComponentInfo::indexOfAny(const std::string &name) const {
 void ComponentInfo::setScaleFactor(const size_t componentIndex,
                                    const Eigen::Vector3d &scaleFactor) {
   m_scaleFactors.access()[componentIndex] = scaleFactor;
+  ++m_geometryRevision;
 }
 
 ComponentType ComponentInfo::componentType(const size_t componentIndex) const {
@@ -574,7 +616,7 @@ ComponentType ComponentInfo::componentType(const size_t componentIndex) const {
 }
 
 /// Get the number of scans
-size_t ComponentInfo::scanCount() const { return m_scanIntervals.size(); }
+size_t ComponentInfo::scanCount() const { return m_scanIntervals->size(); }
 
 bool ComponentInfo::isScanning() const {
   if (m_detectorInfo && m_detectorInfo->isScanning())
@@ -596,7 +638,7 @@ void ComponentInfo::checkNoTimeDependence() const {
 /// Get the scan intervals
 const std::vector<std::pair<int64_t, int64_t>> &
 ComponentInfo::scanIntervals() const {
-  return m_scanIntervals;
+  return *m_scanIntervals;
 }
 
 void ComponentInfo::checkSpecialIndices(size_t componentIndex) const {
@@ -615,7 +657,7 @@ void ComponentInfo::setScanInterval(
   // Enforces setting scan intervals BEFORE time indexed positions and rotations
   checkNoTimeDependence();
   checkScanInterval(interval);
-  m_scanIntervals[0] = interval;
+  m_scanIntervals.access()[0] = interval;
 }
 
 /**
@@ -639,13 +681,14 @@ void ComponentInfo::merge(const ComponentInfo &other) {
   const auto &toMerge = buildMergeIndices(other);
   // Merging the detectorInfo has to be done before we update scanIntervals
   m_detectorInfo->merge(*other.m_detectorInfo, toMerge);
-  for (size_t timeIndex = 0; timeIndex < other.m_scanIntervals.size();
+  for (size_t timeIndex = 0; timeIndex < other.m_scanIntervals->size();
        ++timeIndex) {
     if (!toMerge[timeIndex])
       continue;
     auto &positions = m_positions.access();
     auto &rotations = m_rotations.access();
-    m_scanIntervals.emplace_back(other.m_scanIntervals[timeIndex]);
+    m_scanIntervals.access().emplace_back(
+        (*other.m_scanIntervals)[timeIndex]);
     const size_t indexStart = other.linearIndex({0, timeIndex});
     size_t indexEnd = indexStart + nonDetectorSize();
     positions.insert(positions.end(), other.m_positions->begin() + indexStart,
@@ -653,16 +696,32 @@ void ComponentInfo::merge(const ComponentInfo &other) {
     rotations.insert(rotations.end(), other.m_rotations->begin() + indexStart,
                      other.m_rotations->begin() + indexEnd);
   }
+  ++m_geometryRevision;
+}
+
+/** Returns a counter that is incremented whenever the position, rotation or
+ * scale factor of any component is changed. Intended for caching quantities
+ * derived from the geometry.
+ */
+size_t ComponentInfo::geometryRevision() const { return m_geometryRevision; }
+
+/** Returns a counter that is incremented whenever the geometry of any
+ * component, including the detectors moved through the linked DetectorInfo,
+ * is changed.
+ */
+size_t ComponentInfo::fullGeometryRevision() const {
+  return hasDetectorInfo() ? m_detectorInfo->geometryRevision()
+                           : m_geometryRevision;
 }
 
 std::vector<bool>
 ComponentInfo::buildMergeIndices(const ComponentInfo &other) const {
   checkSizes(other);
-  std::vector<bool> merge(other.m_scanIntervals.size(), true);
-  for (size_t t1 = 0; t1 < other.m_scanIntervals.size(); ++t1) {
-    for (size_t t2 = 0; t2 < m_scanIntervals.size(); ++t2) {
-      const auto interval1 = other.m_scanIntervals[t1];
-      const auto interval2 = m_scanIntervals[t2];
+  std::vector<bool> merge(other.m_scanIntervals->size(), true);
+  for (size_t t1 = 0; t1 < other.m_scanIntervals->size(); ++t1) {
+    for (size_t t2 = 0; t2 < m_scanIntervals->size(); ++t2) {
+      const auto interval1 = (*other.m_scanIntervals)[t1];
+      const auto interval2 = (*m_scanIntervals)[t2];
       if (interval1 == interval2) {
         for (size_t compIndex = 0; compIndex < size(); ++compIndex) {
           checkIdenticalIntervals(other,
@@ -73,13 +73,10 @@ bool DetectorInfo::isEquivalent(const DetectorInfo &other) const {
 
   // Positions: Absolute difference matter, so comparison is not relative.
   // Changes below 1 nm = 1e-9 m are allowed.
-  if (!(m_positions == other.m_positions) &&
-      !std::equal(m_positions->begin(), m_positions->end(),
-                  other.m_positions->begin(),
-                  [](const Eigen::Vector3d &a, const Eigen::Vector3d &b) {
-                    return (a - b).norm() < 1e-9;
-                  }))
-    return false;
+  const auto equivalentPositions = [](const Eigen::Vector3d &a,
+                                      const Eigen::Vector3d &b) {
+    return (a - b).norm() < 1e-9;
+  };
   // At a distance of L = 1000 m (a reasonable upper limit for instrument sizes)
   // from the rotation center we want a difference of less than d = 1 nm = 1e-9
   // m). We have, using small angle approximation,
@@ -90,13 +87,35 @@ bool DetectorInfo::isEquivalent(const DetectorInfo &other) const {
   constexpr double L = 1000.0;
   constexpr double safety_factor = 2.0;
   const double imag_norm_max = sin(d_max / (2.0 * L * safety_factor));
+  const auto equivalentRotations = [imag_norm_max](
+                                       const Eigen::Quaterniond &a,
+                                       const Eigen::Quaterniond &b) {
+    return (a * b.conjugate()).vec().norm() < imag_norm_max;
+  };
+
+  if (isScanning() || other.isScanning()) {
+    // Scan points may store the same geometry differently, so compare the
+    // values of each detector at each time index
+    if (!isScanning() || !other.isScanning() ||
+        m_scanPoints->size() != other.m_scanPoints->size())
+      return false;
+    for (size_t timeIndex = 0; timeIndex <= m_scanPoints->size(); ++timeIndex)
+      for (size_t i = 0; i < size(); ++i)
+        if (!equivalentPositions(position({i, timeIndex}),
+                                 other.position({i, timeIndex})) ||
+            !equivalentRotations(rotation({i, timeIndex}),
+                                 other.rotation({i, timeIndex})))
+          return false;
+    return true;
+  }
+
+  if (!(m_positions == other.m_positions) &&
+      !std::equal(m_positions->begin(), m_positions->end(),
+                  other.m_positions->begin(), equivalentPositions))
+    return false;
   if (!(m_rotations == other.m_rotations) &&
       !std::equal(m_rotations->begin(), m_rotations->end(),
-                  other.m_rotations->begin(),
-                  [imag_norm_max](const Eigen::Quaterniond &a,
-                                  const Eigen::Quaterniond &b) {
-                    return (a * b.conjugate()).vec().norm() < imag_norm_max;
-                  }))
+                  other.m_rotations->begin(), equivalentRotations))
     return false;
   return true;
 }
@@ -146,6 +165,141 @@ void DetectorInfo::setMasked(const std::pair<size_t, size_t> &index,
   m_isMasked.access()[linearIndex(index)] = masked;
 }
 
+/** Moves the detectors with indices in [begin, end) at the given time index:
+ * their positions are rotated about the origin by `rotation` and then
+ * translated by `translation`, and `rotation` is applied to their rotations.
+ *
+ * For a time index that shares its stored positions, e.g., one added by
+ * merging a static beamline, only the transformation is recorded, so that
+ * moving the banks of a scan needs memory per time index and not per detector.
+ */
+void DetectorInfo::transformDetectors(const size_t begin, const size_t end,
+                                      const size_t timeIndex,
+                                      const Eigen::Quaterniond &rotation,
+                                      const Eigen::Vector3d &translation) {
+  if (begin > end || end > size())
+    throw std::out_of_range("DetectorInfo::transformDetectors: invalid range "
+                            "of detector indices");
+  if (timeIndex > 0 && (!m_scanPoints || timeIndex > m_scanPoints->size()))
+    throw std::out_of_range("DetectorInfo::transformDetectors: invalid time "
+                            "index");
+  ++m_geometryRevision;
+  if (timeIndex > 0 && !(*m_scanPoints)[timeIndex - 1].ownsBlock) {
+    auto &transformations =
+        m_scanPoints.access()[timeIndex - 1].transformations;
+    const auto same =
+        std::find_if(transformations.begin(), transformations.end(),
+                     [begin, end](const Transformation &transformation) {
+                       return transformation.begin == begin &&
+                              transformation.end == end;
+                     });
+    if (same != transformations.end()) {
+      same->rotation = rotation * same->rotation;
+      same->translation = rotation * same->translation + translation;
+      return;
+    }
+    if (std::none_of(transformations.begin(), transformations.end(),
+                     [begin, end](const Transformation &transformation) {
+                       return transformation.begin < end &&
+                              begin < transformation.end;
+                     })) {
+      transformations.push_back({begin, end, rotation, translation});
+      return;
+    }
+    // Overlapping ranges cannot be combined, store the detectors instead
+  }
+  const auto offset = blockOffset(timeIndex);
+  auto &positions = m_positions.access();
+  for (size_t i = offset + begin; i < offset + end; ++i)
+    positions[i] = rotation * positions[i] + translation;
+  if (rotation.coeffs() == Eigen::Quaterniond::Identity().coeffs())
+    return;
+  auto &rotations = m_rotations.access();
+  for (size_t i = offset + begin; i < offset + end; ++i)
+    rotations[i] = (rotation * rotations[i]).normalized();
+}
+
+/** Returns the offset of the stored positions and rotations of the given time
+ * index, for modifying them. Shared storage is copied first. */
+size_t DetectorInfo::blockOffset(const size_t timeIndex) {
+  if (timeIndex == 0) {
+    if (m_firstBlockShared)
+      unshareFirstBlock();
+    return 0;
+  }
+  const auto &scanPoint = (*m_scanPoints)[timeIndex - 1];
+  if (scanPoint.ownsBlock)
+    return scanPoint.block * size();
+  const auto block = appendBlock(*this, scanPoint.block * size(),
+                                 scanPoint.transformations);
+  auto &ownScanPoint = m_scanPoints.access()[timeIndex - 1];
+  ownScanPoint.block = block;
+  ownScanPoint.ownsBlock = true;
+  ownScanPoint.transformations.clear();
+  return block * size();
+}
+
+/** Appends a block with the positions and rotations stored in `source` at
+ * `offset`, with `transformations` applied, and returns its index. */
+size_t DetectorInfo::appendBlock(const DetectorInfo &source,
+                                 const size_t offset,
+                                 const Transformations &transformations) {
+  const size_t n = size();
+  auto &positions = m_positions.access();
+  auto &rotations = m_rotations.access();
+  const size_t start = positions.size();
+  // Resize before copying, `source` may be this
+  positions.resize(start + n);
+  rotations.resize(start + n);
+  std::copy_n(source.m_positions->begin() + offset, n,
+              positions.begin() + start);
+  std::copy_n(source.m_rotations->begin() + offset, n,
+              rotations.begin() + start);
+  for (const auto &transformation : transformations) {
+    for (size_t i = start + transformation.begin;
+         i < start + transformation.end; ++i) {
+      positions[i] =
+          transformation.rotation * positions[i] + transformation.translation;
+      rotations[i] = (transformation.rotation * rotations[i]).normalized();
+    }
+  }
+  return n == 0 ? 0 : start / n;
+}
+
+/// Moves scan points referring to block 0 to a copy of it, so that time index
+/// 0 can be modified.
+void DetectorInfo::unshareFirstBlock() {
+  m_firstBlockShared = false;
+  const auto &scanPoints = *m_scanPoints;
+  if (std::none_of(scanPoints.begin(), scanPoints.end(),
+                   [](const ScanPoint &scanPoint) {
+                     return !scanPoint.ownsBlock && scanPoint.block == 0;
+                   }))
+    return;
+  const auto copy = appendBlock(*this, 0, {});
+  for (auto &scanPoint : m_scanPoints.access())
+    if (!scanPoint.ownsBlock && scanPoint.block == 0)
+      scanPoint.block = copy;
+}
+
+/// Returns true if the positions and rotations stored in `other` at `offset`
+/// are those of time index 0 in this.
+bool DetectorInfo::hasFirstBlock(const DetectorInfo &other,
+                                 const size_t offset) const {
+  if (offset == 0 && m_positions == other.m_positions &&
+      m_rotations == other.m_rotations)
+    return true;
+  const size_t n = size();
+  return std::equal(m_positions->begin(), m_positions->begin() + n,
+                    other.m_positions->begin() + offset) &&
+         std::equal(m_rotations->begin(), m_rotations->begin() + n,
+                    other.m_rotations->begin() + offset,
+                    [](const Eigen::Quaterniond &a,
+                       const Eigen::Quaterniond &b) {
+                      return a.coeffs() == b.coeffs();
+                    });
+}
+
 /// Returns the scan count of the detector, reading it from m_componentInfo
 size_t DetectorInfo::scanCount() const { return m_componentInfo->scanCount(); }
 
@@ -191,21 +345,40 @@ void failMerge(const std::string &what) {
 void DetectorInfo::merge(const DetectorInfo &other,
                          const std::vector<bool> &merge) {
   checkSizes(other);
+  if (!m_scanPoints)
+    m_scanPoints = Kernel::make_cow<std::vector<ScanPoint>>();
   for (size_t timeIndex = 0; timeIndex < other.scanCount(); ++timeIndex) {
     if (!merge[timeIndex])
       continue;
     auto &isMasked = m_isMasked.access();
-    auto &positions = m_positions.access();
-    auto &rotations = m_rotations.access();
     const size_t indexStart = other.linearIndex({0, timeIndex});
     size_t indexEnd = indexStart + size();
     isMasked.insert(isMasked.end(), other.m_isMasked->begin() + indexStart,
                     other.m_isMasked->begin() + indexEnd);
-    positions.insert(positions.end(), other.m_positions->begin() + indexStart,
-                     other.m_positions->begin() + indexEnd);
-    rotations.insert(rotations.end(), other.m_rotations->begin() + indexStart,
-                     other.m_rotations->begin() + indexEnd);
+
+    // Time indices that differ from time index 0 of this only by moved banks
+    // refer to its storage instead of copying it
+    ScanPoint scanPoint;
+    size_t offset{0};
+    const Transformations *transformations{nullptr};
+    if (timeIndex > 0) {
+      const auto &otherScanPoint = (*other.m_scanPoints)[timeIndex - 1];
+      offset = otherScanPoint.block * size();
+      transformations = &otherScanPoint.transformations;
+    }
+    if (hasFirstBlock(other, offset)) {
+      if (transformations)
+        scanPoint.transformations = *transformations;
+      m_firstBlockShared = true;
+    } else {
+      scanPoint.block =
+          appendBlock(other, offset,
+                      transformations ? *transformations : Transformations{});
+      scanPoint.ownsBlock = true;
+    }
+    m_scanPoints.access().push_back(std::move(scanPoint));
   }
+  ++m_geometryRevision;
 }
 
 void DetectorInfo::setComponentInfo(ComponentInfo *componentInfo) {
@@ -216,6 +389,19 @@ bool DetectorInfo::hasComponentInfo() const {
   return m_componentInfo != nullptr;
 }
 
+/** Returns a counter that changes whenever the geometry seen by detectors
+ * changes, i.e., when detectors are moved or rotated, or, if a ComponentInfo
+ * is set, when any component is moved, rotated or rescaled.
+ *
+ * Intended for caching quantities derived from the geometry. The value is
+ * only meaningful for comparison with a previous value from the same object.
+ */
+size_t DetectorInfo::geometryRevision() const {
+  if (!hasComponentInfo())
+    return m_geometryRevision;
+  return m_geometryRevision + m_componentInfo->geometryRevision();
+}
+
 double DetectorInfo::l1() const {
   // TODO Not scan safe yet for scanning ComponentInfo
   if (!hasComponentInfo()) {
@@ -19,6 +19,28 @@ SpectrumInfo::SpectrumInfo(
     Kernel::cow_ptr<std::vector<SpectrumDefinition>> spectrumDefinition)
     : m_spectrumDefinition(std::move(spectrumDefinition)) {}
 
+SpectrumInfo::SpectrumInfo(const SpectrumInfo &other)
+    : m_spectrumDefinition(other.m_spectrumDefinition),
+      m_spectrumDefinitionRevision(other.m_spectrumDefinitionRevision.load()) {
+}
+
+SpectrumInfo::SpectrumInfo(SpectrumInfo &&other)
+    : m_spectrumDefinition(std::move(other.m_spectrumDefinition)),
+      m_spectrumDefinitionRevision(other.m_spectrumDefinitionRevision.load()) {
+}
+
+SpectrumInfo &SpectrumInfo::operator=(const SpectrumInfo &other) {
+  m_spectrumDefinition = other.m_spectrumDefinition;
+  m_spectrumDefinitionRevision = other.m_spectrumDefinitionRevision.load();
+  return *this;
+}
+
+SpectrumInfo &SpectrumInfo::operator=(SpectrumInfo &&other) {
+  m_spectrumDefinition = std::move(other.m_spectrumDefinition);
+  m_spectrumDefinitionRevision = other.m_spectrumDefinitionRevision.load();
+  return *this;
+}
+
 /// Returns the size of the SpectrumInfo, i.e., the number of spectra.
 size_t SpectrumInfo::size() const {
   if (!m_spectrumDefinition)
@@ -36,6 +58,7 @@ SpectrumInfo::spectrumDefinition(const size_t index) const {
 void SpectrumInfo::setSpectrumDefinition(const size_t index,
                                          SpectrumDefinition def) {
   m_spectrumDefinition.access()[index] = std::move(def);
+  ++m_spectrumDefinitionRevision;
 }
 
 const Kernel::cow_ptr<std::vector<SpectrumDefinition>> &
@@ -43,5 +66,13 @@ SpectrumInfo::sharedSpectrumDefinitions() const {
   return m_spectrumDefinition;
 }
 
+/** Returns a counter that changes whenever a SpectrumDefinition is set.
+ *
+ * Caches derived from the spectrum definitions can compare it with the value
+ * they were computed for to detect that they are outdated. */
+size_t SpectrumInfo::spectrumDefinitionRevision() const {
+  return m_spectrumDefinitionRevision;
+}
+
 } // namespace Beamline
 } // namespace Mantid
@@ -1380,4 +1380,97 @@ public:
     // has not gone through any merge operations.
     TS_ASSERT(!d.isEquivalent(f));
   }
+
+  void test_setRotation_of_merged_scan_point_moves_detectors() {
+    PosVec pos = {Eigen::Vector3d{1, 0, 0}, Eigen::Vector3d{0, 1, 0},
+                  Eigen::Vector3d{0, 0, 1}};
+    auto infos1 = makeFlatTree(pos, RotVec(3, Eigen::Quaterniond::Identity()));
+    auto infos2 = makeFlatTree(pos, RotVec(3, Eigen::Quaterniond::Identity()));
+    ComponentInfo &a = *std::get<0>(infos1);
+    ComponentInfo &b = *std::get<0>(infos2);
+    const DetectorInfo &detectorInfo = *std::get<1>(infos1);
+    a.setScanInterval({0, 1});
+    b.setScanInterval({1, 2});
+    a.merge(b);
+    a.setPosition({a.root(), 1}, Eigen::Vector3d{0, 0, 1});
+    const Eigen::Quaterniond rot(
+        Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitY()));
+    a.setRotation({a.root(), 1}, rot);
+
+    for (size_t i = 0; i < pos.size(); ++i) {
+      TS_ASSERT(detectorInfo.position({i, 0}).isApprox(pos[i]));
+      TS_ASSERT(detectorInfo.rotation({i, 0}).isApprox(
+          Eigen::Quaterniond::Identity()));
+      // Rotated about the root at z = 1
+      const Eigen::Vector3d expected =
+          rot * pos[i] + Eigen::Vector3d{0, 0, 1};
+      TS_ASSERT(detectorInfo.position({i, 1}).isApprox(expected));
+      TS_ASSERT(detectorInfo.rotation({i, 1}).isApprox(rot));
+    }
+    TS_ASSERT(a.position({a.root(), 1}).isApprox(Eigen::Vector3d{0, 0, 1}));
+  }
+
+  void test_moving_time_index_0_does_not_move_merged_scan_points() {
+    PosVec pos = {Eigen::Vector3d{1, 0, 0}, Eigen::Vector3d{0, 1, 0}};
+    auto infos1 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    auto infos2 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    ComponentInfo &a = *std::get<0>(infos1);
+    ComponentInfo &b = *std::get<0>(infos2);
+    DetectorInfo &detectorInfo = *std::get<1>(infos1);
+    a.setScanInterval({0, 1});
+    b.setScanInterval({1, 2});
+    a.merge(b);
+    a.setPosition({a.root(), 1}, Eigen::Vector3d{0, 0, 2});
+    a.setPosition({a.root(), 0}, Eigen::Vector3d{0, 0, 1});
+    detectorInfo.setPosition({1, 0}, Eigen::Vector3d{5, 5, 5});
+
+    TS_ASSERT(detectorInfo.position({0, 0}).isApprox(Eigen::Vector3d{1, 0, 1}));
+    TS_ASSERT_EQUALS(detectorInfo.position({1, 0}), Eigen::Vector3d(5, 5, 5));
+    TS_ASSERT(detectorInfo.position({0, 1}).isApprox(Eigen::Vector3d{1, 0, 2}));
+    TS_ASSERT(detectorInfo.position({1, 1}).isApprox(Eigen::Vector3d{0, 1, 2}));
+  }
+
+  void test_setting_detector_of_moved_scan_point_keeps_other_detectors() {
+    PosVec pos = {Eigen::Vector3d{1, 0, 0}, Eigen::Vector3d{0, 1, 0}};
+    auto infos1 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    auto infos2 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    auto infos3 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    ComponentInfo &a = *std::get<0>(infos1);
+    ComponentInfo &b = *std::get<0>(infos2);
+    ComponentInfo &c = *std::get<0>(infos3);
+    DetectorInfo &detectorInfo = *std::get<1>(infos1);
+    a.setScanInterval({0, 1});
+    b.setScanInterval({1, 2});
+    c.setScanInterval({2, 3});
+    a.merge(b);
+    a.merge(c);
+    a.setPosition({a.root(), 1}, Eigen::Vector3d{0, 0, 1});
+    a.setPosition({a.root(), 2}, Eigen::Vector3d{0, 0, 2});
+    detectorInfo.setPosition({0, 1}, Eigen::Vector3d{5, 5, 5});
+
+    TS_ASSERT_EQUALS(detectorInfo.position({0, 1}), Eigen::Vector3d(5, 5, 5));
+    TS_ASSERT(detectorInfo.position({1, 1}).isApprox(Eigen::Vector3d{0, 1, 1}));
+    TS_ASSERT(detectorInfo.position({0, 2}).isApprox(Eigen::Vector3d{1, 0, 2}));
+    TS_ASSERT(detectorInfo.position({1, 2}).isApprox(Eigen::Vector3d{0, 1, 2}));
+  }
+
+  void test_moved_scan_points_are_equivalent_to_merged_moved_beamlines() {
+    PosVec pos = {Eigen::Vector3d{1, 0, 0}, Eigen::Vector3d{0, 1, 0}};
+    auto infos1 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    auto infos2 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    auto infos3 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    ComponentInfo &a = *std::get<0>(infos1);
+    ComponentInfo &b = *std::get<0>(infos2);
+    ComponentInfo &c = *std::get<0>(infos3);
+    const Eigen::Quaterniond rot(
+        Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY()));
+    a.setScanInterval({0, 1});
+    b.setScanInterval({1, 2});
+    c.setScanInterval({0, 1});
+    a.merge(b);
+    a.setRotation({a.root(), 1}, rot);
+    b.setRotation(b.root(), rot);
+    c.merge(b);
+    TS_ASSERT(std::get<1>(infos1)->isEquivalent(*std::get<1>(infos3)));
+  }
 };
@@ -274,6 +274,51 @@ public:
     TS_ASSERT_EQUALS(info.rotation(0).coeffs(), rot.normalized().coeffs());
   }
 
+  void test_geometryRevision_changes_on_setPosition_and_setRotation() {
+    DetectorInfo info(PosVec(1), RotVec(1));
+    const auto initial = info.geometryRevision();
+    info.setPosition(0, Eigen::Vector3d{1, 2, 3});
+    const auto moved = info.geometryRevision();
+    TS_ASSERT_DIFFERS(moved, initial);
+    info.setRotation(0, Eigen::Quaterniond{1, 2, 3, 4});
+    TS_ASSERT_DIFFERS(info.geometryRevision(), moved);
+    // Masking does not affect the geometry
+    const auto rotated = info.geometryRevision();
+    info.setMasked(0, true);
+    TS_ASSERT_EQUALS(info.geometryRevision(), rotated);
+  }
+
+  void test_transformDetectors() {
+    PosVec pos{Eigen::Vector3d{1, 0, 0}, Eigen::Vector3d{0, 1, 0},
+               Eigen::Vector3d{0, 0, 1}};
+    DetectorInfo info(pos, RotVec(3, Eigen::Quaterniond::Identity()));
+    const Eigen::Quaterniond rot(
+        Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitZ()));
+    const auto initial = info.geometryRevision();
+    info.transformDetectors(1, 3, 0, rot, Eigen::Vector3d{0, 0, 1});
+    TS_ASSERT_DIFFERS(info.geometryRevision(), initial);
+    TS_ASSERT_EQUALS(info.position(0), pos[0]);
+    TS_ASSERT(info.position(1).isApprox(Eigen::Vector3d{-1, 0, 1}));
+    TS_ASSERT(info.position(2).isApprox(Eigen::Vector3d{0, 0, 2}));
+    TS_ASSERT(info.rotation(0).isApprox(Eigen::Quaterniond::Identity()));
+    TS_ASSERT(info.rotation(1).isApprox(rot));
+    TS_ASSERT(info.rotation(2).isApprox(rot));
+  }
+
+  void test_transformDetectors_invalid_indices() {
+    DetectorInfo info(PosVec(2), RotVec(2));
+    const auto rot = Eigen::Quaterniond::Identity();
+    TS_ASSERT_THROWS(
+        info.transformDetectors(0, 3, 0, rot, Eigen::Vector3d{0, 0, 1}),
+        const std::out_of_range &);
+    TS_ASSERT_THROWS(
+        info.transformDetectors(2, 1, 0, rot, Eigen::Vector3d{0, 0, 1}),
+        const std::out_of_range &);
+    TS_ASSERT_THROWS(
+        info.transformDetectors(0, 2, 1, rot, Eigen::Vector3d{0, 0, 1}),
+        const std::out_of_range &);
+  }
+
   void test_scanCount() {
     DetectorInfo detInfo;
     Mantid::Beamline::ComponentInfo compInfo;
@@ -81,6 +81,13 @@ public:
     TS_ASSERT_EQUALS(def.size(), 1);
   }
 
+  void test_setSpectrumDefinition_changes_revision() {
+    SpectrumInfo info(3);
+    const auto revision = info.spectrumDefinitionRevision();
+    info.setSpectrumDefinition(1, SpectrumDefinition{});
+    TS_ASSERT_DIFFERS(info.spectrumDefinitionRevision(), revision);
+  }
+
   void test_setSpectrumDefinition_move() {
     SpectrumDefinition def;
     def.add(7, 5);
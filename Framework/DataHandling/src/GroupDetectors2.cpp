@@ -20,6 +20,7 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/StringTokenizer.h"
 #include "MantidKernel/Strings.h"
 #include "MantidTypes/SpectrumDefinition.h"
@@ -29,6 +30,8 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/regex.hpp>
 
+#include <algorithm>
+
 namespace Mantid {
 namespace DataHandling {
 // Register the algorithm into the algorithm factory
@@ -1082,57 +1085,68 @@ GroupDetectors2::formGroupsEvent(DataObjects::EventWorkspace_const_sptr inputWS,
   g_log.debug() << name() << ": Preparing to group spectra into "
                 << m_GroupWsInds.size() << " groups\n";
 
-  // where we are copying spectra to, we start copying to the start of the
-  // output workspace
-  size_t outIndex = 0;
+  // The groups are independent so they are formed in parallel, group i going
+  // to output workspace index i
+  std::vector<storage_map::const_iterator> groups;
+  groups.reserve(m_GroupWsInds.size());
+  for (auto it = m_GroupWsInds.cbegin(); it != m_GroupWsInds.cend(); ++it)
+    groups.emplace_back(it);
+  const auto numGroups = static_cast<int64_t>(groups.size());
   // Only used for averaging behaviour. We may have a 1:1 map where a Divide
   // would be waste as it would be just dividing by 1
-  bool requireDivide(false);
+  std::vector<char> requireDivideGroup(groups.size(), false);
   const auto &spectrumInfo = inputWS->spectrumInfo();
-  for (storage_map::const_iterator it = m_GroupWsInds.begin();
-       it != m_GroupWsInds.end(); ++it) {
+  PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
+  for (int64_t outIndex = 0; outIndex < numGroups; ++outIndex) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto &group = *groups[outIndex];
     // This is the grouped spectrum
     EventList &outEL = outputWS->getSpectrum(outIndex);
 
     // The spectrum number of the group is the key
-    outEL.setSpectrumNo(it->first);
+    outEL.setSpectrumNo(group.first);
     // Start fresh with no detector IDs
     outEL.clearDetectorIDs();
 
-    // the Y values and errors from spectra being grouped are combined in the
-    // output spectrum
+    // the events from spectra being grouped are combined in the output
+    // spectrum, which also takes a union of the detector IDs.
     // Keep track of number of detectors required for masking
     size_t nonMaskedSpectra(0);
     beh->mutableX(outIndex)[0] = 0.0;
     beh->mutableE(outIndex)[0] = 0.0;
-    for (auto originalWI : it->second) {
-      const EventList &fromEL = inputWS->getSpectrum(originalWI);
-      // Add the event lists with the operator
-      outEL += fromEL;
-
-      // detectors to add to the output spectrum
-      outEL.addDetectorIDs(fromEL.getDetectorIDs());
+    std::vector<const EventList *> fromELs;
+    fromELs.reserve(group.second.size());
+    for (auto originalWI : group.second) {
+      fromELs.emplace_back(&inputWS->getSpectrum(originalWI));
       if (!spectrumInfo.hasDetectors(originalWI) ||
           !spectrumInfo.isMasked(originalWI)) {
         ++nonMaskedSpectra;
       }
     }
+    // A k-way merge keeps the events sorted if the inputs are
+    outEL.mergeEventLists(fromELs);
     if (nonMaskedSpectra == 0)
       ++nonMaskedSpectra; // Avoid possible divide by zero
-    if (!requireDivide)
-      requireDivide = (nonMaskedSpectra > 1);
+    requireDivideGroup[outIndex] = (nonMaskedSpectra > 1);
     beh->mutableY(outIndex)[0] = static_cast<double>(nonMaskedSpectra);
 
     // make regular progress reports and check for cancelling the algorithm
     if (outIndex % INTERVAL == 0) {
-      m_FracCompl += INTERVAL * prog4Copy;
-      if (m_FracCompl > 1.0)
-        m_FracCompl = 1.0;
-      progress(m_FracCompl);
+      PARALLEL_CRITICAL(GroupDetectors2_formGroupsEvent) {
+        m_FracCompl += INTERVAL * prog4Copy;
+        if (m_FracCompl > 1.0)
+          m_FracCompl = 1.0;
+        progress(m_FracCompl);
+      }
       interruption_point();
     }
-    outIndex++;
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
+  const size_t outIndex = groups.size();
+  const bool requireDivide =
+      std::any_of(requireDivideGroup.cbegin(), requireDivideGroup.cend(),
+                  [](const char required) { return required != 0; });
 
   if (bhv == 1 && requireDivide) {
     g_log.debug() << "Running Divide algorithm to perform averaging.\n";
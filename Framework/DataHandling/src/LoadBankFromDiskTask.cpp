@@ -9,6 +9,7 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/Tracing.h"
 #include "MantidKernel/Unit.h"
 #include <algorithm>
 
@@ -350,6 +351,7 @@ void LoadBankFromDiskTask::run() {
   std::vector<uint64_t> event_index;
 
   // Open the file
+  Kernel::TraceSpan traceSpan(Kernel::Tracing::Category::IO, entry_name);
   ::NeXus::File file(m_loader.alg->m_filename);
   try {
     // Navigate into the file
@@ -425,6 +427,15 @@ void LoadBankFromDiskTask::run() {
   // Close up the file even if errors occured.
   file.closeGroup();
   file.close();
+  if (!m_loadError) {
+    const auto numLoaded = static_cast<uint64_t>(m_loadSize[0]);
+    const size_t eventSize = sizeof(uint32_t) + sizeof(float) +
+                             (m_have_weight ? sizeof(float) : 0);
+    traceSpan.addBytes(event_index.size() * sizeof(uint64_t) +
+                       numLoaded * eventSize);
+    traceSpan.addEvents(numLoaded);
+  }
+  traceSpan.stop();
 
   // Abort if anything failed
   if (m_loadError) {
@@ -11,6 +11,7 @@
 #include "MantidAPI/Progress.h"
 #include "MantidDataHandling/LoadGeometry.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/InstrumentCache.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ConfigService.h"
@@ -211,9 +212,15 @@ void LoadInstrument::exec() {
     } else {
 
       if (loader_type < LoaderType::Nxs) {
-        // Really create the instrument
-        Progress prog(this, 0.0, 1.0, 100);
-        instrument = parser.parseXML(&prog);
+        // Use an instrument built by an earlier process if there is one
+        const InstrumentCache cache;
+        instrument = cache.load(instrumentNameMangled);
+        if (!instrument) {
+          // Really create the instrument
+          Progress prog(this, 0.0, 1.0, 100);
+          instrument = parser.parseXML(&prog);
+          cache.save(*instrument, instrumentNameMangled);
+        }
         // Parse the instrument tree (internally create ComponentInfo and
         // DetectorInfo). This is an optimization that avoids duplicate parsing
         // of the instrument tree when loading multiple workspaces with the same
@@ -78,7 +78,7 @@ void SaveParameterFile::exec() {
   const Instrument_const_sptr instrument = ws->getInstrument();
   // Create legacy parameter map with positions and other parameters extracted
   // from DetectorInfo.
-  const ParameterMap_sptr params = instrument->makeLegacyParameterMap();
+  const ParameterMap_const_sptr params = instrument->makeLegacyParameterMap();
 
   // maps components to a tuple of parameters' name, type, and value
   std::map<ComponentID,
@@ -89,7 +89,7 @@ void SaveParameterFile::exec() {
   Progress prog(this, 0.0, 0.3, params->size());
 
   // Build a list of parameters to save;
-  for (auto &paramsIt : *params) {
+  for (const auto &paramsIt : *params) {
     if (prog.hasCancellationBeenRequested())
       break;
     prog.report("Generating parameters");
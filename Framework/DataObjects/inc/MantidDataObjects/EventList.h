@@ -23,6 +23,7 @@ class DateAndTime;
 namespace Kernel {
 class SplittingInterval;
 using TimeSplitterType = std::vector<SplittingInterval>;
+class TimeSplitter;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
@@ -89,6 +90,8 @@ public:
 
   EventList &operator+=(const EventList &more_events);
 
+  void mergeEventLists(const std::vector<const EventList *> &more_events);
+
   EventList &operator-=(const EventList &more_events);
 
   bool operator==(const EventList &rhs) const;
@@ -296,6 +299,11 @@ public:
                        std::map<int, EventList *> outputs, bool docorrection,
                        double toffactor, double tofshift) const;
 
+  /// Split events by full time with a TimeSplitter
+  void splitByFullTime(const Kernel::TimeSplitter &splitter,
+                       std::map<int, EventList *> outputs, bool docorrection,
+                       double toffactor, double tofshift) const;
+
   /// Split ...
   std::string
   splitByFullTimeMatrixSplitter(const std::vector<int64_t> &vec_splitters_time,
@@ -308,6 +316,10 @@ public:
   void splitByPulseTime(Kernel::TimeSplitterType &splitter,
                         std::map<int, EventList *> outputs) const;
 
+  /// Split events by pulse time with a TimeSplitter
+  void splitByPulseTime(const Kernel::TimeSplitter &splitter,
+                        std::map<int, EventList *> outputs) const;
+
   /// Split events by pulse time with Matrix splitters
   void splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times,
                                   const std::vector<int> &vec_target,
@@ -412,6 +424,10 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  template <class T>
+  static void mergeEvents(std::vector<T> &events,
+                          const std::vector<const EventList *> &sources,
+                          const EventSortType mergeOrder);
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                              const double seconds) const;
@@ -494,6 +510,8 @@ private:
   template <class T>
   void filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
                            typename std::vector<T> &events);
+  void prepareSplitOutputs(const std::map<int, EventList *> &outputs) const;
+  void copyToUnfilteredOutput(const std::map<int, EventList *> &outputs) const;
   template <class T>
   void splitByTimeHelper(Kernel::TimeSplitterType &splitter,
                          std::vector<EventList *> outputs,
@@ -12,6 +12,7 @@
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/TimeSplitter.h"
 #include "MantidKernel/Unit.h"
 
 #ifdef _MSC_VER
@@ -23,11 +24,15 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 using std::ostream;
 using std::runtime_error;
@@ -60,6 +65,53 @@ int64_t calculateCorrectedFullTime(const EventType &event,
                               (tofShift * 1.0E9));
 }
 
+/**
+ * Copy each event to the output for the destination of its time in a
+ * splitter, or to the output with index -1 if the time is before the first
+ * interval or between intervals. Events from the end of the last interval
+ * onwards, whatever its destination, and events without an output are
+ * dropped. The events are mostly in time order so the interval of the
+ * previous event is tried before searching.
+ * @param splitter : The splitter giving the destination of each time
+ * @param outputs : The output event lists by destination
+ * @param events : The events to split
+ * @param eventTime : Function returning the time of an event in nanoseconds
+ */
+template <typename EventType, typename TimeFunction>
+void splitEventsByTimeSplitter(const Kernel::TimeSplitter &splitter,
+                               const std::map<int, EventList *> &outputs,
+                               const std::vector<EventType> &events,
+                               TimeFunction eventTime) {
+  const auto &times = splitter.boundaries();
+  const auto &targets = splitter.targets();
+  const auto coverageEnd = splitter.coverageEnd();
+  // The interval [intervalStart, intervalStop) of the previous event
+  auto intervalStart = std::numeric_limits<int64_t>::max();
+  auto intervalStop = std::numeric_limits<int64_t>::min();
+  EventList *output = nullptr;
+  for (const auto &event : events) {
+    const int64_t time = eventTime(event);
+    if (time >= coverageEnd)
+      continue;
+    if (time < intervalStart || time >= intervalStop) {
+      const auto next = std::upper_bound(times.cbegin(), times.cend(), time);
+      intervalStop = next == times.cend() ? std::numeric_limits<int64_t>::max()
+                                          : *next;
+      int target = Kernel::TimeSplitter::NO_TARGET;
+      if (next == times.cbegin()) {
+        intervalStart = std::numeric_limits<int64_t>::min();
+      } else {
+        intervalStart = *std::prev(next);
+        target = targets[std::distance(times.cbegin(), next) - 1];
+      }
+      const auto found = outputs.find(target);
+      output = found == outputs.end() ? nullptr : found->second;
+    }
+    if (output)
+      output->addEventQuickly(event);
+  }
+}
+
 /**
  * Type for comparing events in terms of time at sample
  */
@@ -521,6 +573,199 @@ EventList &EventList::operator+=(const EventList &more_events) {
   return *this;
 }
 
+namespace {
+/** Get a range over a vector of events as a given event type. Events of a
+ * narrower type are converted into a new vector kept alive by `converted`.
+ *
+ * @tparam T :: the event type of the range
+ * @param events :: the events
+ * @param converted :: storage for converted copies of the events
+ * @return a pair of pointers to the first and one past the last event
+ */
+template <class T, class S>
+std::pair<const T *, const T *>
+eventRange(const std::vector<S> &events,
+           std::vector<std::vector<T>> &converted) {
+  if constexpr (std::is_same<T, S>::value) {
+    return {events.data(), events.data() + events.size()};
+  } else if constexpr (std::is_constructible<T, S>::value) {
+    converted.emplace_back(events.cbegin(), events.cend());
+    const auto &copy = converted.back();
+    return {copy.data(), copy.data() + copy.size()};
+  } else {
+    // The output always has the widest event type of the sources
+    throw std::runtime_error("EventList: cannot merge weighted events into "
+                             "a list of a narrower event type.");
+  }
+}
+
+/** Append the merge of several sorted ranges of events to a vector. The
+ * ranges are kept in a min-heap keyed on their first remaining event, so that
+ * merging M events from K ranges takes O(M log K) comparisons.
+ *
+ * @param ranges :: the sorted ranges; consumed by the merge
+ * @param out :: the vector the merged events are appended to
+ * @param compare :: the ordering all the ranges are sorted by
+ */
+template <class T, class Compare>
+void mergeSortedRanges(std::vector<std::pair<const T *, const T *>> &ranges,
+                       std::vector<T> &out, Compare compare) {
+  const auto laterFront = [&ranges, &compare](const size_t a,
+                                              const size_t b) {
+    return compare(*ranges[b].first, *ranges[a].first);
+  };
+  std::vector<size_t> heap;
+  heap.reserve(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (ranges[i].first != ranges[i].second)
+      heap.emplace_back(i);
+  }
+  std::make_heap(heap.begin(), heap.end(), laterFront);
+  while (heap.size() > 1) {
+    std::pop_heap(heap.begin(), heap.end(), laterFront);
+    auto &range = ranges[heap.back()];
+    out.emplace_back(*range.first);
+    if (++range.first == range.second)
+      heap.pop_back();
+    else
+      std::push_heap(heap.begin(), heap.end(), laterFront);
+  }
+  // The last range left is copied in one go
+  if (!heap.empty())
+    out.insert(out.end(), ranges[heap.front()].first,
+               ranges[heap.front()].second);
+}
+
+/** Whether lists sorted in the given order can be merged into a list of the
+ * given event type without losing that order.
+ */
+bool isMergeableOrder(const EventSortType order, const EventType eventType) {
+  switch (order) {
+  case TOF_SORT:
+    return true;
+  case PULSETIME_SORT:
+  case PULSETIMETOF_SORT:
+    // Events without pulse times cannot be ordered by them
+    return eventType != WEIGHTED_NOTIME;
+  default:
+    return false;
+  }
+}
+} // namespace
+
+// --------------------------------------------------------------------------
+/** Append several EventLists to this event list at once.
+ * The result is the same as adding each list in turn with operator+=, but the
+ * storage is allocated only once. If this list and all the non-empty incoming
+ * lists are sorted by TOF, pulse time or pulse time and TOF, a k-way merge is
+ * done instead of a plain concatenation so that the result remains sorted.
+ * Otherwise the result is unsorted.
+ *
+ * @param more_events :: The EventLists to append.
+ */
+void EventList::mergeEventLists(
+    const std::vector<const EventList *> &more_events) {
+  // The result has the widest event type of all the lists
+  EventType outputType = this->eventType;
+  std::vector<const EventList *> sources;
+  sources.reserve(more_events.size() + 1);
+  if (!this->empty())
+    sources.emplace_back(this);
+  for (const auto *other : more_events) {
+    outputType = std::max(outputType, other->getEventType());
+    if (!other->empty())
+      sources.emplace_back(other);
+  }
+
+  EventSortType mergeOrder = UNSORTED;
+  const auto commonOrder = sources.empty() ? UNSORTED : sources.front()->order;
+  if (isMergeableOrder(commonOrder, outputType) &&
+      std::all_of(sources.cbegin(), sources.cend(),
+                  [commonOrder](const EventList *source) {
+                    return source->order == commonOrder;
+                  }))
+    mergeOrder = commonOrder;
+
+  this->switchTo(outputType);
+  switch (outputType) {
+  case TOF:
+    mergeEvents(this->events, sources, mergeOrder);
+    break;
+  case WEIGHTED:
+    mergeEvents(this->weightedEvents, sources, mergeOrder);
+    break;
+  case WEIGHTED_NOTIME:
+    mergeEvents(this->weightedEventsNoTime, sources, mergeOrder);
+    break;
+  }
+  this->order = mergeOrder;
+
+  for (const auto *other : more_events)
+    addDetectorIDs(other->getDetectorIDs());
+}
+
+// --------------------------------------------------------------------------
+/** Replace a vector of events by the concatenation, or the merge if they are
+ * sorted, of the events of several lists.
+ *
+ * @tparam T :: TofEvent, WeightedEvent or WeightedEventNoTime
+ * @param events :: The event vector to fill; may be one of the sources.
+ * @param sources :: The non-empty lists to take the events from.
+ * @param mergeOrder :: The order all the sources are sorted by, or UNSORTED.
+ */
+template <class T>
+void EventList::mergeEvents(std::vector<T> &events,
+                            const std::vector<const EventList *> &sources,
+                            const EventSortType mergeOrder) {
+  std::vector<std::vector<T>> converted;
+  converted.reserve(sources.size());
+  std::vector<std::pair<const T *, const T *>> ranges;
+  ranges.reserve(sources.size());
+  size_t numEvents = 0;
+  for (const auto *source : sources) {
+    switch (source->eventType) {
+    case TOF:
+      ranges.emplace_back(eventRange<T>(source->events, converted));
+      break;
+    case WEIGHTED:
+      ranges.emplace_back(eventRange<T>(source->weightedEvents, converted));
+      break;
+    case WEIGHTED_NOTIME:
+      ranges.emplace_back(
+          eventRange<T>(source->weightedEventsNoTime, converted));
+      break;
+    }
+    numEvents += static_cast<size_t>(ranges.back().second -
+                                     ranges.back().first);
+  }
+
+  std::vector<T> merged;
+  merged.reserve(numEvents);
+  switch (mergeOrder) {
+  case TOF_SORT:
+    mergeSortedRanges(ranges, merged, [](const T &e1, const T &e2) {
+      return e1.tof() < e2.tof();
+    });
+    break;
+  case PULSETIME_SORT:
+    mergeSortedRanges(ranges, merged, [](const T &e1, const T &e2) {
+      return e1.pulseTime() < e2.pulseTime();
+    });
+    break;
+  case PULSETIMETOF_SORT:
+    mergeSortedRanges(ranges, merged, [](const T &e1, const T &e2) {
+      return e1.pulseTime() < e2.pulseTime() ||
+             (e1.pulseTime() == e2.pulseTime() && e1.tof() < e2.tof());
+    });
+    break;
+  default:
+    for (const auto &range : ranges)
+      merged.insert(merged.end(), range.first, range.second);
+    break;
+  }
+  events.swap(merged);
+}
+
 // --------------------------------------------------------------------------
 /** SUBTRACT another EventList from this event list.
  * The event lists are concatenated, but the weights of the incoming
@@ -4663,6 +4908,119 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Clear the outputs of a split and give them the detector IDs, histogram and
+ * event type of this list
+ * @param outputs :: the output event lists
+ */
+void EventList::prepareSplitOutputs(
+    const std::map<int, EventList *> &outputs) const {
+  for (const auto &output : outputs) {
+    EventList *opeventlist = output.second;
+    opeventlist->clear();
+    opeventlist->setDetectorIDs(this->getDetectorIDs());
+    opeventlist->setHistogram(m_histogram);
+    // Match the output event type.
+    opeventlist->switchTo(eventType);
+  }
+}
+
+/// Copies all events to the output with index -1, if there is one.
+void EventList::copyToUnfilteredOutput(
+    const std::map<int, EventList *> &outputs) const {
+  const auto unfiltered = outputs.find(-1);
+  if (unfiltered != outputs.end())
+    *unfiltered->second = *this;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Split the event list into outputs by event's full time (tof + pulse time).
+ * Unlike the TimeSplitterType overload, each event is looked up in the
+ * splitter so the cost does not grow with the number of intervals. As there,
+ * events before the first interval or between intervals go to the output with
+ * index -1 and events after the last interval are dropped. A splitter without
+ * any interval puts all events in the output with index -1.
+ *
+ * @param splitter :: a TimeSplitter giving where to split
+ * @param outputs :: a map of where the split events will end up
+ * @param docorrection :: a boolean to indiciate whether it is need to do
+ *correction
+ * @param toffactor:  a correction factor for each TOF to multiply with
+ * @param tofshift:  a correction shift for each TOF to add with
+ */
+void EventList::splitByFullTime(const Kernel::TimeSplitter &splitter,
+                                std::map<int, EventList *> outputs,
+                                bool docorrection, double toffactor,
+                                double tofshift) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
+
+  this->sortPulseTimeTOF();
+  prepareSplitOutputs(outputs);
+  if (!splitter.hasCoverage()) {
+    copyToUnfilteredOutput(outputs);
+    return;
+  }
+
+  const auto fullTime = [docorrection, toffactor,
+                         tofshift](const auto &event) -> int64_t {
+    if (docorrection)
+      return calculateCorrectedFullTime(event, toffactor, tofshift);
+    return event.pulseTime().totalNanoseconds() +
+           static_cast<int64_t>(event.tof() * 1000);
+  };
+  switch (eventType) {
+  case TOF:
+    splitEventsByTimeSplitter(splitter, outputs, this->events, fullTime);
+    break;
+  case WEIGHTED:
+    splitEventsByTimeSplitter(splitter, outputs, this->weightedEvents,
+                              fullTime);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Split the event list into outputs by each event's pulse time only.
+ * Events before the first interval of the splitter or between its intervals go
+ * to the output with index -1, events after the last interval are dropped. A
+ * splitter without any interval puts all events in the output with index -1.
+ *
+ * @param splitter :: a TimeSplitter giving where to split
+ * @param outputs :: a map of where the split events will end up
+ */
+void EventList::splitByPulseTime(const Kernel::TimeSplitter &splitter,
+                                 std::map<int, EventList *> outputs) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
+
+  this->sortPulseTimeTOF();
+  prepareSplitOutputs(outputs);
+  if (!splitter.hasCoverage()) {
+    copyToUnfilteredOutput(outputs);
+    return;
+  }
+
+  const auto pulseTime = [](const auto &event) {
+    return event.pulseTime().totalNanoseconds();
+  };
+  switch (eventType) {
+  case TOF:
+    splitEventsByTimeSplitter(splitter, outputs, this->events, pulseTime);
+    break;
+  case WEIGHTED:
+    splitEventsByTimeSplitter(splitter, outputs, this->weightedEvents,
+                              pulseTime);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Split the event list by pulse time
  */
@@ -22,6 +22,7 @@
 #include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/IPropertyManager.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ParallelFor.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
 #include "tbb/parallel_for.h"
@@ -701,16 +702,15 @@ void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
   // Start with empty vector
   out.resize(this->getNumberHistograms(), 0.0);
 
-  // We can run in parallel since there is no cross-reading of event lists
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int wksp_index = 0; wksp_index < int(this->getNumberHistograms());
-       wksp_index++) {
-    // Get Handle to data
-    EventList *el = this->data[wksp_index].get();
-
+  // We can run in parallel since there is no cross-reading of event lists.
+  // The cost of each spectrum is proportional to its number of events.
+  std::vector<size_t> numEvents(data.size());
+  std::transform(data.cbegin(), data.cend(), numEvents.begin(),
+                 [](const auto &el) { return el->getNumberEvents(); });
+  Kernel::parallelForWeighted(numEvents, [&](const size_t wksp_index) {
     // Let the eventList do the integration
-    out[wksp_index] = el->integrate(minX, maxX, entireRange);
-  }
+    out[wksp_index] = data[wksp_index]->integrate(minX, maxX, entireRange);
+  });
 }
 
 } // namespace DataObjects
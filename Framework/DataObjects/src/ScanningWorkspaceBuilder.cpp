@@ -263,18 +263,27 @@ void ScanningWorkspaceBuilder::buildPositions(
 
 void ScanningWorkspaceBuilder::buildRelativeRotationsForScans(
     Geometry::DetectorInfo &outputDetectorInfo) const {
-  for (size_t i = 0; i < outputDetectorInfo.size(); ++i) {
-    for (size_t j = 0; j < outputDetectorInfo.scanCount(); ++j) {
-      if (outputDetectorInfo.isMonitor({i, j}))
+  // Rotating x about the rotation position c gives R x + (c - R c). Runs of
+  // non-monitor detectors are transformed together, which the scan stores
+  // without copying their positions and rotations.
+  for (size_t j = 0; j < outputDetectorInfo.scanCount(); ++j) {
+    const auto rotation = Kernel::Quat(m_instrumentAngles[j], m_rotationAxis);
+    auto rotatedPosition = m_rotationPosition;
+    rotation.rotate(rotatedPosition);
+    const auto translation = m_rotationPosition - rotatedPosition;
+    size_t begin = 0;
+    while (begin < outputDetectorInfo.size()) {
+      if (outputDetectorInfo.isMonitor(begin)) {
+        ++begin;
         continue;
-      auto position = outputDetectorInfo.position({i, j});
-      const auto rotation = Kernel::Quat(m_instrumentAngles[j], m_rotationAxis);
-      position -= m_rotationPosition;
-      rotation.rotate(position);
-      position += m_rotationPosition;
-      outputDetectorInfo.setPosition({i, j}, position);
-      const auto &oldRotation = outputDetectorInfo.rotation({i, j});
-      outputDetectorInfo.setRotation({i, j}, rotation * oldRotation);
+      }
+      auto end = begin + 1;
+      while (end < outputDetectorInfo.size() &&
+             !outputDetectorInfo.isMonitor(end))
+        ++end;
+      outputDetectorInfo.transformDetectors(begin, end, j, rotation,
+                                            translation);
+      begin = end;
     }
   }
 }
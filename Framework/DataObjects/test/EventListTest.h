@@ -11,6 +11,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/TimeSplitter.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/Unit.h"
 
@@ -381,6 +382,106 @@ public:
     }
   }
 
+  //==================================================================================
+  //--- Merging several lists at once ----
+  //==================================================================================
+
+  void test_mergeEventLists_keeps_tof_order() {
+    EventList lhs(el), rhs1, rhs2;
+    rhs1 += TofEvent(75, 1);
+    rhs1 += TofEvent(2, 2);
+    rhs1.addDetectorID(3);
+    rhs2 += TofEvent(60, 3);
+    rhs2.addDetectorID(4);
+    lhs.sortTof();
+    rhs1.sortTof();
+    rhs2.sortTof();
+
+    lhs.mergeEventLists({&rhs1, &rhs2});
+    TS_ASSERT_EQUALS(lhs.getSortType(), TOF_SORT);
+    TS_ASSERT_EQUALS(lhs.getNumberEvents(), 6);
+    const std::vector<double> expected{2, 3.5, 50, 60, 75, 100};
+    TS_ASSERT_EQUALS(lhs.getTofs(), expected);
+    TS_ASSERT(lhs.hasDetectorID(3));
+    TS_ASSERT(lhs.hasDetectorID(4));
+  }
+
+  void test_mergeEventLists_keeps_pulse_time_order() {
+    EventList lhs(el), rhs;
+    rhs += TofEvent(1, 300);
+    rhs += TofEvent(2, 50);
+    lhs.sortPulseTime();
+    rhs.sortPulseTime();
+
+    lhs.mergeEventLists({&rhs});
+    TS_ASSERT_EQUALS(lhs.getSortType(), PULSETIME_SORT);
+    const auto pulseTimes = lhs.getPulseTimes();
+    TS_ASSERT_EQUALS(pulseTimes.size(), 5);
+    TS_ASSERT(std::is_sorted(pulseTimes.cbegin(), pulseTimes.cend()));
+  }
+
+  void test_mergeEventLists_with_different_orders_concatenates() {
+    EventList lhs(el), rhs(el);
+    lhs.sortTof();
+    rhs.sortPulseTime();
+
+    lhs.mergeEventLists({&rhs});
+    TS_ASSERT_EQUALS(lhs.getSortType(), UNSORTED);
+    const std::vector<double> expected{3.5, 50, 100, 50, 100, 3.5};
+    TS_ASSERT_EQUALS(lhs.getTofs(), expected);
+  }
+
+  void test_mergeEventLists_of_unsorted_lists_is_unsorted() {
+    EventList lhs(el), rhs(el);
+    lhs.sortTof();
+
+    lhs.mergeEventLists({&rhs});
+    TS_ASSERT_EQUALS(lhs.getSortType(), UNSORTED);
+    TS_ASSERT_EQUALS(lhs.getNumberEvents(), 6);
+  }
+
+  void test_mergeEventLists_into_empty_list_keeps_order() {
+    EventList lhs, rhs(el);
+    rhs.sortPulseTimeTOF();
+
+    lhs.mergeEventLists({&rhs});
+    TS_ASSERT_EQUALS(lhs.getSortType(), PULSETIMETOF_SORT);
+    TS_ASSERT_EQUALS(lhs.getNumberEvents(), 3);
+  }
+
+  void test_mergeEventLists_without_pulse_times_drops_pulse_order() {
+    EventList lhs(el), rhs(el);
+    lhs.sortPulseTime();
+    rhs.switchTo(WEIGHTED_NOTIME);
+    rhs.sortPulseTime();
+
+    lhs.mergeEventLists({&rhs});
+    TS_ASSERT_EQUALS(lhs.getEventType(), WEIGHTED_NOTIME);
+    TS_ASSERT_EQUALS(lhs.getSortType(), UNSORTED);
+    TS_ASSERT_EQUALS(lhs.getNumberEvents(), 6);
+  }
+
+  void test_mergeEventLists_all_nine_type_combinations() {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        EventList lhs(el), rhs(el);
+        lhs.switchTo(static_cast<EventType>(i));
+        rhs.switchTo(static_cast<EventType>(j));
+        lhs.sortTof();
+        rhs.sortTof();
+
+        TS_ASSERT_THROWS_NOTHING(lhs.mergeEventLists({&rhs}));
+        // The same type as given by operator+=
+        TS_ASSERT_EQUALS(static_cast<int>(lhs.getEventType()), std::max(i, j));
+        TS_ASSERT_EQUALS(lhs.getSortType(), TOF_SORT);
+        TS_ASSERT_EQUALS(lhs.getNumberEvents(), 6);
+        TS_ASSERT_DELTA(lhs.getEvent(0).tof(), 3.5, 1e-5);
+        TS_ASSERT_DELTA(lhs.getEvent(5).tof(), 100, 1e-5);
+        TS_ASSERT_DELTA(lhs.integrate(0, 1e10, true), 6., 1e-5);
+      }
+    }
+  }
+
   //==================================================================================
   //--- Minus Operation ----
   //==================================================================================
@@ -1864,6 +1965,93 @@ public:
     }
   }
 
+  void test_split_TimeSplitter_events_before_first_and_after_last_interval() {
+    const DateAndTime before(int64_t{500000});
+    const DateAndTime inside(int64_t{1500000});
+    const DateAndTime after(int64_t{5000000});
+    std::map<int, EventList *> outputs;
+    outputs.emplace(0, new EventList());
+    outputs.emplace(-1, new EventList());
+    TimeSplitterType split;
+    split.emplace_back(1000000, 2000000, 0);
+
+    for (const bool byPulseTime : {false, true}) {
+      el = EventList();
+      el += TofEvent(1.0, before);
+      el += TofEvent(2.0, inside);
+      el += TofEvent(3.0, after);
+      if (byPulseTime)
+        el.splitByPulseTime(TimeSplitter(split), outputs);
+      else
+        el.splitByFullTime(TimeSplitter(split), outputs, false, 1.0, 0.0);
+
+      // Before the first interval goes to -1, after the last one is dropped
+      TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 1);
+      TS_ASSERT_EQUALS(outputs[-1]->getEvent(0).pulseTime(), before);
+      TS_ASSERT_EQUALS(outputs[0]->getNumberEvents(), 1);
+      TS_ASSERT_EQUALS(outputs[0]->getEvent(0).pulseTime(), inside);
+    }
+
+    for (auto &output : outputs) {
+      delete output.second;
+    }
+  }
+
+  void test_split_TimeSplitter_trailing_unfiltered_interval() {
+    const DateAndTime inside(int64_t{1500000});
+    const DateAndTime unfiltered(int64_t{2500000});
+    const DateAndTime after(int64_t{5000000});
+    std::map<int, EventList *> outputs;
+    outputs.emplace(0, new EventList());
+    outputs.emplace(-1, new EventList());
+    TimeSplitterType split;
+    split.emplace_back(1000000, 2000000, 0);
+    split.emplace_back(2000000, 3000000, -1);
+
+    for (const bool byPulseTime : {false, true}) {
+      el = EventList();
+      el += TofEvent(1.0, inside);
+      el += TofEvent(2.0, unfiltered);
+      el += TofEvent(3.0, after);
+      if (byPulseTime)
+        el.splitByPulseTime(TimeSplitter(split), outputs);
+      else
+        el.splitByFullTime(TimeSplitter(split), outputs, false, 1.0, 0.0);
+
+      // The explicit -1 interval is kept, only times after it are dropped
+      TS_ASSERT_EQUALS(outputs[0]->getNumberEvents(), 1);
+      TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 1);
+      TS_ASSERT_EQUALS(outputs[-1]->getEvent(0).pulseTime(), unfiltered);
+    }
+
+    for (auto &output : outputs) {
+      delete output.second;
+    }
+  }
+
+  void test_split_empty_TimeSplitter_keeps_all_events_unfiltered() {
+    std::map<int, EventList *> outputs;
+    outputs.emplace(0, new EventList());
+    outputs.emplace(-1, new EventList());
+
+    for (const bool byPulseTime : {false, true}) {
+      el = EventList();
+      el += TofEvent(1.0, DateAndTime(int64_t{500000}));
+      el += TofEvent(2.0, DateAndTime(int64_t{5000000}));
+      if (byPulseTime)
+        el.splitByPulseTime(TimeSplitter(), outputs);
+      else
+        el.splitByFullTime(TimeSplitter(), outputs, false, 1.0, 0.0);
+
+      TS_ASSERT_EQUALS(outputs[0]->getNumberEvents(), 0);
+      TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 2);
+    }
+
+    for (auto &output : outputs) {
+      delete output.second;
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test method to split events by full time (pulse + tof) withtout correction
    * on TOF
@@ -1917,6 +2105,43 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** Test method to split events by full time (pulse + tof) with a
+   * TimeSplitter
+   */
+  void test_splitByFullTime_TimeSplitter() {
+    fake_uniform_time_sns_data();
+
+    std::map<int, EventList *> outputs;
+    for (int i = 0; i < 10; i++)
+      outputs.emplace(i, new EventList());
+    outputs.emplace(-1, new EventList());
+
+    // Reject the odd pulses, keeping the even ones from pulse 1 to 9
+    TimeSplitterType split;
+    for (int i = 1; i < 10; i++)
+      split.emplace_back(i * 1000000, (i + 1) * 1000000, i % 2 ? -1 : i);
+
+    el.splitByFullTime(TimeSplitter(split), outputs, false, 1.0, 0.0);
+
+    TS_ASSERT_EQUALS(outputs[0]->getNumberEvents(), 0);
+    for (int i = 1; i < 10; i++) {
+      TS_ASSERT_EQUALS(outputs[i]->getNumberEvents(), (i % 2) ? 0 : 1);
+    }
+    // The first pulse and the odd pulses. Events after the last interval are
+    // dropped.
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 6);
+
+    // Splitting by pulse time gives the same result here
+    el.splitByPulseTime(TimeSplitter(split), outputs);
+    TS_ASSERT_EQUALS(outputs[4]->getNumberEvents(), 1);
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 6);
+
+    for (auto &output : outputs) {
+      delete output.second;
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test method to split events by full time (pulse + tof) withtout correction
    * on TOF
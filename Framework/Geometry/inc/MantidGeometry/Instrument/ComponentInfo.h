@@ -12,6 +12,7 @@
 #include "MantidGeometry/Objects/BoundingBox.h"
 #include "MantidKernel/DateAndTime.h"
 #include <boost/shared_ptr.hpp>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -32,6 +33,7 @@ class ComponentInfo;
 }
 
 namespace Geometry {
+class DetectorBVH;
 class Instrument;
 
 /** ComponentInfo : Provides a component centric view on to the instrument.
@@ -51,6 +53,11 @@ private:
   boost::shared_ptr<std::vector<boost::shared_ptr<const Geometry::IObject>>>
       m_shapes;
 
+  mutable std::mutex m_detectorBVHMutex;
+  /// Shared with copies, which hold the same shapes
+  mutable std::shared_ptr<const DetectorBVH> m_detectorBVH;
+  mutable size_t m_detectorBVHRevision = 0;
+
   BoundingBox componentBoundingBox(const size_t index,
                                    const BoundingBox *reference) const;
 
@@ -94,6 +101,7 @@ public:
   QuadrilateralComponent
   quadrilateralComponent(const size_t componentIndex) const;
   size_t indexOf(Geometry::IComponent *id) const;
+  bool hasComponent(Geometry::IComponent *id) const;
   size_t indexOfAny(const std::string &name) const;
   bool isDetector(const size_t componentIndex) const;
   Kernel::V3D position(const size_t componentIndex) const;
@@ -141,6 +149,7 @@ public:
                                        Types::Core::DateAndTime> &interval);
   size_t scanCount() const;
   void merge(const ComponentInfo &other);
+  const DetectorBVH &detectorBVH() const;
 
   ComponentInfoIterator<ComponentInfo> begin();
   ComponentInfoIterator<ComponentInfo> end();
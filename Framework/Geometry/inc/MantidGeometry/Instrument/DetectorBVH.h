@@ -0,0 +1,91 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/Quat.h"
+#include "MantidKernel/V3D.h"
+
+#include <limits>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class ComponentInfo;
+class IObject;
+
+/** DetectorBVH : a bounding volume hierarchy over the detectors of a
+  ComponentInfo, for finding the detector hit by a ray or containing a point
+  without walking the component tree.
+
+  The hierarchy is a flat array of nodes built from the bounding boxes of the
+  detectors in the frame of the instrument. Candidate detectors are tested
+  exactly against their shape, taking their position, rotation and scale
+  factor into account. Monitors are included; detectors without a valid
+  shape are not.
+
+  The hierarchy refers to the shapes held by the ComponentInfo it was built
+  from, which shares them with its copies, and must not outlive all of them.
+  It does not follow later changes of the geometry;
+  ComponentInfo::detectorBVH() rebuilds it when needed. The queries are
+  thread-safe.
+*/
+class MANTID_GEOMETRY_DLL DetectorBVH {
+public:
+  /// Returned by the queries when no detector is found
+  static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+  explicit DetectorBVH(const ComponentInfo &componentInfo);
+
+  /// @return the number of detectors in the hierarchy
+  size_t size() const { return m_detectors.size(); }
+
+  size_t findDetector(const Kernel::V3D &start,
+                      const Kernel::V3D &direction) const;
+  std::vector<size_t>
+  findDetectors(const Kernel::V3D &start,
+                const std::vector<Kernel::V3D> &directions) const;
+  size_t detectorContaining(const Kernel::V3D &point) const;
+  std::vector<size_t>
+  detectorsContaining(const std::vector<Kernel::V3D> &points) const;
+
+private:
+  /// A node of the hierarchy. The children of an inner node are the next
+  /// node and the node at index second.
+  struct Node {
+    double min[3];
+    double max[3];
+    /// First detector of a leaf, or the second child of an inner node
+    size_t first;
+    /// Number of detectors of a leaf, 0 for inner nodes
+    size_t count;
+  };
+  /// The placement and shape of a detector
+  struct PlacedDetector {
+    size_t index;
+    Kernel::V3D position;
+    Kernel::Quat rotation;
+    Kernel::Quat inverseRotation;
+    Kernel::V3D scaleFactor;
+    bool isScaled;
+    const IObject *shape;
+  };
+
+  size_t build(std::vector<size_t> &order, size_t begin, size_t end,
+               const std::vector<Kernel::V3D> &minima,
+               const std::vector<Kernel::V3D> &maxima);
+  double distanceTo(const PlacedDetector &detector, const Kernel::V3D &start,
+                    const Kernel::V3D &direction) const;
+  bool contains(const PlacedDetector &detector, const Kernel::V3D &point) const;
+
+  std::vector<Node> m_nodes;
+  /// Detectors in the order of the leaves
+  std::vector<PlacedDetector> m_detectors;
+};
+
+} // namespace Geometry
+} // namespace Mantid
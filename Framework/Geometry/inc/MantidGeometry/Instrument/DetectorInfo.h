@@ -7,6 +7,7 @@
 #pragma once
 
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -91,9 +92,24 @@ public:
   void setRotation(const size_t index, const Kernel::Quat &rotation);
   void setRotation(const std::pair<size_t, size_t> &index,
                    const Kernel::Quat &rotation);
+  void transformDetectors(const size_t begin, const size_t end,
+                          const size_t timeIndex, const Kernel::Quat &rotation,
+                          const Kernel::V3D &translation);
 
   const Geometry::IDetector &detector(const size_t index) const;
 
+  /// L2, 2-theta, signed 2-theta and azimuthal angle of all detectors. The
+  /// angles are NaN for monitors.
+  struct CachedGeometry {
+    std::vector<double> l2;
+    std::vector<double> twoTheta;
+    std::vector<double> signedTwoTheta;
+    std::vector<double> azimuthal;
+  };
+  const CachedGeometry &cachedGeometry() const;
+  const std::vector<double> &solidAngles() const;
+  size_t geometryRevision() const;
+
   // This does not really belong into DetectorInfo, but it seems to be useful
   // while Instrument-2.0 does not exist.
   Kernel::V3D sourcePosition() const;
@@ -133,6 +149,14 @@ private:
   mutable std::vector<boost::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+
+  /// Guards the lazily computed caches below, which are shared with copies
+  /// until either side modifies the geometry
+  mutable std::mutex m_cacheMutex;
+  mutable std::shared_ptr<const CachedGeometry> m_cachedGeometry;
+  mutable size_t m_cachedGeometryRevision = 0;
+  mutable std::shared_ptr<const std::vector<double>> m_solidAngles;
+  mutable size_t m_solidAnglesRevision = 0;
 };
 
 using DetectorInfoIt = DetectorInfoIterator<DetectorInfo>;
@@ -0,0 +1,49 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Instrument_fwd.h"
+
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+
+/** InstrumentCache : a directory of binary files holding instruments that
+  have already been built from their instrument definition, so that other
+  processes can load them without parsing the XML again.
+
+  A file is named after the mangled name of the instrument definition, which
+  contains the checksum of the XML, so a modified definition is parsed again.
+  The file holds the component tree with the positions, rotations and shapes
+  of the components, the detector and monitor marks, the reference frame and
+  the parameters defined in the definition. The beamline ComponentInfo and
+  DetectorInfo are not stored; they are built from the restored tree by
+  Instrument::parseTreeAndCacheBeamline as after parsing.
+
+  Instruments containing structured detectors, shapes not defined in XML or
+  a separate physical instrument cannot be cached and are always parsed.
+*/
+class MANTID_GEOMETRY_DLL InstrumentCache {
+public:
+  InstrumentCache();
+  explicit InstrumentCache(std::string directory);
+
+  /// @return true if instruments are read from and written to the cache
+  bool isEnabled() const { return !m_directory.empty(); }
+  std::string filename(const std::string &mangledName) const;
+  bool save(const Instrument &instrument, const std::string &mangledName) const;
+  Instrument_sptr load(const std::string &mangledName) const;
+
+private:
+  /// The directory holding the files, empty if the cache is disabled
+  std::string m_directory;
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -13,6 +13,7 @@
 #include <Poco/AutoPtr.h>
 #include <Poco/DOM/Document.h>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace Poco {
@@ -142,6 +143,9 @@ private:
 
   /// Method for populating IdList
   void populateIdList(Poco::XML::Element *pE, IdList &idList);
+  /// Populate IdList from the idlist of a component element
+  void populateIdListOfComponent(const Poco::XML::Element *pCompElem,
+                                 IdList &idList);
 
   std::vector<std::string>
   buildExcludeList(const Poco::XML::Element *const location);
@@ -189,6 +193,11 @@ private:
   void appendLocations(Geometry::ICompAssembly *parent,
                        const Poco::XML::Element *pLocElems,
                        const Poco::XML::Element *pCompElem, IdList &idList);
+  /// Append the detectors of a \<locations\> element without expanding it
+  bool appendDetectorLocations(Geometry::ICompAssembly *parent,
+                               const Poco::XML::Element *pLocElems,
+                               const Poco::XML::Element *pCompElem,
+                               IdList &idList);
 
   /// Set parameter/logfile info (if any) associated with component
   void setLogfile(const Geometry::IComponent *comp,
@@ -339,7 +348,7 @@ private:
    *  - instead of using the comparatively slow poco call getElementsByTagName()
    * (or getChildElement)
    */
-  std::vector<Poco::XML::Element *> m_hasParameterElement;
+  std::unordered_set<const Poco::XML::Element *> m_hasParameterElement;
   /// has m_hasParameterElement been set - used when public method
   /// setComponentLinks is used
   bool m_hasParameterElement_beenSet;
@@ -11,9 +11,11 @@
 #include "MantidGeometry/IDTypes.h" //For specnum_t
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument/Parameter.h"
+#include "MantidKernel/cow_ptr.h"
 
 #include "tbb/concurrent_unordered_map.h"
 
+#include <atomic>
 #include <memory>
 #include <typeinfo>
 #include <vector>
@@ -61,9 +63,9 @@ public:
   ParameterMap(const ParameterMap &other);
   ~ParameterMap();
   /// Returns true if the map is empty, false otherwise
-  inline bool empty() const { return m_map.empty(); }
+  inline bool empty() const { return m_map->empty(); }
   /// Return the size of the map
-  inline int size() const { return static_cast<int>(m_map.size()); }
+  inline int size() const { return static_cast<int>(m_map->size()); }
   /// Return string to be used in the map
   static const std::string &pos();
   static const std::string &posx();
@@ -91,14 +93,17 @@ public:
 
   /// Clears the map
   inline void clear() {
-    m_map.clear();
+    m_map = boost::make_shared<pmap>();
     clearPositionSensitiveCaches();
+    clearInheritedParameters();
   }
   /// method swaps two parameter maps contents  each other. All caches contents
   /// is nullified (TO DO: it can be efficiently swapped too)
   void swap(ParameterMap &other) {
-    m_map.swap(other.m_map);
+    std::swap(m_map, other.m_map);
     clearPositionSensitiveCaches();
+    clearInheritedParameters();
+    other.clearInheritedParameters();
   }
   /// Clear any parameters with the given name
   void clearParametersByName(const std::string &name);
@@ -236,7 +241,7 @@ public:
     std::vector<T> retval;
 
     pmap_cit it;
-    for (it = m_map.begin(); it != m_map.end(); ++it) {
+    for (it = m_map->begin(); it != m_map->end(); ++it) {
       if (compName == it->first->getName()) {
         boost::shared_ptr<Parameter> param = get(it->first, name);
         if (param)
@@ -314,12 +319,20 @@ public:
   /// adds a parameter filename that has been loaded
   void addParameterFilename(const std::string &filename);
 
-  /// access iterators. begin;
-  pmap_it begin() { return m_map.begin(); }
-  pmap_cit begin() const { return m_map.begin(); }
+  /// access iterators. begin; The non-const iterators copy a shared map
+  /// and drop the inherited parameter tables, as parameters may be changed
+  /// through them. Use the const iterators to read the parameters.
+  pmap_it begin() {
+    clearInheritedParameters();
+    return m_map.access().begin();
+  }
+  pmap_cit begin() const { return m_map->begin(); }
   /// access iterators. end;
-  pmap_it end() { return m_map.end(); }
-  pmap_cit end() const { return m_map.end(); }
+  pmap_it end() {
+    clearInheritedParameters();
+    return m_map.access().end();
+  }
+  pmap_cit end() const { return m_map->end(); }
 
   bool hasDetectorInfo(const Instrument *instrument) const;
   bool hasComponentInfo(const Instrument *instrument) const;
@@ -333,6 +346,9 @@ public:
   void setInstrument(const Instrument *instrument);
 
 private:
+  struct InheritedParameters;
+  struct InheritanceTables;
+
   boost::shared_ptr<Parameter> create(const std::string &className,
                                       const std::string &name) const;
 
@@ -345,16 +361,28 @@ private:
   /// the parameter map
   component_map_cit positionOf(const IComponent *comp, const char *name,
                                const char *type) const;
+  /// The parameters inherited by each component of the instrument
+  boost::shared_ptr<const InheritedParameters>
+  inheritedParameters(const char *name, const char *type) const;
+  /// Invalidates the tables of inherited parameters
+  void clearInheritedParameters();
 
   /// internal list of parameter files loaded
   std::vector<std::string> m_parameterFileNames;
 
-  /// internal parameter map instance
-  pmap m_map;
+  /// internal parameter map instance, shared between copies until one of
+  /// them is modified
+  Kernel::cow_ptr<pmap> m_map;
   /// internal cache map instance for cached position values
   std::unique_ptr<Kernel::Cache<const ComponentID, Kernel::V3D>> m_cacheLocMap;
   /// internal cache map instance for cached rotation values
   std::unique_ptr<Kernel::Cache<const ComponentID, Kernel::Quat>> m_cacheRotMap;
+  /// Tables of the parameters found by getRecursive() for each component
+  /// index, built on demand for each parameter name and type
+  mutable boost::shared_ptr<const InheritanceTables> m_inheritanceTables;
+  /// Incremented whenever parameters are added or removed, which invalidates
+  /// the tables built before
+  std::atomic<size_t> m_revision{0};
 
   /// Pointer to the DetectorInfo wrapper. NULL unless the instrument is
   /// associated with an ExperimentInfo object.
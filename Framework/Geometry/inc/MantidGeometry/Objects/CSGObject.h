@@ -31,6 +31,7 @@ class V3D;
 
 namespace Geometry {
 class CompGrp;
+class CSGProgram;
 class GeometryHandler;
 class Rule;
 class Surface;
@@ -109,6 +110,7 @@ public:
   isValid(const Kernel::V3D &) const override; ///< Check if a point is valid
   bool isValid(const std::map<int, int> &)
       const; ///< Check if a set of surfaces are valid.
+  std::vector<bool> isValid(const std::vector<Kernel::V3D> &points) const;
   bool isOnSide(const Kernel::V3D &) const override;
   Mantid::Geometry::TrackDirection calcValidType(const Kernel::V3D &Pt,
                                                  const Kernel::V3D &uVec) const;
@@ -198,6 +200,7 @@ private:
                int &compUnit) const;
   std::unique_ptr<CompGrp> procComp(std::unique_ptr<Rule>) const;
   int checkSurfaceValid(const Kernel::V3D &, const Kernel::V3D &) const;
+  void compileRules();
 
   /// Calculate bounding box using Rule system
   void calcBoundingBoxByRule();
@@ -217,6 +220,8 @@ private:
                                     const size_t seed) const;
   /// Top rule [ Geometric scope of object]
   std::unique_ptr<Rule> TopRule;
+  /// TopRule compiled for fast point tests, if it could be compiled
+  std::unique_ptr<CSGProgram> m_program;
   /// Object's bounding box
   BoundingBox m_boundingBox;
   // -- DEPRECATED --
@@ -0,0 +1,83 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class Rule;
+class Surface;
+
+/** CSGProgram : the rule tree of a CSGObject compiled into a postfix program
+  over a table of surfaces, for testing whether points are inside the object
+  without walking the tree.
+
+  The side of each surface is computed from its coefficients, held one array
+  per coefficient, with the same arithmetic and tolerances as
+  Surface::side(), so the results are identical to Rule::isValid(). Surfaces
+  of other types are asked through their virtual side(). The program then
+  combines the sides on a stack of bits without branching.
+
+  A program holds the coefficients at the time it was compiled and must be
+  compiled again when the rules or surfaces change.
+*/
+class MANTID_GEOMETRY_DLL CSGProgram {
+public:
+  static std::unique_ptr<CSGProgram> compile(const Rule &topRule);
+
+  bool isValid(const Kernel::V3D &point) const;
+  std::vector<bool> isValid(const std::vector<Kernel::V3D> &points) const;
+
+private:
+  /// How the side of a surface is computed
+  enum class SurfaceType : uint8_t {
+    Plane,
+    Sphere,
+    XCylinder,
+    YCylinder,
+    ZCylinder,
+    Cone,
+    Quadratic,
+    Virtual
+  };
+  enum class OpCode : uint8_t { Surface, Constant, Not, And, Or };
+  struct Instruction {
+    OpCode opCode;
+    /// The sign of a surface, or the value of a constant
+    int8_t sign;
+    /// Index of the surface
+    uint32_t surface;
+  };
+  /// Number of coefficients stored per surface
+  static constexpr size_t NCOEFFICIENTS = 10;
+
+  CSGProgram() = default;
+  bool emit(const Rule &rule, const size_t depth);
+  uint32_t addSurface(const Surface &surface);
+  int side(const size_t surface, const Kernel::V3D &point) const;
+  void sides(const size_t surface, const std::vector<Kernel::V3D> &points,
+             int8_t *result) const;
+  template <typename SideOf> bool run(const SideOf &sideOf) const;
+
+  /// The program in postfix order
+  std::vector<Instruction> m_instructions;
+  std::vector<SurfaceType> m_types;
+  /// Coefficients of the surfaces, indexed by coefficient then surface
+  std::array<std::vector<double>, NCOEFFICIENTS> m_coefficients;
+  /// The surfaces themselves, for the Virtual type
+  std::vector<const Surface *> m_surfaces;
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -0,0 +1,47 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <array>
+
+namespace Mantid {
+namespace Geometry {
+namespace detail {
+class ShapeInfo;
+}
+/** ShapeIntersection : closed-form intersections of a ray with the shapes
+  described by a ShapeInfo, for objects that do not need the generic
+  surface-by-surface calculation.
+*/
+namespace ShapeIntersection {
+
+/// The part of a ray inside a shape, as distances along the ray from its
+/// start in units of the length of its direction. The entry is negative if
+/// the ray starts inside the shape.
+struct Interval {
+  double entry;
+  double exit;
+};
+
+/// A ray crosses a supported shape in at most this many intervals
+constexpr size_t MAX_INTERVALS = 2;
+
+using Intervals = std::array<Interval, MAX_INTERVALS>;
+
+MANTID_GEOMETRY_DLL bool isSupported(const detail::ShapeInfo &shapeInfo);
+
+MANTID_GEOMETRY_DLL size_t intersect(const detail::ShapeInfo &shapeInfo,
+                                     const Kernel::V3D &start,
+                                     const Kernel::V3D &direction,
+                                     Intervals &intervals);
+
+} // namespace ShapeIntersection
+} // namespace Geometry
+} // namespace Mantid
@@ -8,6 +8,7 @@
 #include "MantidBeamline/ComponentInfo.h"
 #include "MantidBeamline/ComponentType.h"
 #include "MantidGeometry/IComponent.h"
+#include "MantidGeometry/Instrument/DetectorBVH.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
 #include "MantidGeometry/Objects/IObject.h"
 #include "MantidKernel/EigenConversionHelpers.h"
@@ -98,7 +99,11 @@ ComponentInfo::cloneWithoutDetectorInfo() const {
 ComponentInfo::ComponentInfo(const ComponentInfo &other)
     : m_componentInfo(other.m_componentInfo->cloneWithoutDetectorInfo()),
       m_componentIds(other.m_componentIds),
-      m_compIDToIndex(other.m_compIDToIndex), m_shapes(other.m_shapes) {}
+      m_compIDToIndex(other.m_compIDToIndex), m_shapes(other.m_shapes) {
+  std::lock_guard<std::mutex> lock(other.m_detectorBVHMutex);
+  m_detectorBVH = other.m_detectorBVH;
+  m_detectorBVHRevision = other.m_detectorBVHRevision;
+}
 
 // Defined as default in source for forward declaration with std::unique_ptr.
 ComponentInfo::~ComponentInfo() = default;
@@ -149,6 +154,11 @@ size_t ComponentInfo::indexOf(Geometry::IComponent *id) const {
   return m_compIDToIndex->at(id);
 }
 
+/// Returns true if the component with the given ID has an index
+bool ComponentInfo::hasComponent(Geometry::IComponent *id) const {
+  return m_compIDToIndex->count(id) != 0;
+}
+
 size_t ComponentInfo::indexOfAny(const std::string &name) const {
   return m_componentInfo->indexOfAny(name);
 }
@@ -447,6 +457,23 @@ void ComponentInfo::merge(const ComponentInfo &other) {
   m_componentInfo->merge(*other.m_componentInfo);
 }
 
+/**
+ * Returns a bounding volume hierarchy over the detectors, for finding the
+ * detector hit by a ray or containing a point. It is built on the first call
+ * and rebuilt when the geometry has changed since, so the reference is only
+ * valid until the next change of the geometry.
+ * @throw std::runtime_error if the beamline is scanning
+ */
+const DetectorBVH &ComponentInfo::detectorBVH() const {
+  std::lock_guard<std::mutex> lock(m_detectorBVHMutex);
+  const auto revision = m_componentInfo->fullGeometryRevision();
+  if (m_detectorBVH && m_detectorBVHRevision == revision)
+    return *m_detectorBVH;
+  m_detectorBVH = std::make_shared<DetectorBVH>(*this);
+  m_detectorBVHRevision = revision;
+  return *m_detectorBVH;
+}
+
 ComponentInfoIt ComponentInfo::begin() {
   return ComponentInfoIt(*this, 0, size());
 }
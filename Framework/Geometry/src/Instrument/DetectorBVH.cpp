@@ -0,0 +1,328 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Instrument/DetectorBVH.h"
+#include "MantidBeamline/ComponentType.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/Track.h"
+#include "MantidKernel/ParallelFor.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::V3D;
+
+namespace {
+/// Largest number of detectors in a leaf
+constexpr size_t MAX_LEAF_SIZE = 4;
+/// Number of queries a thread takes at a time in the batched queries
+constexpr size_t QUERIES_PER_TASK = 64;
+
+/** Find where a ray enters an axis-aligned box, by the slab method
+ * @param min :: the lower corner of the box
+ * @param max :: the upper corner of the box
+ * @param start :: the start of the ray
+ * @param inverseDirection :: the inverse of each component of the direction
+ * @param maxDistance :: the distance beyond which hits are ignored
+ * @return the distance from the start at which the ray enters the box, 0 if
+ * it starts inside, or infinity if it misses it
+ */
+double boxEntry(const double *min, const double *max, const V3D &start,
+                const V3D &inverseDirection, const double maxDistance) {
+  double entry = 0.;
+  double exit = maxDistance;
+  for (size_t axis = 0; axis < 3; ++axis) {
+    double near = (min[axis] - start[axis]) * inverseDirection[axis];
+    double far = (max[axis] - start[axis]) * inverseDirection[axis];
+    if (near > far)
+      std::swap(near, far);
+    // Written so that NaN, from a ray lying in a face, keeps the bounds
+    entry = near > entry ? near : entry;
+    exit = far < exit ? far : exit;
+    if (entry > exit)
+      return std::numeric_limits<double>::infinity();
+  }
+  return entry;
+}
+
+bool boxContains(const double *min, const double *max, const V3D &point) {
+  for (size_t axis = 0; axis < 3; ++axis) {
+    if (point[axis] < min[axis] || point[axis] > max[axis])
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+/**
+ * Build the hierarchy over the detectors of a ComponentInfo
+ * @param componentInfo :: the beamline geometry
+ * @throw std::runtime_error if the beamline is scanning
+ */
+DetectorBVH::DetectorBVH(const ComponentInfo &componentInfo) {
+  if (componentInfo.scanCount() > 1)
+    throw std::runtime_error(
+        "DetectorBVH does not support scanning instruments");
+
+  std::vector<size_t> indices;
+  std::unordered_set<const IObject *> shapes;
+  for (size_t i = 0; i < componentInfo.size(); ++i) {
+    if (!componentInfo.isDetector(i) || !componentInfo.hasValidShape(i) ||
+        componentInfo.componentType(i) == Beamline::ComponentType::Infinite)
+      continue;
+    indices.emplace_back(i);
+    // The first call computes and caches the bounding box of the shape,
+    // which is not thread-safe
+    if (shapes.insert(&componentInfo.shape(i)).second)
+      componentInfo.shape(i).getBoundingBox();
+  }
+
+  std::vector<V3D> minima(indices.size());
+  std::vector<V3D> maxima(indices.size());
+  std::vector<PlacedDetector> detectors(indices.size());
+  Kernel::parallelFor(0, indices.size(), [&](const size_t i) {
+    const auto index = indices[i];
+    const auto box = componentInfo.boundingBox(index);
+    minima[i] = box.minPoint();
+    maxima[i] = box.maxPoint();
+    auto &detector = detectors[i];
+    detector.index = index;
+    detector.position = componentInfo.position(index);
+    detector.rotation = componentInfo.rotation(index);
+    detector.inverseRotation = detector.rotation;
+    detector.inverseRotation.inverse();
+    detector.scaleFactor = componentInfo.scaleFactor(index);
+    detector.isScaled =
+        (detector.scaleFactor - V3D(1., 1., 1.)).norm() >= 1e-12;
+    detector.shape = &componentInfo.shape(index);
+  });
+
+  std::vector<size_t> order(indices.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (!order.empty()) {
+    m_nodes.reserve(2 * order.size() / MAX_LEAF_SIZE + 1);
+    build(order, 0, order.size(), minima, maxima);
+  }
+  m_detectors.reserve(order.size());
+  for (const auto i : order)
+    m_detectors.emplace_back(detectors[i]);
+}
+
+/**
+ * Create the node holding the detectors order[begin, end), and its children,
+ * by splitting the detectors at the median of their centres along the
+ * longest axis of the node
+ * @return the index of the node
+ */
+size_t DetectorBVH::build(std::vector<size_t> &order, const size_t begin,
+                          const size_t end, const std::vector<V3D> &minima,
+                          const std::vector<V3D> &maxima) {
+  const size_t nodeIndex = m_nodes.size();
+  m_nodes.emplace_back();
+  Node node;
+  V3D centreMin = (minima[order[begin]] + maxima[order[begin]]) * 0.5;
+  V3D centreMax = centreMin;
+  for (size_t axis = 0; axis < 3; ++axis) {
+    node.min[axis] = std::numeric_limits<double>::max();
+    node.max[axis] = std::numeric_limits<double>::lowest();
+  }
+  for (size_t i = begin; i < end; ++i) {
+    const auto &low = minima[order[i]];
+    const auto &high = maxima[order[i]];
+    const auto centre = (low + high) * 0.5;
+    for (size_t axis = 0; axis < 3; ++axis) {
+      node.min[axis] = std::min(node.min[axis], low[axis]);
+      node.max[axis] = std::max(node.max[axis], high[axis]);
+      centreMin[axis] = std::min(centreMin[axis], centre[axis]);
+      centreMax[axis] = std::max(centreMax[axis], centre[axis]);
+    }
+  }
+
+  const auto extent = centreMax - centreMin;
+  size_t axis = 0;
+  if (extent[1] > extent[axis])
+    axis = 1;
+  if (extent[2] > extent[axis])
+    axis = 2;
+  if (end - begin <= MAX_LEAF_SIZE || extent[axis] == 0.) {
+    node.first = begin;
+    node.count = end - begin;
+    m_nodes[nodeIndex] = node;
+    return nodeIndex;
+  }
+
+  const size_t middle = begin + (end - begin) / 2;
+  std::nth_element(order.begin() + begin, order.begin() + middle,
+                   order.begin() + end, [&](const size_t a, const size_t b) {
+                     return minima[a][axis] + maxima[a][axis] <
+                            minima[b][axis] + maxima[b][axis];
+                   });
+  build(order, begin, middle, minima, maxima);
+  node.first = build(order, middle, end, minima, maxima);
+  node.count = 0;
+  m_nodes[nodeIndex] = node;
+  return nodeIndex;
+}
+
+/**
+ * Find the first detector hit by a ray
+ * @param start :: the start of the ray
+ * @param direction :: the direction of the ray, need not be normalised
+ * @return the index of the nearest detector whose shape the ray enters, or
+ * NONE
+ */
+size_t DetectorBVH::findDetector(const V3D &start,
+                                 const V3D &direction) const {
+  if (m_nodes.empty() || direction.nullVector())
+    return NONE;
+  const auto unitDirection = Kernel::normalize(direction);
+  const V3D inverseDirection(1. / unitDirection.X(), 1. / unitDirection.Y(),
+                             1. / unitDirection.Z());
+
+  size_t result = NONE;
+  double nearest = std::numeric_limits<double>::infinity();
+  std::vector<size_t> stack{0};
+  while (!stack.empty()) {
+    const size_t nodeIndex = stack.back();
+    const auto &node = m_nodes[nodeIndex];
+    stack.pop_back();
+    if (boxEntry(node.min, node.max, start, inverseDirection, nearest) >=
+        nearest)
+      continue;
+    if (node.count == 0) {
+      stack.emplace_back(node.first);
+      stack.emplace_back(nodeIndex + 1);
+      continue;
+    }
+    for (size_t i = node.first; i < node.first + node.count; ++i) {
+      const double distance = distanceTo(m_detectors[i], start, unitDirection);
+      if (distance < nearest) {
+        nearest = distance;
+        result = m_detectors[i].index;
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * Find the first detector hit by each of many rays from the same start, in
+ * parallel
+ * @param start :: the start of the rays, e.g. the sample position
+ * @param directions :: the direction of each ray
+ * @return the result of findDetector() for each ray
+ */
+std::vector<size_t>
+DetectorBVH::findDetectors(const V3D &start,
+                           const std::vector<V3D> &directions) const {
+  std::vector<size_t> results(directions.size());
+  Kernel::parallelFor(
+      0, directions.size(),
+      [&](const size_t i) { results[i] = findDetector(start, directions[i]); },
+      QUERIES_PER_TASK);
+  return results;
+}
+
+/**
+ * @param point :: a point in the frame of the instrument
+ * @return the index of a detector whose shape contains the point, or NONE
+ */
+size_t DetectorBVH::detectorContaining(const V3D &point) const {
+  if (m_nodes.empty())
+    return NONE;
+  std::vector<size_t> stack{0};
+  while (!stack.empty()) {
+    const size_t nodeIndex = stack.back();
+    const auto &node = m_nodes[nodeIndex];
+    stack.pop_back();
+    if (!boxContains(node.min, node.max, point))
+      continue;
+    if (node.count == 0) {
+      stack.emplace_back(node.first);
+      stack.emplace_back(nodeIndex + 1);
+      continue;
+    }
+    for (size_t i = node.first; i < node.first + node.count; ++i) {
+      if (contains(m_detectors[i], point))
+        return m_detectors[i].index;
+    }
+  }
+  return NONE;
+}
+
+/**
+ * Find the detector containing each of many points, in parallel
+ * @param points :: points in the frame of the instrument
+ * @return the result of detectorContaining() for each point
+ */
+std::vector<size_t>
+DetectorBVH::detectorsContaining(const std::vector<V3D> &points) const {
+  std::vector<size_t> results(points.size());
+  Kernel::parallelFor(
+      0, points.size(),
+      [&](const size_t i) { results[i] = detectorContaining(points[i]); },
+      QUERIES_PER_TASK);
+  return results;
+}
+
+/**
+ * @param detector :: a detector
+ * @param start :: the start of a ray
+ * @param direction :: the unit direction of the ray
+ * @return the distance from the start to where the ray enters the shape of
+ * the detector, or infinity if it misses it
+ */
+double DetectorBVH::distanceTo(const PlacedDetector &detector, const V3D &start,
+                               const V3D &direction) const {
+  // Move the ray into the frame of the shape
+  auto localStart = start - detector.position;
+  detector.inverseRotation.rotate(localStart);
+  auto localDirection = direction;
+  detector.inverseRotation.rotate(localDirection);
+  if (detector.isScaled) {
+    localStart /= detector.scaleFactor;
+    localDirection /= detector.scaleFactor;
+  }
+  localDirection.normalize();
+
+  Track track(localStart, localDirection);
+  if (detector.shape->interceptSurface(track) == 0)
+    return std::numeric_limits<double>::infinity();
+  double distance = std::numeric_limits<double>::infinity();
+  for (auto link = track.cbegin(); link != track.cend(); ++link) {
+    if (!detector.isScaled) {
+      distance = std::min(distance, link->distFromStart);
+      continue;
+    }
+    auto entry = link->entryPoint * detector.scaleFactor;
+    detector.rotation.rotate(entry);
+    distance = std::min(distance, (detector.position + entry).distance(start));
+  }
+  return distance;
+}
+
+/**
+ * @param detector :: a detector
+ * @param point :: a point in the frame of the instrument
+ * @return true if the shape of the detector contains the point
+ */
+bool DetectorBVH::contains(const PlacedDetector &detector,
+                           const V3D &point) const {
+  auto localPoint = point - detector.position;
+  detector.inverseRotation.rotate(localPoint);
+  if (detector.isScaled)
+    localPoint /= detector.scaleFactor;
+  return detector.shape->isValid(localPoint);
+}
+
+} // namespace Geometry
+} // namespace Mantid
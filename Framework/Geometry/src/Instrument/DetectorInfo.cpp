@@ -14,8 +14,41 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <limits>
+
 namespace Mantid {
 namespace Geometry {
+namespace {
+/// Axes used for computing scattering angles, see DetectorInfo::azimuthal().
+struct BeamAxes {
+  Kernel::V3D beamLine;
+  Kernel::V3D horizontal;
+  Kernel::V3D vertical;
+};
+
+BeamAxes makeBeamAxes(const Kernel::V3D &samplePos,
+                      const Kernel::V3D &sourcePos,
+                      const ReferenceFrame &referenceFrame) {
+  BeamAxes axes;
+  axes.beamLine = samplePos - sourcePos;
+  if (axes.beamLine.nullVector()) {
+    throw Kernel::Exception::InstrumentDefinitionError(
+        "Source and sample are at same position!");
+  }
+  const auto beamLineNormalized = Kernel::normalize(axes.beamLine);
+  const auto origHorizontal = referenceFrame.vecPointingHorizontal();
+  axes.vertical = beamLineNormalized.cross_prod(origHorizontal);
+  if (axes.vertical.scalar_prod(referenceFrame.vecPointingUp()) <= 0.)
+    throw std::runtime_error(
+        "Failed to create up axis orthogonal to the beam direction");
+  axes.horizontal = axes.vertical.cross_prod(beamLineNormalized);
+  if (origHorizontal.scalar_prod(axes.horizontal) <= 0.)
+    throw std::runtime_error(
+        "Failed to create horizontal axis orthogonal to the beam direction");
+  return axes;
+}
+} // namespace
+
 /** Construct DetectorInfo based on an Instrument.
  *
  * The Instrument reference `instrument` must be the parameterized instrument
@@ -54,7 +87,14 @@ DetectorInfo::DetectorInfo(const DetectorInfo &other)
       m_instrument(other.m_instrument), m_detectorIDs(other.m_detectorIDs),
       m_detIDToIndex(other.m_detIDToIndex),
       m_lastDetector(PARALLEL_GET_MAX_THREADS),
-      m_lastIndex(PARALLEL_GET_MAX_THREADS, -1) {}
+      m_lastIndex(PARALLEL_GET_MAX_THREADS, -1) {
+  // The copy has the same geometry revision, so the caches stay valid for it
+  std::lock_guard<std::mutex> lock(other.m_cacheMutex);
+  m_cachedGeometry = other.m_cachedGeometry;
+  m_cachedGeometryRevision = other.m_cachedGeometryRevision;
+  m_solidAngles = other.m_solidAngles;
+  m_solidAnglesRevision = other.m_solidAnglesRevision;
+}
 
 /// Assigns the contents of the non-wrapping part of `rhs` to this.
 DetectorInfo &DetectorInfo::operator=(const DetectorInfo &rhs) {
@@ -65,6 +105,9 @@ DetectorInfo &DetectorInfo::operator=(const DetectorInfo &rhs) {
   // Do NOT assign anything in the "wrapping" part of DetectorInfo. We simply
   // assign the underlying Beamline::DetectorInfo.
   *m_detectorInfo = *rhs.m_detectorInfo;
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  m_cachedGeometry.reset();
+  m_solidAngles.reset();
   return *this;
 }
 
@@ -238,35 +281,11 @@ double DetectorInfo::azimuthal(const size_t index) const {
     throw std::logic_error("Azimuthal angle is not defined for monitors");
 
   const auto samplePos = samplePosition();
-  const auto beamLine = samplePos - sourcePosition();
-
-  if (beamLine.nullVector()) {
-    throw Kernel::Exception::InstrumentDefinitionError(
-        "Source and sample are at same position!");
-  }
-
+  const auto axes = makeBeamAxes(samplePos, sourcePosition(),
+                                 *m_instrument->getReferenceFrame());
   const auto sampleDetVec = position(index) - samplePos;
-  const auto beamLineNormalized = Kernel::normalize(beamLine);
-
-  // generate the vertical axis
-  const auto origHorizontal =
-      m_instrument->getReferenceFrame()->vecPointingHorizontal();
-  const auto vertical = beamLineNormalized.cross_prod(origHorizontal);
-  if (vertical.scalar_prod(
-          m_instrument->getReferenceFrame()->vecPointingUp()) <= 0.)
-    throw std::runtime_error(
-        "Failed to create up axis orthogonal to the beam direction");
-
-  // generate the horizontal axis perpendicular to the other two
-  const auto horizontal = vertical.cross_prod(beamLineNormalized);
-  if (origHorizontal.scalar_prod(horizontal) <= 0.)
-    throw std::runtime_error(
-        "Failed to create horizontal axis orthogonal to the beam direction");
-
-  const double dotHorizontal = sampleDetVec.scalar_prod(horizontal);
-  const double dotVertical = sampleDetVec.scalar_prod(vertical);
-
-  return atan2(dotVertical, dotHorizontal);
+  return atan2(sampleDetVec.scalar_prod(axes.vertical),
+               sampleDetVec.scalar_prod(axes.horizontal));
 }
 
 double DetectorInfo::azimuthal(const std::pair<size_t, size_t> &index) const {
@@ -274,35 +293,11 @@ double DetectorInfo::azimuthal(const std::pair<size_t, size_t> &index) const {
     throw std::logic_error("Azimuthal angle is not defined for monitors");
 
   const auto samplePos = samplePosition();
-  const auto beamLine = samplePos - sourcePosition();
-
-  if (beamLine.nullVector()) {
-    throw Kernel::Exception::InstrumentDefinitionError(
-        "Source and sample are at same position!");
-  }
-
+  const auto axes = makeBeamAxes(samplePos, sourcePosition(),
+                                 *m_instrument->getReferenceFrame());
   const auto sampleDetVec = position(index) - samplePos;
-  const auto beamLineNormalized = Kernel::normalize(beamLine);
-
-  // generate the vertical axis
-  const auto origHorizontal =
-      m_instrument->getReferenceFrame()->vecPointingHorizontal();
-  const auto vertical = beamLineNormalized.cross_prod(origHorizontal);
-  if (vertical.scalar_prod(
-          m_instrument->getReferenceFrame()->vecPointingUp()) <= 0.)
-    throw std::runtime_error(
-        "Failed to create up axis orthogonal to the beam direction");
-
-  // generate the horizontal axis perpendicular to the other two
-  const auto horizontal = vertical.cross_prod(beamLineNormalized);
-  if (origHorizontal.scalar_prod(horizontal) <= 0.)
-    throw std::runtime_error(
-        "Failed to create horizontal axis orthogonal to the beam direction");
-
-  const double dotHorizontal = sampleDetVec.scalar_prod(horizontal);
-  const double dotVertical = sampleDetVec.scalar_prod(vertical);
-
-  return atan2(dotVertical, dotHorizontal);
+  return atan2(sampleDetVec.scalar_prod(axes.vertical),
+               sampleDetVec.scalar_prod(axes.horizontal));
 }
 
 /// Returns the position of the detector with given index.
@@ -371,11 +366,119 @@ void DetectorInfo::setRotation(const std::pair<size_t, size_t> &index,
   m_detectorInfo->setRotation(index, Kernel::toQuaterniond(rotation));
 }
 
+/** Rotates the detectors with indices in [begin, end) at the given time index
+ * about the origin and then translates them. Not thread safe.
+ *
+ * Preferable to setting positions and rotations of each detector when moving
+ * banks of a scan, see Beamline::DetectorInfo::transformDetectors. */
+void DetectorInfo::transformDetectors(const size_t begin, const size_t end,
+                                      const size_t timeIndex,
+                                      const Kernel::Quat &rotation,
+                                      const Kernel::V3D &translation) {
+  m_detectorInfo->transformDetectors(begin, end, timeIndex,
+                                     Kernel::toQuaterniond(rotation),
+                                     Kernel::toVector3d(translation));
+}
+
 /// Return a const reference to the detector with given index.
 const Geometry::IDetector &DetectorInfo::detector(const size_t index) const {
   return getDetector(index);
 }
 
+/** Returns L2, 2-theta and the azimuthal angle of all detectors.
+ *
+ * The values are computed for all detectors at once on the first call and
+ * cached until detectors or other components are moved, rotated or rescaled.
+ * When most detectors are needed this is much cheaper than calling l2(),
+ * twoTheta() and azimuthal() for each of them. The returned reference is
+ * invalidated by such modifications. Throws under the same conditions as
+ * azimuthal() and for scanning instruments. */
+const DetectorInfo::CachedGeometry &DetectorInfo::cachedGeometry() const {
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  const auto revision = m_detectorInfo->geometryRevision();
+  if (m_cachedGeometry && m_cachedGeometryRevision == revision)
+    return *m_cachedGeometry;
+
+  const size_t numberOfDetectors = size();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  auto geometry = std::make_shared<CachedGeometry>();
+  geometry->l2.resize(numberOfDetectors);
+  geometry->twoTheta.resize(numberOfDetectors, nan);
+  geometry->signedTwoTheta.resize(numberOfDetectors, nan);
+  geometry->azimuthal.resize(numberOfDetectors, nan);
+
+  const auto samplePos = samplePosition();
+  const auto sourcePos = sourcePosition();
+  const double l1 = this->l1();
+  std::unique_ptr<BeamAxes> axes;
+  Kernel::V3D normToSurface;
+  for (size_t i = 0; i < numberOfDetectors; ++i) {
+    const auto pos = position(i);
+    if (isMonitor(i)) {
+      geometry->l2[i] = pos.distance(sourcePos) - l1;
+      continue;
+    }
+    if (!axes) {
+      const auto &referenceFrame = *m_instrument->getReferenceFrame();
+      axes = std::make_unique<BeamAxes>(
+          makeBeamAxes(samplePos, sourcePos, referenceFrame));
+      normToSurface = axes->beamLine.cross_prod(referenceFrame.vecThetaSign());
+    }
+    geometry->l2[i] = pos.distance(samplePos);
+    const auto sampleDetVec = pos - samplePos;
+    const double twoTheta = sampleDetVec.angle(axes->beamLine);
+    geometry->twoTheta[i] = twoTheta;
+    geometry->signedTwoTheta[i] =
+        normToSurface.scalar_prod(axes->beamLine.cross_prod(sampleDetVec)) < 0
+            ? -twoTheta
+            : twoTheta;
+    geometry->azimuthal[i] = atan2(sampleDetVec.scalar_prod(axes->vertical),
+                                   sampleDetVec.scalar_prod(axes->horizontal));
+  }
+  m_cachedGeometry = std::move(geometry);
+  m_cachedGeometryRevision = revision;
+  return *m_cachedGeometry;
+}
+
+/** Returns the solid angles of all detectors as seen from the sample.
+ *
+ * The solid angles are computed in parallel for all detectors on the first
+ * call and cached with the same lifetime as cachedGeometry(). Entries are NaN
+ * for monitors and for detectors whose solid angle cannot be computed, e.g.,
+ * because they have no shape; detector(index).solidAngle() gives the reason
+ * for the latter. */
+const std::vector<double> &DetectorInfo::solidAngles() const {
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  const auto revision = m_detectorInfo->geometryRevision();
+  if (m_solidAngles && m_solidAnglesRevision == revision)
+    return *m_solidAngles;
+
+  auto solidAngles = std::make_shared<std::vector<double>>(
+      size(), std::numeric_limits<double>::quiet_NaN());
+  const auto samplePos = samplePosition();
+  const auto numberOfDetectors = static_cast<int64_t>(size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfDetectors; ++i) {
+    if (isMonitor(i))
+      continue;
+    try {
+      (*solidAngles)[i] = getDetector(i).solidAngle(samplePos);
+    } catch (const std::exception &) {
+      // Left as NaN, callers needing the value can query the detector.
+    }
+  }
+  m_solidAngles = std::move(solidAngles);
+  m_solidAnglesRevision = revision;
+  return *m_solidAngles;
+}
+
+/** Returns a counter that changes whenever detectors or other components are
+ * moved, rotated or rescaled. Caches derived from the geometry can store it to
+ * detect that they are out of date. */
+size_t DetectorInfo::geometryRevision() const {
+  return m_detectorInfo->geometryRevision();
+}
+
 /// Returns the source position.
 Kernel::V3D DetectorInfo::sourcePosition() const {
   return Kernel::toV3D(m_detectorInfo->sourcePosition());
@@ -18,6 +18,7 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Material.h"
 #include "MantidKernel/Matrix.h"
+#include "MantidKernel/ParallelFor.h"
 #include <algorithm>
 #include <boost/make_shared.hpp>
 #include <boost/regex.hpp>
@@ -457,9 +458,11 @@ V3D GridDetector::getRelativePosAtXYZ(int x, int y, int z) const {
 
 void GridDetector::createLayer(const std::string &name, CompAssembly *parent,
                                int iz, int &minDetID, int &maxDetID) {
-  // Loop and create all detectors in this layer.
+  // Create an ICompAssembly for each x-column first, so that they are added
+  // to the parent in order, then fill the columns in parallel
+  std::vector<CompAssembly *> columns;
+  columns.reserve(m_xpixels);
   for (int ix = 0; ix < m_xpixels; ++ix) {
-    // Create an ICompAssembly for each x-column
     std::ostringstream oss_col;
     if (m_zpixels > 0)
       oss_col << name << "(z=" << iz << ","
@@ -467,8 +470,14 @@ void GridDetector::createLayer(const std::string &name, CompAssembly *parent,
     else
       oss_col << name << "(x=" << ix << ")";
 
-    auto *xColumn = new CompAssembly(oss_col.str(), parent);
+    columns.emplace_back(new CompAssembly(oss_col.str(), parent));
+  }
 
+  std::vector<int> columnMinDetID(m_xpixels, minDetID);
+  std::vector<int> columnMaxDetID(m_xpixels, maxDetID);
+  Kernel::parallelFor(0, columns.size(), [&](const size_t column) {
+    const auto ix = static_cast<int>(column);
+    auto *xColumn = columns[column];
     for (int iy = 0; iy < m_ypixels; ++iy) {
       // Make the name
       std::ostringstream oss;
@@ -481,12 +490,12 @@ void GridDetector::createLayer(const std::string &name, CompAssembly *parent,
       auto id = this->getDetectorIDAtXYZ(ix, iy, iz);
 
       // minimum grid detector id
-      if (id < minDetID) {
-        minDetID = id;
+      if (id < columnMinDetID[column]) {
+        columnMinDetID[column] = id;
       }
       // maximum grid detector id
-      if (id > maxDetID) {
-        maxDetID = id;
+      if (id > columnMaxDetID[column]) {
+        columnMaxDetID[column] = id;
       }
       // Create the detector from the given id & shape and with xColumn as the
       // parent.
@@ -506,7 +515,9 @@ void GridDetector::createLayer(const std::string &name, CompAssembly *parent,
       // Add it to the x-column
       xColumn->add(detector);
     }
-  }
+  });
+  minDetID = *std::min_element(columnMinDetID.cbegin(), columnMinDetID.cend());
+  maxDetID = *std::max_element(columnMaxDetID.cbegin(), columnMaxDetID.cend());
 }
 
 bool checkValidOrderString(const std::string &order) {
@@ -0,0 +1,709 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Instrument/InstrumentCache.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/CompAssembly.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/GridDetector.h"
+#include "MantidGeometry/Instrument/ObjCompAssembly.h"
+#include "MantidGeometry/Instrument/ObjComponent.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+
+#include <boost/make_shared.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_map>
+
+using Mantid::Kernel::Quat;
+using Mantid::Kernel::V3D;
+using Mantid::Types::Core::DateAndTime;
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+Kernel::Logger g_log("InstrumentCache");
+
+/// Identifies the file layout, increment when it changes
+constexpr uint32_t FILE_VERSION = 2;
+/// Written first in native byte order. Values are stored in the byte order
+/// of the machine writing the file, so a file written by a machine of the
+/// other byte order, e.g. through a shared cache directory, reads it as
+/// another value and is rejected.
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+/// Extension of the cache files
+const std::string EXTENSION(".instrumentcache");
+
+/// The component types that can be stored
+enum class ComponentKind : uint8_t {
+  Component,
+  ObjComponent,
+  Detector,
+  CompAssembly,
+  ObjCompAssembly,
+  GridDetector,
+  RectangularDetector
+};
+
+/// Marks of a detector in the detector cache of the instrument
+enum DetectorMark : uint8_t { IsDetector = 0, IsMonitor = 1 };
+
+/// Appends values to a buffer as raw binary
+class Writer {
+public:
+  template <typename T> void write(const T value) {
+    m_buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void writeString(const std::string &value) {
+    write(static_cast<uint64_t>(value.size()));
+    m_buffer.append(value);
+  }
+  void writeV3D(const V3D &value) {
+    write(value.X());
+    write(value.Y());
+    write(value.Z());
+  }
+  void writeQuat(const Quat &value) {
+    write(value.real());
+    write(value.imagI());
+    write(value.imagJ());
+    write(value.imagK());
+  }
+  void append(const Writer &other) { m_buffer.append(other.m_buffer); }
+  const std::string &buffer() const { return m_buffer; }
+
+private:
+  std::string m_buffer;
+};
+
+/// Reads values written by Writer from a buffer
+class Reader {
+public:
+  explicit Reader(const std::string &buffer)
+      : m_current(buffer.data()), m_end(buffer.data() + buffer.size()) {}
+
+  template <typename T> T read() {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+  std::string readString() {
+    const auto size = static_cast<size_t>(read<uint64_t>());
+    const char *data = take(size);
+    return std::string(data, size);
+  }
+  V3D readV3D() {
+    const auto x = read<double>();
+    const auto y = read<double>();
+    const auto z = read<double>();
+    return V3D(x, y, z);
+  }
+  Quat readQuat() {
+    const auto w = read<double>();
+    const auto a = read<double>();
+    const auto b = read<double>();
+    const auto c = read<double>();
+    return Quat(w, a, b, c);
+  }
+
+private:
+  /// @return the next size bytes of the buffer
+  const char *take(const size_t size) {
+    if (size > static_cast<size_t>(m_end - m_current))
+      throw std::runtime_error("Unexpected end of file");
+    const char *data = m_current;
+    m_current += size;
+    return data;
+  }
+
+  const char *m_current;
+  const char *m_end;
+};
+
+/// Append component and all the components below it, in pre-order
+void flatten(const IComponent *component,
+             std::vector<const IComponent *> &components) {
+  components.emplace_back(component);
+  if (const auto *assembly = dynamic_cast<const ICompAssembly *>(component)) {
+    for (int i = 0; i < assembly->nelements(); ++i)
+      flatten(assembly->getChild(i).get(), components);
+  }
+}
+
+/// @return the axis of a unit vector of the reference frame
+PointingAlong toAxis(const V3D &direction) {
+  if (direction.X() != 0.)
+    return X;
+  return direction.Y() != 0. ? Y : Z;
+}
+
+/// Writes the parts of an instrument that are not rebuilt when loading
+class InstrumentWriter {
+public:
+  explicit InstrumentWriter(const Instrument &instrument) {
+    flatten(&instrument, m_components);
+    for (size_t i = 0; i < m_components.size(); ++i)
+      m_indices.emplace(m_components[i], static_cast<int64_t>(i));
+  }
+
+  /// @return the index of a component in the flattened tree, -1 for none
+  int64_t indexOf(const IComponent *component) const {
+    if (!component)
+      return -1;
+    const auto it = m_indices.find(component);
+    if (it == m_indices.end())
+      throw std::runtime_error("Component " + component->getName() +
+                               " is not in the instrument tree");
+    return it->second;
+  }
+
+  /// Write the children of an assembly, recursively
+  void writeChildren(Writer &out, const ICompAssembly &assembly) {
+    out.write(static_cast<uint64_t>(assembly.nelements()));
+    for (int i = 0; i < assembly.nelements(); ++i)
+      writeComponent(out, *assembly.getChild(i));
+  }
+
+  /// Write the shapes referred to by the components written so far
+  void writeShapes(Writer &out) const {
+    out.write(static_cast<uint64_t>(m_shapes.size()));
+    for (const auto *shape : m_shapes) {
+      out.writeString(shape->getShapeXML());
+      out.writeString(shape->id());
+      out.write(static_cast<int32_t>(shape->getName()));
+    }
+  }
+
+private:
+  void writeComponent(Writer &out, const IComponent &component) {
+    const auto &type = typeid(component);
+    ComponentKind kind;
+    if (type == typeid(Component))
+      kind = ComponentKind::Component;
+    else if (type == typeid(ObjComponent))
+      kind = ComponentKind::ObjComponent;
+    else if (type == typeid(Detector))
+      kind = ComponentKind::Detector;
+    else if (type == typeid(CompAssembly))
+      kind = ComponentKind::CompAssembly;
+    else if (type == typeid(ObjCompAssembly))
+      kind = ComponentKind::ObjCompAssembly;
+    else if (type == typeid(GridDetector))
+      kind = ComponentKind::GridDetector;
+    else if (type == typeid(RectangularDetector))
+      kind = ComponentKind::RectangularDetector;
+    else
+      throw std::runtime_error("Component " + component.getName() +
+                               " has a type that cannot be cached");
+
+    out.write(kind);
+    out.writeString(component.getName());
+    out.writeV3D(component.getRelativePos());
+    out.writeQuat(component.getRelativeRot());
+    switch (kind) {
+    case ComponentKind::Component:
+      break;
+    case ComponentKind::Detector:
+      out.write(static_cast<int32_t>(
+          dynamic_cast<const Detector &>(component).getID()));
+      out.write(shapeIndex(dynamic_cast<const Detector &>(component).shape()));
+      break;
+    case ComponentKind::ObjComponent:
+    case ComponentKind::ObjCompAssembly:
+      out.write(
+          shapeIndex(dynamic_cast<const IObjComponent &>(component).shape()));
+      break;
+    case ComponentKind::GridDetector:
+    case ComponentKind::RectangularDetector:
+      writeGrid(out, dynamic_cast<const GridDetector &>(component));
+      return;
+    case ComponentKind::CompAssembly:
+      break;
+    }
+    if (kind == ComponentKind::CompAssembly ||
+        kind == ComponentKind::ObjCompAssembly)
+      writeChildren(out, dynamic_cast<const ICompAssembly &>(component));
+  }
+
+  /// Write what GridDetector::initialize needs to create the pixels, then
+  /// the orientation of the pixels, which the parser may have changed
+  void writeGrid(Writer &out, const GridDetector &grid) {
+    if (grid.nelements() == 0)
+      throw std::runtime_error("Grid detector " + grid.getName() +
+                               " has no pixels");
+    out.write(shapeIndex(grid.getAtXYZ(0, 0, 0)->shape()));
+    out.write(static_cast<int32_t>(grid.xpixels()));
+    out.write(grid.xstart());
+    out.write(grid.xstep());
+    out.write(static_cast<int32_t>(grid.ypixels()));
+    out.write(grid.ystart());
+    out.write(grid.ystep());
+    out.write(static_cast<int32_t>(grid.zpixels()));
+    out.write(grid.zstart());
+    out.write(grid.zstep());
+    out.write(static_cast<int32_t>(grid.idstart()));
+    out.writeString(grid.idFillOrder());
+    out.write(static_cast<int32_t>(grid.idstepbyrow()));
+    out.write(static_cast<int32_t>(grid.idstep()));
+
+    std::vector<const IComponent *> generated;
+    flatten(&grid, generated);
+    out.write(static_cast<uint64_t>(generated.size() - 1));
+    for (auto it = generated.cbegin() + 1; it != generated.cend(); ++it)
+      out.writeQuat((*it)->getRelativeRot());
+  }
+
+  /// @return the index of a shape in the shape table, -1 for none
+  int64_t shapeIndex(const boost::shared_ptr<const IObject> &shape) {
+    if (!shape)
+      return -1;
+    const auto it = m_shapeIndices.find(shape.get());
+    if (it != m_shapeIndices.end())
+      return it->second;
+    const auto *csgShape = dynamic_cast<const CSGObject *>(shape.get());
+    if (!csgShape || csgShape->getShapeXML().empty())
+      throw std::runtime_error("A shape is not defined by XML");
+    const auto index = static_cast<int64_t>(m_shapes.size());
+    m_shapes.emplace_back(csgShape);
+    m_shapeIndices.emplace(shape.get(), index);
+    return index;
+  }
+
+  std::vector<const IComponent *> m_components;
+  std::unordered_map<const IComponent *, int64_t> m_indices;
+  std::vector<const CSGObject *> m_shapes;
+  std::unordered_map<const IObject *, int64_t> m_shapeIndices;
+};
+
+/// Restores the component tree written by InstrumentWriter
+class InstrumentReader {
+public:
+  explicit InstrumentReader(Reader &in) : m_in(in) {}
+
+  void readShapes() {
+    const auto numShapes = m_in.read<uint64_t>();
+    ShapeFactory factory;
+    for (uint64_t i = 0; i < numShapes; ++i) {
+      auto shape = factory.createShape(m_in.readString(), false);
+      shape->setID(m_in.readString());
+      shape->setName(m_in.read<int32_t>());
+      m_shapes.emplace_back(std::move(shape));
+    }
+  }
+
+  void readChildren(ICompAssembly &parent) {
+    const auto numChildren = m_in.read<uint64_t>();
+    for (uint64_t i = 0; i < numChildren; ++i)
+      readComponent(parent);
+  }
+
+private:
+  void readComponent(ICompAssembly &parent) {
+    const auto kind = m_in.read<ComponentKind>();
+    const auto name = m_in.readString();
+    const auto pos = m_in.readV3D();
+    const auto rot = m_in.readQuat();
+    Component *component = nullptr;
+    ICompAssembly *assembly = nullptr;
+    switch (kind) {
+    case ComponentKind::Component:
+      component = new Component(name, &parent);
+      parent.add(component);
+      break;
+    case ComponentKind::ObjComponent:
+      component = new ObjComponent(name, shape(m_in.read<int64_t>()), &parent);
+      parent.add(component);
+      break;
+    case ComponentKind::Detector: {
+      const auto id = m_in.read<int32_t>();
+      component = new Detector(name, id, shape(m_in.read<int64_t>()), &parent);
+      parent.add(component);
+      break;
+    }
+    case ComponentKind::CompAssembly: {
+      auto *compAssembly = new CompAssembly(name, &parent);
+      component = compAssembly;
+      assembly = compAssembly;
+      break;
+    }
+    case ComponentKind::ObjCompAssembly: {
+      auto *objAssembly = new ObjCompAssembly(name, &parent);
+      objAssembly->setOutline(shape(m_in.read<int64_t>()));
+      component = objAssembly;
+      assembly = objAssembly;
+      break;
+    }
+    case ComponentKind::GridDetector:
+      component = readGrid(new GridDetector(name, &parent));
+      break;
+    case ComponentKind::RectangularDetector:
+      component = readGrid(new RectangularDetector(name, &parent));
+      break;
+    default:
+      throw std::runtime_error("Unknown component type");
+    }
+    component->setPos(pos);
+    component->setRot(rot);
+    if (assembly)
+      readChildren(*assembly);
+  }
+
+  GridDetector *readGrid(GridDetector *grid) {
+    const auto pixelShape = shape(m_in.read<int64_t>());
+    const auto xpixels = m_in.read<int32_t>();
+    const auto xstart = m_in.read<double>();
+    const auto xstep = m_in.read<double>();
+    const auto ypixels = m_in.read<int32_t>();
+    const auto ystart = m_in.read<double>();
+    const auto ystep = m_in.read<double>();
+    const auto zpixels = m_in.read<int32_t>();
+    const auto zstart = m_in.read<double>();
+    const auto zstep = m_in.read<double>();
+    const auto idstart = m_in.read<int32_t>();
+    const auto idFillOrder = m_in.readString();
+    const auto idstepbyrow = m_in.read<int32_t>();
+    const auto idstep = m_in.read<int32_t>();
+    grid->GridDetector::initialize(pixelShape, xpixels, xstart, xstep, ypixels,
+                                   ystart, ystep, zpixels, zstart, zstep,
+                                   idstart, idFillOrder, idstepbyrow, idstep);
+
+    std::vector<const IComponent *> generated;
+    flatten(grid, generated);
+    if (m_in.read<uint64_t>() != generated.size() - 1)
+      throw std::runtime_error("Grid detector " + grid->getName() +
+                               " has a different number of pixels");
+    for (auto it = generated.cbegin() + 1; it != generated.cend(); ++it) {
+      // The pixels are owned by the grid, which is not const
+      auto *pixel =
+          const_cast<Component *>(dynamic_cast<const Component *>(*it));
+      pixel->setRot(m_in.readQuat());
+    }
+    return grid;
+  }
+
+  boost::shared_ptr<IObject> shape(const int64_t index) const {
+    if (index < 0)
+      return nullptr;
+    return m_shapes.at(static_cast<size_t>(index));
+  }
+
+  Reader &m_in;
+  std::vector<boost::shared_ptr<IObject>> m_shapes;
+};
+
+/// @return the file content for instrument
+/// @throw std::runtime_error if the instrument cannot be cached
+std::string serialize(const Instrument &instrument,
+                      const std::string &mangledName) {
+  if (instrument.isParametrized() || instrument.getPhysicalInstrument() ||
+      !instrument.getParameterMap()->empty())
+    throw std::runtime_error("Only unmodified instruments can be cached");
+
+  InstrumentWriter instrumentWriter(instrument);
+  Writer tree;
+  instrumentWriter.writeChildren(tree, instrument);
+
+  Writer out;
+  out.write(BYTE_ORDER_MARK);
+  out.write(FILE_VERSION);
+  out.writeString(mangledName);
+  out.writeString(instrument.getName());
+  out.writeV3D(instrument.getRelativePos());
+  out.writeQuat(instrument.getRelativeRot());
+  out.writeString(instrument.getDefaultView());
+  out.writeString(instrument.getDefaultAxis());
+  out.write(instrument.getValidFromDate().totalNanoseconds());
+  out.write(instrument.getValidToDate().totalNanoseconds());
+  out.writeString(instrument.getFilename());
+  out.writeString(instrument.getXmlText());
+
+  const auto frame = instrument.getReferenceFrame();
+  out.write(static_cast<uint8_t>(frame->pointingUp()));
+  out.write(static_cast<uint8_t>(frame->pointingAlongBeam()));
+  out.write(static_cast<uint8_t>(toAxis(frame->vecThetaSign())));
+  out.write(static_cast<uint8_t>(frame->getHandedness()));
+  out.writeString(frame->origin());
+
+  // getLogfileUnit has no const overload
+  const auto &units = const_cast<Instrument &>(instrument).getLogfileUnit();
+  out.write(static_cast<uint64_t>(units.size()));
+  for (const auto &unit : units) {
+    out.writeString(unit.first);
+    out.writeString(unit.second);
+  }
+
+  // The shapes are collected while writing the tree but are read first
+  instrumentWriter.writeShapes(out);
+  out.append(tree);
+
+  const auto detectorIDs = instrument.getDetectorIDs();
+  out.write(static_cast<uint64_t>(detectorIDs.size()));
+  for (const auto id : detectorIDs) {
+    out.write(instrumentWriter.indexOf(instrument.getBaseDetector(id)));
+    out.write(instrument.isMonitor(id) ? IsMonitor : IsDetector);
+  }
+  out.write(instrumentWriter.indexOf(instrument.getSource().get()));
+  out.write(instrumentWriter.indexOf(instrument.getSample().get()));
+
+  const auto &parameters = instrument.getLogfileCache();
+  out.write(static_cast<uint64_t>(parameters.size()));
+  for (const auto &item : parameters) {
+    const auto &parameter = *item.second;
+    out.writeString(item.first.first);
+    out.write(instrumentWriter.indexOf(item.first.second));
+    out.writeString(parameter.m_logfileID);
+    out.writeString(parameter.m_value);
+    out.write(static_cast<uint8_t>(parameter.m_interpolation != nullptr));
+    if (parameter.m_interpolation) {
+      std::ostringstream interpolation;
+      interpolation.precision(17);
+      interpolation << *parameter.m_interpolation;
+      out.writeString(interpolation.str());
+    }
+    out.writeString(parameter.m_formula);
+    out.writeString(parameter.m_formulaUnit);
+    out.writeString(parameter.m_resultUnit);
+    out.writeString(parameter.m_paramName);
+    out.writeString(parameter.m_type);
+    out.writeString(parameter.m_tie);
+    out.write(static_cast<uint64_t>(parameter.m_constraint.size()));
+    for (const auto &constraint : parameter.m_constraint)
+      out.writeString(constraint);
+    out.writeString(parameter.m_penaltyFactor);
+    out.writeString(parameter.m_fittingFunction);
+    out.writeString(parameter.m_extractSingleValueAs);
+    out.writeString(parameter.m_eq);
+    out.write(instrumentWriter.indexOf(parameter.m_component));
+    out.write(parameter.m_angleConvertConst);
+    out.writeString(parameter.m_description);
+  }
+  return out.buffer();
+}
+
+/// @return the instrument held in buffer, or nullptr if it was written for
+/// another instrument definition, another version of the file layout or by a
+/// machine of the other byte order
+Instrument_sptr deserialize(const std::string &buffer,
+                            const std::string &mangledName) {
+  Reader in(buffer);
+  if (in.read<uint32_t>() != BYTE_ORDER_MARK ||
+      in.read<uint32_t>() != FILE_VERSION || in.readString() != mangledName)
+    return nullptr;
+
+  auto instrument = boost::make_shared<Instrument>(in.readString());
+  instrument->setPos(in.readV3D());
+  instrument->setRot(in.readQuat());
+  instrument->setDefaultView(in.readString());
+  instrument->setDefaultViewAxis(in.readString());
+  instrument->setValidFromDate(DateAndTime(in.read<int64_t>()));
+  instrument->setValidToDate(DateAndTime(in.read<int64_t>()));
+  instrument->setFilename(in.readString());
+  instrument->setXmlText(in.readString());
+
+  const auto up = static_cast<PointingAlong>(in.read<uint8_t>());
+  const auto alongBeam = static_cast<PointingAlong>(in.read<uint8_t>());
+  const auto thetaSign = static_cast<PointingAlong>(in.read<uint8_t>());
+  const auto handedness = static_cast<Handedness>(in.read<uint8_t>());
+  instrument->setReferenceFrame(boost::make_shared<ReferenceFrame>(
+      up, alongBeam, thetaSign, handedness, in.readString()));
+
+  auto &units = instrument->getLogfileUnit();
+  const auto numUnits = in.read<uint64_t>();
+  for (uint64_t i = 0; i < numUnits; ++i) {
+    auto key = in.readString();
+    units[key] = in.readString();
+  }
+
+  InstrumentReader instrumentReader(in);
+  instrumentReader.readShapes();
+  instrumentReader.readChildren(*instrument);
+
+  std::vector<const IComponent *> components;
+  flatten(instrument.get(), components);
+  const auto component = [&components](const int64_t index) {
+    return index < 0 ? nullptr
+                     : components.at(static_cast<size_t>(index));
+  };
+
+  const auto numDetectors = in.read<uint64_t>();
+  std::vector<const IDetector *> monitors;
+  for (uint64_t i = 0; i < numDetectors; ++i) {
+    const auto *detector =
+        dynamic_cast<const IDetector *>(component(in.read<int64_t>()));
+    if (!detector)
+      throw std::runtime_error("A marked detector is not a detector");
+    if (in.read<DetectorMark>() == IsMonitor)
+      monitors.emplace_back(detector);
+    else
+      instrument->markAsDetectorIncomplete(detector);
+  }
+  instrument->markAsDetectorFinalize();
+  for (const auto *monitor : monitors)
+    instrument->markAsMonitor(monitor);
+  if (const auto *source = component(in.read<int64_t>()))
+    instrument->markAsSource(source);
+  if (const auto *sample = component(in.read<int64_t>()))
+    instrument->markAsSamplePos(sample);
+
+  auto &parameters = instrument->getLogfileCache();
+  const auto numParameters = in.read<uint64_t>();
+  for (uint64_t i = 0; i < numParameters; ++i) {
+    auto key = std::make_pair(in.readString(), component(in.read<int64_t>()));
+    const auto logfileID = in.readString();
+    const auto value = in.readString();
+    boost::shared_ptr<Kernel::Interpolation> interpolation;
+    if (in.read<uint8_t>() != 0) {
+      interpolation = boost::make_shared<Kernel::Interpolation>();
+      std::istringstream text(in.readString());
+      text >> *interpolation;
+    }
+    const auto formula = in.readString();
+    const auto formulaUnit = in.readString();
+    const auto resultUnit = in.readString();
+    const auto paramName = in.readString();
+    const auto type = in.readString();
+    const auto tie = in.readString();
+    std::vector<std::string> constraint(
+        static_cast<size_t>(in.read<uint64_t>()));
+    for (auto &item : constraint)
+      item = in.readString();
+    auto penaltyFactor = in.readString();
+    const auto fittingFunction = in.readString();
+    const auto extractSingleValueAs = in.readString();
+    const auto eq = in.readString();
+    const auto *parameterComponent = component(in.read<int64_t>());
+    const auto angleConvertConst = in.read<double>();
+    const auto description = in.readString();
+    parameters.emplace(
+        std::move(key),
+        boost::make_shared<XMLInstrumentParameter>(
+            logfileID, value, interpolation, formula, formulaUnit, resultUnit,
+            paramName, type, tie, constraint, penaltyFactor, fittingFunction,
+            extractSingleValueAs, eq, parameterComponent, angleConvertConst,
+            description));
+  }
+  return instrument;
+}
+} // namespace
+
+/// Use the directory set by instrumentDefinition.cacheDirectory, if any
+InstrumentCache::InstrumentCache()
+    : InstrumentCache(Kernel::ConfigService::Instance().getString(
+          "instrumentDefinition.cacheDirectory")) {}
+
+/**
+ * @param directory :: the directory holding the files, empty to disable the
+ * cache
+ */
+InstrumentCache::InstrumentCache(std::string directory)
+    : m_directory(std::move(directory)) {}
+
+/**
+ * @param mangledName :: the mangled name of the instrument definition, see
+ * InstrumentDefinitionParser::getMangledName
+ * @return the path of the file holding the instrument
+ */
+std::string InstrumentCache::filename(const std::string &mangledName) const {
+  Poco::Path path(m_directory);
+  path.makeDirectory();
+  path.setFileName(mangledName + EXTENSION);
+  return path.toString();
+}
+
+/**
+ * Write an instrument that has just been built from its definition. The file
+ * is written under a temporary name and renamed so that other processes never
+ * read a partial file.
+ * @param instrument :: the instrument
+ * @param mangledName :: the mangled name of the instrument definition
+ * @return true if the instrument has been written
+ */
+bool InstrumentCache::save(const Instrument &instrument,
+                           const std::string &mangledName) const {
+  if (!isEnabled() || mangledName.empty())
+    return false;
+  std::string content;
+  try {
+    content = serialize(instrument, mangledName);
+  } catch (const std::exception &e) {
+    g_log.information() << "Instrument " << instrument.getName()
+                        << " is not cached: " << e.what() << '\n';
+    return false;
+  }
+
+  const auto target = filename(mangledName);
+  const auto temporary =
+      target + "." + std::to_string(Poco::Process::id()) + ".tmp";
+  try {
+    Poco::File(m_directory).createDirectories();
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    out.close();
+    if (!out)
+      throw std::runtime_error("Unable to write " + temporary);
+    Poco::File(temporary).renameTo(target);
+  } catch (const std::exception &e) {
+    g_log.warning() << "Unable to cache instrument " << instrument.getName()
+                    << ": " << e.what() << '\n';
+    try {
+      Poco::File(temporary).remove();
+    } catch (const Poco::Exception &) {
+    }
+    return false;
+  }
+  g_log.debug() << "Cached instrument " << instrument.getName() << " in "
+                << target << '\n';
+  return true;
+}
+
+/**
+ * @param mangledName :: the mangled name of the instrument definition
+ * @return the instrument, or nullptr if it is not in the cache or the file
+ * cannot be read
+ */
+Instrument_sptr InstrumentCache::load(const std::string &mangledName) const {
+  if (!isEnabled() || mangledName.empty())
+    return nullptr;
+  const auto path = filename(mangledName);
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in)
+    return nullptr;
+  std::string content(static_cast<size_t>(in.tellg()), '\0');
+  in.seekg(0);
+  in.read(&content[0], static_cast<std::streamsize>(content.size()));
+  if (!in) {
+    g_log.warning("Unable to read cached instrument " + path);
+    return nullptr;
+  }
+  try {
+    auto instrument = deserialize(content, mangledName);
+    if (instrument)
+      g_log.debug("Loaded cached instrument " + path);
+    return instrument;
+  } catch (const std::exception &e) {
+    g_log.warning() << "Unable to load cached instrument " << path << ": "
+                    << e.what() << '\n';
+    return nullptr;
+  }
+}
+
+} // namespace Geometry
+} // namespace Mantid
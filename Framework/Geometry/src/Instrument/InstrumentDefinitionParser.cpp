@@ -20,6 +20,7 @@
 #include "MantidKernel/ChecksumHelper.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/ParallelFor.h"
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/UnitFactory.h"
@@ -56,6 +57,115 @@ namespace Geometry {
 namespace {
 // initialize the static logger
 Kernel::Logger g_log("InstrumentDefinitionParser");
+
+/// The attributes of a <locations> element
+struct LocationsElement {
+  /// Number of <location> this <locations> element is shorthand for
+  size_t nElements = 0;
+  /// Name of the locations, to which the count is appended
+  std::string name;
+  int nameCountStart = 0;
+  int nameCountIncrement = 1;
+  /// Numeric attributes of the current location. If an attribute isn't here,
+  /// it wasn't set
+  std::map<std::string, double> values;
+  /// Steps added to the range attributes from one location to the next
+  std::map<std::string, double> steps;
+
+  /// @return the name of the i-th location, empty if the locations are unnamed
+  std::string locationName(const size_t i) const {
+    if (name.empty())
+      return name;
+    return name + std::to_string(nameCountStart + (i * nameCountIncrement));
+  }
+  /// Move the range attributes to the next location
+  void next() {
+    for (const auto &step : steps)
+      values[step.first] += step.second;
+  }
+};
+
+/** Read the attributes of a <locations> element
+ * @param pElem :: the <locations> element
+ * @return the attributes, with the values of the first location
+ * @throw InstrumentDefinitionError if the attributes are invalid
+ */
+LocationsElement readLocationsElement(const Poco::XML::Element *pElem) {
+  LocationsElement locations;
+  if (pElem->hasAttribute("n-elements")) {
+    auto n = boost::lexical_cast<int>(
+        Strings::strip(pElem->getAttribute("n-elements")));
+
+    if (n <= 0) {
+      throw Exception::InstrumentDefinitionError("n-elements must be positive");
+    } else {
+      locations.nElements = static_cast<size_t>(n);
+    }
+  } else {
+    throw Exception::InstrumentDefinitionError(
+        "When using <locations> n-elements attribute is required. See "
+        "www.mantidproject.org/IDF.");
+  }
+
+  if (pElem->hasAttribute("name")) {
+    locations.name = pElem->getAttribute("name");
+  }
+
+  if (pElem->hasAttribute("name-count-start")) {
+    locations.nameCountStart = boost::lexical_cast<int>(
+        Strings::strip(pElem->getAttribute("name-count-start")));
+  }
+
+  if (pElem->hasAttribute("name-count-increment")) {
+    locations.nameCountIncrement = boost::lexical_cast<int>(
+        Strings::strip(pElem->getAttribute("name-count-increment")));
+
+    if (locations.nameCountIncrement <= 0)
+      throw Exception::InstrumentDefinitionError(
+          "name-count-increment must be greater than zero.");
+  }
+
+  // A list of numeric attributes which are allowed to have corresponding -end
+  std::set<std::string> rangeAttrs = {"x", "y", "z", "r", "t", "p", "rot"};
+
+  // Numeric attributes related to rotation. Doesn't make sense to have -end
+  // for
+  // those
+  std::set<std::string> rotAttrs = {"axis-x", "axis-y", "axis-z"};
+
+  // A set of all numeric attributes for convenience
+  std::set<std::string> allAttrs;
+  allAttrs.insert(rangeAttrs.begin(), rangeAttrs.end());
+  allAttrs.insert(rotAttrs.begin(), rotAttrs.end());
+
+  // Read all the set attribute values
+  for (const auto &attr : allAttrs) {
+    if (pElem->hasAttribute(attr)) {
+      locations.values[attr] = boost::lexical_cast<double>(
+          Strings::strip(pElem->getAttribute(attr)));
+    }
+  }
+
+  // Find *-end for range attributes and calculate steps
+  for (const auto &rangeAttr : rangeAttrs) {
+    std::string endAttr = rangeAttr + "-end";
+    if (pElem->hasAttribute(endAttr)) {
+      if (locations.values.find(rangeAttr) == locations.values.end()) {
+        throw Exception::InstrumentDefinitionError(
+            "*-end attribute without corresponding * attribute.");
+      }
+
+      double from = locations.values[rangeAttr];
+      auto to = boost::lexical_cast<double>(
+          Strings::strip(pElem->getAttribute(endAttr)));
+
+      locations.steps[rangeAttr] =
+          (to - from) / (static_cast<double>(locations.nElements) - 1);
+    }
+  }
+
+  return locations;
+}
 } // namespace
 //----------------------------------------------------------------------------------------------
 /** Default Constructor - not very functional in this state
@@ -460,7 +570,7 @@ void InstrumentDefinitionParser::
   while (pNode) {
     if (pNode->nodeName() == "parameter") {
       auto pParameterElem = dynamic_cast<Element *>(pNode);
-      m_hasParameterElement.emplace_back(
+      m_hasParameterElement.emplace(
           dynamic_cast<Element *>(pParameterElem->parentNode()));
     }
     pNode = it.nextNode();
@@ -582,12 +692,16 @@ void InstrumentDefinitionParser::getTypeAndComponentPointers(
 void InstrumentDefinitionParser::appendLocations(
     Geometry::ICompAssembly *parent, const Poco::XML::Element *pLocElems,
     const Poco::XML::Element *pCompElem, IdList &idList) {
+  const bool assembly = isAssembly(pCompElem->getAttribute("type"));
+  if (!assembly &&
+      appendDetectorLocations(parent, pLocElems, pCompElem, idList))
+    return;
+
   // create detached <location> elements from <locations> element
   Poco::AutoPtr<Document> pLocationsDoc = convertLocationsElement(pLocElems);
 
   // Get pointer to root element
   const Element *pRootLocationsElem = pLocationsDoc->documentElement();
-  const bool assembly = isAssembly(pCompElem->getAttribute("type"));
 
   auto *pElem =
       dynamic_cast<Poco::XML::Element *>(pRootLocationsElem->firstChild());
@@ -608,6 +722,121 @@ void InstrumentDefinitionParser::appendLocations(
   }
 }
 
+//-----------------------------------------------------------------------------------------------------------------------
+/** Append the detectors or monitors of a \<locations\> element whose
+ *component type is a single detector, without expanding it into \<location\>
+ *elements. The positions and names are resolved first, the detectors are then
+ *created, positioned and made to face the default facing in parallel, and
+ *finally added to the parent and marked in the order of the locations, giving
+ *the same instrument as appendLeaf() for each location.
+ *
+ *  @param parent :: CompAssembly to append the detectors to
+ *  @param pLocElems ::  Poco::XML element that points to a locations element
+ *  @param pCompElem :: The Poco::XML \<component\> element that contains the
+ *\<locations\> element
+ *  @param idList :: The current IDList
+ *  @return false if nothing was appended because the detectors need
+ *appendLeaf(), e.g. for offsets, neutronic positions or to report errors
+ *
+ *  @throw InstrumentDefinitionError Thrown if issues with the content of XML
+ *instrument file
+ */
+bool InstrumentDefinitionParser::appendDetectorLocations(
+    Geometry::ICompAssembly *parent, const Poco::XML::Element *pLocElems,
+    const Poco::XML::Element *pCompElem, IdList &idList) {
+  if (m_deltaOffsets || m_indirectPositions ||
+      pCompElem->hasAttribute("mark-as"))
+    return false;
+
+  const std::string typeName = pCompElem->getAttribute("type");
+  const std::string category = getTypeElement[typeName]->getAttribute("is");
+  static const boost::regex exp("Detector|detector|Monitor|monitor");
+  if (!boost::regex_match(category, exp))
+    return false;
+
+  populateIdListOfComponent(pCompElem, idList);
+  auto locations = readLocationsElement(pLocElems);
+  const size_t nElements = locations.nElements;
+  const auto firstID = static_cast<size_t>(idList.counted);
+  if (firstID + nElements > idList.vec.size())
+    return false;
+
+  // Resolve the names and relative positions of the detectors. The values of
+  // the attributes are accumulated as in convertLocationsElement().
+  const auto &values = locations.values;
+  const auto value = [&values](const std::string &attr,
+                                const double fallback) {
+    const auto it = values.find(attr);
+    return it == values.end() ? fallback : it->second;
+  };
+  const bool polar =
+      values.count("r") > 0 || values.count("t") > 0 || values.count("p") > 0;
+  const bool rotated = values.count("rot") > 0;
+  const std::string componentName = pCompElem->hasAttribute("name")
+                                        ? pCompElem->getAttribute("name")
+                                        : typeName;
+  std::vector<std::string> names(nElements, componentName);
+  std::vector<Kernel::V3D> positions(nElements);
+  std::vector<Kernel::Quat> rotations(rotated ? nElements : 0);
+  for (size_t i = 0; i < nElements; ++i) {
+    if (!locations.name.empty())
+      names[i] = locations.locationName(i);
+    if (polar) {
+      positions[i].spherical(value("r", 0.),
+                             m_angleConvertConst * value("t", 0.),
+                             m_angleConvertConst * value("p", 0.));
+    } else {
+      positions[i] =
+          Kernel::V3D(value("x", 0.), value("y", 0.), value("z", 0.));
+    }
+    if (rotated) {
+      rotations[i] = Kernel::Quat(
+          m_angleConvertConst * value("rot", 0.),
+          Kernel::V3D(value("axis-x", 0.), value("axis-y", 0.),
+                      value("axis-z", 1.)));
+    }
+    locations.next();
+  }
+
+  // Create the detectors
+  const auto shape = mapTypeNameToShape[typeName];
+  std::vector<std::unique_ptr<Geometry::Detector>> detectors(nElements);
+  Kernel::parallelFor(0, nElements, [&](const size_t i) {
+    auto detector = std::make_unique<Geometry::Detector>(
+        names[i], idList.vec[firstID + i], shape, parent);
+    detector->setPos(positions[i]);
+    if (rotated)
+      detector->rotate(rotations[i]);
+    if (m_haveDefaultFacing) {
+      IComponent *comp = detector.get();
+      makeXYplaneFaceComponent(comp, m_defaultFacing);
+    }
+    detectors[i] = std::move(detector);
+  });
+
+  // Add them to the instrument in order
+  const bool monitor = category == "Monitor" || category == "monitor";
+  for (auto &created : detectors) {
+    auto *detector = created.release();
+    parent->add(detector);
+    idList.counted++;
+    setLogfile(detector, pCompElem, m_instrument->getLogfileCache());
+    try {
+      if (monitor)
+        m_instrument->markAsMonitor(detector);
+      else
+        m_instrument->markAsDetectorIncomplete(detector);
+    } catch (Kernel::Exception::ExistsError &) {
+      throw Kernel::Exception::InstrumentDefinitionError(
+          "Detector with ID = " + std::to_string(detector->getID()) +
+              " present more then once in XML instrument file",
+          m_xmlFile->getFileFullPathStr());
+    }
+    m_facingComponent.emplace_back(detector);
+  }
+  return true;
+}
+
 //-----------------------------------------------------------------------------------------------------------------------
 /** Save DOM tree to xml file. This method was initially added for testing
  *purpose
@@ -1130,7 +1359,6 @@ std::vector<std::string> InstrumentDefinitionParser::buildExcludeList(
 void InstrumentDefinitionParser::appendAssembly(
     Geometry::ICompAssembly *parent, const Poco::XML::Element *pLocElem,
     const Poco::XML::Element *pCompElem, IdList &idList) {
-  const std::string filename = m_xmlFile->getFileFullPathStr();
   // The location element is required to be a child of a component element. Get
   // this component element
   // Element* pCompElem =
@@ -1140,23 +1368,7 @@ void InstrumentDefinitionParser::appendAssembly(
   // Note idlist may be defined for any component
   // Note any new idlist found will take precedence.
 
-  if (pCompElem->hasAttribute("idlist")) {
-    std::string idlist = pCompElem->getAttribute("idlist");
-
-    if (idlist != idList.idname) {
-      Element *pFound =
-          pCompElem->ownerDocument()->getElementById(idlist, "idname");
-
-      if (pFound == nullptr) {
-        throw Kernel::Exception::InstrumentDefinitionError(
-            "No <idlist> with name idname=\"" + idlist +
-                "\" present in instrument definition file.",
-            filename);
-      }
-      idList.reset();
-      populateIdList(pFound, idList);
-    }
-  }
+  populateIdListOfComponent(pCompElem, idList);
 
   // Create the assembly that will be appended into the parent.
   Geometry::ICompAssembly *ass;
@@ -1764,24 +1976,7 @@ void InstrumentDefinitionParser::appendLeaf(Geometry::ICompAssembly *parent,
   // Note idlist may be defined for any component
   // Note any new idlist found will take precedence.
 
-  if (pCompElem->hasAttribute("idlist")) {
-    std::string idlist = pCompElem->getAttribute("idlist");
-
-    if (idlist != idList.idname) {
-      Element *pFound =
-          pCompElem->ownerDocument()->getElementById(idlist, "idname");
-
-      if (pFound == nullptr) {
-        throw Kernel::Exception::InstrumentDefinitionError(
-            "No <idlist> with name idname=\"" + idlist +
-                "\" present in instrument definition file.",
-            filename);
-      }
-
-      idList.reset();
-      populateIdList(pFound, idList);
-    }
-  }
+  populateIdListOfComponent(pCompElem, idList);
 
   // get the type element of the component element in order to determine if
   // the
@@ -1840,6 +2035,35 @@ void InstrumentDefinitionParser::appendLeaf(Geometry::ICompAssembly *parent,
   }
 }
 
+//-----------------------------------------------------------------------------------------------------------------------
+/** Populate the IdList from the \<idlist\> referred to by the idlist
+ *attribute of a component, if any and if it is not the current one.
+ *
+ *  @param pCompElem :: Poco::XML \<component\> element
+ *  @param idList :: The current IDList
+ *
+ *  @throw InstrumentDefinitionError Thrown if the \<idlist\> doesn't exist
+ */
+void InstrumentDefinitionParser::populateIdListOfComponent(
+    const Poco::XML::Element *pCompElem, IdList &idList) {
+  if (!pCompElem->hasAttribute("idlist"))
+    return;
+  const std::string idlist = pCompElem->getAttribute("idlist");
+  if (idlist == idList.idname)
+    return;
+
+  Element *pFound =
+      pCompElem->ownerDocument()->getElementById(idlist, "idname");
+  if (pFound == nullptr) {
+    throw Kernel::Exception::InstrumentDefinitionError(
+        "No <idlist> with name idname=\"" + idlist +
+            "\" present in instrument definition file.",
+        m_xmlFile->getFileFullPathStr());
+  }
+  idList.reset();
+  populateIdList(pFound, idList);
+}
+
 //-----------------------------------------------------------------------------------------------------------------------
 /** Method for populating IdList.
  *
@@ -2181,9 +2405,7 @@ void InstrumentDefinitionParser::setLogfile(
   // parameter, see
   // defintion of m_hasParameterElement for more info
   if (m_hasParameterElement_beenSet)
-    if (m_hasParameterElement.end() == std::find(m_hasParameterElement.begin(),
-                                                 m_hasParameterElement.end(),
-                                                 pElem))
+    if (m_hasParameterElement.count(pElem) == 0)
       return;
 
   Poco::AutoPtr<NodeList> pNL_comp =
@@ -2973,117 +3195,28 @@ std::string InstrumentDefinitionParser::translateRotateXMLcuboid(
 Poco::AutoPtr<Poco::XML::Document>
 InstrumentDefinitionParser::convertLocationsElement(
     const Poco::XML::Element *pElem) {
-  // Number of <location> this <locations> element is shorthand for
-  size_t nElements(0);
-  if (pElem->hasAttribute("n-elements")) {
-    auto n = boost::lexical_cast<int>(
-        Strings::strip(pElem->getAttribute("n-elements")));
-
-    if (n <= 0) {
-      throw Exception::InstrumentDefinitionError("n-elements must be positive");
-    } else {
-      nElements = static_cast<size_t>(n);
-    }
-  } else {
-    throw Exception::InstrumentDefinitionError(
-        "When using <locations> n-elements attribute is required. See "
-        "www.mantidproject.org/IDF.");
-  }
-
-  std::string name;
-  if (pElem->hasAttribute("name")) {
-    name = pElem->getAttribute("name");
-  }
-
-  int nameCountStart(0);
-  if (pElem->hasAttribute("name-count-start")) {
-    nameCountStart = boost::lexical_cast<int>(
-        Strings::strip(pElem->getAttribute("name-count-start")));
-  }
-
-  int nameCountIncrement(1);
-  if (pElem->hasAttribute("name-count-increment")) {
-    nameCountIncrement = boost::lexical_cast<int>(
-        Strings::strip(pElem->getAttribute("name-count-increment")));
-
-    if (nameCountIncrement <= 0)
-      throw Exception::InstrumentDefinitionError(
-          "name-count-increment must be greater than zero.");
-  }
-
-  // A list of numeric attributes which are allowed to have corresponding -end
-  std::set<std::string> rangeAttrs = {"x", "y", "z", "r", "t", "p", "rot"};
-
-  // Numeric attributes related to rotation. Doesn't make sense to have -end
-  // for
-  // those
-  std::set<std::string> rotAttrs = {"axis-x", "axis-y", "axis-z"};
-
-  // A set of all numeric attributes for convenience
-  std::set<std::string> allAttrs;
-  allAttrs.insert(rangeAttrs.begin(), rangeAttrs.end());
-  allAttrs.insert(rotAttrs.begin(), rotAttrs.end());
-
-  // Attribute values as read from <locations>. If the attribute doesn't have
-  // a
-  // value here, it
-  // means that it wasn't set
-  std::map<std::string, double> attrValues;
-
-  // Read all the set attribute values
-  for (const auto &attr : allAttrs) {
-    if (pElem->hasAttribute(attr)) {
-      attrValues[attr] = boost::lexical_cast<double>(
-          Strings::strip(pElem->getAttribute(attr)));
-    }
-  }
-
-  // Range attribute steps
-  std::map<std::string, double> rangeAttrSteps;
-
-  // Find *-end for range attributes and calculate steps
-  for (const auto &rangeAttr : rangeAttrs) {
-    std::string endAttr = rangeAttr + "-end";
-    if (pElem->hasAttribute(endAttr)) {
-      if (attrValues.find(rangeAttr) == attrValues.end()) {
-        throw Exception::InstrumentDefinitionError(
-            "*-end attribute without corresponding * attribute.");
-      }
-
-      double from = attrValues[rangeAttr];
-      auto to = boost::lexical_cast<double>(
-          Strings::strip(pElem->getAttribute(endAttr)));
-
-      rangeAttrSteps[rangeAttr] =
-          (to - from) / (static_cast<double>(nElements) - 1);
-    }
-  }
+  auto locations = readLocationsElement(pElem);
 
   Poco::AutoPtr<Document> pDoc = new Document;
   Poco::AutoPtr<Element> pRoot =
       pDoc->createElement("expansion-of-locations-element");
   pDoc->appendChild(pRoot);
 
-  for (size_t i = 0; i < nElements; ++i) {
+  for (size_t i = 0; i < locations.nElements; ++i) {
     Poco::AutoPtr<Element> pLoc = pDoc->createElement("location");
 
-    if (!name.empty()) {
+    if (!locations.name.empty()) {
       // Add name with appropriate numeric postfix
-      pLoc->setAttribute(
-          "name",
-          name + std::to_string(nameCountStart + (i * nameCountIncrement)));
+      pLoc->setAttribute("name", locations.locationName(i));
     }
 
     // Copy values of all the attributes set
-    for (auto &attrValue : attrValues) {
+    for (const auto &attrValue : locations.values) {
       pLoc->setAttribute(attrValue.first,
                          boost::lexical_cast<std::string>(attrValue.second));
-
-      // If attribute has a step, increase the value by the step
-      if (rangeAttrSteps.find(attrValue.first) != rangeAttrSteps.end()) {
-        attrValue.second += rangeAttrSteps[attrValue.first];
-      }
     }
+    // Increase the values of the range attributes by their step
+    locations.next();
 
     pRoot->appendChild(pLoc);
   }
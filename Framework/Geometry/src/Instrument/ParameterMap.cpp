@@ -14,8 +14,10 @@
 #include "MantidKernel/Cache.h"
 #include "MantidKernel/MultiThreaded.h"
 #include <boost/algorithm/string.hpp>
+#include <boost/make_shared.hpp>
 #include <cstring>
 #include <nexus/NeXusFile.hpp>
+#include <unordered_map>
 
 #ifdef _WIN32
 #define strcasecmp _stricmp
@@ -58,6 +60,28 @@ void checkIsNotMaskingParameter(const std::string &name) {
                              "ParameterMap. Use DetectorInfo instead");
 }
 } // namespace
+
+/// The parameter found by getRecursive() for each component index, for one
+/// parameter name and type
+struct ParameterMap::InheritedParameters {
+  /// For each component, one plus the index of its parameter, or 0 if none
+  std::vector<uint32_t> owners;
+  /// The distinct parameters
+  std::vector<Parameter_sptr> parameters;
+
+  Parameter_sptr get(const size_t componentIndex) const {
+    const auto owner = owners[componentIndex];
+    return owner == 0 ? Parameter_sptr() : parameters[owner - 1];
+  }
+};
+
+/// The tables of inherited parameters built at one revision of the map. They
+/// are never modified once shared: new tables are added to a copy.
+struct ParameterMap::InheritanceTables {
+  size_t revision;
+  std::unordered_map<std::string, boost::shared_ptr<const InheritedParameters>>
+      tables;
+};
 /**
  * Default constructor
  */
@@ -70,12 +94,11 @@ ParameterMap::ParameterMap()
 ParameterMap::ParameterMap(const ParameterMap &other)
     : m_parameterFileNames(other.m_parameterFileNames), m_map(other.m_map),
       m_cacheLocMap(
-          std::make_unique<Kernel::Cache<const ComponentID, Kernel::V3D>>(
-              *other.m_cacheLocMap)),
+          std::make_unique<Kernel::Cache<const ComponentID, Kernel::V3D>>()),
       m_cacheRotMap(
-          std::make_unique<Kernel::Cache<const ComponentID, Kernel::Quat>>(
-              *other.m_cacheRotMap)),
-      m_instrument(other.m_instrument) {
+          std::make_unique<Kernel::Cache<const ComponentID, Kernel::Quat>>()),
+      m_inheritanceTables(boost::atomic_load(&other.m_inheritanceTables)),
+      m_revision(other.m_revision.load()), m_instrument(other.m_instrument) {
   if (m_instrument)
     std::tie(m_componentInfo, m_detectorInfo) =
         m_instrument->makeBeamline(*this, &other);
@@ -149,14 +172,14 @@ bool ParameterMap::operator==(const ParameterMap &rhs) const {
   // asString method turns the ComponentIDs to full-qualified name identifiers
   // so we will use the same approach to compare them
 
-  auto thisEnd = this->m_map.cend();
-  auto rhsEnd = rhs.m_map.cend();
-  for (auto thisIt = this->m_map.begin(); thisIt != thisEnd; ++thisIt) {
+  auto thisEnd = this->m_map->cend();
+  auto rhsEnd = rhs.m_map->cend();
+  for (auto thisIt = this->m_map->begin(); thisIt != thisEnd; ++thisIt) {
     const IComponent *comp = static_cast<IComponent *>(thisIt->first);
     const std::string fullName = comp->getFullName();
     const auto &param = thisIt->second;
     bool match(false);
-    for (auto rhsIt = rhs.m_map.cbegin(); rhsIt != rhsEnd; ++rhsIt) {
+    for (auto rhsIt = rhs.m_map->cbegin(); rhsIt != rhsEnd; ++rhsIt) {
       const IComponent *rhsComp = static_cast<IComponent *>(rhsIt->first);
       const std::string rhsFullName = rhsComp->getFullName();
       if (fullName == rhsFullName && (*param) == (*rhsIt->second)) {
@@ -181,7 +204,7 @@ const std::string ParameterMap::getDescription(const std::string &compName,
                                                const std::string &name) const {
   pmap_cit it;
   std::string result;
-  for (it = m_map.begin(); it != m_map.end(); ++it) {
+  for (it = m_map->begin(); it != m_map->end(); ++it) {
     if (compName == it->first->getName()) {
       boost::shared_ptr<Parameter> param = get(it->first, name);
       if (param) {
@@ -205,7 +228,7 @@ ParameterMap::getShortDescription(const std::string &compName,
                                   const std::string &name) const {
   pmap_cit it;
   std::string result;
-  for (it = m_map.begin(); it != m_map.end(); ++it) {
+  for (it = m_map->begin(); it != m_map->end(); ++it) {
     if (compName == it->first->getName()) {
       boost::shared_ptr<Parameter> param = get(it->first, name);
       if (param) {
@@ -246,14 +269,14 @@ const std::string ParameterMap::diff(const ParameterMap &rhs,
   // so we will use the same approach to compare them
 
   std::stringstream strOutput;
-  auto thisEnd = this->m_map.cend();
-  auto rhsEnd = rhs.m_map.cend();
-  for (auto thisIt = this->m_map.cbegin(); thisIt != thisEnd; ++thisIt) {
+  auto thisEnd = this->m_map->cend();
+  auto rhsEnd = rhs.m_map->cend();
+  for (auto thisIt = this->m_map->cbegin(); thisIt != thisEnd; ++thisIt) {
     const IComponent *comp = static_cast<IComponent *>(thisIt->first);
     const std::string fullName = comp->getFullName();
     const auto &param = thisIt->second;
     bool match(false);
-    for (auto rhsIt = rhs.m_map.cbegin(); rhsIt != rhsEnd; ++rhsIt) {
+    for (auto rhsIt = rhs.m_map->cbegin(); rhsIt != rhsEnd; ++rhsIt) {
       const IComponent *rhsComp = static_cast<IComponent *>(rhsIt->first);
       const std::string rhsFullName = rhsComp->getFullName();
       if (fullName == rhsFullName && (*param) == (*rhsIt->second)) {
@@ -270,7 +293,7 @@ const std::string ParameterMap::diff(const ParameterMap &rhs,
                 << " and value: " << (*param).asString() << '\n';
       bool componentWithSameNameRHS = false;
       bool parameterWithSameNameRHS = false;
-      for (auto rhsIt = rhs.m_map.cbegin(); rhsIt != rhsEnd; ++rhsIt) {
+      for (auto rhsIt = rhs.m_map->cbegin(); rhsIt != rhsEnd; ++rhsIt) {
         const IComponent *rhsComp = static_cast<IComponent *>(rhsIt->first);
         const std::string rhsFullName = rhsComp->getFullName();
         if (fullName == rhsFullName) {
@@ -303,13 +326,15 @@ const std::string ParameterMap::diff(const ParameterMap &rhs,
 void ParameterMap::clearParametersByName(const std::string &name) {
   checkIsNotMaskingParameter(name);
   // Key is component ID so have to search through whole lot
-  for (auto itr = m_map.begin(); itr != m_map.end();) {
+  auto &map = m_map.access();
+  for (auto itr = map.begin(); itr != map.end();) {
     if (itr->second->name() == name) {
-      PARALLEL_CRITICAL(unsafe_erase) { itr = m_map.unsafe_erase(itr); }
+      PARALLEL_CRITICAL(unsafe_erase) { itr = map.unsafe_erase(itr); }
     } else {
       ++itr;
     }
   }
+  clearInheritedParameters();
   // Check if the caches need invalidating
   if (name == pos() || name == rot())
     clearPositionSensitiveCaches();
@@ -323,16 +348,18 @@ void ParameterMap::clearParametersByName(const std::string &name) {
 void ParameterMap::clearParametersByName(const std::string &name,
                                          const IComponent *comp) {
   checkIsNotMaskingParameter(name);
-  if (!m_map.empty()) {
+  if (!m_map->empty()) {
+    auto &map = m_map.access();
     const ComponentID id = comp->getComponentID();
-    auto itrs = m_map.equal_range(id);
+    auto itrs = map.equal_range(id);
     for (auto it = itrs.first; it != itrs.second;) {
       if (it->second->name() == name) {
-        PARALLEL_CRITICAL(unsafe_erase) { it = m_map.unsafe_erase(it); }
+        PARALLEL_CRITICAL(unsafe_erase) { it = map.unsafe_erase(it); }
       } else {
         ++it;
       }
     }
+    clearInheritedParameters();
 
     // Check if the caches need invalidating
     if (name == pos() || name == rot())
@@ -386,7 +413,7 @@ void ParameterMap::add(const IComponent *comp,
   // However, this is old behavior and many things rely on this actually be
   // an
   // add/replace-style function
-  if (existing_par != m_map.end()) {
+  if (existing_par != m_map->end()) {
     boost::atomic_store(&(existing_par->second), par);
   } else {
 // When using Clang & Linux, TBB 4.4 doesn't detect C++11 features.
@@ -397,11 +424,12 @@ void ParameterMap::add(const IComponent *comp,
 #define CLANG_ON_LINUX false
 #endif
 #if TBB_VERSION_MAJOR >= 4 && TBB_VERSION_MINOR >= 4 && !CLANG_ON_LINUX
-    m_map.emplace(comp->getComponentID(), par);
+    m_map.access().emplace(comp->getComponentID(), par);
 #else
-    m_map.insert(std::make_pair(comp->getComponentID(), par));
+    m_map.access().insert(std::make_pair(comp->getComponentID(), par));
 #endif
   }
+  clearInheritedParameters();
 }
 
 /** Create or adjust "pos" parameter for a component
@@ -637,10 +665,11 @@ void ParameterMap::forceUnsafeSetMasked(const IComponent *comp, bool value) {
 #define CLANG_ON_LINUX false
 #endif
 #if TBB_VERSION_MAJOR >= 4 && TBB_VERSION_MINOR >= 4 && !CLANG_ON_LINUX
-  m_map.emplace(comp->getComponentID(), param);
+  m_map.access().emplace(comp->getComponentID(), param);
 #else
-  m_map.insert(std::make_pair(comp->getComponentID(), param));
+  m_map.access().insert(std::make_pair(comp->getComponentID(), param));
 #endif
+  clearInheritedParameters();
 }
 
 /**
@@ -739,10 +768,10 @@ bool ParameterMap::contains(const IComponent *comp, const std::string &name,
 bool ParameterMap::contains(const IComponent *comp, const char *name,
                             const char *type) const {
   checkIsNotMaskingParameter(name);
-  if (m_map.empty())
+  if (m_map->empty())
     return false;
   const ComponentID id = comp->getComponentID();
-  std::pair<pmap_cit, pmap_cit> components = m_map.equal_range(id);
+  std::pair<pmap_cit, pmap_cit> components = m_map->equal_range(id);
   bool anytype = (strlen(type) == 0);
   for (auto itr = components.first; itr != components.second; ++itr) {
     const auto &param = itr->second;
@@ -762,13 +791,13 @@ bool ParameterMap::contains(const IComponent *comp, const char *name,
 bool ParameterMap::contains(const IComponent *comp,
                             const Parameter &parameter) const {
   checkIsNotMaskingParameter(parameter.name());
-  if (m_map.empty() || !comp)
+  if (m_map->empty() || !comp)
     return false;
 
   const ComponentID id = comp->getComponentID();
-  auto it_found = m_map.find(id);
-  if (it_found != m_map.end()) {
-    auto itrs = m_map.equal_range(id);
+  auto it_found = m_map->find(id);
+  if (it_found != m_map->end()) {
+    auto itrs = m_map->equal_range(id);
     for (auto itr = itrs.first; itr != itrs.second; ++itr) {
       const Parameter_sptr &param = itr->second;
       if (*param == parameter)
@@ -809,7 +838,7 @@ boost::shared_ptr<Parameter> ParameterMap::get(const IComponent *comp,
     return result;
 
   auto itr = positionOf(comp, name, type);
-  if (itr != m_map.end())
+  if (itr != m_map->end())
     result = boost::atomic_load(&itr->second);
   return result;
 }
@@ -823,15 +852,17 @@ boost::shared_ptr<Parameter> ParameterMap::get(const IComponent *comp,
  */
 component_map_it ParameterMap::positionOf(const IComponent *comp,
                                           const char *name, const char *type) {
-  auto result = m_map.end();
+  // The iterator may be used to modify the parameter so the map is unshared
+  auto &map = m_map.access();
+  auto result = map.end();
   if (!comp)
     return result;
   const bool anytype = (strlen(type) == 0);
-  if (!m_map.empty()) {
+  if (!map.empty()) {
     const ComponentID id = comp->getComponentID();
-    auto it_found = m_map.find(id);
-    if (it_found != m_map.end()) {
-      auto itrs = m_map.equal_range(id);
+    auto it_found = map.find(id);
+    if (it_found != map.end()) {
+      auto itrs = map.equal_range(id);
       for (auto itr = itrs.first; itr != itrs.second; ++itr) {
         const auto &param = itr->second;
         if (strcasecmp(param->nameAsCString(), name) == 0 &&
@@ -855,15 +886,15 @@ component_map_it ParameterMap::positionOf(const IComponent *comp,
 component_map_cit ParameterMap::positionOf(const IComponent *comp,
                                            const char *name,
                                            const char *type) const {
-  auto result = m_map.end();
+  auto result = m_map->end();
   if (!comp)
     return result;
   const bool anytype = (strlen(type) == 0);
-  if (!m_map.empty()) {
+  if (!m_map->empty()) {
     const ComponentID id = comp->getComponentID();
-    auto it_found = m_map.find(id);
-    if (it_found != m_map.end()) {
-      auto itrs = m_map.equal_range(id);
+    auto it_found = m_map->find(id);
+    if (it_found != m_map->end()) {
+      auto itrs = m_map->equal_range(id);
       for (auto itr = itrs.first; itr != itrs.second; ++itr) {
         const auto &param = itr->second;
         if (strcasecmp(param->nameAsCString(), name) == 0 &&
@@ -885,11 +916,11 @@ component_map_cit ParameterMap::positionOf(const IComponent *comp,
 Parameter_sptr ParameterMap::getByType(const IComponent *comp,
                                        const std::string &type) const {
   Parameter_sptr result;
-  if (!m_map.empty()) {
+  if (!m_map->empty()) {
     const ComponentID id = comp->getComponentID();
-    auto it_found = m_map.find(id);
-    if (it_found != m_map.end() && it_found->first) {
-      auto itrs = m_map.equal_range(id);
+    auto it_found = m_map->find(id);
+    if (it_found != m_map->end() && it_found->first) {
+      auto itrs = m_map->equal_range(id);
       for (auto itr = itrs.first; itr != itrs.second; ++itr) {
         const auto &param = itr->second;
         if (strcasecmp(param->type().c_str(), type.c_str()) == 0) {
@@ -897,8 +928,8 @@ Parameter_sptr ParameterMap::getByType(const IComponent *comp,
           break;
         }
       } // found->firdst
-    }   // it_found != m_map.end()
-  }     //! m_map.empty()
+    }   // it_found != m_map->end()
+  }     //! m_map->empty()
   return result;
 }
 
@@ -948,6 +979,14 @@ Parameter_sptr ParameterMap::getRecursive(const IComponent *comp,
                                           const char *name,
                                           const char *type) const {
   checkIsNotMaskingParameter(name);
+  // Components of the instrument look up the parameter in a table instead of
+  // walking up the tree
+  if (m_componentInfo && !m_map->empty()) {
+    const auto id = comp->getComponentID();
+    if (m_componentInfo->hasComponent(id))
+      return inheritedParameters(name, type)
+          ->get(m_componentInfo->indexOf(id));
+  }
   Parameter_sptr result = this->get(comp->getComponentID(), name, type);
   if (result)
     return result;
@@ -962,6 +1001,67 @@ Parameter_sptr ParameterMap::getRecursive(const IComponent *comp,
   return result;
 }
 
+/**
+ * Return the table of the parameters found by getRecursive() for each
+ * component of the instrument, building it if the parameters were modified
+ * since it was last built.
+ * @param name :: Parameter name
+ * @param type :: An optional type string
+ * @returns the table for the name and type
+ */
+boost::shared_ptr<const ParameterMap::InheritedParameters>
+ParameterMap::inheritedParameters(const char *name, const char *type) const {
+  std::string key(name);
+  key.push_back('\0');
+  key.append(type);
+  const size_t revision = m_revision.load();
+  auto tables = boost::atomic_load(&m_inheritanceTables);
+  if (tables && tables->revision == revision) {
+    const auto found = tables->tables.find(key);
+    if (found != tables->tables.end())
+      return found->second;
+  }
+
+  const auto &componentInfo = *m_componentInfo;
+  auto inherited = boost::make_shared<InheritedParameters>();
+  auto &owners = inherited->owners;
+  owners.assign(componentInfo.size(), 0);
+  const bool anytype = (strlen(type) == 0);
+  // The first matching parameter of a component is the one get() returns
+  for (const auto &entry : *m_map) {
+    const auto param = boost::atomic_load(&entry.second);
+    if (strcasecmp(param->nameAsCString(), name) != 0 ||
+        !(anytype || param->type() == type) ||
+        !componentInfo.hasComponent(entry.first))
+      continue;
+    auto &owner = owners[componentInfo.indexOf(entry.first)];
+    if (owner == 0) {
+      inherited->parameters.emplace_back(param);
+      owner = static_cast<uint32_t>(inherited->parameters.size());
+    }
+  }
+  // Parents have larger indices than their children, the root being last
+  for (size_t index = componentInfo.root(); index-- > 0;) {
+    if (owners[index] == 0)
+      owners[index] = owners[componentInfo.parent(index)];
+  }
+
+  auto updated = boost::make_shared<InheritanceTables>();
+  updated->revision = revision;
+  if (tables && tables->revision == revision)
+    updated->tables = tables->tables;
+  updated->tables.emplace(std::move(key), inherited);
+  boost::atomic_store(&m_inheritanceTables,
+                      boost::shared_ptr<const InheritanceTables>(updated));
+  return inherited;
+}
+
+/**
+ * Invalidates the tables of inherited parameters after parameters have been
+ * added or removed
+ */
+void ParameterMap::clearInheritedParameters() { ++m_revision; }
+
 /**
  * Return the value of a parameter as a string
  * @param comp :: Component to which parameter is related
@@ -992,12 +1092,12 @@ std::string ParameterMap::getString(const IComponent *comp,
 std::set<std::string> ParameterMap::names(const IComponent *comp) const {
   std::set<std::string> paramNames;
   const ComponentID id = comp->getComponentID();
-  auto it_found = m_map.find(id);
-  if (it_found == m_map.end()) {
+  auto it_found = m_map->find(id);
+  if (it_found == m_map->end()) {
     return paramNames;
   }
 
-  auto itrs = m_map.equal_range(id);
+  auto itrs = m_map->equal_range(id);
   for (auto it = itrs.first; it != itrs.second; ++it) {
     paramNames.insert(it->second->name());
   }
@@ -1013,7 +1113,7 @@ std::set<std::string> ParameterMap::names(const IComponent *comp) const {
  */
 std::string ParameterMap::asString() const {
   std::stringstream out;
-  for (const auto &mappair : m_map) {
+  for (const auto &mappair : *m_map) {
     const boost::shared_ptr<Parameter> &p = mappair.second;
     if (p && mappair.first) {
       const auto *comp = dynamic_cast<const IComponent *>(mappair.first);
@@ -1089,12 +1189,14 @@ void ParameterMap::copyFromParameterMap(const IComponent *oldComp,
     Parameter_sptr thisParameter = oldPMap->get(oldComp, oldParameterName);
 // Insert the fetched parameter in the m_map
 #if TBB_VERSION_MAJOR >= 4 && TBB_VERSION_MINOR >= 4 && !CLANG_ON_LINUX
-    m_map.emplace(newComp->getComponentID(), std::move(thisParameter));
+    m_map.access().emplace(newComp->getComponentID(),
+                           std::move(thisParameter));
 #else
-    m_map.insert(
+    m_map.access().insert(
         std::make_pair(newComp->getComponentID(), std::move(thisParameter)));
 #endif
   }
+  clearInheritedParameters();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1209,6 +1311,7 @@ void ParameterMap::setInstrument(const Instrument *instrument) {
   if (!instrument) {
     m_componentInfo = nullptr;
     m_detectorInfo = nullptr;
+    clearInheritedParameters();
     return;
   }
   if (m_instrument)
@@ -1219,6 +1322,7 @@ void ParameterMap::setInstrument(const Instrument *instrument) {
                            "base instrument, not a parametrized instrument");
   m_instrument = instrument;
   std::tie(m_componentInfo, m_detectorInfo) = m_instrument->makeBeamline(*this);
+  clearInheritedParameters();
 }
 
 } // Namespace Geometry
@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidGeometry/Objects/CSGObject.h"
 
+#include "MantidGeometry/Objects/CSGProgram.h"
 #include "MantidGeometry/Objects/Rules.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/RandomPoint.h"
@@ -13,6 +14,7 @@
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "MantidGeometry/Rendering/vtkGeometryCacheReader.h"
 #include "MantidGeometry/Rendering/vtkGeometryCacheWriter.h"
+#include "MantidGeometry/ShapeIntersection.h"
 #include "MantidGeometry/Surfaces/Cone.h"
 #include "MantidGeometry/Surfaces/Cylinder.h"
 #include "MantidGeometry/Surfaces/LineIntersectVisit.h"
@@ -228,57 +230,27 @@ double cuboidSolidAngle(const V3D &observer, const std::vector<V3D> &vectors) {
   // triangles defining the 6 surfaces of the bounding box. Using a consistent
   // ordering of points the "away facing" triangles give -ve contributions to
   // the solid angle and hence are ignored.
-  std::vector<V3D> pts;
-  pts.reserve(8);
   const V3D dx = vectors[1] - vectors[0];
   const V3D dz = vectors[3] - vectors[0];
-  pts.emplace_back(vectors[2]);
-  pts.emplace_back(vectors[2] + dx);
-  pts.emplace_back(vectors[1]);
-  pts.emplace_back(vectors[0]);
-  pts.emplace_back(vectors[2] + dz);
-  pts.emplace_back(vectors[2] + dz + dx);
-  pts.emplace_back(vectors[1] + dz);
-  pts.emplace_back(vectors[0] + dz);
+  const std::array<V3D, 8> pts{{vectors[2], vectors[2] + dx, vectors[1],
+                                vectors[0], vectors[2] + dz,
+                                vectors[2] + dz + dx, vectors[1] + dz,
+                                vectors[0] + dz}};
 
   constexpr unsigned int ntriangles(12);
-  std::vector<std::vector<int>> triMap(ntriangles, std::vector<int>(3, 0));
-  triMap[0][0] = 1;
-  triMap[0][1] = 4;
-  triMap[0][2] = 3;
-  triMap[1][0] = 3;
-  triMap[1][1] = 2;
-  triMap[1][2] = 1;
-  triMap[2][0] = 5;
-  triMap[2][1] = 6;
-  triMap[2][2] = 7;
-  triMap[3][0] = 7;
-  triMap[3][1] = 8;
-  triMap[3][2] = 5;
-  triMap[4][0] = 1;
-  triMap[4][1] = 2;
-  triMap[4][2] = 6;
-  triMap[5][0] = 6;
-  triMap[5][1] = 5;
-  triMap[5][2] = 1;
-  triMap[6][0] = 2;
-  triMap[6][1] = 3;
-  triMap[6][2] = 7;
-  triMap[7][0] = 7;
-  triMap[7][1] = 6;
-  triMap[7][2] = 2;
-  triMap[8][0] = 3;
-  triMap[8][1] = 4;
-  triMap[8][2] = 8;
-  triMap[9][0] = 8;
-  triMap[9][1] = 7;
-  triMap[9][2] = 3;
-  triMap[10][0] = 1;
-  triMap[10][1] = 5;
-  triMap[10][2] = 8;
-  triMap[11][0] = 8;
-  triMap[11][1] = 4;
-  triMap[11][2] = 1;
+  static constexpr std::array<std::array<int, 3>, ntriangles> triMap{
+      {{{1, 4, 3}},
+       {{3, 2, 1}},
+       {{5, 6, 7}},
+       {{7, 8, 5}},
+       {{1, 2, 6}},
+       {{6, 5, 1}},
+       {{2, 3, 7}},
+       {{7, 6, 2}},
+       {{3, 4, 8}},
+       {{8, 7, 3}},
+       {{1, 5, 8}},
+       {{8, 4, 1}}}};
   double sangle = 0.0;
   for (unsigned int i = 0; i < ntriangles; i++) {
     const double sa =
@@ -310,41 +282,45 @@ double cylinderSolidAngle(const V3D &observer, const V3D &centre,
   // For simplicity the triangulation points are constructed such that the cone
   // axis points up the +Z axis and then rotated into their final position
 
-  // Required rotation
+  // Required rotation. As it is linear only the unit vectors are rotated and
+  // the triangulation points are combined from them.
   constexpr V3D initial_axis(0., 0., 1.0);
   const Quat transform(initial_axis, axis);
+  V3D u(1., 0., 0.), v(0., 1., 0.), w(initial_axis);
+  transform.rotate(u);
+  transform.rotate(v);
+  transform.rotate(w);
 
-  // Do the base cap which is a point at the centre and nslices points around it
+  // Radial offsets of the nslices points around the axis
   constexpr double angle_step =
       2 * M_PI / static_cast<double>(Cylinder::g_nslices);
+  std::array<V3D, Cylinder::g_nslices> radial;
+  for (int sl = 0; sl < Cylinder::g_nslices; ++sl) {
+    radial[sl] = u * (radius * std::cos(angle_step * sl)) +
+                 v * (radius * std::sin(angle_step * sl));
+  }
 
   const double z_step = height / Cylinder::g_nstacks;
-  double z0(0.0), z1(z_step);
+  double z1(z_step);
   double solid_angle(0.0);
+  std::array<V3D, Cylinder::g_nslices> lower, upper;
+  for (int sl = 0; sl < Cylinder::g_nslices; ++sl) {
+    lower[sl] = centre + radial[sl];
+  }
   for (int st = 1; st <= Cylinder::g_nstacks; ++st) {
     if (st == Cylinder::g_nstacks)
       z1 = height;
-
+    const V3D upperCentre = centre + w * z1;
     for (int sl = 0; sl < Cylinder::g_nslices; ++sl) {
-      double x = radius * std::cos(angle_step * sl);
-      double y = radius * std::sin(angle_step * sl);
-      V3D pt1 = V3D(x, y, z0);
-      V3D pt2 = V3D(x, y, z1);
-      int vertex = (sl + 1) % Cylinder::g_nslices;
-      x = radius * std::cos(angle_step * vertex);
-      y = radius * std::sin(angle_step * vertex);
-      V3D pt3 = V3D(x, y, z0);
-      V3D pt4 = V3D(x, y, z1);
-      // Rotations
-      transform.rotate(pt1);
-      transform.rotate(pt3);
-      transform.rotate(pt2);
-      transform.rotate(pt4);
+      upper[sl] = upperCentre + radial[sl];
+    }
 
-      pt1 += centre;
-      pt2 += centre;
-      pt3 += centre;
-      pt4 += centre;
+    for (int sl = 0; sl < Cylinder::g_nslices; ++sl) {
+      const int vertex = (sl + 1) % Cylinder::g_nslices;
+      const V3D &pt1 = lower[sl];
+      const V3D &pt2 = upper[sl];
+      const V3D &pt3 = lower[vertex];
+      const V3D &pt4 = upper[vertex];
 
       double sa = triangleSolidAngle(pt1, pt4, pt3, observer);
       if (sa > 0.0) {
@@ -355,7 +331,7 @@ double cylinderSolidAngle(const V3D &observer, const V3D &centre,
         solid_angle += sa;
       }
     }
-    z0 = z1;
+    std::swap(lower, upper);
     z1 += z_step;
   }
 
@@ -441,6 +417,8 @@ CSGObject &CSGObject::operator=(const CSGObject &A) {
 
     if (TopRule)
       createSurfaceList();
+    else
+      m_program.reset();
   }
   return *this;
 }
@@ -813,11 +791,29 @@ int CSGObject::checkSurfaceValid(const Kernel::V3D &C,
  * @returns 1 if true and 0 if false
  */
 bool CSGObject::isValid(const Kernel::V3D &point) const {
+  if (m_program)
+    return m_program->isValid(point);
   if (!TopRule)
     return false;
   return TopRule->isValid(point);
 }
 
+/**
+ * Determines whether each of many points is within the object or on the
+ * surface
+ * @param points :: Points to be tested
+ * @returns the result of isValid for each point
+ */
+std::vector<bool>
+CSGObject::isValid(const std::vector<Kernel::V3D> &points) const {
+  if (m_program)
+    return m_program->isValid(points);
+  std::vector<bool> results(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    results[i] = isValid(points[i]);
+  return results;
+}
+
 /**
  * Determines is group of surface maps are valid
  * @param SMap :: map of SurfaceNumber : status
@@ -870,9 +866,18 @@ int CSGObject::createSurfaceList(const int outFlag) {
       logger.debug() << (*vc)->getName() << '\n';
     }
   }
+  compileRules();
   return 1;
 }
 
+/**
+ * Compiles the rules for isValid. Must be called whenever the rules or the
+ * surfaces they refer to change.
+ */
+void CSGObject::compileRules() {
+  m_program = TopRule ? CSGProgram::compile(*TopRule) : nullptr;
+}
+
 /**
  * Returns all of the numbers of surfaces
  * @return Surface numbers
@@ -963,6 +968,7 @@ void CSGObject::print() const {
 void CSGObject::makeComplement() {
   std::unique_ptr<Rule> NCG = procComp(std::move(TopRule));
   TopRule = std::move(NCG);
+  compileRules();
 }
 
 /**
@@ -1019,6 +1025,7 @@ void CSGObject::write(std::ostream &OX) const {
  */
 int CSGObject::procString(const std::string &Line) {
   TopRule = nullptr;
+  m_program.reset();
   std::map<int, std::unique_ptr<Rule>> RuleList; // List for the rules
   int Ridx = 0; // Current index (not necessary size of RuleList
   // SURFACE REPLACEMENT
@@ -1103,23 +1110,45 @@ int CSGObject::procString(const std::string &Line) {
  */
 int CSGObject::interceptSurface(Geometry::Track &track) const {
   int originalCount = track.count(); // Number of intersections original track
-  // Loop over all the surfaces.
-  LineIntersectVisit LI(track.startPoint(), track.direction());
-  for (auto &surface : m_SurList) {
-    surface->acceptVisitor(LI);
-  }
-  const auto &IPoints(LI.getPoints());
-  const auto &dPoints(LI.getDistance());
+  if (m_handler && m_handler->hasShapeInfo() &&
+      ShapeIntersection::isSupported(m_handler->shapeInfo()) &&
+      !hasComplement()) {
+    // The object is a single known shape: intersect it in closed form
+    const auto &start = track.startPoint();
+    const auto &direction = track.direction();
+    ShapeIntersection::Intervals intervals;
+    const size_t count = ShapeIntersection::intersect(
+        m_handler->shapeInfo(), start, direction, intervals);
+    for (size_t i = 0; i < count; ++i) {
+      const auto &interval = intervals[i];
+      // Skip grazing rays, as calcValidType() would
+      if (interval.exit - std::max(interval.entry, 0.0) < Kernel::Tolerance)
+        continue;
+      if (interval.entry > 0.0)
+        track.addPoint(TrackDirection::ENTERING,
+                       start + direction * interval.entry, *this);
+      track.addPoint(TrackDirection::LEAVING, start + direction * interval.exit,
+                     *this);
+    }
+  } else {
+    // Loop over all the surfaces.
+    LineIntersectVisit LI(track.startPoint(), track.direction());
+    for (auto &surface : m_SurList) {
+      surface->acceptVisitor(LI);
+    }
+    const auto &IPoints(LI.getPoints());
+    const auto &dPoints(LI.getDistance());
 
-  auto ditr = dPoints.begin();
-  auto itrEnd = IPoints.end();
-  for (auto iitr = IPoints.begin(); iitr != itrEnd; ++iitr, ++ditr) {
-    if (*ditr > 0.0) // only interested in forward going points
-    {
-      // Is the point and enterance/exit Point
-      const TrackDirection flag = calcValidType(*iitr, track.direction());
-      if (flag != TrackDirection::INVALID)
-        track.addPoint(flag, *iitr, *this);
+    auto ditr = dPoints.begin();
+    auto itrEnd = IPoints.end();
+    for (auto iitr = IPoints.begin(); iitr != itrEnd; ++iitr, ++ditr) {
+      if (*ditr > 0.0) // only interested in forward going points
+      {
+        // Is the point and enterance/exit Point
+        const TrackDirection flag = calcValidType(*iitr, track.direction());
+        if (flag != TrackDirection::INVALID)
+          track.addPoint(flag, *iitr, *this);
+      }
     }
   }
   track.buildLink();
@@ -1995,8 +2024,12 @@ CSGObject::generatePointInObject(PseudoRandomNumberGenerator &rng,
   // the bounding box but slows down shapes that leave lots of void
   // within the box. So there is a sweet spot which depends on the actual
   // shape, its dimension and orientation.
+  // Thin annuli leave most of their bounding box empty, so they are sampled
+  // directly.
   const size_t bruteForceAttempts{
-      std::min(static_cast<size_t>(5), maxAttempts)};
+      shape() == detail::ShapeInfo::GeometryShape::HOLLOWCYLINDER
+          ? 0
+          : std::min(static_cast<size_t>(5), maxAttempts)};
   boost::optional<V3D> maybePoint{
       RandomPoint::inGenericShape(*this, rng, bruteForceAttempts)};
   if (maybePoint) {
@@ -2045,8 +2078,12 @@ CSGObject::generatePointInObject(Kernel::PseudoRandomNumberGenerator &rng,
   // the bounding box well but slows down shapes that leave lots of void
   // within the box. So there is a sweet spot which depends on the actual
   // shape, its dimension and orientation.
+  // Thin annuli leave most of their bounding box empty, so they are sampled
+  // directly.
   const size_t bruteForceAttempts{
-      std::min(static_cast<size_t>(5), maxAttempts)};
+      shape() == detail::ShapeInfo::GeometryShape::HOLLOWCYLINDER
+          ? 0
+          : std::min(static_cast<size_t>(5), maxAttempts)};
   point = RandomPoint::bounded(*this, rng, activeRegion, bruteForceAttempts);
   if (!point) {
     detail::ShapeInfo::GeometryShape shape;
@@ -0,0 +1,396 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/CSGProgram.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Surfaces/Cone.h"
+#include "MantidGeometry/Surfaces/Cylinder.h"
+#include "MantidGeometry/Surfaces/General.h"
+#include "MantidGeometry/Surfaces/Plane.h"
+#include "MantidGeometry/Surfaces/Sphere.h"
+#include "MantidKernel/Tolerance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::Tolerance;
+using Kernel::V3D;
+
+namespace {
+/// Largest depth of the stack of bits used to run a program
+constexpr size_t MAX_STACK_DEPTH = 64;
+
+// The functions below repeat the arithmetic of the side() method of each
+// surface type so that the results are identical.
+
+/// @see Plane::side
+inline int planeSide(const double *c, const V3D &p) {
+  const double Dp = c[0] * p[0] + c[1] * p[1] + c[2] * p[2] - c[3];
+  if (Tolerance < std::abs(Dp))
+    return (Dp > 0) ? 1 : -1;
+  return 0;
+}
+
+/// @see Sphere::side
+inline int sphereSide(const double *c, const V3D &p) {
+  const double xdiff(p[0] - c[0]), ydiff(p[1] - c[1]), zdiff(p[2] - c[2]);
+  const double displace =
+      sqrt(xdiff * xdiff + ydiff * ydiff + zdiff * zdiff) - c[3];
+  if (fabs(displace) < Tolerance)
+    return 0;
+  return (displace > 0.0) ? 1 : -1;
+}
+
+/// @see Cylinder::side, for a cylinder along an axis, with a and b the
+/// other two axes
+inline int cylinderSide(const double *c, const V3D &p, const size_t a,
+                        const size_t b) {
+  double x = p[a] - c[a];
+  x *= x;
+  double y = p[b] - c[b];
+  y *= y;
+  const double displace = x + y - c[3] * c[3];
+  if (fabs(displace / c[3]) < Tolerance)
+    return 0;
+  return (displace > 0.0) ? 1 : -1;
+}
+
+/// @see Cone::side
+inline int coneSide(const double *c, const V3D &p) {
+  const double x(p[0] - c[0]), y(p[1] - c[1]), z(p[2] - c[2]);
+  double rptAngle = x * c[3] + y * c[4] + z * c[5];
+  rptAngle *= rptAngle / (x * x + y * y + z * z);
+  const double eqn(sqrt(rptAngle));
+  if (fabs(eqn - c[6]) < Tolerance)
+    return 0;
+  return (eqn > c[6]) ? 1 : -1;
+}
+
+/// @see Quadratic::side
+inline int quadraticSide(const double *c, const V3D &p) {
+  double res(0.0);
+  res += c[0] * p[0] * p[0];
+  res += c[1] * p[1] * p[1];
+  res += c[2] * p[2] * p[2];
+  res += c[3] * p[0] * p[1];
+  res += c[4] * p[0] * p[2];
+  res += c[5] * p[1] * p[2];
+  res += c[6] * p[0];
+  res += c[7] * p[1];
+  res += c[8] * p[2];
+  res += c[9];
+  if (fabs(res) < Tolerance)
+    return 0;
+  return (res > 0) ? 1 : -1;
+}
+
+void copyVector(const V3D &vector, double *c) {
+  c[0] = vector.X();
+  c[1] = vector.Y();
+  c[2] = vector.Z();
+}
+
+template <typename Side>
+void fillSides(const std::vector<V3D> &points, int8_t *result,
+               const Side &side) {
+  for (size_t i = 0; i < points.size(); ++i)
+    result[i] = static_cast<int8_t>(side(points[i]));
+}
+} // namespace
+
+/**
+ * Compile a rule tree
+ * @param topRule :: the top rule of an object, with its surfaces populated
+ * @return the program, or a null pointer if the tree contains rules that
+ * cannot be compiled, such as references to other objects, or is too deep
+ */
+std::unique_ptr<CSGProgram> CSGProgram::compile(const Rule &topRule) {
+  std::unique_ptr<CSGProgram> program(new CSGProgram());
+  if (!program->emit(topRule, 0))
+    return nullptr;
+  return program;
+}
+
+/**
+ * Run the program on a stack of bits, the top of the stack being the lowest
+ * bit
+ * @param sideOf :: gives the side of a surface, by index, for the point
+ * @return the value left on the stack
+ */
+template <typename SideOf> bool CSGProgram::run(const SideOf &sideOf) const {
+  uint64_t stack = 0;
+  for (const auto &instruction : m_instructions) {
+    switch (instruction.opCode) {
+    case OpCode::Surface:
+      stack = (stack << 1) |
+              static_cast<uint64_t>(sideOf(instruction.surface) *
+                                        instruction.sign >=
+                                    0);
+      break;
+    case OpCode::Constant:
+      stack = (stack << 1) | static_cast<uint64_t>(instruction.sign);
+      break;
+    case OpCode::Not:
+      stack ^= 1;
+      break;
+    case OpCode::And:
+      stack = (stack >> 1) & (stack | ~uint64_t{1});
+      break;
+    case OpCode::Or:
+      stack = (stack >> 1) | (stack & 1);
+      break;
+    }
+  }
+  return (stack & 1) != 0;
+}
+
+/**
+ * @param point :: a point to test
+ * @return true if the point is inside or on the surface of the object, as
+ * Rule::isValid()
+ */
+bool CSGProgram::isValid(const V3D &point) const {
+  return run([&](const size_t surface) { return side(surface, point); });
+}
+
+/**
+ * Test many points at once. The sides of each surface are computed for all
+ * the points before the program is run for each point.
+ * @param points :: the points to test
+ * @return the result of isValid() for each point
+ */
+std::vector<bool>
+CSGProgram::isValid(const std::vector<V3D> &points) const {
+  const size_t nPoints = points.size();
+  std::vector<int8_t> allSides(m_types.size() * nPoints);
+  for (size_t surface = 0; surface < m_types.size(); ++surface)
+    sides(surface, points, allSides.data() + surface * nPoints);
+
+  std::vector<bool> results(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    const int8_t *pointSides = allSides.data() + i;
+    results[i] = run([pointSides, nPoints](const size_t surface) {
+      return pointSides[surface * nPoints];
+    });
+  }
+  return results;
+}
+
+/**
+ * Append the instructions evaluating a rule
+ * @param rule :: the rule
+ * @param depth :: the number of values on the stack before the rule
+ * @return false if the rule cannot be compiled
+ */
+bool CSGProgram::emit(const Rule &rule, const size_t depth) {
+  if (depth >= MAX_STACK_DEPTH)
+    return false;
+  if (const auto *surfPoint = dynamic_cast<const SurfPoint *>(&rule)) {
+    if (!surfPoint->getKey()) {
+      m_instructions.push_back({OpCode::Constant, 0, 0});
+      return true;
+    }
+    m_instructions.push_back(
+        {OpCode::Surface, static_cast<int8_t>(surfPoint->getSign()),
+         addSurface(*surfPoint->getKey())});
+    return true;
+  }
+  if (dynamic_cast<const Intersection *>(&rule)) {
+    const auto *a = rule.leaf(0);
+    const auto *b = rule.leaf(1);
+    if (!a || !b) {
+      m_instructions.push_back({OpCode::Constant, 0, 0});
+      return true;
+    }
+    if (!emit(*a, depth) || !emit(*b, depth + 1))
+      return false;
+    m_instructions.push_back({OpCode::And, 0, 0});
+    return true;
+  }
+  if (dynamic_cast<const Union *>(&rule)) {
+    const auto *a = rule.leaf(0);
+    const auto *b = rule.leaf(1);
+    if (a && b) {
+      if (!emit(*a, depth) || !emit(*b, depth + 1))
+        return false;
+      m_instructions.push_back({OpCode::Or, 0, 0});
+      return true;
+    }
+    if (a || b)
+      return emit(a ? *a : *b, depth);
+    m_instructions.push_back({OpCode::Constant, 0, 0});
+    return true;
+  }
+  if (dynamic_cast<const CompGrp *>(&rule)) {
+    const auto *a = rule.leaf(0);
+    if (!a) {
+      m_instructions.push_back({OpCode::Constant, 1, 0});
+      return true;
+    }
+    if (!emit(*a, depth))
+      return false;
+    m_instructions.push_back({OpCode::Not, 0, 0});
+    return true;
+  }
+  if (dynamic_cast<const BoolValue *>(&rule)) {
+    // The value does not depend on the point
+    m_instructions.push_back(
+        {OpCode::Constant, static_cast<int8_t>(rule.isValid(V3D())), 0});
+    return true;
+  }
+  // CompObj refers to another object, which may change independently
+  return false;
+}
+
+/**
+ * Add a surface to the table, unless it is already there
+ * @param surface :: the surface
+ * @return the index of the surface in the table
+ */
+uint32_t CSGProgram::addSurface(const Surface &surface) {
+  const auto existing =
+      std::find(m_surfaces.cbegin(), m_surfaces.cend(), &surface);
+  if (existing != m_surfaces.cend())
+    return static_cast<uint32_t>(std::distance(m_surfaces.cbegin(), existing));
+
+  double c[NCOEFFICIENTS] = {};
+  auto type = SurfaceType::Virtual;
+  const auto &surfaceType = typeid(surface);
+  if (surfaceType == typeid(Plane)) {
+    const auto &plane = static_cast<const Plane &>(surface);
+    type = SurfaceType::Plane;
+    const auto &normal = plane.getNormal();
+    copyVector(normal, c);
+    c[3] = plane.getDistance();
+  } else if (surfaceType == typeid(Sphere)) {
+    const auto &sphere = static_cast<const Sphere &>(surface);
+    type = SurfaceType::Sphere;
+    const auto centre = sphere.getCentre();
+    copyVector(centre, c);
+    c[3] = sphere.getRadius();
+  } else if (surfaceType == typeid(Cylinder)) {
+    const auto &cylinder = static_cast<const Cylinder &>(surface);
+    const auto normal = cylinder.getNormal();
+    const auto centre = cylinder.getCentre();
+    // As Cylinder::setNvec
+    size_t axis = 3;
+    for (size_t i = 0; i < 3; ++i) {
+      if (fabs(normal[i]) > (1.0 - Tolerance)) {
+        axis = i;
+        break;
+      }
+    }
+    if (axis == 3) {
+      type = SurfaceType::Quadratic;
+      const auto &eqn = cylinder.copyBaseEqn();
+      std::copy(eqn.cbegin(), eqn.cend(), c);
+    } else if (cylinder.getRadius() > 0.0) {
+      const SurfaceType types[] = {SurfaceType::XCylinder,
+                                   SurfaceType::YCylinder,
+                                   SurfaceType::ZCylinder};
+      type = types[axis];
+      copyVector(centre, c);
+      c[3] = cylinder.getRadius();
+    }
+  } else if (surfaceType == typeid(Cone)) {
+    const auto &cone = static_cast<const Cone &>(surface);
+    type = SurfaceType::Cone;
+    const auto centre = cone.getCentre();
+    const auto normal = cone.getNormal();
+    copyVector(centre, c);
+    copyVector(normal, c + 3);
+    c[6] = cone.getCosAngle();
+  } else if (surfaceType == typeid(General)) {
+    type = SurfaceType::Quadratic;
+    const auto &eqn = static_cast<const General &>(surface).copyBaseEqn();
+    std::copy(eqn.cbegin(), eqn.cend(), c);
+  }
+
+  m_types.emplace_back(type);
+  m_surfaces.emplace_back(&surface);
+  for (size_t i = 0; i < NCOEFFICIENTS; ++i)
+    m_coefficients[i].emplace_back(c[i]);
+  return static_cast<uint32_t>(m_surfaces.size() - 1);
+}
+
+/**
+ * @param surface :: index of a surface in the table
+ * @param point :: a point
+ * @return the side of the surface the point is on, as Surface::side()
+ */
+int CSGProgram::side(const size_t surface, const V3D &point) const {
+  double c[NCOEFFICIENTS];
+  for (size_t i = 0; i < NCOEFFICIENTS; ++i)
+    c[i] = m_coefficients[i][surface];
+  switch (m_types[surface]) {
+  case SurfaceType::Plane:
+    return planeSide(c, point);
+  case SurfaceType::Sphere:
+    return sphereSide(c, point);
+  case SurfaceType::XCylinder:
+    return cylinderSide(c, point, 1, 2);
+  case SurfaceType::YCylinder:
+    return cylinderSide(c, point, 2, 0);
+  case SurfaceType::ZCylinder:
+    return cylinderSide(c, point, 0, 1);
+  case SurfaceType::Cone:
+    return coneSide(c, point);
+  case SurfaceType::Quadratic:
+    return quadraticSide(c, point);
+  default:
+    return m_surfaces[surface]->side(point);
+  }
+}
+
+/**
+ * Compute the side of a surface for many points
+ * @param surface :: index of a surface in the table
+ * @param points :: the points
+ * @param result :: the side of each point, as Surface::side()
+ */
+void CSGProgram::sides(const size_t surface, const std::vector<V3D> &points,
+                       int8_t *result) const {
+  double c[NCOEFFICIENTS];
+  for (size_t i = 0; i < NCOEFFICIENTS; ++i)
+    c[i] = m_coefficients[i][surface];
+  switch (m_types[surface]) {
+  case SurfaceType::Plane:
+    fillSides(points, result, [&c](const V3D &p) { return planeSide(c, p); });
+    break;
+  case SurfaceType::Sphere:
+    fillSides(points, result, [&c](const V3D &p) { return sphereSide(c, p); });
+    break;
+  case SurfaceType::XCylinder:
+    fillSides(points, result,
+              [&c](const V3D &p) { return cylinderSide(c, p, 1, 2); });
+    break;
+  case SurfaceType::YCylinder:
+    fillSides(points, result,
+              [&c](const V3D &p) { return cylinderSide(c, p, 2, 0); });
+    break;
+  case SurfaceType::ZCylinder:
+    fillSides(points, result,
+              [&c](const V3D &p) { return cylinderSide(c, p, 0, 1); });
+    break;
+  case SurfaceType::Cone:
+    fillSides(points, result, [&c](const V3D &p) { return coneSide(c, p); });
+    break;
+  case SurfaceType::Quadratic:
+    fillSides(points, result,
+              [&c](const V3D &p) { return quadraticSide(c, p); });
+    break;
+  default:
+    const auto *key = m_surfaces[surface];
+    fillSides(points, result, [key](const V3D &p) { return key->side(p); });
+  }
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -0,0 +1,211 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/ShapeIntersection.h"
+#include "MantidGeometry/Rendering/ShapeInfo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Geometry {
+namespace ShapeIntersection {
+
+namespace {
+constexpr double INF = std::numeric_limits<double>::infinity();
+/// The whole ray
+constexpr Interval ALL{-INF, INF};
+/// An interval containing no point
+constexpr Interval EMPTY{INF, -INF};
+
+bool isEmpty(const Interval &interval) {
+  return !(interval.entry < interval.exit);
+}
+
+Interval overlap(const Interval &a, const Interval &b) {
+  return {std::max(a.entry, b.entry), std::min(a.exit, b.exit)};
+}
+
+/**
+ * Solve a t^2 + b t + c <= 0 for a >= 0.
+ * @param a The coefficient of t^2
+ * @param b The coefficient of t
+ * @param c The constant term
+ * @return the interval of t between the roots
+ */
+Interval betweenRoots(const double a, const double b, const double c) {
+  if (a == 0.)
+    return c <= 0. ? ALL : EMPTY;
+  const double discriminant = b * b - 4. * a * c;
+  if (discriminant < 0.)
+    return EMPTY;
+  // Avoid the cancellation of the textbook formula
+  const double q = -0.5 * (b + std::copysign(std::sqrt(discriminant), b));
+  if (q == 0.)
+    return EMPTY;
+  const double t0 = q / a;
+  const double t1 = c / q;
+  return t0 < t1 ? Interval{t0, t1} : Interval{t1, t0};
+}
+
+/**
+ * The part of a ray between two parallel planes.
+ * @param position The projection of the start of the ray on the normal
+ * @param speed The projection of the direction of the ray on the normal
+ * @param low The projection of the first plane
+ * @param high The projection of the second plane
+ * @return the interval between the planes
+ */
+Interval slab(const double position, const double speed, const double low,
+              const double high) {
+  if (speed == 0.)
+    return position >= low && position <= high ? ALL : EMPTY;
+  const double t0 = (low - position) / speed;
+  const double t1 = (high - position) / speed;
+  return t0 < t1 ? Interval{t0, t1} : Interval{t1, t0};
+}
+
+Interval sphere(const detail::ShapeInfo &shapeInfo, const Kernel::V3D &start,
+                const Kernel::V3D &direction) {
+  const auto geometry = shapeInfo.sphereGeometry();
+  const Kernel::V3D p{start - geometry.centre};
+  return betweenRoots(direction.norm2(), 2. * p.scalar_prod(direction),
+                      p.norm2() - geometry.radius * geometry.radius);
+}
+
+/// The part of a ray inside an infinitely long cylinder; p is the start of
+/// the ray relative to a point of the axis
+Interval infiniteCylinder(const Kernel::V3D &p, const Kernel::V3D &direction,
+                          const Kernel::V3D &axis, const double radius) {
+  const Kernel::V3D pPerpendicular{p - axis * p.scalar_prod(axis)};
+  const Kernel::V3D dPerpendicular{direction -
+                                   axis * direction.scalar_prod(axis)};
+  return betweenRoots(dPerpendicular.norm2(),
+                      2. * pPerpendicular.scalar_prod(dPerpendicular),
+                      pPerpendicular.norm2() - radius * radius);
+}
+
+Interval cappedCylinder(const Kernel::V3D &p, const Kernel::V3D &direction,
+                        const Kernel::V3D &axis, const double radius,
+                        const double height) {
+  return overlap(infiniteCylinder(p, direction, axis, radius),
+                 slab(p.scalar_prod(axis), direction.scalar_prod(axis), 0.,
+                      height));
+}
+
+Interval cylinder(const detail::ShapeInfo &shapeInfo, const Kernel::V3D &start,
+                  const Kernel::V3D &direction) {
+  const auto geometry = shapeInfo.cylinderGeometry();
+  return cappedCylinder(start - geometry.centreOfBottomBase, direction,
+                        geometry.axis, geometry.radius, geometry.height);
+}
+
+size_t hollowCylinder(const detail::ShapeInfo &shapeInfo,
+                      const Kernel::V3D &start, const Kernel::V3D &direction,
+                      Intervals &intervals) {
+  const auto geometry = shapeInfo.hollowCylinderGeometry();
+  const Kernel::V3D p{start - geometry.centreOfBottomBase};
+  const auto outer = cappedCylinder(p, direction, geometry.axis,
+                                    geometry.radius, geometry.height);
+  if (isEmpty(outer))
+    return 0;
+  const auto inner = overlap(
+      infiniteCylinder(p, direction, geometry.axis, geometry.innerRadius),
+      outer);
+  if (isEmpty(inner)) {
+    intervals[0] = outer;
+    return 1;
+  }
+  size_t count{0};
+  for (const Interval &part : {Interval{outer.entry, inner.entry},
+                               Interval{inner.exit, outer.exit}}) {
+    if (!isEmpty(part))
+      intervals[count++] = part;
+  }
+  return count;
+}
+
+/// A cuboid is a parallelepiped: the intersection of three slabs
+Interval cuboid(const detail::ShapeInfo &shapeInfo, const Kernel::V3D &start,
+                const Kernel::V3D &direction) {
+  const auto geometry = shapeInfo.cuboidGeometry();
+  const Kernel::V3D p{start - geometry.leftFrontBottom};
+  const std::array<Kernel::V3D, 3> edges{
+      {geometry.rightFrontBottom - geometry.leftFrontBottom,
+       geometry.leftFrontTop - geometry.leftFrontBottom,
+       geometry.leftBackBottom - geometry.leftFrontBottom}};
+  Interval result{ALL};
+  for (size_t i = 0; i < 3; ++i) {
+    const Kernel::V3D normal{
+        edges[(i + 1) % 3].cross_prod(edges[(i + 2) % 3])};
+    const double width{normal.scalar_prod(edges[i])};
+    result = overlap(result, slab(normal.scalar_prod(p),
+                                  normal.scalar_prod(direction),
+                                  std::min(0., width), std::max(0., width)));
+  }
+  return result;
+}
+} // namespace
+
+/**
+ * @param shapeInfo A shape info
+ * @return whether intersect() can handle the shape
+ */
+bool isSupported(const detail::ShapeInfo &shapeInfo) {
+  switch (shapeInfo.shape()) {
+  case detail::ShapeInfo::GeometryShape::CUBOID:
+  case detail::ShapeInfo::GeometryShape::CYLINDER:
+  case detail::ShapeInfo::GeometryShape::HOLLOWCYLINDER:
+  case detail::ShapeInfo::GeometryShape::SPHERE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Find where a ray crosses a shape. Only the parts of the ray ahead of its
+ * start are returned, in order along the ray.
+ * @param shapeInfo A shape info for which isSupported() is true
+ * @param start The start of the ray
+ * @param direction The direction of the ray
+ * @param intervals [Out] The intervals inside the shape
+ * @return the number of intervals found
+ */
+size_t intersect(const detail::ShapeInfo &shapeInfo, const Kernel::V3D &start,
+                 const Kernel::V3D &direction, Intervals &intervals) {
+  size_t count{0};
+  switch (shapeInfo.shape()) {
+  case detail::ShapeInfo::GeometryShape::CUBOID:
+    intervals[count++] = cuboid(shapeInfo, start, direction);
+    break;
+  case detail::ShapeInfo::GeometryShape::CYLINDER:
+    intervals[count++] = cylinder(shapeInfo, start, direction);
+    break;
+  case detail::ShapeInfo::GeometryShape::HOLLOWCYLINDER:
+    count = hollowCylinder(shapeInfo, start, direction, intervals);
+    break;
+  case detail::ShapeInfo::GeometryShape::SPHERE:
+    intervals[count++] = sphere(shapeInfo, start, direction);
+    break;
+  default:
+    throw std::invalid_argument(
+        "ShapeIntersection::intersect: unsupported shape");
+  }
+  const auto last = std::remove_if(
+      intervals.begin(), intervals.begin() + count,
+      [](const Interval &interval) {
+        return isEmpty(interval) || interval.exit <= 0.;
+      });
+  return static_cast<size_t>(std::distance(intervals.begin(), last));
+}
+
+} // namespace ShapeIntersection
+} // namespace Geometry
+} // namespace Mantid
@@ -0,0 +1,110 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/CSGProgram.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/V3D.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class CSGProgramTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CSGProgramTest *createSuite() { return new CSGProgramTest(); }
+  static void destroySuite(CSGProgramTest *suite) { delete suite; }
+
+  void test_sphere() {
+    assertSameAsRules(*ComponentCreationHelper::createSphere(0.5));
+  }
+
+  void test_cylinder_along_axis() {
+    assertSameAsRules(*ComponentCreationHelper::createCappedCylinder(
+        0.3, 1., V3D(0., -0.5, 0.), V3D(0., 1., 0.), "cyl"));
+  }
+
+  void test_tilted_cylinder() {
+    assertSameAsRules(*ComponentCreationHelper::createCappedCylinder(
+        0.3, 1., V3D(), V3D(1., 1., 0.), "cyl"));
+  }
+
+  void test_hollow_cylinder() {
+    assertSameAsRules(*ComponentCreationHelper::createHollowCylinder(
+        0.2, 0.4, 1., V3D(0., 0., -0.5), V3D(0., 0., 1.), "hollow"));
+  }
+
+  void test_rotated_cuboid() {
+    assertSameAsRules(
+        *ComponentCreationHelper::createCuboid(0.4, 0.3, 0.2, M_PI / 6.));
+  }
+
+  void test_complement_of_sphere() {
+    assertSameAsRules(*ComponentCreationHelper::createHollowShell(0.3, 0.6));
+  }
+
+  void test_cone() {
+    const std::string xml = "<cone id=\"cone\">"
+                            "<tip-point x=\"0\" y=\"0\" z=\"0.5\" />"
+                            "<axis x=\"0\" y=\"0\" z=\"-1\" />"
+                            "<angle val=\"30\" />"
+                            "<height val=\"1\" />"
+                            "</cone>";
+    assertSameAsRules(*ShapeFactory().createShape(xml));
+  }
+
+  void test_object_uses_program_for_batched_points() {
+    const auto sphere = ComponentCreationHelper::createSphere(0.5);
+    const std::vector<V3D> points{V3D(), V3D(0.5, 0., 0.), V3D(0., 0.6, 0.)};
+    const std::vector<bool> expected{true, true, false};
+    TS_ASSERT_EQUALS(sphere->isValid(points), expected);
+  }
+
+  void test_object_without_rules_is_not_compiled() {
+    CSGObject object;
+    TS_ASSERT(!object.isValid(V3D()));
+    TS_ASSERT_EQUALS(object.isValid(std::vector<V3D>{V3D()}),
+                     std::vector<bool>{false});
+  }
+
+private:
+  void assertSameAsRules(const CSGObject &object) {
+    const auto program = CSGProgram::compile(*object.topRule());
+    TS_ASSERT(program);
+    if (!program)
+      return;
+
+    // Random points around the object, and points of a grid that fall on
+    // its surfaces
+    Mantid::Kernel::MersenneTwister rng(12345);
+    std::vector<V3D> points;
+    for (size_t i = 0; i < 2000; ++i)
+      points.emplace_back(rng.nextValue() * 2. - 1., rng.nextValue() * 2. - 1.,
+                          rng.nextValue() * 2. - 1.);
+    for (int x = -10; x <= 10; ++x)
+      for (int y = -10; y <= 10; ++y)
+        for (int z = -10; z <= 10; ++z)
+          points.emplace_back(0.1 * x, 0.1 * y, 0.1 * z);
+
+    const auto results = program->isValid(points);
+    TS_ASSERT_EQUALS(results.size(), points.size());
+    size_t mismatches = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+      const bool expected = object.topRule()->isValid(points[i]);
+      if (program->isValid(points[i]) != expected || results[i] != expected)
+        ++mismatches;
+    }
+    TS_ASSERT_EQUALS(mismatches, 0);
+  }
+};
@@ -0,0 +1,147 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/DetectorBVH.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
+#include "MantidKernel/V3D.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class DetectorBVHTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DetectorBVHTest *createSuite() { return new DetectorBVHTest(); }
+  static void destroySuite(DetectorBVHTest *suite) { delete suite; }
+
+  void test_size_is_number_of_detectors() {
+    const auto wrappers = makeWrappers(
+        ComponentCreationHelper::createTestInstrumentRectangular(2, 5));
+    const DetectorBVH bvh(*wrappers.first);
+    TS_ASSERT_EQUALS(bvh.size(), 50);
+  }
+
+  void test_rays_to_pixels_find_them() {
+    const auto wrappers = makeWrappers(
+        ComponentCreationHelper::createTestInstrumentRectangular(1, 10));
+    const auto &componentInfo = *wrappers.first;
+    const DetectorBVH bvh(componentInfo);
+    const auto sample = componentInfo.samplePosition();
+    for (size_t i = 0; i < componentInfo.size(); ++i) {
+      if (componentInfo.isDetector(i))
+        TS_ASSERT_EQUALS(
+            bvh.findDetector(sample, componentInfo.position(i) - sample), i);
+    }
+  }
+
+  void test_ray_missing_all_detectors_finds_none() {
+    const auto wrappers = makeWrappers(
+        ComponentCreationHelper::createTestInstrumentRectangular(1, 10));
+    const DetectorBVH bvh(*wrappers.first);
+    TS_ASSERT_EQUALS(bvh.findDetector(V3D(), V3D(0., 0., -1.)),
+                     DetectorBVH::NONE);
+    TS_ASSERT_EQUALS(bvh.findDetector(V3D(), V3D(1., 0., 0.)),
+                     DetectorBVH::NONE);
+    TS_ASSERT_EQUALS(bvh.findDetector(V3D(), V3D()), DetectorBVH::NONE);
+  }
+
+  void test_nearest_detector_is_found() {
+    // Bank 2 is behind bank 1 as seen from the sample
+    const auto wrappers = makeWrappers(
+        ComponentCreationHelper::createTestInstrumentRectangular(2, 4, 0.008,
+                                                                 1.0));
+    const auto &componentInfo = *wrappers.first;
+    const auto &detectorInfo = *wrappers.second;
+    const DetectorBVH bvh(componentInfo);
+    const auto front = detectorInfo.indexOf(16);
+    const auto back = detectorInfo.indexOf(32);
+    TS_ASSERT_EQUALS(bvh.findDetector(V3D(), componentInfo.position(back)),
+                     front);
+  }
+
+  void test_batched_rays_match_single_rays() {
+    const auto wrappers = makeWrappers(
+        ComponentCreationHelper::createTestInstrumentCylindrical(3));
+    const auto &componentInfo = *wrappers.first;
+    const DetectorBVH bvh(componentInfo);
+    const auto sample = componentInfo.samplePosition();
+    std::vector<V3D> directions;
+    for (size_t i = 0; i < componentInfo.size(); ++i)
+      directions.emplace_back(componentInfo.position(i) - sample);
+    directions.emplace_back(0., 0., -1.);
+
+    const auto results = bvh.findDetectors(sample, directions);
+    TS_ASSERT_EQUALS(results.size(), directions.size());
+    for (size_t i = 0; i < directions.size(); ++i)
+      TS_ASSERT_EQUALS(results[i], bvh.findDetector(sample, directions[i]));
+    // Only the front bank is not hidden behind another one
+    for (size_t i = 0; i < componentInfo.size(); ++i) {
+      if (componentInfo.isDetector(i) && componentInfo.position(i).Z() < 6.)
+        TS_ASSERT_EQUALS(results[i], i);
+    }
+  }
+
+  void test_points_inside_pixels_find_them() {
+    const auto wrappers = makeWrappers(
+        ComponentCreationHelper::createTestInstrumentRectangular(1, 10));
+    const auto &componentInfo = *wrappers.first;
+    const DetectorBVH bvh(componentInfo);
+    std::vector<V3D> points;
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < componentInfo.size(); ++i) {
+      if (componentInfo.isDetector(i)) {
+        points.emplace_back(componentInfo.position(i));
+        expected.emplace_back(i);
+      }
+    }
+    points.emplace_back(0., 0., 100.);
+    expected.emplace_back(DetectorBVH::NONE);
+
+    const auto results = bvh.detectorsContaining(points);
+    TS_ASSERT_EQUALS(results, expected);
+    for (size_t i = 0; i < points.size(); ++i)
+      TS_ASSERT_EQUALS(bvh.detectorContaining(points[i]), expected[i]);
+  }
+
+  void test_component_info_rebuilds_hierarchy_after_move() {
+    const auto wrappers = makeWrappers(
+        ComponentCreationHelper::createTestInstrumentRectangular(1, 4));
+    auto &componentInfo = *wrappers.first;
+    auto &detectorInfo = *wrappers.second;
+    const auto index = detectorInfo.indexOf(16);
+    const auto oldPosition = componentInfo.position(index);
+    const auto &initial = componentInfo.detectorBVH();
+    TS_ASSERT_EQUALS(initial.detectorContaining(oldPosition), index);
+
+    const V3D newPosition(1., 1., 1.);
+    detectorInfo.setPosition(index, newPosition);
+    const auto &bvh = componentInfo.detectorBVH();
+    TS_ASSERT_EQUALS(bvh.detectorContaining(oldPosition), DetectorBVH::NONE);
+    TS_ASSERT_EQUALS(bvh.detectorContaining(newPosition), index);
+    TS_ASSERT_EQUALS(&componentInfo.detectorBVH(), &bvh);
+
+    const auto bank = componentInfo.parent(index);
+    componentInfo.setPosition(bank, componentInfo.position(bank) +
+                                        V3D(0., 0., 1.));
+    TS_ASSERT_EQUALS(componentInfo.detectorBVH().detectorContaining(
+                         newPosition + V3D(0., 0., 1.)),
+                     index);
+  }
+
+private:
+  std::pair<std::unique_ptr<ComponentInfo>, std::unique_ptr<DetectorInfo>>
+  makeWrappers(const Instrument_sptr &instrument) {
+    return InstrumentVisitor::makeWrappers(*instrument);
+  }
+};
@@ -0,0 +1,214 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/InstrumentCache.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Strings.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <fstream>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::ConfigService;
+
+class InstrumentCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static InstrumentCacheTest *createSuite() {
+    return new InstrumentCacheTest();
+  }
+  static void destroySuite(InstrumentCacheTest *suite) { delete suite; }
+
+  InstrumentCacheTest() {
+    Poco::Path path(ConfigService::Instance().getTempDir());
+    path.makeDirectory();
+    path.pushDirectory("InstrumentCacheTest");
+    m_directory = path.toString();
+  }
+
+  void tearDown() override {
+    Poco::File directory(m_directory);
+    if (directory.exists())
+      directory.remove(true);
+  }
+
+  void test_disabled_cache_does_nothing() {
+    InstrumentCache cache("");
+    TS_ASSERT(!cache.isEnabled());
+    const auto instrument =
+        ComponentCreationHelper::createTestInstrumentCylindrical(1);
+    TS_ASSERT(!cache.save(*instrument, "name"));
+    TS_ASSERT(!cache.load("name"));
+  }
+
+  void test_instrument_is_restored() {
+    const auto instrument =
+        ComponentCreationHelper::createTestInstrumentCylindrical(2);
+    InstrumentCache cache(m_directory);
+    TS_ASSERT(cache.save(*instrument, "cylindrical"));
+    TS_ASSERT(Poco::File(cache.filename("cylindrical")).exists());
+
+    const auto restored = cache.load("cylindrical");
+    TS_ASSERT(restored);
+    assertSameInstrument(*instrument, *restored);
+  }
+
+  void test_rectangular_detectors_are_restored() {
+    const auto instrument = parse("MINITOPAZ_Definition.xml", "MINITOPAZ");
+    InstrumentCache cache(m_directory);
+    TS_ASSERT(cache.save(*instrument, "MINITOPAZ"));
+
+    const auto restored = cache.load("MINITOPAZ");
+    TS_ASSERT(restored);
+    assertSameInstrument(*instrument, *restored);
+    TS_ASSERT_EQUALS(restored->containsRectDetectors(),
+                     instrument->containsRectDetectors());
+    const auto bank = boost::dynamic_pointer_cast<const RectangularDetector>(
+        restored->getComponentByName("bank1"));
+    TS_ASSERT(bank);
+    TS_ASSERT_EQUALS(bank->xpixels(), 100);
+  }
+
+  void test_parameters_and_instrument_settings_are_restored() {
+    const auto instrument =
+        parse("IDF_for_UNIT_TESTING2.xml", "For Unit Testing2");
+    InstrumentCache cache(m_directory);
+    TS_ASSERT(cache.save(*instrument, "UnitTesting2"));
+
+    const auto restored = cache.load("UnitTesting2");
+    TS_ASSERT(restored);
+    assertSameInstrument(*instrument, *restored);
+    TS_ASSERT_EQUALS(restored->getXmlText(), instrument->getXmlText());
+    TS_ASSERT_EQUALS(restored->getFilename(), instrument->getFilename());
+    TS_ASSERT_EQUALS(restored->getValidFromDate(),
+                     instrument->getValidFromDate());
+    TS_ASSERT_EQUALS(restored->getValidToDate(), instrument->getValidToDate());
+    TS_ASSERT_EQUALS(restored->getDefaultView(), instrument->getDefaultView());
+    TS_ASSERT_EQUALS(restored->getDefaultAxis(), instrument->getDefaultAxis());
+    const auto frame = restored->getReferenceFrame();
+    TS_ASSERT_EQUALS(frame->pointingUp(),
+                     instrument->getReferenceFrame()->pointingUp());
+    TS_ASSERT_EQUALS(frame->pointingAlongBeam(),
+                     instrument->getReferenceFrame()->pointingAlongBeam());
+    TS_ASSERT_EQUALS(frame->vecThetaSign(),
+                     instrument->getReferenceFrame()->vecThetaSign());
+
+    const auto &parameters = instrument->getLogfileCache();
+    const auto &restoredParameters = restored->getLogfileCache();
+    TS_ASSERT(!parameters.empty());
+    TS_ASSERT_EQUALS(restoredParameters.size(), parameters.size());
+    auto restoredIt = restoredParameters.cbegin();
+    for (auto it = parameters.cbegin();
+         it != parameters.cend() && restoredIt != restoredParameters.cend();
+         ++it, ++restoredIt) {
+      const auto &parameter = *it->second;
+      const auto &restoredParameter = *restoredIt->second;
+      TS_ASSERT_EQUALS(restoredIt->first.first, it->first.first);
+      TS_ASSERT_EQUALS(restoredParameter.m_paramName, parameter.m_paramName);
+      TS_ASSERT_EQUALS(restoredParameter.m_value, parameter.m_value);
+      TS_ASSERT_EQUALS(restoredParameter.m_type, parameter.m_type);
+      TS_ASSERT_EQUALS(restoredParameter.m_formula, parameter.m_formula);
+      TS_ASSERT_EQUALS(restoredParameter.m_constraint, parameter.m_constraint);
+      TS_ASSERT_EQUALS(restoredParameter.m_component->getFullName(),
+                       parameter.m_component->getFullName());
+      TS_ASSERT_EQUALS(restoredParameter.m_interpolation->value(1.),
+                       parameter.m_interpolation->value(1.));
+    }
+  }
+
+  void test_file_of_another_definition_is_not_loaded() {
+    const auto instrument =
+        ComponentCreationHelper::createTestInstrumentCylindrical(1);
+    InstrumentCache cache(m_directory);
+    TS_ASSERT(cache.save(*instrument, "old"));
+    TS_ASSERT(!cache.load("new"));
+
+    Poco::File(cache.filename("old")).copyTo(cache.filename("new"));
+    TS_ASSERT(!cache.load("new"));
+  }
+
+  void test_truncated_file_is_not_loaded() {
+    const auto instrument =
+        ComponentCreationHelper::createTestInstrumentCylindrical(1);
+    InstrumentCache cache(m_directory);
+    TS_ASSERT(cache.save(*instrument, "truncated"));
+    const auto filename = cache.filename("truncated");
+    const auto content = Mantid::Kernel::Strings::loadFile(filename);
+    std::ofstream(filename, std::ios::binary | std::ios::trunc)
+        << content.substr(0, content.size() / 2);
+
+    TS_ASSERT(!cache.load("truncated"));
+  }
+
+  void test_instrument_with_physical_instrument_is_not_saved() {
+    const auto instrument =
+        ComponentCreationHelper::createTestInstrumentCylindrical(1);
+    instrument->setPhysicalInstrument(
+        std::make_unique<Instrument>(*instrument));
+    InstrumentCache cache(m_directory);
+    TS_ASSERT(!cache.save(*instrument, "physical"));
+    TS_ASSERT(!Poco::File(cache.filename("physical")).exists());
+  }
+
+private:
+  Instrument_sptr parse(const std::string &filename, const std::string &name) {
+    const auto path = ConfigService::Instance().getInstrumentDirectory() +
+                      "/unit_testing/" + filename;
+    InstrumentDefinitionParser parser(path, name,
+                                      Mantid::Kernel::Strings::loadFile(path));
+    return parser.parseXML(nullptr);
+  }
+
+  void assertSameInstrument(const Instrument &expected,
+                            const Instrument &actual) {
+    TS_ASSERT_EQUALS(actual.getName(), expected.getName());
+    TS_ASSERT_EQUALS(actual.nelements(), expected.nelements());
+    TS_ASSERT_EQUALS(actual.getSource()->getFullName(),
+                     expected.getSource()->getFullName());
+    TS_ASSERT_EQUALS(actual.getSource()->getPos(),
+                     expected.getSource()->getPos());
+    TS_ASSERT_EQUALS(actual.getSample()->getFullName(),
+                     expected.getSample()->getFullName());
+    TS_ASSERT_EQUALS(actual.getMonitors(), expected.getMonitors());
+
+    const auto detectorIDs = expected.getDetectorIDs();
+    TS_ASSERT_EQUALS(actual.getDetectorIDs(), detectorIDs);
+    if (actual.getDetectorIDs() != detectorIDs)
+      return;
+    for (const auto id : detectorIDs) {
+      const auto *detector = expected.getBaseDetector(id);
+      const auto *restored = actual.getBaseDetector(id);
+      TS_ASSERT_EQUALS(restored->getFullName(), detector->getFullName());
+      TS_ASSERT_EQUALS(restored->getPos(), detector->getPos());
+      TS_ASSERT_EQUALS(restored->getRotation(), detector->getRotation());
+      const auto shape =
+          boost::dynamic_pointer_cast<const CSGObject>(detector->shape());
+      const auto restoredShape =
+          boost::dynamic_pointer_cast<const CSGObject>(restored->shape());
+      TS_ASSERT(restoredShape);
+      if (shape && restoredShape) {
+        TS_ASSERT_EQUALS(restoredShape->getShapeXML(), shape->getShapeXML());
+        TS_ASSERT_EQUALS(restoredShape->getName(), shape->getName());
+      }
+    }
+  }
+
+  std::string m_directory;
+};
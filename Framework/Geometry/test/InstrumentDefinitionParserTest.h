@@ -1070,6 +1070,53 @@ public:
     TS_ASSERT_THROWS(loadInstrLocations(locations, numDetectors, true),
                      const Exception::InstrumentDefinitionError &);
   }
+
+  void testLocationsGiveSameDetectorsAsLocationElements() {
+    const std::string locations =
+        R"(<locations n-elements="4" name="det" r="2.0" p="10.0" )"
+        R"(p-end="40.0" rot="0.0" rot-end="90.0" axis-x="1.0" axis-z="0.0" />)";
+    std::string expanded;
+    for (int i = 0; i < 4; ++i) {
+      expanded += "<location name=\"det" + std::to_string(i) + "\" p=\"" +
+                  std::to_string(10. * (i + 1)) + "\" r=\"2.0\" rot=\"" +
+                  std::to_string(30. * i) +
+                  "\" axis-x=\"1.0\" axis-z=\"0.0\" />";
+    }
+    detid_t numDetectors = 4;
+
+    Instrument_sptr instr = loadInstrLocations(locations, numDetectors);
+    Instrument_sptr expected = loadInstrLocations(expanded, numDetectors);
+
+    for (detid_t id = 1; id <= numDetectors; ++id) {
+      const auto detector = instr->getDetector(id);
+      const auto expectedDetector = expected->getDetector(id);
+      TS_ASSERT_EQUALS(detector->getFullName(),
+                       expectedDetector->getFullName());
+      TS_ASSERT_DELTA(detector->getPos().distance(expectedDetector->getPos()),
+                      0., 1.0E-12);
+      double deg, axisX, axisY, axisZ;
+      expectedDetector->getRotation().getAngleAxis(deg, axisX, axisY, axisZ);
+      checkDetectorRot(detector, deg, axisX, axisY, axisZ);
+    }
+  }
+
+  void testUnnamedLocationsTakeTheNameOfTheType() {
+    std::string locations = R"(<locations n-elements="3" x="1.0" />)";
+    detid_t numDetectors = 3;
+
+    Instrument_sptr instr = loadInstrLocations(locations, numDetectors);
+
+    TS_ASSERT_EQUALS(instr->getDetector(1)->getName(), "flat-detector");
+    TS_ASSERT_EQUALS(instr->getDetector(3)->getName(), "flat-detector");
+  }
+
+  void testLocationsWithTooFewIDs() {
+    std::string locations = R"(<locations n-elements="5" name="det" />)";
+    detid_t numDetectors = 3;
+
+    TS_ASSERT_THROWS(loadInstrLocations(locations, numDetectors, true),
+                     const Exception::InstrumentDefinitionError &);
+  }
 };
 
 class InstrumentDefinitionParserTestPerformance : public CxxTest::TestSuite {
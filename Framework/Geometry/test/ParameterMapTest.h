@@ -401,6 +401,24 @@ public:
     TS_ASSERT_EQUALS(origValue, origParameter->value<Quat>());
   }
 
+  void
+  test_Adding_Or_Clearing_Parameters_On_A_Copy_Does_Not_Change_Original() {
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), "first", 1.0);
+
+    ParameterMap copy(pmap);
+    copy.addDouble(m_testInstrument.get(), "second", 2.0);
+    TS_ASSERT_EQUALS(2, copy.size());
+    TS_ASSERT_EQUALS(1, pmap.size());
+    TS_ASSERT(!pmap.contains(m_testInstrument.get(), "second"));
+
+    ParameterMap other(pmap);
+    other.clearParametersByName("first");
+    TS_ASSERT(other.empty());
+    TS_ASSERT(pmap.contains(m_testInstrument.get(), "first"));
+    TS_ASSERT(copy.contains(m_testInstrument.get(), "first"));
+  }
+
   void testMap_Contains_Newly_Added_Value_For_Correct_Component() {
     ParameterMap pmap;
     const std::string name("NewValue");
@@ -647,6 +665,71 @@ public:
     TS_ASSERT_EQUALS(oldA->value<bool>(), false);
   }
 
+  void test_recursive_lookup_in_instrument_follows_modifications() {
+    ParameterMap pmap;
+    pmap.setInstrument(m_testInstrument.get());
+    const auto detector = m_testInstrument->getDetector(1);
+    const auto bank = detector->getParent();
+    pmap.addDouble(m_testInstrument.get(), "efficiency", 0.5);
+    auto fetched = pmap.getRecursive(detector.get(), "Efficiency");
+    TS_ASSERT(fetched);
+    TS_ASSERT_EQUALS(fetched->value<double>(), 0.5);
+    TS_ASSERT(!pmap.getRecursive(detector.get(), "efficiency", "int"));
+
+    // A parameter closer to the detector takes precedence
+    pmap.addDouble(bank.get(), "efficiency", 0.7);
+    fetched = pmap.getRecursive(detector.get(), "efficiency");
+    TS_ASSERT_EQUALS(fetched->value<double>(), 0.7);
+    TS_ASSERT_EQUALS(pmap.getRecursive(m_testInstrument.get(), "efficiency")
+                         ->value<double>(),
+                     0.5);
+    const ParameterMap copy(pmap);
+    TS_ASSERT_EQUALS(
+        copy.getRecursive(detector.get(), "efficiency")->value<double>(), 0.7);
+
+    pmap.clearParametersByName("efficiency", bank.get());
+    fetched = pmap.getRecursive(detector.get(), "efficiency");
+    TS_ASSERT_EQUALS(fetched->value<double>(), 0.5);
+    pmap.clear();
+    TS_ASSERT(!pmap.getRecursive(detector.get(), "efficiency"));
+    TS_ASSERT_EQUALS(
+        copy.getRecursive(detector.get(), "efficiency")->value<double>(), 0.7);
+  }
+
+  void test_recursive_lookup_follows_modifications_through_iterators() {
+    ParameterMap pmap;
+    pmap.setInstrument(m_testInstrument.get());
+    const auto detector = m_testInstrument->getDetector(1);
+    pmap.addDouble(m_testInstrument.get(), "efficiency", 0.5);
+    TS_ASSERT_EQUALS(
+        pmap.getRecursive(detector.get(), "efficiency")->value<double>(), 0.5);
+    const ParameterMap copy(pmap);
+
+    for (auto &item : pmap) {
+      if (item.second->name() == "efficiency") {
+        auto replacement = Mantid::Geometry::ParameterFactory::create(
+            "double", "efficiency");
+        replacement->fromString("0.9");
+        item.second = replacement;
+      }
+    }
+    TS_ASSERT_EQUALS(
+        pmap.getRecursive(detector.get(), "efficiency")->value<double>(), 0.9);
+    TS_ASSERT_EQUALS(
+        copy.getRecursive(detector.get(), "efficiency")->value<double>(), 0.5);
+  }
+
+  void test_recursive_lookup_of_component_outside_instrument() {
+    ParameterMap pmap;
+    pmap.setInstrument(m_testInstrument.get());
+    pmap.addDouble(m_testInstrument.get(), "efficiency", 0.5);
+    Mantid::Geometry::Detector outside("outside", 1000, nullptr);
+    TS_ASSERT(!pmap.getRecursive(&outside, "efficiency"));
+    pmap.addDouble(&outside, "efficiency", 0.9);
+    TS_ASSERT_EQUALS(
+        pmap.getRecursive(&outside, "efficiency")->value<double>(), 0.9);
+  }
+
   void test_asString_for_doubles() {
     ParameterMap pmap;
     auto comp = m_testInstrument.get();
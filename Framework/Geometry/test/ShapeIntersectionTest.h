@@ -0,0 +1,143 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/Track.h"
+#include "MantidGeometry/Rendering/GeometryHandler.h"
+#include "MantidGeometry/Rendering/ShapeInfo.h"
+#include "MantidGeometry/ShapeIntersection.h"
+#include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/V3D.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class ShapeIntersectionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ShapeIntersectionTest *createSuite() {
+    return new ShapeIntersectionTest();
+  }
+  static void destroySuite(ShapeIntersectionTest *suite) { delete suite; }
+
+  void test_ray_through_sphere() {
+    const auto sphere = ComponentCreationHelper::createSphere(0.5);
+    ShapeIntersection::Intervals intervals;
+    TS_ASSERT_EQUALS(ShapeIntersection::intersect(sphere->shapeInfo(),
+                                                  V3D(0., 0., -2.),
+                                                  V3D(0., 0., 1.), intervals),
+                     1);
+    TS_ASSERT_DELTA(intervals[0].entry, 1.5, 1e-12);
+    TS_ASSERT_DELTA(intervals[0].exit, 2.5, 1e-12);
+  }
+
+  void test_ray_starting_inside_sphere() {
+    const auto sphere = ComponentCreationHelper::createSphere(0.5);
+    ShapeIntersection::Intervals intervals;
+    TS_ASSERT_EQUALS(ShapeIntersection::intersect(sphere->shapeInfo(), V3D(),
+                                                  V3D(1., 0., 0.), intervals),
+                     1);
+    TS_ASSERT_DELTA(intervals[0].entry, -0.5, 1e-12);
+    TS_ASSERT_DELTA(intervals[0].exit, 0.5, 1e-12);
+  }
+
+  void test_ray_behind_or_beside_shape_misses() {
+    const auto sphere = ComponentCreationHelper::createSphere(0.5);
+    ShapeIntersection::Intervals intervals;
+    TS_ASSERT_EQUALS(ShapeIntersection::intersect(sphere->shapeInfo(),
+                                                  V3D(0., 0., 2.),
+                                                  V3D(0., 0., 1.), intervals),
+                     0);
+    TS_ASSERT_EQUALS(ShapeIntersection::intersect(sphere->shapeInfo(),
+                                                  V3D(0., 1., -2.),
+                                                  V3D(0., 0., 1.), intervals),
+                     0);
+  }
+
+  void test_ray_across_hollow_cylinder_crosses_wall_twice() {
+    const auto hollow = ComponentCreationHelper::createHollowCylinder(
+        0.2, 0.4, 1., V3D(0., -0.5, 0.), V3D(0., 1., 0.), "hollow");
+    ShapeIntersection::Intervals intervals;
+    TS_ASSERT_EQUALS(ShapeIntersection::intersect(hollow->shapeInfo(),
+                                                  V3D(-1., 0., 0.),
+                                                  V3D(1., 0., 0.), intervals),
+                     2);
+    TS_ASSERT_DELTA(intervals[0].entry, 0.6, 1e-12);
+    TS_ASSERT_DELTA(intervals[0].exit, 0.8, 1e-12);
+    TS_ASSERT_DELTA(intervals[1].entry, 1.2, 1e-12);
+    TS_ASSERT_DELTA(intervals[1].exit, 1.4, 1e-12);
+    // Along the bore
+    TS_ASSERT_EQUALS(ShapeIntersection::intersect(hollow->shapeInfo(),
+                                                  V3D(0., -1., 0.),
+                                                  V3D(0., 1., 0.), intervals),
+                     0);
+  }
+
+  void test_sphere_matches_generic_intersection() {
+    assertSameAsGeneric(ComponentCreationHelper::createSphere(0.5));
+  }
+
+  void test_cylinder_matches_generic_intersection() {
+    assertSameAsGeneric(ComponentCreationHelper::createCappedCylinder(
+        0.3, 1., V3D(0.1, -0.5, 0.), V3D(1., 1., 0.), "cyl"));
+  }
+
+  void test_hollow_cylinder_matches_generic_intersection() {
+    assertSameAsGeneric(ComponentCreationHelper::createHollowCylinder(
+        0.2, 0.4, 1., V3D(0., 0., -0.5), V3D(0., 0., 1.), "hollow"));
+  }
+
+  void test_rotated_cuboid_matches_generic_intersection() {
+    assertSameAsGeneric(
+        ComponentCreationHelper::createCuboid(0.4, 0.3, 0.2, M_PI / 6.));
+  }
+
+private:
+  void assertSameAsGeneric(const boost::shared_ptr<CSGObject> &shape) {
+    TS_ASSERT(ShapeIntersection::isSupported(shape->shapeInfo()));
+    // The same object without a ShapeInfo takes the generic path
+    CSGObject generic(*shape);
+    generic.setGeometryHandler(boost::make_shared<GeometryHandler>(&generic));
+    TS_ASSERT_EQUALS(generic.shape(),
+                     detail::ShapeInfo::GeometryShape::NOSHAPE);
+
+    Mantid::Kernel::MersenneTwister rng(54321);
+    size_t hits{0};
+    for (size_t i = 0; i < 2000; ++i) {
+      const V3D start(rng.nextValue() * 3. - 1.5, rng.nextValue() * 3. - 1.5,
+                      rng.nextValue() * 3. - 1.5);
+      V3D direction(rng.nextValue() - 0.5, rng.nextValue() - 0.5,
+                    rng.nextValue() - 0.5);
+      direction.normalize();
+      Track analytic(start, direction);
+      Track reference(start, direction);
+      TS_ASSERT_EQUALS(shape->interceptSurface(analytic),
+                       generic.interceptSurface(reference));
+      TS_ASSERT_EQUALS(analytic.count(), reference.count());
+      if (analytic.count() != reference.count())
+        continue;
+      hits += analytic.count() > 0 ? 1 : 0;
+      auto expected = reference.cbegin();
+      for (auto link = analytic.cbegin(); link != analytic.cend();
+           ++link, ++expected) {
+        TS_ASSERT_DELTA(link->distFromStart, expected->distFromStart, 1e-10);
+        TS_ASSERT_DELTA(link->distInsideObject, expected->distInsideObject,
+                        1e-10);
+        TS_ASSERT_DELTA(link->entryPoint.distance(expected->entryPoint), 0.,
+                        1e-10);
+      }
+    }
+    TS_ASSERT_LESS_THAN(0, hits);
+  }
+};
@@ -6,13 +6,55 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include "MantidHistogramData/BinEdges.h"
 #include "MantidHistogramData/DllConfig.h"
+
+#include <vector>
+
 namespace Mantid {
 namespace HistogramData {
 class Histogram;
-class BinEdges;
 
 MANTID_HISTOGRAMDATA_DLL Histogram rebin(const Histogram &input,
                                          const BinEdges &binEdges);
+
+/** RebinMap : the overlaps between a set of bin edges and a new set of bin
+  edges, computed once and applied to any number of histograms with the old
+  bin edges.
+
+  Each new bin is a weighted sum of the old bins it overlaps, so rebinning a
+  histogram is a sparse matrix-vector product without searching the bin edges
+  again. This pays off when many histograms share their bin edges.
+*/
+class MANTID_HISTOGRAMDATA_DLL RebinMap {
+public:
+  RebinMap(const BinEdges &oldBinEdges, const BinEdges &newBinEdges);
+
+  Histogram rebin(const Histogram &input) const;
+
+  /// @return the bin edges of the rebinned histograms
+  const BinEdges &binEdges() const { return m_binEdges; }
+  /// @return the number of overlapping pairs of old and new bins
+  size_t size() const { return m_oldBins.size(); }
+
+private:
+  Histogram rebinCounts(const Histogram &input) const;
+  Histogram rebinFrequencies(const Histogram &input) const;
+
+  BinEdges m_binEdges;
+  size_t m_numOldBins;
+  /// The overlaps of new bin i are in [m_offsets[i], m_offsets[i + 1])
+  std::vector<size_t> m_offsets;
+  /// The old bin of each overlap
+  std::vector<size_t> m_oldBins;
+  /// The width of each overlap
+  std::vector<double> m_widths;
+  /// The width of each overlap divided by the width of its old bin
+  std::vector<double> m_fractions;
+  /// The width of each overlap multiplied by the width of its old bin, which
+  /// weights the variances of frequencies
+  std::vector<double> m_varianceWeights;
+};
+
 } // namespace HistogramData
 } // namespace Mantid
@@ -162,5 +162,144 @@ Histogram rebin(const Histogram &input, const BinEdges &binEdges) {
     throw std::runtime_error("YMode must be defined for input histogram.");
 }
 
+/** Compute the overlaps of the old and new bins. The checks on the bin
+ * widths are those of rebin().
+ * @param oldBinEdges :: the bin edges of the histograms to rebin
+ * @param newBinEdges :: the bin edges of the rebinned histograms
+ * @throws InvalidBinEdgesError for non-positive input/output bin widths
+ */
+RebinMap::RebinMap(const BinEdges &oldBinEdges, const BinEdges &newBinEdges)
+    : m_binEdges(newBinEdges),
+      m_numOldBins(oldBinEdges.empty() ? 0 : oldBinEdges.size() - 1) {
+  auto &xold = oldBinEdges.rawData();
+  auto &xnew = newBinEdges.rawData();
+  const size_t size_ynew = xnew.empty() ? 0 : xnew.size() - 1;
+  m_offsets.reserve(size_ynew + 1);
+  m_offsets.emplace_back(0);
+  size_t iold = 0;
+  size_t inew = 0;
+
+  while ((inew < size_ynew) && (iold < m_numOldBins)) {
+    auto xo_low = xold[iold];
+    auto xo_high = xold[iold + 1];
+    auto xn_low = xnew[inew];
+    auto xn_high = xnew[inew + 1];
+    auto owidth = xo_high - xo_low;
+    auto nwidth = xn_high - xn_low;
+
+    if (owidth <= 0.0 || nwidth <= 0.0) {
+      if (xo_high == -DBL_MAX && xo_low == -DBL_MAX) {
+        throw InvalidBinEdgesError(
+            "One or more x-values was unusually low "
+            "(below -1e100). This usually occurs when a "
+            "monitor spectrum has not been masked after "
+            "ConvertUnits has been run on the workspace");
+      } else {
+        throw InvalidBinEdgesError("Negative or zero bin widths not allowed.");
+      }
+    }
+
+    if (xn_high <= xo_low) {
+      m_offsets.emplace_back(m_oldBins.size());
+      inew++; /* old and new bins do not overlap */
+    } else if (xo_high <= xn_low)
+      iold++; /* old and new bins do not overlap */
+    else {
+      // delta is the overlap of the bins on the x axis
+      auto delta = xo_high < xn_high ? xo_high : xn_high;
+      delta -= xo_low > xn_low ? xo_low : xn_low;
+
+      m_oldBins.emplace_back(iold);
+      m_widths.emplace_back(delta);
+      m_fractions.emplace_back(delta / owidth);
+      m_varianceWeights.emplace_back(delta * owidth);
+
+      if (xn_high > xo_high) {
+        iold++;
+      } else {
+        m_offsets.emplace_back(m_oldBins.size());
+        inew++;
+      }
+    }
+  }
+  // The remaining new bins overlap no old bin
+  m_offsets.resize(size_ynew + 1, m_oldBins.size());
+}
+
+/** Rebins a histogram whose bin edges are those the map was created with.
+ * The result is the same as rebin() up to rounding.
+ * @param input :: input histogram data to be rebinned.
+ * @returns The rebinned histogram.
+ * @throws std::runtime_error if the input histogram xmode is not BinEdges,
+ * the input yMode is undefined, or the number of bins does not match
+ */
+Histogram RebinMap::rebin(const Histogram &input) const {
+  if (input.xMode() != Histogram::XMode::BinEdges)
+    throw std::runtime_error(
+        "XMode must be Histogram::XMode::BinEdges for input histogram");
+  if (input.y().size() != m_numOldBins)
+    throw std::runtime_error(
+        "The input histogram does not have the bins of the RebinMap");
+  if (input.yMode() == Histogram::YMode::Counts)
+    return rebinCounts(input);
+  else if (input.yMode() == Histogram::YMode::Frequencies)
+    return rebinFrequencies(input);
+  else
+    throw std::runtime_error("YMode must be defined for input histogram.");
+}
+
+Histogram RebinMap::rebinCounts(const Histogram &input) const {
+  auto &yold = input.y().rawData();
+  auto &eold = input.e().rawData();
+
+  const size_t size_ynew = m_offsets.size() - 1;
+  Counts newCounts(size_ynew);
+  CountVariances newCountVariances(size_ynew);
+  auto &ynew = newCounts.mutableData();
+  auto &enew = newCountVariances.mutableData();
+
+  for (size_t inew = 0; inew < size_ynew; ++inew) {
+    double y = 0.;
+    double variance = 0.;
+    for (size_t i = m_offsets[inew]; i < m_offsets[inew + 1]; ++i) {
+      const auto iold = m_oldBins[i];
+      y += yold[iold] * m_fractions[i];
+      variance += eold[iold] * eold[iold] * m_fractions[i];
+    }
+    ynew[inew] = y;
+    enew[inew] = variance;
+  }
+
+  return Histogram(m_binEdges, newCounts,
+                   CountStandardDeviations(std::move(newCountVariances)));
+}
+
+Histogram RebinMap::rebinFrequencies(const Histogram &input) const {
+  auto &yold = input.y().rawData();
+  auto &eold = input.e().rawData();
+  auto &xnew = m_binEdges.rawData();
+
+  const size_t size_ynew = m_offsets.size() - 1;
+  Frequencies newFrequencies(size_ynew);
+  FrequencyStandardDeviations newFrequencyStdDev(size_ynew);
+  auto &ynew = newFrequencies.mutableData();
+  auto &enew = newFrequencyStdDev.mutableData();
+
+  for (size_t inew = 0; inew < size_ynew; ++inew) {
+    double y = 0.;
+    double variance = 0.;
+    for (size_t i = m_offsets[inew]; i < m_offsets[inew + 1]; ++i) {
+      const auto iold = m_oldBins[i];
+      y += yold[iold] * m_widths[i];
+      variance += eold[iold] * eold[iold] * m_varianceWeights[i];
+    }
+    const auto factor = 1 / (xnew[inew + 1] - xnew[inew]);
+    ynew[inew] = y * factor;
+    enew[inew] = sqrt(variance) * factor;
+  }
+
+  return Histogram(m_binEdges, newFrequencies, newFrequencyStdDev);
+}
+
 } // namespace HistogramData
 } // namespace Mantid
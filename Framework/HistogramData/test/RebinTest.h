@@ -388,7 +388,57 @@ public:
     TS_ASSERT_EQUALS(outFreq.e()[2], 0);
   }
 
+  void testRebinMapMatchesRebin() {
+    const auto counts = getCountsHistogram();
+    const auto frequencies = getFrequencyHistogram();
+    for (const auto &edges :
+         {BinEdges{-1, 0.5, 0.7, 3.2, 3.3, 7.9, 12},
+          BinEdges(20, LinearGenerator(-0.25, 0.5)), BinEdges{2.5, 3.5},
+          BinEdges{10, 11, 12}}) {
+      const RebinMap map(counts.binEdges(), edges);
+      assertRebinnedEqual(map.rebin(counts), rebin(counts, edges));
+      assertRebinnedEqual(map.rebin(frequencies), rebin(frequencies, edges));
+    }
+  }
+
+  void testRebinMapSize() {
+    // Each new bin overlaps two old ones
+    const RebinMap map(BinEdges(10, LinearGenerator(0, 1)),
+                       BinEdges{0.5, 1.5, 2.5});
+    TS_ASSERT_EQUALS(map.size(), 4);
+    TS_ASSERT_EQUALS(map.binEdges().rawData(),
+                     std::vector<double>({0.5, 1.5, 2.5}));
+  }
+
+  void testRebinMapFailsBinEdgesInvalid() {
+    const BinEdges edges(10, LinearGenerator(0, 1));
+    const BinEdges invalid(std::vector<double>{1, 2, 2, 3});
+    TS_ASSERT_THROWS(RebinMap(edges, invalid), const InvalidBinEdgesError &);
+    TS_ASSERT_THROWS(RebinMap(invalid, edges), const InvalidBinEdgesError &);
+  }
+
+  void testRebinMapFailsOtherBins() {
+    const RebinMap map(BinEdges(5, LinearGenerator(0, 1)),
+                       BinEdges{0.5, 1.5});
+    TS_ASSERT_THROWS(map.rebin(getCountsHistogram()),
+                     const std::runtime_error &);
+    TS_ASSERT_THROWS(
+        map.rebin(Histogram(Points(4, LinearGenerator(0, 1)), Counts(4, 1))),
+        const std::runtime_error &);
+  }
+
 private:
+  void assertRebinnedEqual(const Histogram &actual,
+                           const Histogram &expected) {
+    TS_ASSERT_EQUALS(actual.x(), expected.x());
+    TS_ASSERT_EQUALS(actual.yMode(), expected.yMode());
+    TS_ASSERT_EQUALS(actual.y().size(), expected.y().size());
+    for (size_t i = 0; i < expected.y().size(); ++i) {
+      TS_ASSERT_DELTA(actual.y()[i], expected.y()[i], 1e-12);
+      TS_ASSERT_DELTA(actual.e()[i], expected.e()[i], 1e-12);
+    }
+  }
+
   Histogram getCountsHistogram() {
     return Histogram(BinEdges(10, LinearGenerator(0, 1)),
                      Counts{10.5, 11.2, 19.3, 25.4, 36.8, 40.3, 17.7, 9.3, 4.6},
@@ -443,6 +493,18 @@ public:
       rebin(histFreq, lgBins);
   }
 
+  void testRebinMapCountsSmallerBins() {
+    const RebinMap map(hist.binEdges(), smBins);
+    for (size_t i = 0; i < nIters; i++)
+      map.rebin(hist);
+  }
+
+  void testRebinMapCountsLargerBins() {
+    const RebinMap map(hist.binEdges(), lgBins);
+    for (size_t i = 0; i < nIters; i++)
+      map.rebin(hist);
+  }
+
 private:
   const size_t binSize = 10000;
   const size_t nIters = 10000;
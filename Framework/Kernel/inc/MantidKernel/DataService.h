@@ -516,6 +516,27 @@ protected:
   DataService(const std::string &name) : svcName(name), g_log(svcName) {}
   virtual ~DataService() = default;
 
+  /** Replace the object stored under a name without notifying observers, for
+   * services that swap an object for an equivalent stand-in
+   * @param name :: name of the object
+   * @param expected :: the object that must currently be stored
+   * @param replacement :: the object to store instead
+   * @param maxUseCount :: if not 0, the most owners the object may have,
+   * including the service, so that the caller knows who else uses it
+   * @return true if the object was replaced
+   */
+  bool exchange(const std::string &name, const boost::shared_ptr<T> &expected,
+                boost::shared_ptr<T> replacement, const long maxUseCount = 0) {
+    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
+    auto it = datamap.find(name);
+    if (it == datamap.end() || it->second != expected ||
+        (maxUseCount > 0 && expected.use_count() > maxUseCount)) {
+      return false;
+    }
+    it->second = std::move(replacement);
+    return true;
+  }
+
 private:
   void checkForEmptyName(const std::string &name) {
     if (name.empty()) {
@@ -0,0 +1,308 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+  KDTree is a header-only k-d tree for exact k nearest neighbour and fixed
+  radius searches in N dimensions.
+
+  The tree is implicit: the points are reordered such that every node is the
+  median of a contiguous range of the point array, its left subtree occupying
+  the lower half of the range and its right subtree the upper half. No node
+  objects are allocated, which keeps the tree compact and the searches cache
+  friendly. Small ranges at the bottom of the tree are scanned linearly.
+
+  Construction of the lower levels of the tree runs in parallel. A constructed
+  tree is immutable so any number of threads may query it concurrently. The
+  batched query methods do that themselves.
+
+  All distances are reported as squared Euclidean distances.
+*/
+template <size_t N> class KDTree {
+public:
+  using Point = std::array<double, N>;
+
+  /// A point found by a search.
+  struct Neighbour {
+    /// Index of the point in the container given to the constructor
+    size_t index;
+    /// Squared distance to the search position
+    double distanceSq;
+  };
+  using Neighbours = std::vector<Neighbour>;
+
+  /** Build a tree
+   * @param points :: a container of points; each point must support
+   * operator[] for indices 0 to N-1
+   */
+  template <typename Points> explicit KDTree(const Points &points) {
+    const size_t numPoints = points.size();
+    if (numPoints == 0) {
+      throw std::invalid_argument("KDTree: cannot build a tree without points");
+    }
+    m_entries.resize(numPoints);
+    m_splitDims.resize(numPoints, 0);
+    size_t i = 0;
+    for (const auto &point : points) {
+      for (size_t d = 0; d < N; ++d) {
+        m_entries[i].point[d] = static_cast<double>(point[d]);
+      }
+      m_entries[i].index = i;
+      ++i;
+    }
+    build();
+  }
+
+  /// @return the number of points in the tree
+  size_t size() const { return m_entries.size(); }
+
+  /** Find the k nearest neighbours of a position
+   * @param pos :: the search position
+   * @param k :: the number of neighbours to find
+   * @return up to k neighbours ordered by increasing distance
+   */
+  Neighbours nearest(const Point &pos, const size_t k) const {
+    Neighbours result;
+    if (k == 0) {
+      return result;
+    }
+    result.reserve(k);
+    searchNearest(pos, k, 0, size(), result);
+    std::sort_heap(result.begin(), result.end(), closerThan);
+    for (auto &neighbour : result) {
+      neighbour.index = m_entries[neighbour.index].index;
+    }
+    return result;
+  }
+
+  /** Find all points within a radius of a position
+   * @param pos :: the search position
+   * @param radius :: the search radius, inclusive
+   * @return the neighbours ordered by increasing distance
+   */
+  Neighbours withinRadius(const Point &pos, const double radius) const {
+    Neighbours result;
+    if (radius < 0.) {
+      return result;
+    }
+    searchRadius(pos, radius * radius, 0, size(), result);
+    std::sort(result.begin(), result.end(), closerThan);
+    for (auto &neighbour : result) {
+      neighbour.index = m_entries[neighbour.index].index;
+    }
+    return result;
+  }
+
+  /** Find the k nearest neighbours of many positions in parallel
+   * @param positions :: the search positions
+   * @param k :: the number of neighbours to find
+   * @return the result of nearest() for each position
+   */
+  std::vector<Neighbours> batchNearest(const std::vector<Point> &positions,
+                                       const size_t k) const {
+    std::vector<Neighbours> results(positions.size());
+    const auto numPositions = static_cast<int64_t>(positions.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numPositions; ++i) {
+      results[i] = nearest(positions[i], k);
+    }
+    return results;
+  }
+
+  /** Find the points within a radius of many positions in parallel
+   * @param positions :: the search positions
+   * @param radius :: the search radius, inclusive
+   * @return the result of withinRadius() for each position
+   */
+  std::vector<Neighbours>
+  batchWithinRadius(const std::vector<Point> &positions,
+                    const double radius) const {
+    std::vector<Neighbours> results(positions.size());
+    const auto numPositions = static_cast<int64_t>(positions.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numPositions; ++i) {
+      results[i] = withinRadius(positions[i], radius);
+    }
+    return results;
+  }
+
+private:
+  /// Ranges of at most this many points are not split further
+  static constexpr size_t LEAF_SIZE = 8;
+  /// Ranges larger than this are split before the parallel build starts
+  static constexpr size_t PARALLEL_GRAIN = 4096;
+
+  struct Entry {
+    Point point;
+    size_t index;
+  };
+
+  struct Range {
+    size_t begin;
+    size_t end;
+  };
+
+  static bool closerThan(const Neighbour &a, const Neighbour &b) {
+    return a.distanceSq < b.distanceSq;
+  }
+
+  double distanceSq(const Point &pos, const size_t i) const {
+    double sum = 0.;
+    for (size_t d = 0; d < N; ++d) {
+      const double delta = pos[d] - m_entries[i].point[d];
+      sum += delta * delta;
+    }
+    return sum;
+  }
+
+  /// Build the tree: split the top levels serially, the rest in parallel
+  void build() {
+    std::vector<Range> pending{{0, size()}};
+    std::vector<Range> subtrees;
+    while (!pending.empty()) {
+      const auto range = pending.back();
+      pending.pop_back();
+      if (range.end - range.begin <= PARALLEL_GRAIN) {
+        subtrees.emplace_back(range);
+        continue;
+      }
+      const size_t mid = split(range.begin, range.end);
+      pending.push_back({range.begin, mid});
+      pending.push_back({mid + 1, range.end});
+    }
+    const auto numSubtrees = static_cast<int64_t>(subtrees.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numSubtrees; ++i) {
+      buildRecursive(subtrees[i].begin, subtrees[i].end);
+    }
+  }
+
+  void buildRecursive(const size_t begin, const size_t end) {
+    if (end - begin <= LEAF_SIZE) {
+      return;
+    }
+    const size_t mid = split(begin, end);
+    buildRecursive(begin, mid);
+    buildRecursive(mid + 1, end);
+  }
+
+  /** Partition a range around the median of its widest dimension
+   * @return the position of the median
+   */
+  size_t split(const size_t begin, const size_t end) {
+    Point low, high;
+    low.fill(std::numeric_limits<double>::max());
+    high.fill(std::numeric_limits<double>::lowest());
+    for (size_t i = begin; i < end; ++i) {
+      const auto &point = m_entries[i].point;
+      for (size_t d = 0; d < N; ++d) {
+        low[d] = std::min(low[d], point[d]);
+        high[d] = std::max(high[d], point[d]);
+      }
+    }
+    uint8_t dim = 0;
+    for (size_t d = 1; d < N; ++d) {
+      if (high[d] - low[d] > high[dim] - low[dim]) {
+        dim = static_cast<uint8_t>(d);
+      }
+    }
+    const size_t mid = begin + (end - begin) / 2;
+    std::nth_element(m_entries.begin() + begin, m_entries.begin() + mid,
+                     m_entries.begin() + end,
+                     [dim](const Entry &a, const Entry &b) {
+                       return a.point[dim] < b.point[dim];
+                     });
+    m_splitDims[mid] = dim;
+    return mid;
+  }
+
+  /// Offer point i to a max-heap holding the k best candidates so far
+  void offer(const Point &pos, const size_t k, const size_t i,
+             Neighbours &heap) const {
+    const double dist = distanceSq(pos, i);
+    if (heap.size() < k) {
+      heap.push_back({i, dist});
+      std::push_heap(heap.begin(), heap.end(), closerThan);
+    } else if (dist < heap.front().distanceSq) {
+      std::pop_heap(heap.begin(), heap.end(), closerThan);
+      heap.back() = {i, dist};
+      std::push_heap(heap.begin(), heap.end(), closerThan);
+    }
+  }
+
+  void searchNearest(const Point &pos, const size_t k, const size_t begin,
+                     const size_t end, Neighbours &heap) const {
+    if (end - begin <= LEAF_SIZE) {
+      for (size_t i = begin; i < end; ++i) {
+        offer(pos, k, i, heap);
+      }
+      return;
+    }
+    const size_t mid = begin + (end - begin) / 2;
+    offer(pos, k, mid, heap);
+    const auto dim = m_splitDims[mid];
+    const double delta = pos[dim] - m_entries[mid].point[dim];
+    if (delta < 0.) {
+      searchNearest(pos, k, begin, mid, heap);
+      if (heap.size() < k || delta * delta < heap.front().distanceSq) {
+        searchNearest(pos, k, mid + 1, end, heap);
+      }
+    } else {
+      searchNearest(pos, k, mid + 1, end, heap);
+      if (heap.size() < k || delta * delta < heap.front().distanceSq) {
+        searchNearest(pos, k, begin, mid, heap);
+      }
+    }
+  }
+
+  void searchRadius(const Point &pos, const double radiusSq,
+                    const size_t begin, const size_t end,
+                    Neighbours &result) const {
+    if (end - begin <= LEAF_SIZE) {
+      for (size_t i = begin; i < end; ++i) {
+        const double dist = distanceSq(pos, i);
+        if (dist <= radiusSq) {
+          result.push_back({i, dist});
+        }
+      }
+      return;
+    }
+    const size_t mid = begin + (end - begin) / 2;
+    const double dist = distanceSq(pos, mid);
+    if (dist <= radiusSq) {
+      result.push_back({mid, dist});
+    }
+    const auto dim = m_splitDims[mid];
+    const double delta = pos[dim] - m_entries[mid].point[dim];
+    if (delta <= 0. || delta * delta <= radiusSq) {
+      searchRadius(pos, radiusSq, begin, mid, result);
+    }
+    if (delta >= 0. || delta * delta <= radiusSq) {
+      searchRadius(pos, radiusSq, mid + 1, end, result);
+    }
+  }
+
+  /// The points and their original indices in tree order
+  std::vector<Entry> m_entries;
+  /// The split dimension of the node rooted at each tree position
+  std::vector<uint8_t> m_splitDims;
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -6,6 +6,8 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include "MantidKernel/DllConfig.h"
+
 #include <atomic>
 #include <mutex>
 
@@ -77,6 +79,28 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
   } while (!f.compare_exchange_weak(old, desired));
 }
 
+/// @return the maximum number of threads parallel loops may use in total
+MANTID_KERNEL_DLL int parallelThreadBudget();
+
+/// Set the maximum number of threads parallel loops may use in total
+MANTID_KERNEL_DLL void setParallelThreadBudget(const int numThreads);
+
+/// @return the number of threads a parallel loop started now should use
+MANTID_KERNEL_DLL int parallelThreadCount();
+
+/** ParallelTaskScope marks the calling thread as running one of many
+ * concurrent tasks, e.g. a Task of a ThreadPool, for its lifetime. Parallel
+ * loops started by the thread in the meantime run serially instead of
+ * spawning a team of threads per task and oversubscribing the cores.
+ */
+class MANTID_KERNEL_DLL ParallelTaskScope {
+public:
+  ParallelTaskScope();
+  ~ParallelTaskScope();
+  ParallelTaskScope(const ParallelTaskScope &) = delete;
+  ParallelTaskScope &operator=(const ParallelTaskScope &) = delete;
+};
+
 } // namespace Kernel
 } // namespace Mantid
 
@@ -84,12 +108,8 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 // GCC
 #ifdef _MSC_VER
 #define PRAGMA __pragma
-#define PARALLEL_SET_CONFIG_THREADS
 #else //_MSC_VER
 #define PRAGMA(x) _Pragma(#x)
-#define PARALLEL_SET_CONFIG_THREADS                                            \
-  setMaxCoresToConfig();                                                       \
-  PARALLEL_SET_DYNAMIC(false);
 #endif //_MSC_VER
 
 /** Begins a block to skip processing is the algorithm has been interupted
@@ -136,19 +156,21 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *   This includes an arbirary check: condition.
  *   "condition" must evaluate to TRUE in order for the
- *   code to be executed in parallel
+ *   code to be executed in parallel.
+ *   All the PARALLEL_FOR macros use parallelThreadCount() threads and the
+ *   default schedule. Loops whose iterations differ much in cost can use
+ *   parallelForWeighted() from ParallelFor.h instead.
  */
 #define PARALLEL_FOR_IF(condition)                                             \
-  PARALLEL_SET_CONFIG_THREADS                                                  \
-  PRAGMA(omp parallel for if (condition) )
+  PRAGMA(omp parallel for if (condition)                                       \
+             num_threads(Mantid::Kernel::parallelThreadCount()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *   This includes no checks to see if workspaces are suitable
  *   and therefore should not be used in any loops that access workspaces.
  */
 #define PARALLEL_FOR_NO_WSP_CHECK()                                            \
-  PARALLEL_SET_CONFIG_THREADS                                                  \
-  PRAGMA(omp parallel for)
+  PRAGMA(omp parallel for num_threads(Mantid::Kernel::parallelThreadCount()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *  and declare the variables to be firstprivate.
@@ -156,12 +178,12 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
  *  and therefore should not be used in any loops that access workspace.
  */
 #define PARALLEL_FOR_NOWS_CHECK_FIRSTPRIVATE(variable)                         \
-  PARALLEL_SET_CONFIG_THREADS                                                  \
-  PRAGMA(omp parallel for firstprivate(variable) )
+  PRAGMA(omp parallel for firstprivate(variable)                               \
+             num_threads(Mantid::Kernel::parallelThreadCount()))
 
 #define PARALLEL_FOR_NO_WSP_CHECK_FIRSTPRIVATE2(variable1, variable2)          \
-  PARALLEL_SET_CONFIG_THREADS                                                  \
-  PRAGMA(omp parallel for firstprivate(variable1, variable2) )
+  PRAGMA(omp parallel for firstprivate(variable1, variable2)                   \
+             num_threads(Mantid::Kernel::parallelThreadCount()))
 
 /** Ensures that the next execution line or block is only executed if
  * there are multple threads execting in this region
@@ -198,20 +220,13 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 
 #define PARALLEL_THREAD_NUMBER omp_get_thread_num()
 
-#define PARALLEL PRAGMA(omp parallel)
+#define PARALLEL                                                               \
+  PRAGMA(omp parallel num_threads(Mantid::Kernel::parallelThreadCount()))
 
 #define PARALLEL_SECTIONS PRAGMA(omp sections nowait)
 
 #define PARALLEL_SECTION PRAGMA(omp section)
 
-inline void setMaxCoresToConfig() {
-  const auto maxCores = Mantid::Kernel::ConfigService::Instance().getValue<int>(
-      "MultiThreaded.MaxCores");
-  if (maxCores.get_value_or(0) > 0) {
-    PARALLEL_SET_NUM_THREADS(maxCores.get());
-  }
-}
-
 /** General purpose define for OpenMP, becomes the equivalent of
  * #pragma omp EXPRESSION
  * (if your compiler supports OpenMP)
@@ -6,15 +6,16 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
-#include "MantidKernel/ANN/ANN.h"
 #include "MantidKernel/DllConfig.h"
+#include "MantidKernel/KDTree.h"
 
 #include <Eigen/Core>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 /**
-  NearestNeighbours is a thin wrapper class around the ANN library for finding
+  NearestNeighbours is a thin wrapper class around KDTree for finding
   the k nearest neighbours.
 
   Given a vector of Eigen::Vectors this class will generate a KDTree. The tree
@@ -30,59 +31,6 @@
 namespace Mantid {
 namespace Kernel {
 
-//------------------------------------------------------------------------------
-// Helper classes
-//------------------------------------------------------------------------------
-
-/**
- * NNDataPoints is a thin RAII wrapper class around the ANNpointArray type. This
- * takes care of the proper allocation and deallocation of memory.
- */
-class NNDataPoints {
-public:
-  /** Construct a new set of data points
-   *
-   * @param nPts :: the number of data points
-   * @param nElems :: the number of elements for each point
-   */
-  NNDataPoints(const int nPts, const int nElems) : m_nPts(nPts) {
-    m_data = annAllocPts(m_nPts, nElems);
-  }
-
-  ~NNDataPoints() { annDeallocPts(m_data); }
-
-  /** Return a handle to the raw ANNpointArray wrapped by this class
-   *
-   * @return handle to the raw ANNpointArray
-   */
-  ANNpointArray rawData() { return m_data; }
-
-  /** Access a raw point in the collection of points
-   *
-   * This will check the index used is within bounds and return nullptr if
-   * outside of those bounds
-   *
-   * @param i :: the index of the point to return a handle to
-   * @return handle to a single point in the collection of points
-   */
-  ANNcoord *mutablePoint(const int i) {
-    if (i < m_nPts)
-      return m_data[i];
-    else
-      return nullptr;
-  }
-
-private:
-  /// Number of points stored
-  const int m_nPts;
-  /// Array of points for use with NN search
-  ANNpointArray m_data;
-};
-
-//------------------------------------------------------------------------------
-// NearestNeighbours implementation
-//------------------------------------------------------------------------------
-
 template <int N = 3> class DLLExport NearestNeighbours {
 
 public:
@@ -95,85 +43,42 @@ public:
    *
    * @param points :: vector of Eigen::Vectors to search through
    */
-  NearestNeighbours(const std::vector<VectorType> &points) {
-    const auto numPoints = static_cast<int>(points.size());
-    if (numPoints == 0)
-      std::runtime_error(
-          "Need at least one point to initialise NearestNeighbours.");
-
-    m_dataPoints =
-        std::make_unique<NNDataPoints>(numPoints, static_cast<int>(N));
-
-    for (size_t i = 0; i < points.size(); ++i) {
-      Eigen::Map<VectorType>(m_dataPoints->mutablePoint(static_cast<int>(i)), N,
-                             1) = points[i];
-    }
-    m_kdTree = std::make_unique<ANNkd_tree>(m_dataPoints->rawData(), numPoints,
-                                            static_cast<int>(N));
-  }
-
-  ~NearestNeighbours() { annClose(); }
+  NearestNeighbours(const std::vector<VectorType> &points)
+      : m_points(points), m_kdTree(std::make_unique<Tree>(m_points)) {}
 
   NearestNeighbours(const NearestNeighbours &) = delete;
 
   /** Find the k nearest neighbours to a given point
-   *
-   * This is a thin wrapper around the ANN library annkSearch method
    *
    * @param pos :: the position to find th k nearest neighbours of
    * @param k :: the number of neighbours to find
-   * @param error :: error term for finding approximate nearest neighbours. if
-   * 	zero then exact neighbours will be found. (default = 0.0).
-   * @return vector neighbours as tuples of (position, index, distance)
+   * @param error :: unused, the search is always exact. Kept for
+   * compatibility with the former approximate search.
+   * @return vector neighbours as tuples of (position, index, squared distance)
    */
   NearestNeighbourResults findNearest(const VectorType &pos, const size_t k = 1,
-                                      const double error = 0.0) {
-    const auto numNeighbours = static_cast<int>(k);
-    // create arrays to store the indices & distances of nearest neighbours
-    auto nnIndexList = std::unique_ptr<ANNidx[]>(new ANNidx[numNeighbours]);
-    auto nnDistList = std::unique_ptr<ANNdist[]>(new ANNdist[numNeighbours]);
-
-    // create ANNpoint from Eigen array
-    auto point = std::unique_ptr<ANNcoord[]>(annAllocPt(N));
-    Eigen::Map<VectorType>(point.get(), N, 1) = pos;
-
-    // find the k nearest neighbours
-    m_kdTree->annkSearch(point.get(), numNeighbours, nnIndexList.get(),
-                         nnDistList.get(), error);
+                                      const double error = 0.0) const {
+    UNUSED_ARG(error);
+    typename Tree::Point point;
+    Eigen::Map<VectorType>(point.data(), N, 1) = pos;
+    const auto neighbours = m_kdTree->nearest(point, k);
 
-    return makeResults(k, std::move(nnIndexList), std::move(nnDistList));
-  }
-
-private:
-  /** Helper function to create a instance of NearestNeighbourResults
-   *
-   * @param k :: the number of neighbours searched for
-   * @param nnIndexList :: the ordered list of indicies matching the closest k
-   *neighbours
-   * @param nnDistList :: the ordered list of distances matching the closest k
-   *neighbours
-   * @return a new NearestNeighbourResults object from the found items
-   */
-  NearestNeighbourResults
-  makeResults(const size_t k, const std::unique_ptr<ANNidx[]> nnIndexList,
-              const std::unique_ptr<ANNdist[]> nnDistList) {
     NearestNeighbourResults results;
-    results.reserve(k);
-
-    for (size_t i = 0; i < k; ++i) {
-      // create Eigen array from ANNpoint
-      auto pos = m_dataPoints->mutablePoint(nnIndexList[i]);
-      VectorType point = Eigen::Map<VectorType>(pos, N, 1);
-      results.emplace_back(point, nnIndexList[i], nnDistList[i]);
+    results.reserve(neighbours.size());
+    for (const auto &neighbour : neighbours) {
+      results.emplace_back(m_points[neighbour.index], neighbour.index,
+                           neighbour.distanceSq);
     }
-
     return results;
   }
 
-  /// handle to the list of data points to search through
-  std::unique_ptr<NNDataPoints> m_dataPoints;
-  /// handle to the ANN KD-tree used for searching
-  std::unique_ptr<ANNkd_tree> m_kdTree;
+private:
+  using Tree = KDTree<static_cast<size_t>(N)>;
+
+  /// the list of data points to search through
+  std::vector<VectorType> m_points;
+  /// handle to the KD-tree used for searching
+  std::unique_ptr<Tree> m_kdTree;
 };
 } // namespace Kernel
 } // namespace Mantid
@@ -0,0 +1,218 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <numeric>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace ParallelDetail {
+/// Collects the first exception thrown inside a parallel loop
+class ExceptionCollector {
+public:
+  /// Run a callable, storing any exception it throws
+  template <typename Func> void run(Func &&func) {
+    if (m_failed)
+      return;
+    try {
+      func();
+    } catch (...) {
+      PARALLEL_CRITICAL(ParallelDetail_ExceptionCollector) {
+        if (!m_exception)
+          m_exception = std::current_exception();
+      }
+      m_failed = true;
+    }
+  }
+  /// Rethrow the stored exception, if any
+  void rethrow() const {
+    if (m_exception)
+      std::rethrow_exception(m_exception);
+  }
+
+private:
+  std::atomic<bool> m_failed{false};
+  std::exception_ptr m_exception;
+};
+
+/// A range of indices and its cost
+struct Chunk {
+  size_t begin;
+  size_t end;
+  double cost;
+};
+
+/** Split [0, costs.size()) into at most numChunks contiguous chunks of about
+ * equal total cost. If all costs are zero, every index counts as 1.
+ */
+template <typename Cost>
+std::vector<Chunk> weightedChunks(const std::vector<Cost> &costs,
+                                  const size_t numChunks) {
+  std::vector<Chunk> chunks;
+  double total = 0.;
+  for (const auto cost : costs)
+    total += static_cast<double>(cost);
+  const bool uniform = !(total > 0.);
+  if (uniform)
+    total = static_cast<double>(costs.size());
+  const double target = total / static_cast<double>(numChunks);
+  Chunk current{0, 0, 0.};
+  for (size_t i = 0; i < costs.size(); ++i) {
+    current.cost += uniform ? 1. : static_cast<double>(costs[i]);
+    current.end = i + 1;
+    if (current.cost >= target) {
+      chunks.emplace_back(current);
+      current = {i + 1, i + 1, 0.};
+    }
+  }
+  if (current.end > current.begin)
+    chunks.emplace_back(current);
+  return chunks;
+}
+} // namespace ParallelDetail
+
+// Parallel loops over index ranges, built on the thread budget of
+// MultiThreaded.h.
+//
+// Unlike the PARALLEL_FOR macros these take the loop body as a callable, so
+// they can choose how to split the range at run time:
+// - parallelFor() hands out chunks of a fixed size, or guided chunks.
+// - parallelForWeighted() splits the range into chunks of equal total cost,
+//   e.g. using the number of events of each spectrum, and runs the most
+//   expensive chunks first.
+// - parallelReduce() combines per-chunk results in a fixed order, so the
+//   result does not depend on the number of threads.
+//
+// All of them run serially when parallel is false, when only one thread is
+// available, or when called from a parallel loop or a ParallelTaskScope. The
+// first exception thrown by the loop body is rethrown once all threads have
+// stopped; the remaining iterations are skipped.
+
+/** Call func(i) for every i in [begin, end) in parallel
+ * @param begin :: first index
+ * @param end :: one past the last index
+ * @param func :: the loop body, called with each index
+ * @param grainSize :: number of consecutive indices a thread takes at a time;
+ *        0 (default) starts with large chunks and shrinks them towards the
+ *        end of the loop
+ * @param parallel :: false to run serially, e.g. if the workspaces are not
+ *        thread-safe
+ */
+template <typename Func>
+void parallelFor(const size_t begin, const size_t end, Func &&func,
+                 const size_t grainSize = 0, const bool parallel = true) {
+  if (end <= begin)
+    return;
+  const int numThreads = parallel ? parallelThreadCount() : 1;
+  const auto count = static_cast<int64_t>(end - begin);
+  if (numThreads <= 1 || count <= static_cast<int64_t>(grainSize)) {
+    for (size_t i = begin; i < end; ++i)
+      func(i);
+    return;
+  }
+  ParallelDetail::ExceptionCollector errors;
+  if (grainSize == 0) {
+    PRAGMA_OMP(parallel for num_threads(numThreads) schedule(guided))
+    for (int64_t i = 0; i < count; ++i) {
+      errors.run([&]() { func(begin + static_cast<size_t>(i)); });
+    }
+  } else {
+    PRAGMA_OMP(parallel for num_threads(numThreads)
+                   schedule(dynamic, static_cast<int>(grainSize)))
+    for (int64_t i = 0; i < count; ++i) {
+      errors.run([&]() { func(begin + static_cast<size_t>(i)); });
+    }
+  }
+  errors.rethrow();
+}
+
+/** Call func(i) for every index of costs in parallel, balancing the threads
+ * by the cost of each index.
+ * @param costs :: the estimated cost of each index, e.g. the number of events
+ *        in each spectrum. Any non-negative arithmetic type.
+ * @param func :: the loop body, called with each index
+ * @param parallel :: false to run serially
+ */
+template <typename Cost, typename Func>
+void parallelForWeighted(const std::vector<Cost> &costs, Func &&func,
+                         const bool parallel = true) {
+  const int numThreads = parallel ? parallelThreadCount() : 1;
+  if (numThreads <= 1 || costs.size() <= 1) {
+    for (size_t i = 0; i < costs.size(); ++i)
+      func(i);
+    return;
+  }
+  // A few chunks per thread, so that a thread finishing early can take more
+  auto chunks = ParallelDetail::weightedChunks(
+      costs, std::min(costs.size(), static_cast<size_t>(numThreads) * 8));
+  // Most expensive first, so that no expensive chunk is left for last
+  std::stable_sort(chunks.begin(), chunks.end(),
+                   [](const auto &lhs, const auto &rhs) {
+                     return lhs.cost > rhs.cost;
+                   });
+  ParallelDetail::ExceptionCollector errors;
+  const auto numChunks = static_cast<int64_t>(chunks.size());
+  PRAGMA_OMP(parallel for num_threads(numThreads) schedule(dynamic, 1))
+  for (int64_t c = 0; c < numChunks; ++c) {
+    errors.run([&]() {
+      for (size_t i = chunks[c].begin; i < chunks[c].end; ++i)
+        func(i);
+    });
+  }
+  errors.rethrow();
+}
+
+/** Reduce func(i) for every i in [begin, end) in parallel
+ *
+ * The range is split into chunks independent of the number of threads; each
+ * chunk is reduced in order starting from identity and the chunk results are
+ * combined in order, so the result is reproducible.
+ * @param begin :: first index
+ * @param end :: one past the last index
+ * @param identity :: the neutral element of combine
+ * @param func :: called with each index, returns a T
+ * @param combine :: associative binary operation on two Ts
+ * @param parallel :: false to run serially
+ * @return the combined result, or identity for an empty range
+ */
+template <typename T, typename Func, typename Combine>
+T parallelReduce(const size_t begin, const size_t end, const T &identity,
+                 Func &&func, Combine &&combine, const bool parallel = true) {
+  if (end <= begin)
+    return identity;
+  constexpr size_t maxChunks = 256;
+  const size_t count = end - begin;
+  const size_t chunkSize = (count + maxChunks - 1) / maxChunks;
+  const size_t numChunks = (count + chunkSize - 1) / chunkSize;
+  std::vector<T> partials(numChunks, identity);
+  parallelFor(
+      0, numChunks,
+      [&](const size_t c) {
+        const size_t first = begin + c * chunkSize;
+        const size_t last = std::min(end, first + chunkSize);
+        T result = identity;
+        for (size_t i = first; i < last; ++i)
+          result = combine(result, func(i));
+        partials[c] = std::move(result);
+      },
+      1, parallel);
+  T result = identity;
+  for (auto &partial : partials)
+    result = combine(result, partial);
+  return result;
+}
+
+} // namespace Kernel
+} // namespace Mantid
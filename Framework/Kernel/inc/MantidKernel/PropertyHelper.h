@@ -161,6 +161,15 @@ std::string toPrettyString(const std::vector<std::vector<T>> &value,
                           maxLength);
 }
 
+/// Whether converting a value to a string for the history should be deferred
+/// until the history is read. True only for long arrays of numbers.
+template <typename T> bool hasLazyHistory(const T &) { return false; }
+
+template <typename T> bool hasLazyHistory(const std::vector<T> &value) {
+  constexpr size_t minimumSize = 1000;
+  return std::is_arithmetic<T>::value && value.size() >= minimumSize;
+}
+
 /// Specialization for any type, should be appropriate for properties with a
 /// single value.
 template <typename T> int findSize(const T &) { return 1; }
@@ -13,7 +13,9 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <functional>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -37,6 +39,11 @@ public:
                   const std::string &type, const bool isdefault,
                   const unsigned int direction = 99);
 
+  /// construct a property history whose value is generated on first use
+  PropertyHistory(const std::string &name,
+                  std::function<std::string()> generateValue,
+                  const std::string &type, const bool isdefault,
+                  const unsigned int direction = 99);
   /// construct a property history from a property object
   PropertyHistory(Property const *const prop);
   /// destructor
@@ -44,9 +51,9 @@ public:
   /// get name of algorithm parameter const
   const std::string &name() const { return m_name; };
   /// get value of algorithm parameter const
-  const std::string &value() const { return m_value; };
+  const std::string &value() const;
   /// set value of algorithm parameter
-  void setValue(const std::string &value) { m_value = value; };
+  void setValue(const std::string &value);
   /// get type of algorithm parameter const
   const std::string &type() const { return m_type; };
   /// get isdefault flag of algorithm parameter const
@@ -67,10 +74,13 @@ public:
   }
 
 private:
+  struct LazyValue;
   /// The name of the parameter
   std::string m_name;
   /// The value of the parameter
   std::string m_value;
+  /// The value if it is generated on first use, shared between copies
+  std::shared_ptr<LazyValue> m_lazyValue;
   /// The type of the parameter
   std::string m_type;
   /// flag defining if the parameter is a default or a user-defined parameter
@@ -53,6 +53,7 @@ public:
   std::string valueAsPrettyStr(const size_t maxLength = 0,
                                const bool collapseLists = true) const override;
   Json::Value valueAsJson() const override;
+  const PropertyHistory createHistory() const override;
   virtual bool operator==(const PropertyWithValue<TYPE> &rhs) const;
   virtual bool operator!=(const PropertyWithValue<TYPE> &rhs) const;
   int size() const override;
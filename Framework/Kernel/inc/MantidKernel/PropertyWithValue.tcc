@@ -11,6 +11,7 @@
 #include "MantidKernel/NullValidator.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/PropertyHelper.h"
+#include "MantidKernel/PropertyHistory.h"
 #include "MantidKernel/PropertyWithValueJSON.h"
 #include "MantidKernel/Strings.h"
 
@@ -138,6 +139,21 @@ PropertyWithValue<TYPE>::valueAsPrettyStr(const size_t maxLength,
   return retVal;
 }
 
+/** Create a PropertyHistory object representing the current state of the
+ * property. Long arrays of numbers are copied and only converted to a string
+ * when the history value is read, which often never happens.
+ * @return the history of the property
+ */
+template <typename TYPE>
+const PropertyHistory PropertyWithValue<TYPE>::createHistory() const {
+  if (!hasLazyHistory(m_value))
+    return Property::createHistory();
+  auto value = boost::make_shared<const TYPE>(m_value);
+  return PropertyHistory(
+      name(), [value]() { return toPrettyString(*value, 0, true); }, type(),
+      isDefault(), direction());
+}
+
 /**
  * Attempt to construct a Json::Value object from the plain value
  * @return A new Json::Value object
@@ -0,0 +1,79 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : a ThreadScheduler with one task queue per
+ * thread instead of a single queue behind one lock.
+ *
+ * A Task pushed from inside a running Task (e.g. a subtask of a recursive
+ * split) goes to the back of the queue of the thread running it, and each
+ * thread pops the back of its own queue first, so that related work stays on
+ * the same core. A Task pushed from outside the thread pool goes to the queue
+ * with the least queued cost. A thread whose queue is empty steals the oldest
+ * Task of the queue with the most queued cost.
+ *
+ * Every queue has its own lock, held only to push or pop a single Task, so
+ * threads contend only when they steal from the same queue.
+ *
+ * Task mutexes are not taken into account when scheduling: a Task whose mutex
+ * is busy simply waits for it in ThreadPoolRunnable. Use
+ * ThreadSchedulerMutexes when many tasks share a few mutexes.
+ */
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numThreads = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(std::shared_ptr<Task> newTask) override;
+  std::shared_ptr<Task> pop(size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+
+  /// @return the number of task queues
+  size_t numQueues() const { return m_queues.size(); }
+
+private:
+  /// The tasks of one thread
+  struct TaskQueue {
+    /// Lock on tasks
+    std::mutex lock;
+    /// Tasks, the newest at the back
+    std::deque<std::shared_ptr<Task>> tasks;
+    /// Number of tasks, readable without the lock
+    std::atomic<size_t> size{0};
+    /// Total cost of the tasks, readable without the lock
+    std::atomic<double> queuedCost{0.};
+    /// Total cost of all tasks pushed since the last clear()
+    std::atomic<double> pushedCost{0.};
+  };
+
+  size_t queueForPush() const;
+  std::shared_ptr<Task> popBack(TaskQueue &queue);
+  std::shared_ptr<Task> steal(const size_t thief);
+
+  /// Unique ID identifying the threads of this scheduler
+  const size_t m_id;
+  /// One queue per thread
+  std::vector<std::unique_ptr<TaskQueue>> m_queues;
+};
+
+} // namespace Kernel
+} // namespace Mantid
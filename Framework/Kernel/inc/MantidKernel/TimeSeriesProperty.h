@@ -14,6 +14,7 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+#include "MantidKernel/cow_ptr.h"
 #include <cstdint>
 #include <utility>
 
@@ -307,7 +308,7 @@ public:
   /**Reserve memory for efficient adding values to existing property
    * makes sense only when you have reasonably precise estimate of the
    * total size you'll need easily available in advance.  */
-  void reserve(size_t size) { m_values.reserve(size); };
+  void reserve(size_t size) { m_values.access().reserve(size); };
 
   /// If filtering by log, get the time intervals for splitting
   std::vector<Mantid::Kernel::SplittingInterval> getSplittingIntervals() const;
@@ -333,9 +334,15 @@ private:
   bool isTimeFiltered(const Types::Core::DateAndTime &time) const;
   /// Time weighted mean and standard deviation
   std::pair<double, double> timeAverageValueAndStdDev() const;
+  /// Returns the values for modification, dropping derived data
+  std::vector<TimeValueUnit<TYPE>> &mutableValues();
+  /// Running time integrals of the values, see timeIntegrals()
+  struct TimeIntegrals;
+  /// Returns the running time integrals of the values, computed if necessary
+  boost::shared_ptr<const TimeIntegrals> timeIntegrals() const;
 
-  /// Holds the time series data
-  mutable std::vector<TimeValueUnit<TYPE>> m_values;
+  /// Holds the time series data, shared between copies until modified
+  mutable Kernel::cow_ptr<std::vector<TimeValueUnit<TYPE>>> m_values;
 
   /// The number of values (or time intervals) in the time series. It can be
   /// different from m_propertySeries.size()
@@ -350,6 +357,8 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+  /// Lazily computed running time integrals of the sorted values
+  mutable boost::shared_ptr<const TimeIntegrals> m_timeIntegrals;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
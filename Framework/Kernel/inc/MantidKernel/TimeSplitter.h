@@ -8,6 +8,12 @@
 
 #include "MantidKernel/DateAndTime.h"
 
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -69,5 +75,70 @@ MANTID_KERNEL_DLL TimeSplitterType operator|(const TimeSplitterType &a,
                                              const TimeSplitterType &b);
 MANTID_KERNEL_DLL TimeSplitterType operator~(const TimeSplitterType &a);
 
+/**
+ * TimeSplitter maps every point in time to the destination index of the
+ * splitting interval containing it.
+ *
+ * The intervals are held as a sorted list of boundaries, each carrying the
+ * destination that applies from that boundary up to the next. Times before
+ * the first boundary and from the last boundary onwards have no destination.
+ * Adjacent intervals with the same destination are merged, so the
+ * representation of a given splitter is unique. Finding the destination of a
+ * time is a binary search, and union and intersection are a single merge of
+ * the boundary lists.
+ *
+ * Since intervals with destination NO_TARGET merge with the uncovered time
+ * around them, the end of the last interval is kept separately as
+ * coverageEnd(), which may lie after the last boundary.
+ */
+class MANTID_KERNEL_DLL TimeSplitter {
+public:
+  /// The destination of times outside all intervals
+  static constexpr int NO_TARGET = -1;
+
+  TimeSplitter() = default;
+  explicit TimeSplitter(const TimeSplitterType &intervals);
+  TimeSplitter(const Types::Core::DateAndTime &start,
+               const Types::Core::DateAndTime &stop, const int index = 0);
+
+  int valueAtTime(const Types::Core::DateAndTime &time) const;
+  int valueAtTime(const int64_t nanoseconds) const;
+
+  /// @return true if no time has a destination
+  bool empty() const { return m_times.empty(); }
+  /// @return true if the splitter was built from at least one interval
+  bool hasCoverage() const { return m_coverageEnd != NO_COVERAGE; }
+  /// @return the end of the last interval in nanoseconds
+  int64_t coverageEnd() const { return m_coverageEnd; }
+  /// @return the sorted interval boundaries in nanoseconds
+  const std::vector<int64_t> &boundaries() const { return m_times; }
+  /// @return the destination of the time from each boundary to the next
+  const std::vector<int> &targets() const { return m_targets; }
+
+  std::set<int> outputIndices() const;
+  TimeSplitterType intervals() const;
+
+  TimeSplitter operator|(const TimeSplitter &other) const;
+  TimeSplitter operator&(const TimeSplitter &filter) const;
+  bool operator==(const TimeSplitter &other) const;
+  bool operator!=(const TimeSplitter &other) const;
+
+  std::string toString() const;
+  static TimeSplitter fromString(const std::string &text);
+
+private:
+  /// The coverage end of a splitter built from no intervals
+  static constexpr int64_t NO_COVERAGE = std::numeric_limits<int64_t>::min();
+
+  void addBoundary(const int64_t time, const int target);
+
+  /// The interval boundaries in nanoseconds, strictly increasing
+  std::vector<int64_t> m_times;
+  /// The destination from each boundary to the next; the last is NO_TARGET
+  std::vector<int> m_targets;
+  /// The end of the last interval, whatever its destination
+  int64_t m_coverageEnd = NO_COVERAGE;
+};
+
 } // Namespace Kernel
 } // Namespace Mantid
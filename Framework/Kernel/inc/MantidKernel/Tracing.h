@@ -0,0 +1,81 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace Mantid {
+namespace Kernel {
+
+/** Tracing : records the time spans of algorithms, child algorithms,
+ * ThreadPool tasks and I/O at run time and exports them in the Chrome trace
+ * event format, which chrome://tracing and Perfetto can display.
+ *
+ * Tracing is off by default and then costs a single atomic load per span. It
+ * is switched on by setting the environment variable MANTID_TRACE_FILE or the
+ * configuration key tracing.file to the path of the JSON file to write when
+ * the framework shuts down, or by calling setEnabled().
+ *
+ * Every thread records into its own fixed-size ring buffer, without locks;
+ * when a buffer is full its oldest spans are overwritten. Spans may carry the
+ * number of bytes read and events processed, which the export also turns into
+ * cumulative counters, and algorithm spans record the peak resident memory of
+ * the process.
+ *
+ * The export and clear() read the buffers of all threads: call them while no
+ * traced work is running.
+ */
+class MANTID_KERNEL_DLL Tracing {
+public:
+  /// What a span measures
+  enum class Category : uint8_t { Algorithm, ChildAlgorithm, Task, IO };
+
+  static bool enabled();
+  static void setEnabled(const bool enable);
+  static void setOutputFile(const std::string &filename);
+  static std::string outputFile();
+  static void flush();
+  static void clear();
+  static void writeChromeTrace(std::ostream &out);
+  static void writeChromeTrace(const std::string &filename);
+};
+
+/** TraceSpan : records the time between its construction and destruction, or
+ * stop(), as a span of the calling thread if tracing is enabled.
+ */
+class MANTID_KERNEL_DLL TraceSpan {
+public:
+  TraceSpan(const Tracing::Category category, const char *name);
+  TraceSpan(const Tracing::Category category, const std::string &name);
+  ~TraceSpan();
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+  /// Add to the number of bytes read during the span
+  void addBytes(const uint64_t bytes) { m_bytes += bytes; }
+  /// Add to the number of events processed during the span
+  void addEvents(const uint64_t events) { m_events += events; }
+  void stop();
+
+private:
+  /// Maximum length of the recorded name
+  static constexpr size_t NAME_SIZE = 64;
+
+  Tracing::Category m_category;
+  /// Start time in ns since tracing started, negative if not recording
+  int64_t m_begin;
+  uint64_t m_bytes = 0;
+  uint64_t m_events = 0;
+  char m_name[NAME_SIZE];
+};
+
+} // namespace Kernel
+} // namespace Mantid
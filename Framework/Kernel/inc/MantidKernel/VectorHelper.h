@@ -45,6 +45,12 @@ void MANTID_KERNEL_DLL rebinHistogram(const std::vector<double> &xold,
                                       std::vector<double> &ynew,
                                       std::vector<double> &enew, bool addition);
 
+// Rebin Histogram data given and returning variances rather than errors
+void MANTID_KERNEL_DLL rebinHistogramVariances(
+    const std::vector<double> &xold, const std::vector<double> &yold,
+    const std::vector<double> &vold, const std::vector<double> &xnew,
+    std::vector<double> &ynew, std::vector<double> &vnew, bool addition);
+
 /// Convert an array of bin boundaries to bin center values.
 void MANTID_KERNEL_DLL convertToBinCentre(const std::vector<double> &bin_edges,
                                           std::vector<double> &bin_centres);
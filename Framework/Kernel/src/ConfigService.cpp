@@ -15,6 +15,7 @@
 #include "MantidKernel/Glob.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MantidVersion.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/NetworkProxy.h"
 #include "MantidKernel/StdoutChannel.h"
 #include "MantidKernel/Strings.h"
@@ -1062,6 +1063,11 @@ void ConfigServiceImpl::setString(const std::string &key,
 
   m_pConf->setString(key, value);
 
+  if (key == "MultiThreaded.MaxCores") {
+    // Read the new value on next use
+    setParallelThreadBudget(0);
+  }
+
   m_notificationCenter.postNotification(new ValueChanged(key, value, old));
   m_changed_keys.insert(key);
 }
@@ -0,0 +1,80 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// The thread budget; 0 until it is read from the configuration
+std::atomic<int> threadBudget{0};
+/// Number of ParallelTaskScope objects alive on this thread
+thread_local int taskScopeDepth = 0;
+
+/// @return the number of threads available to the process
+int hardwareThreads() {
+// windows hangs with openmp for some reason
+#if defined(_WIN32) || !defined(_OPENMP)
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+#else
+  return std::max(1, omp_get_max_threads());
+#endif
+}
+} // namespace
+
+/** The budget is MultiThreaded.MaxCores if set in the configuration, otherwise
+ * the number of hardware threads. It is read once and cached until
+ * setParallelThreadBudget() is called.
+ * @return the maximum number of threads parallel loops may use in total
+ */
+int parallelThreadBudget() {
+  int budget = threadBudget.load(std::memory_order_relaxed);
+  if (budget > 0)
+    return budget;
+  const auto maxCores =
+      ConfigService::Instance().getValue<int>("MultiThreaded.MaxCores");
+  budget = maxCores.get_value_or(0) > 0 ? maxCores.get() : hardwareThreads();
+  threadBudget.store(budget, std::memory_order_relaxed);
+  return budget;
+}
+
+/** Set the maximum number of threads parallel loops may use in total
+ * @param numThreads :: the new budget; 0 means read it from the configuration
+ * again on next use
+ */
+void setParallelThreadBudget(const int numThreads) {
+  threadBudget.store(std::max(0, numThreads), std::memory_order_relaxed);
+}
+
+/** Parallel loops nested in a ParallelTaskScope or in another parallel region
+ * run serially, since their callers already occupy the threads.
+ * @return the number of threads a parallel loop started now should use
+ */
+int parallelThreadCount() {
+  if (taskScopeDepth > 0)
+    return 1;
+#ifdef _OPENMP
+  if (omp_in_parallel())
+    return 1;
+#endif
+  return parallelThreadBudget();
+}
+
+ParallelTaskScope::ParallelTaskScope() { ++taskScopeDepth; }
+
+ParallelTaskScope::~ParallelTaskScope() { --taskScopeDepth; }
+
+} // namespace Kernel
+} // namespace Mantid
@@ -15,11 +15,21 @@
 #include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <cstdint>
+#include <mutex>
 #include <ostream>
 
 namespace Mantid {
 namespace Kernel {
 
+/// A value that is converted to a string once, when it is first read
+struct PropertyHistory::LazyValue {
+  explicit LazyValue(std::function<std::string()> generator)
+      : generate(std::move(generator)) {}
+  std::once_flag generated;
+  std::function<std::string()> generate;
+  std::string value;
+};
+
 /// Constructor
 PropertyHistory::PropertyHistory(const std::string &name,
                                  const std::string &value,
@@ -28,11 +38,49 @@ PropertyHistory::PropertyHistory(const std::string &name,
     : m_name(name), m_value(value), m_type(type), m_isDefault(isdefault),
       m_direction(direction) {}
 
+/** Constructor for values that are expensive to convert to a string, e.g.
+ * long arrays. The value is generated when it is first read, which may be
+ * never.
+ * @param name :: the name of the parameter
+ * @param generateValue :: returns the value of the parameter as a string
+ * @param type :: the type of the parameter
+ * @param isdefault :: true if the parameter has its default value
+ * @param direction :: the direction of the parameter
+ */
+PropertyHistory::PropertyHistory(const std::string &name,
+                                 std::function<std::string()> generateValue,
+                                 const std::string &type, const bool isdefault,
+                                 const unsigned int direction)
+    : m_name(name),
+      m_lazyValue(std::make_shared<LazyValue>(std::move(generateValue))),
+      m_type(type), m_isDefault(isdefault), m_direction(direction) {}
+
 PropertyHistory::PropertyHistory(Property const *const prop)
     : m_name(prop->name()), m_value(prop->valueAsPrettyStr(0, true)),
       m_type(prop->type()), m_isDefault(prop->isDefault()),
       m_direction(prop->direction()) {}
 
+/// @return the value of the parameter as a string
+const std::string &PropertyHistory::value() const {
+  if (!m_lazyValue)
+    return m_value;
+  auto &lazy = *m_lazyValue;
+  std::call_once(lazy.generated, [&lazy]() {
+    lazy.value = lazy.generate();
+    // Release whatever the generator holds on to
+    lazy.generate = nullptr;
+  });
+  return lazy.value;
+}
+
+/** Set the value of the parameter
+ * @param value :: the new value as a string
+ */
+void PropertyHistory::setValue(const std::string &value) {
+  m_value = value;
+  m_lazyValue.reset();
+}
+
 /** Prints a text representation of itself
  *  @param os :: The output stream to write to
  *  @param indent :: an indentation value to make pretty printing of object and
@@ -43,10 +91,11 @@ PropertyHistory::PropertyHistory(Property const *const prop)
 void PropertyHistory::printSelf(std::ostream &os, const int indent,
                                 const size_t maxPropertyLength) const {
   os << std::string(indent, ' ') << "Name: " << m_name;
-  if ((maxPropertyLength > 0) && (m_value.size() > maxPropertyLength)) {
-    os << ", Value: " << Strings::shorten(m_value, maxPropertyLength);
+  const auto &propertyValue = value();
+  if ((maxPropertyLength > 0) && (propertyValue.size() > maxPropertyLength)) {
+    os << ", Value: " << Strings::shorten(propertyValue, maxPropertyLength);
   } else {
-    os << ", Value: " << m_value;
+    os << ", Value: " << propertyValue;
   }
   os << ", Default?: " << (m_isDefault ? "Yes" : "No");
   os << ", Direction: " << Kernel::Direction::asText(m_direction) << '\n';
@@ -87,7 +136,7 @@ bool PropertyHistory::isEmptyDefault() const {
   if (m_isDefault && m_direction != Direction::Output) {
     if (std::find(numberTypes.begin(), numberTypes.end(), m_type) !=
         numberTypes.end()) {
-      if (std::find(emptyValues.begin(), emptyValues.end(), m_value) !=
+      if (std::find(emptyValues.begin(), emptyValues.end(), value()) !=
           emptyValues.end()) {
         emptyDefault = true;
       }
@@ -9,7 +9,6 @@
 //----------------------------------------------------------------------
 #include "MantidKernel/ThreadPool.h"
 
-#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Task.h"
@@ -20,10 +19,6 @@
 #include <algorithm>
 #include <sstream>
 #include <stdexcept>
-// needed on windows and any place missing openmp
-#if defined(_WIN32) || !defined(_OPENMP)
-#include <Poco/Environment.h>
-#endif
 
 namespace Mantid {
 namespace Kernel {
@@ -63,25 +58,12 @@ ThreadPool::ThreadPool(ThreadScheduler *scheduler, size_t numThreads,
 ThreadPool::~ThreadPool() = default;
 
 //--------------------------------------------------------------------------------
-/** Return the number of physical cores available on the system.
- * NOTE: Uses OPENMP or Poco::Environment::processorCount() to find the number.
- * @return how many cores are present.
+/** Return the number of cores to use, i.e. the process-wide thread budget:
+ * MultiThreaded.MaxCores if set, otherwise the number of hardware threads.
+ * @return how many cores to use.
  */
 size_t ThreadPool::getNumPhysicalCores() {
-// windows hangs with openmp for some reason
-#if defined(_WIN32) || !defined(_OPENMP)
-  int physicalCores = Poco::Environment::processorCount();
-#else
-  int physicalCores = PARALLEL_GET_MAX_THREADS;
-#endif
-
-  auto maxCores =
-      Kernel::ConfigService::Instance().getValue<int>("MultiThreaded.MaxCores");
-
-  if (!maxCores.is_initialized())
-    return std::min(maxCores.get_value_or(0), physicalCores);
-  else
-    return physicalCores;
+  return static_cast<size_t>(parallelThreadBudget());
 }
 
 //--------------------------------------------------------------------------------
@@ -5,9 +5,11 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidKernel/ThreadPoolRunnable.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/Tracing.h"
 
 #include <Poco/Thread.h>
 
@@ -45,6 +47,8 @@ void ThreadPoolRunnable::clearWait() { m_waitSec = 0.0; }
  */
 void ThreadPoolRunnable::run() {
   std::shared_ptr<Task> task;
+  // The other threads of the pool are busy too: run nested loops serially
+  ParallelTaskScope parallelTaskScope;
 
   // If there are no tasks yet, wait up to m_waitSec for them to come up
   while (m_scheduler->empty() && m_waitSec > 0.0) {
@@ -65,6 +69,7 @@ void ThreadPoolRunnable::run() {
 
       try {
         // Run the task (synchronously within this thread)
+        TraceSpan span(Tracing::Category::Task, "Task");
         task->run();
       } catch (std::exception &e) {
         // The task threw an exception!
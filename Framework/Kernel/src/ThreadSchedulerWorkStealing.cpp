@@ -0,0 +1,178 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Source of unique scheduler IDs; unlike addresses they are never reused
+std::atomic<size_t> nextSchedulerID{1};
+/// The ID of the scheduler whose pop() was last called by this thread, if any
+thread_local size_t currentScheduler = 0;
+/// The queue of this thread in currentScheduler
+thread_local size_t currentQueue = 0;
+} // namespace
+
+/** Constructor
+ *
+ * @param numThreads :: number of task queues to create; one per thread of the
+ *        ThreadPool is best. Default 0 = the number of hardware threads. Any
+ *        thread number beyond it shares a queue.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numThreads)
+    : ThreadScheduler(), m_id(nextSchedulerID++) {
+  if (numThreads == 0)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  m_queues.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i)
+    m_queues.emplace_back(std::make_unique<TaskQueue>());
+}
+
+/// Destructor
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+//-------------------------------------------------------------------------------
+/** Add a Task to the queue of the calling thread if it is running a Task of
+ * this scheduler, otherwise to the queue with the least queued cost.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(std::shared_ptr<Task> newTask) {
+  const double cost = newTask->cost();
+  auto &queue = *m_queues[queueForPush()];
+  std::lock_guard<std::mutex> lock(queue.lock);
+  queue.tasks.emplace_back(std::move(newTask));
+  queue.size.store(queue.tasks.size());
+  queue.queuedCost.store(queue.queuedCost.load() + cost);
+  queue.pushedCost.store(queue.pushedCost.load() + cost);
+}
+
+//-------------------------------------------------------------------------------
+/** Retrieves the newest Task of the thread's own queue, or steals one.
+ * @param threadnum :: ID of the calling thread.
+ * @return a Task pointer to execute, or nullptr if all queues are empty.
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const size_t index = threadnum % m_queues.size();
+  currentScheduler = m_id;
+  currentQueue = index;
+  if (auto task = popBack(*m_queues[index]))
+    return task;
+  return steal(index);
+}
+
+//-------------------------------------------------------------------------------
+/// @return the number of queued tasks
+size_t ThreadSchedulerWorkStealing::size() {
+  size_t total = 0;
+  for (const auto &queue : m_queues)
+    total += queue->size.load();
+  return total;
+}
+
+//-------------------------------------------------------------------------------
+/// @return true if all queues are empty
+bool ThreadSchedulerWorkStealing::empty() {
+  return std::all_of(m_queues.cbegin(), m_queues.cend(),
+                     [](const auto &queue) { return queue->size.load() == 0; });
+}
+
+//-------------------------------------------------------------------------------
+/// Empty out all queues
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    queue->tasks.clear();
+    queue->size.store(0);
+    queue->queuedCost.store(0.);
+    queue->pushedCost.store(0.);
+  }
+  m_cost = 0;
+  m_costExecuted = 0;
+}
+
+//-------------------------------------------------------------------------------
+/// @return the total cost of all tasks pushed since the last clear()
+double ThreadSchedulerWorkStealing::totalCost() {
+  double total = 0.;
+  for (const auto &queue : m_queues)
+    total += queue->pushedCost.load();
+  return total;
+}
+
+//-------------------------------------------------------------------------------
+/// @return the index of the queue a Task pushed by the calling thread goes to
+size_t ThreadSchedulerWorkStealing::queueForPush() const {
+  if (currentScheduler == m_id)
+    return currentQueue;
+  size_t best = 0;
+  for (size_t i = 1; i < m_queues.size(); ++i) {
+    if (m_queues[i]->queuedCost.load() < m_queues[best]->queuedCost.load())
+      best = i;
+  }
+  return best;
+}
+
+//-------------------------------------------------------------------------------
+/** Pop the newest Task of a queue
+ * @param queue :: the queue to pop
+ * @return the Task, or nullptr if the queue is empty
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::popBack(TaskQueue &queue) {
+  if (queue.size.load() == 0)
+    return nullptr;
+  std::lock_guard<std::mutex> lock(queue.lock);
+  if (queue.tasks.empty())
+    return nullptr;
+  auto task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  queue.size.store(queue.tasks.size());
+  queue.queuedCost.store(queue.tasks.empty()
+                             ? 0.
+                             : queue.queuedCost.load() - task->cost());
+  return task;
+}
+
+//-------------------------------------------------------------------------------
+/** Steal the oldest Task of the queue with the most queued cost, trying the
+ * other queues if it was emptied in the meantime.
+ * @param thief :: the queue of the calling thread, which is empty
+ * @return the Task, or nullptr if all queues are empty
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::steal(const size_t thief) {
+  // Snapshot the queued costs, which other threads keep changing
+  std::vector<std::pair<double, size_t>> victims;
+  victims.reserve(m_queues.size());
+  for (size_t i = 0; i < m_queues.size(); ++i) {
+    if (i != thief && m_queues[i]->size.load() > 0)
+      victims.emplace_back(m_queues[i]->queuedCost.load(), i);
+  }
+  std::sort(victims.begin(), victims.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs > rhs; });
+
+  for (const auto &victim : victims) {
+    auto &queue = *m_queues[victim.second];
+    std::lock_guard<std::mutex> lock(queue.lock);
+    if (queue.tasks.empty())
+      continue;
+    auto task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    queue.size.store(queue.tasks.size());
+    queue.queuedCost.store(queue.tasks.empty()
+                               ? 0.
+                               : queue.queuedCost.load() - task->cost());
+    return task;
+  }
+  return nullptr;
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -13,7 +13,9 @@
 #include <json/value.h>
 #include <nexus/NeXusFile.hpp>
 
-#include <boost/regex.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <iterator>
 #include <numeric>
 
 namespace Mantid {
@@ -91,21 +93,21 @@ template <typename TYPE>
 std::unique_ptr<TimeSeriesProperty<double>>
 TimeSeriesProperty<TYPE>::getDerivative() const {
 
-  if (this->m_values.size() < 2) {
+  if (this->m_values->size() < 2) {
     throw std::runtime_error("Derivative is not defined for a time-series "
                              "property with less then two values");
   }
 
   this->sortIfNecessary();
-  auto it = this->m_values.begin();
+  auto it = this->m_values->begin();
   int64_t t0 = it->time().totalNanoseconds();
   TYPE v0 = it->value();
 
   it++;
   auto timeSeriesDeriv = std::make_unique<TimeSeriesProperty<double>>(
       this->name() + "_derivative");
-  timeSeriesDeriv->reserve(this->m_values.size() - 1);
-  for (; it != m_values.end(); it++) {
+  timeSeriesDeriv->reserve(this->m_values->size() - 1);
+  for (; it != m_values->end(); it++) {
     TYPE v1 = it->value();
     int64_t t1 = it->time().totalNanoseconds();
     if (t1 != t0) {
@@ -132,7 +134,7 @@ TimeSeriesProperty<std::string>::getDerivative() const {
 template <typename TYPE>
 size_t TimeSeriesProperty<TYPE>::getMemorySize() const {
   // Rough estimate
-  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  return m_values->size() * (sizeof(TYPE) + sizeof(DateAndTime));
 }
 
 /**
@@ -157,8 +159,8 @@ operator+=(Property const *right) {
 
   if (rhs) {
     if (this->operator!=(*rhs)) {
-      m_values.insert(m_values.end(), rhs->m_values.begin(),
-                      rhs->m_values.end());
+      auto &values = mutableValues();
+      values.insert(values.end(), rhs->m_values->begin(), rhs->m_values->end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
@@ -167,7 +169,7 @@ operator+=(Property const *right) {
     }
 
     // Count the REAL size.
-    m_size = static_cast<int>(m_values.size());
+    m_size = static_cast<int>(m_values->size());
 
   } else
     g_log.warning() << "TimeSeriesProperty " << this->name()
@@ -287,28 +289,29 @@ void TimeSeriesProperty<TYPE>::filterByTime(
   sortIfNecessary();
 
   // 1. Do nothing for single (constant) value
-  if (m_values.size() <= 1)
+  if (m_values->size() <= 1)
     return;
 
+  auto &values = mutableValues();
   typename std::vector<TimeValueUnit<TYPE>>::iterator iterhead, iterend;
 
   // 2. Determine index for start and remove  Note erase is [...)
   int istart = this->findIndex(start);
-  if (istart >= 0 && static_cast<size_t>(istart) < m_values.size()) {
+  if (istart >= 0 && static_cast<size_t>(istart) < values.size()) {
     // "start time" is behind time-series's starting time
-    iterhead = m_values.begin() + istart;
+    iterhead = values.begin() + istart;
 
     // False - The filter time is on the mark.  Erase [begin(),  istart)
     // True - The filter time is larger than T[istart]. Erase[begin(), istart)
     // ...
     //       filter start(time) and move istart to filter startime
-    bool useprefiltertime = !(m_values[istart].time() == start);
+    bool useprefiltertime = !(values[istart].time() == start);
 
     // Remove the series
-    m_values.erase(m_values.begin(), iterhead);
+    values.erase(values.begin(), iterhead);
 
     if (useprefiltertime) {
-      m_values[0].setTime(start);
+      values[0].setTime(start);
     }
   } else {
     // "start time" is before/after time-series's starting time: do nothing
@@ -317,20 +320,20 @@ void TimeSeriesProperty<TYPE>::filterByTime(
 
   // 3. Determine index for end and remove  Note erase is [...)
   int iend = this->findIndex(stop);
-  if (static_cast<size_t>(iend) < m_values.size()) {
-    if (m_values[iend].time() == stop) {
+  if (static_cast<size_t>(iend) < values.size()) {
+    if (values[iend].time() == stop) {
       // Filter stop is on a log.  Delete that log
-      iterend = m_values.begin() + iend;
+      iterend = values.begin() + iend;
     } else {
       // Filter stop is behind iend. Keep iend
-      iterend = m_values.begin() + iend + 1;
+      iterend = values.begin() + iend + 1;
     }
     // Delete from [iend to mp.end)
-    m_values.erase(iterend, m_values.end());
+    values.erase(iterend, values.end());
   }
 
   // 4. Make size consistent
-  m_size = static_cast<int>(m_values.size());
+  m_size = static_cast<int>(values.size());
 }
 
 /**
@@ -345,7 +348,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   sortIfNecessary();
 
   // 2. Return for single value
-  if (m_values.size() <= 1) {
+  if (m_values->size() <= 1) {
     return;
   }
 
@@ -353,7 +356,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   std::vector<TimeValueUnit<TYPE>> mp_copy;
 
   g_log.debug() << "DB541  mp_copy Size = " << mp_copy.size()
-                << "  Original MP Size = " << m_values.size() << "\n";
+                << "  Original MP Size = " << m_values->size() << "\n";
 
   // 4. Create new
   for (const auto &splitter : splittervec) {
@@ -364,49 +367,47 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
     if (tstartindex < 0) {
       // The splitter is not well defined, and use the first
       tstartindex = 0;
-    } else if (tstartindex >= int(m_values.size())) {
+    } else if (tstartindex >= int(m_values->size())) {
       // The splitter is not well defined, adn use the last
-      tstartindex = int(m_values.size()) - 1;
+      tstartindex = int(m_values->size()) - 1;
     }
 
     int tstopindex = findIndex(t_stop);
 
     if (tstopindex < 0) {
       tstopindex = 0;
-    } else if (tstopindex >= int(m_values.size())) {
-      tstopindex = int(m_values.size()) - 1;
+    } else if (tstopindex >= int(m_values->size())) {
+      tstopindex = int(m_values->size()) - 1;
     } else {
-      if (t_stop == m_values[size_t(tstopindex)].time() &&
+      if (t_stop == (*m_values)[size_t(tstopindex)].time() &&
           size_t(tstopindex) > 0) {
         tstopindex--;
       }
     }
 
     /* Check */
-    if (tstartindex < 0 || tstopindex >= int(m_values.size())) {
+    if (tstartindex < 0 || tstopindex >= int(m_values->size())) {
       g_log.warning() << "Memory Leak In SplitbyTime!\n";
     }
 
     if (tstartindex == tstopindex) {
-      TimeValueUnit<TYPE> temp(t_start, m_values[tstartindex].value());
+      TimeValueUnit<TYPE> temp(t_start, (*m_values)[tstartindex].value());
       mp_copy.emplace_back(temp);
     } else {
-      mp_copy.emplace_back(t_start, m_values[tstartindex].value());
+      mp_copy.emplace_back(t_start, (*m_values)[tstartindex].value());
       for (auto im = size_t(tstartindex + 1); im <= size_t(tstopindex); ++im) {
-        mp_copy.emplace_back(m_values[im].time(), m_values[im].value());
+        mp_copy.emplace_back((*m_values)[im].time(), (*m_values)[im].value());
       }
     }
   } // ENDFOR
 
   g_log.debug() << "DB530  Filtered Log Size = " << mp_copy.size()
-                << "  Original Log Size = " << m_values.size() << "\n";
+                << "  Original Log Size = " << m_values->size() << "\n";
 
   // 5. Clear
-  m_values.clear();
-  m_values = mp_copy;
-  mp_copy.clear();
+  mutableValues() = std::move(mp_copy);
 
-  m_size = static_cast<int>(m_values.size());
+  m_size = static_cast<int>(m_values->size());
 }
 
 /**
@@ -441,12 +442,13 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     auto *myOutput = dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
     if (myOutput) {
       outputs_tsp.emplace_back(myOutput);
-      if (this->m_values.size() == 1) {
+      if (this->m_values->size() == 1) {
         // Special case for TSP with a single entry = just copy.
         myOutput->m_values = this->m_values;
+        myOutput->m_timeIntegrals.reset();
         myOutput->m_size = 1;
       } else {
-        myOutput->m_values.clear();
+        myOutput->mutableValues().clear();
         myOutput->m_size = 0;
       }
     } else {
@@ -455,19 +457,20 @@ void TimeSeriesProperty<TYPE>::splitByTime(
   }
 
   // 2. Special case for TSP with a single entry = just copy.
-  if (this->m_values.size() == 1)
+  if (this->m_values->size() == 1)
     return;
 
   // 3. We will be iterating through all the entries in the the map/vector
+  const auto &values = *m_values;
   size_t i_property = 0;
 
   //    And at the same time, iterate through the splitter
   auto itspl = splitter.begin();
 
   size_t counter = 0;
-  g_log.debug() << "[DB] Number of time series entries = " << m_values.size()
+  g_log.debug() << "[DB] Number of time series entries = " << values.size()
                 << ", Number of splitters = " << splitter.size() << "\n";
-  while (itspl != splitter.end() && i_property < m_values.size()) {
+  while (itspl != splitter.end() && i_property < values.size()) {
     // Get the splitting interval times and destination
     DateAndTime start = itspl->start();
     DateAndTime stop = itspl->stop();
@@ -486,13 +489,13 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     }
 
     // Skip the events before the start of the time
-    while (i_property < m_values.size() && m_values[i_property].time() < start)
+    while (i_property < values.size() && values[i_property].time() < start)
       ++i_property;
 
-    if (i_property == m_values.size()) {
+    if (i_property == values.size()) {
       // i_property is out of the range. Then use the last entry
-      myOutput->addValue(m_values[i_property - 1].time(),
-                         m_values[i_property - 1].value());
+      myOutput->addValue(values[i_property - 1].time(),
+                         values[i_property - 1].value());
 
       ++itspl;
       ++counter;
@@ -500,21 +503,21 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     }
 
     // The current entry is within an interval. Record them until out
-    if (m_values[i_property].time() > start && i_property > 0 && !isPeriodic) {
+    if (values[i_property].time() > start && i_property > 0 && !isPeriodic) {
       // Record the previous oneif this property is not exactly on start time
       //   and this entry is not recorded
       size_t i_prev = i_property - 1;
       if (myOutput->size() == 0 ||
-          m_values[i_prev].time() != myOutput->lastTime())
-        myOutput->addValue(m_values[i_prev].time(), m_values[i_prev].value());
+          values[i_prev].time() != myOutput->lastTime())
+        myOutput->addValue(values[i_prev].time(), values[i_prev].value());
     }
 
     // Loop through all the entries until out.
-    while (i_property < m_values.size() && m_values[i_property].time() < stop) {
+    while (i_property < values.size() && values[i_property].time() < stop) {
 
       // Copy the log out to the output
-      myOutput->addValue(m_values[i_property].time(),
-                         m_values[i_property].value());
+      myOutput->addValue(values[i_property].time(),
+                         values[i_property].value());
       ++i_property;
     }
 
@@ -526,7 +529,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
       break;
 
     // No need to keep looping through the filter if we are out of events
-    if (i_property == this->m_values.size())
+    if (i_property == values.size())
       break;
 
   } // Looping through entries in the splitter vector
@@ -710,7 +713,7 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   split.clear();
 
   // Do nothing if the log is empty.
-  if (m_values.empty())
+  if (m_values->empty())
     return;
 
   // 1. Sort
@@ -723,11 +726,11 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   DateAndTime t;
   DateAndTime start, stop;
 
-  for (size_t i = 0; i < m_values.size(); ++i) {
+  for (size_t i = 0; i < m_values->size(); ++i) {
     const DateAndTime lastTime = t;
     // The new entry
-    t = m_values[i].time();
-    TYPE val = m_values[i].value();
+    t = (*m_values)[i].time();
+    TYPE val = (*m_values)[i].value();
 
     // A good value?
     const bool isGood = ((val >= min) && (val <= max));
@@ -873,38 +876,20 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
 
   // If there's just a single value in the log, return that.
   if (realSize() == 1) {
-    return static_cast<double>(m_values.front().value());
+    return static_cast<double>(m_values->front().value());
   }
 
-  sortIfNecessary();
-
+  const auto integrals = timeIntegrals();
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
     // Calculate the total time duration (in seconds) within by the filter
     totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = getSingleValue(time.start(), index);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-    }
-
-    // Now close off with the end of the current filter range
-    numerator +=
-        DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
+    numerator += integrals->integral(time.start(), time.stop()).first;
   }
 
   // 'Normalise' by the total time
-  return numerator / totalTime;
+  return integrals->reference + numerator / totalTime;
 }
 
 /** Function specialization for TimeSeriesProperty<std::string>
@@ -946,36 +931,22 @@ std::pair<double, double> TimeSeriesProperty<TYPE>::averageAndStdDevInFilter(
                                      std::numeric_limits<double>::quiet_NaN()};
   }
 
-  double numerator(0.0), totalTime(0.0);
+  // Integrals of the deviation from the reference value and of its square
+  const auto integrals = timeIntegrals();
+  double first(0.0), second(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
     // Calculate the total time duration (in seconds) within by the filter
     totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = getSingleValue(time.start(), index);
-    double valuestddev = (value - mean) * (value - mean);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          valuestddev;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-      valuestddev = (value - mean) * (value - mean);
-    }
-
-    // Now close off with the end of the current filter range
-    numerator +=
-        DateAndTime::secondsFromDuration(time.stop() - startTime) * valuestddev;
+    const auto integral = integrals->integral(time.start(), time.stop());
+    first += integral.first;
+    second += integral.second;
   }
 
   // Normalise by the total time
-  return std::pair<double, double>{mean, std::sqrt(numerator / totalTime)};
+  const double shift = first / totalTime;
+  const double variance = std::max(second / totalTime - shift * shift, 0.0);
+  return std::pair<double, double>{mean, std::sqrt(variance)};
 }
 
 /** Function specialization for TimeSeriesProperty<std::string>
@@ -1013,9 +984,9 @@ TimeSeriesProperty<TYPE>::valueAsCorrectMap() const {
   // 2. Data Strcture
   std::map<DateAndTime, TYPE> asMap;
 
-  if (!m_values.empty()) {
-    for (size_t i = 0; i < m_values.size(); i++)
-      asMap[m_values[i].time()] = m_values[i].value();
+  if (!m_values->empty()) {
+    for (size_t i = 0; i < m_values->size(); i++)
+      asMap[(*m_values)[i].time()] = (*m_values)[i].value();
   }
 
   return asMap;
@@ -1030,10 +1001,10 @@ std::vector<TYPE> TimeSeriesProperty<TYPE>::valuesAsVector() const {
   sortIfNecessary();
 
   std::vector<TYPE> out;
-  out.reserve(m_values.size());
+  out.reserve(m_values->size());
 
-  for (size_t i = 0; i < m_values.size(); i++)
-    out.emplace_back(m_values[i].value());
+  for (size_t i = 0; i < m_values->size(); i++)
+    out.emplace_back((*m_values)[i].value());
 
   return out;
 }
@@ -1049,10 +1020,10 @@ std::multimap<DateAndTime, TYPE>
 TimeSeriesProperty<TYPE>::valueAsMultiMap() const {
   std::multimap<DateAndTime, TYPE> asMultiMap;
 
-  if (!m_values.empty()) {
-    for (size_t i = 0; i < m_values.size(); i++)
+  if (!m_values->empty()) {
+    for (size_t i = 0; i < m_values->size(); i++)
       asMultiMap.insert(
-          std::make_pair(m_values[i].time(), m_values[i].value()));
+          std::make_pair((*m_values)[i].time(), (*m_values)[i].value()));
   }
 
   return asMultiMap;
@@ -1067,10 +1038,10 @@ std::vector<DateAndTime> TimeSeriesProperty<TYPE>::timesAsVector() const {
   sortIfNecessary();
 
   std::vector<DateAndTime> out;
-  out.reserve(m_values.size());
+  out.reserve(m_values->size());
 
-  for (size_t i = 0; i < m_values.size(); i++) {
-    out.emplace_back(m_values[i].time());
+  for (size_t i = 0; i < m_values->size(); i++) {
+    out.emplace_back((*m_values)[i].time());
   }
 
   return out;
@@ -1087,12 +1058,12 @@ std::vector<double> TimeSeriesProperty<TYPE>::timesAsVectorSeconds() const {
 
   // 2. Output data structure
   std::vector<double> out;
-  out.reserve(m_values.size());
+  out.reserve(m_values->size());
 
-  Types::Core::DateAndTime start = m_values[0].time();
-  for (size_t i = 0; i < m_values.size(); i++) {
+  Types::Core::DateAndTime start = (*m_values)[0].time();
+  for (size_t i = 0; i < m_values->size(); i++) {
     out.emplace_back(
-        DateAndTime::secondsFromDuration(m_values[i].time() - start));
+        DateAndTime::secondsFromDuration((*m_values)[i].time() - start));
   }
 
   return out;
@@ -1108,7 +1079,8 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time,
                                         const TYPE value) {
   TimeValueUnit<TYPE> newvalue(time, value);
   // Add the value to the back of the vector
-  m_values.emplace_back(newvalue);
+  auto &values = mutableValues();
+  values.emplace_back(newvalue);
   // Increment the separate record of the property's size
   m_size++;
 
@@ -1119,11 +1091,11 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time,
     // First item, must be sorted.
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   } else if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN &&
-             m_values.back() < *(m_values.rbegin() + 1)) {
+             m_values->back() < *(m_values->rbegin() + 1)) {
     // Previously unknown and still unknown
     m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
   } else if (m_propSortedFlag == TimeSeriesSortStatus::TSSORTED &&
-             m_values.back() < *(m_values.rbegin() + 1)) {
+             m_values->back() < *(m_values->rbegin() + 1)) {
     // Previously sorted but last added is not in order
     m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
   }
@@ -1168,8 +1140,9 @@ void TimeSeriesProperty<TYPE>::addValues(
     const std::vector<TYPE> &values) {
   size_t length = std::min(times.size(), values.size());
   m_size += static_cast<int>(length);
+  auto &series = mutableValues();
   for (size_t i = 0; i < length; ++i) {
-    m_values.emplace_back(times[i], values[i]);
+    series.emplace_back(times[i], values[i]);
   }
 
   if (!values.empty())
@@ -1195,7 +1168,7 @@ void TimeSeriesProperty<TYPE>::replaceValues(
  */
 template <typename TYPE>
 DateAndTime TimeSeriesProperty<TYPE>::lastTime() const {
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("lastTime(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1204,14 +1177,14 @@ DateAndTime TimeSeriesProperty<TYPE>::lastTime() const {
 
   sortIfNecessary();
 
-  return m_values.rbegin()->time();
+  return m_values->rbegin()->time();
 }
 
 /** Returns the first value regardless of filter
  *  @return Value
  */
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("firstValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1220,7 +1193,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
 
   sortIfNecessary();
 
-  return m_values[0].value();
+  return (*m_values)[0].value();
 }
 
 /** Returns the first time regardless of filter
@@ -1228,7 +1201,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
  */
 template <typename TYPE>
 DateAndTime TimeSeriesProperty<TYPE>::firstTime() const {
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("firstTime(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1237,7 +1210,7 @@ DateAndTime TimeSeriesProperty<TYPE>::firstTime() const {
 
   sortIfNecessary();
 
-  return m_values[0].time();
+  return (*m_values)[0].time();
 }
 
 /**
@@ -1245,7 +1218,7 @@ DateAndTime TimeSeriesProperty<TYPE>::firstTime() const {
  *  @return Value
  */
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::lastValue() const {
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("lastValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1254,17 +1227,17 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::lastValue() const {
 
   sortIfNecessary();
 
-  return m_values.rbegin()->value();
+  return m_values->rbegin()->value();
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::minValue() const {
-  return std::min_element(m_values.begin(), m_values.end(),
+  return std::min_element(m_values->begin(), m_values->end(),
                           TimeValueUnit<TYPE>::valueCmp)
       ->value();
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::maxValue() const {
-  return std::max_element(m_values.begin(), m_values.end(),
+  return std::max_element(m_values->begin(), m_values->end(),
                           TimeValueUnit<TYPE>::valueCmp)
       ->value();
 }
@@ -1280,7 +1253,7 @@ template <typename TYPE> int TimeSeriesProperty<TYPE>::size() const {
  * the number of entries, including repeated ones.
  */
 template <typename TYPE> int TimeSeriesProperty<TYPE>::realSize() const {
-  return static_cast<int>(m_values.size());
+  return static_cast<int>(m_values->size());
 }
 
 /*
@@ -1291,10 +1264,10 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::value() const {
   sortIfNecessary();
 
   std::stringstream ins;
-  for (size_t i = 0; i < m_values.size(); i++) {
+  for (size_t i = 0; i < m_values->size(); i++) {
     try {
-      ins << m_values[i].time().toSimpleString();
-      ins << "  " << m_values[i].value() << "\n";
+      ins << (*m_values)[i].time().toSimpleString();
+      ins << "  " << (*m_values)[i].value() << "\n";
     } catch (...) {
       // Some kind of error; for example, invalid year, can occur when
       // converting boost time.
@@ -1315,11 +1288,11 @@ std::vector<std::string> TimeSeriesProperty<TYPE>::time_tValue() const {
   sortIfNecessary();
 
   std::vector<std::string> values;
-  values.reserve(m_values.size());
+  values.reserve(m_values->size());
 
-  for (size_t i = 0; i < m_values.size(); i++) {
+  for (const auto &entry : *m_values) {
     std::stringstream line;
-    line << m_values[i].time().toSimpleString() << " " << m_values[i].value();
+    line << entry.time().toSimpleString() << " " << entry.value();
     values.emplace_back(line.str());
   }
 
@@ -1341,17 +1314,17 @@ std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::valueAsMap() const {
   // 2. Build map
 
   std::map<DateAndTime, TYPE> asMap;
-  if (m_values.empty())
+  if (m_values->empty())
     return asMap;
 
-  TYPE d = m_values[0].value();
-  asMap[m_values[0].time()] = d;
+  TYPE d = (*m_values)[0].value();
+  asMap[(*m_values)[0].time()] = d;
 
-  for (size_t i = 1; i < m_values.size(); i++) {
-    if (m_values[i].value() != d) {
+  for (size_t i = 1; i < m_values->size(); i++) {
+    if ((*m_values)[i].value() != d) {
       // Only put entry with different value from last entry to map
-      asMap[m_values[i].time()] = m_values[i].value();
-      d = m_values[i].value();
+      asMap[(*m_values)[i].time()] = (*m_values)[i].value();
+      d = (*m_values)[i].value();
     }
   }
   return asMap;
@@ -1398,7 +1371,7 @@ std::string TimeSeriesProperty<TYPE>::setDataItem(
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
-  m_values.clear();
+  mutableValues().clear();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
@@ -1413,9 +1386,9 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clearOutdated() {
   if (realSize() > 1) {
-    auto lastValue = m_values.back();
+    auto lastValue = m_values->back();
     clear();
-    m_values.emplace_back(lastValue);
+    mutableValues().emplace_back(lastValue);
     m_size = 1;
   }
 }
@@ -1461,14 +1434,15 @@ void TimeSeriesProperty<TYPE>::create(
                                 "for the time and values vectors.");
 
   clear();
-  m_values.reserve(new_times.size());
+  auto &values = mutableValues();
+  values.reserve(new_times.size());
 
   std::size_t num = new_values.size();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   for (std::size_t i = 0; i < num; i++) {
     TimeValueUnit<TYPE> newentry(new_times[i], new_values[i]);
-    m_values.emplace_back(newentry);
+    values.emplace_back(newentry);
     if (m_propSortedFlag == TimeSeriesSortStatus::TSSORTED && i > 0 &&
         new_times[i - 1] > new_times[i]) {
       // Status gets to unsorted
@@ -1477,7 +1451,7 @@ void TimeSeriesProperty<TYPE>::create(
   }
 
   // reset the size
-  m_size = static_cast<int>(m_values.size());
+  m_size = static_cast<int>(m_values->size());
 }
 
 /** Returns the value at a particular time
@@ -1487,7 +1461,7 @@ void TimeSeriesProperty<TYPE>::create(
 template <typename TYPE>
 TYPE TimeSeriesProperty<TYPE>::getSingleValue(
     const Types::Core::DateAndTime &t) const {
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("getSingleValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1499,12 +1473,12 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(
 
   // 2.
   TYPE value;
-  if (t < m_values[0].time()) {
+  if (t < (*m_values)[0].time()) {
     // 1. Out side of lower bound
-    value = m_values[0].value();
-  } else if (t >= m_values.back().time()) {
+    value = (*m_values)[0].value();
+  } else if (t >= m_values->back().time()) {
     // 2. Out side of upper bound
-    value = m_values.back().value();
+    value = m_values->back().value();
   } else {
     // 3. Within boundary
     int index = this->findIndex(t);
@@ -1512,17 +1486,17 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(
     if (index < 0) {
       // If query time "t" is earlier than the begin time of the series
       index = 0;
-    } else if (index == int(m_values.size())) {
+    } else if (index == int(m_values->size())) {
       // If query time "t" is later than the end time of the  series
-      index = static_cast<int>(m_values.size()) - 1;
-    } else if (index > int(m_values.size())) {
+      index = static_cast<int>(m_values->size()) - 1;
+    } else if (index > int(m_values->size())) {
       std::stringstream errss;
       errss << "TimeSeriesProperty.findIndex() returns index (" << index
-            << " ) > maximum defined value " << m_values.size();
+            << " ) > maximum defined value " << m_values->size();
       throw std::logic_error(errss.str());
     }
 
-    value = m_values[static_cast<size_t>(index)].value();
+    value = (*m_values)[static_cast<size_t>(index)].value();
   }
 
   return value;
@@ -1536,7 +1510,7 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(
 template <typename TYPE>
 TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
                                               int &index) const {
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("getSingleValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1548,14 +1522,14 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
 
   // 2.
   TYPE value;
-  if (t < m_values[0].time()) {
+  if (t < (*m_values)[0].time()) {
     // 1. Out side of lower bound
-    value = m_values[0].value();
+    value = (*m_values)[0].value();
     index = 0;
-  } else if (t >= m_values.back().time()) {
+  } else if (t >= m_values->back().time()) {
     // 2. Out side of upper bound
-    value = m_values.back().value();
-    index = int(m_values.size()) - 1;
+    value = m_values->back().value();
+    index = int(m_values->size()) - 1;
   } else {
     // 3. Within boundary
     index = this->findIndex(t);
@@ -1563,17 +1537,17 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
     if (index < 0) {
       // If query time "t" is earlier than the begin time of the series
       index = 0;
-    } else if (index == int(m_values.size())) {
+    } else if (index == int(m_values->size())) {
       // If query time "t" is later than the end time of the  series
-      index = static_cast<int>(m_values.size()) - 1;
-    } else if (index > int(m_values.size())) {
+      index = static_cast<int>(m_values->size()) - 1;
+    } else if (index > int(m_values->size())) {
       std::stringstream errss;
       errss << "TimeSeriesProperty.findIndex() returns index (" << index
-            << " ) > maximum defined value " << m_values.size();
+            << " ) > maximum defined value " << m_values->size();
       throw std::logic_error(errss.str());
     }
 
-    value = m_values[static_cast<size_t>(index)].value();
+    value = (*m_values)[static_cast<size_t>(index)].value();
   }
 
   return value;
@@ -1592,7 +1566,7 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
 template <typename TYPE>
 TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
   // 0. Throw exception
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("nthInterval(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1608,21 +1582,22 @@ TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
 
   if (m_filter.empty()) {
     // I. No filter
-    if (n >= static_cast<int>(m_values.size()) ||
-        (n == static_cast<int>(m_values.size()) - 1 && m_values.size() == 1)) {
+    if (n >= static_cast<int>(m_values->size()) ||
+        (n == static_cast<int>(m_values->size()) - 1 &&
+         m_values->size() == 1)) {
       // 1. Out of bound
       ;
-    } else if (n == static_cast<int>(m_values.size()) - 1) {
+    } else if (n == static_cast<int>(m_values->size()) - 1) {
       // 2. Last one by making up an end time.
       time_duration d =
-          m_values.rbegin()->time() - (m_values.rbegin() + 1)->time();
-      DateAndTime endTime = m_values.rbegin()->time() + d;
-      Kernel::TimeInterval dt(m_values.rbegin()->time(), endTime);
+          m_values->rbegin()->time() - (m_values->rbegin() + 1)->time();
+      DateAndTime endTime = m_values->rbegin()->time() + d;
+      Kernel::TimeInterval dt(m_values->rbegin()->time(), endTime);
       deltaT = dt;
     } else {
       // 3. Regular
-      DateAndTime startT = m_values[static_cast<std::size_t>(n)].time();
-      DateAndTime endT = m_values[static_cast<std::size_t>(n) + 1].time();
+      DateAndTime startT = (*m_values)[static_cast<std::size_t>(n)].time();
+      DateAndTime endT = (*m_values)[static_cast<std::size_t>(n) + 1].time();
       TimeInterval dt(startT, endT);
       deltaT = dt;
     }
@@ -1638,8 +1613,8 @@ TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
       // 2. n = size of the allowed region, duplicate the last one
       auto ind_t1 = static_cast<long>(m_filterQuickRef.back().first);
       long ind_t2 = ind_t1 - 1;
-      Types::Core::DateAndTime t1 = (m_values.begin() + ind_t1)->time();
-      Types::Core::DateAndTime t2 = (m_values.begin() + ind_t2)->time();
+      Types::Core::DateAndTime t1 = (m_values->begin() + ind_t1)->time();
+      Types::Core::DateAndTime t2 = (m_values->begin() + ind_t2)->time();
       time_duration d = t1 - t2;
       Types::Core::DateAndTime t3 = t1 + d;
       Kernel::TimeInterval dt(t1, t3);
@@ -1662,7 +1637,7 @@ TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
           m_filter[m_filterQuickRef[refindex].first].first;
       size_t iStartIndex =
           m_filterQuickRef[refindex + 1].first + static_cast<size_t>(diff);
-      Types::Core::DateAndTime ltime0 = m_values[iStartIndex].time();
+      Types::Core::DateAndTime ltime0 = (*m_values)[iStartIndex].time();
       if (iStartIndex == 0 && ftime0 < ltime0) {
         // a) Special case that True-filter time starts before log time
         t0 = ltime0;
@@ -1677,14 +1652,14 @@ TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
 
       // ii) end time
       size_t iStopIndex = iStartIndex + 1;
-      if (iStopIndex >= m_values.size()) {
+      if (iStopIndex >= m_values->size()) {
         // a) Last log entry is for the start
         Types::Core::DateAndTime ftimef =
             m_filter[m_filterQuickRef[refindex + 3].first].first;
         tf = ftimef;
       } else {
         // b) Using the earlier value of next log entry and next filter entry
-        Types::Core::DateAndTime ltimef = m_values[iStopIndex].time();
+        Types::Core::DateAndTime ltimef = (*m_values)[iStopIndex].time();
         Types::Core::DateAndTime ftimef =
             m_filter[m_filterQuickRef[refindex + 3].first].first;
         if (ltimef < ftimef)
@@ -1711,7 +1686,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
   TYPE value;
 
   // 1. Throw error if property is empty
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("nthValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1723,12 +1698,12 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
 
   if (m_filter.empty()) {
     // 3. Situation 1:  No filter
-    if (static_cast<size_t>(n) < m_values.size()) {
-      TimeValueUnit<TYPE> entry = m_values[static_cast<std::size_t>(n)];
+    if (static_cast<size_t>(n) < m_values->size()) {
+      TimeValueUnit<TYPE> entry = (*m_values)[static_cast<std::size_t>(n)];
       value = entry.value();
     } else {
       TimeValueUnit<TYPE> entry =
-          m_values[static_cast<std::size_t>(m_size) - 1];
+          (*m_values)[static_cast<std::size_t>(m_size) - 1];
       value = entry.value();
     }
   } else {
@@ -1738,7 +1713,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
     if (static_cast<size_t>(n) > m_filterQuickRef.back().second + 1) {
       // 1. n >= size of the allowed region
       size_t ilog = (m_filterQuickRef.rbegin() + 1)->first;
-      value = m_values[ilog].value();
+      value = (*m_values)[ilog].value();
     } else {
       // 2. n < size
       Types::Core::DateAndTime t0;
@@ -1751,7 +1726,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
       size_t ilog =
           m_filterQuickRef[refindex + 1].first +
           (static_cast<std::size_t>(n) - m_filterQuickRef[refindex].second);
-      value = m_values[ilog].value();
+      value = (*m_values)[ilog].value();
     } // END-IF-ELSE Cases
   }
 
@@ -1767,17 +1742,17 @@ template <typename TYPE>
 Types::Core::DateAndTime TimeSeriesProperty<TYPE>::nthTime(int n) const {
   sortIfNecessary();
 
-  if (m_values.empty()) {
+  if (m_values->empty()) {
     const std::string error("nthTime(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
     throw std::runtime_error(error);
   }
 
-  if (n < 0 || n >= static_cast<int>(m_values.size()))
-    n = static_cast<int>(m_values.size()) - 1;
+  if (n < 0 || n >= static_cast<int>(m_values->size()))
+    n = static_cast<int>(m_values->size()) - 1;
 
-  return m_values[static_cast<size_t>(n)].time();
+  return (*m_values)[static_cast<size_t>(n)].time();
 }
 
 /* Divide the property into  allowed and disallowed time intervals according to
@@ -1835,12 +1810,12 @@ void TimeSeriesProperty<TYPE>::filterWith(
   // 2b) Get a clean finish
   if (filtervalues.back()) {
     DateAndTime lastTime, nextLastT;
-    if (m_values.back().time() > filtertimes.back()) {
-      const size_t nvalues(m_values.size());
+    if (m_values->back().time() > filtertimes.back()) {
+      const size_t nvalues(m_values->size());
       // Last log time is later than last filter time
-      lastTime = m_values.back().time();
-      if (nvalues > 1 && m_values[nvalues - 2].time() > filtertimes.back())
-        nextLastT = m_values[nvalues - 2].time();
+      lastTime = m_values->back().time();
+      if (nvalues > 1 && (*m_values)[nvalues - 2].time() > filtertimes.back())
+        nextLastT = (*m_values)[nvalues - 2].time();
       else
         nextLastT = filtertimes.back();
     } else {
@@ -1851,10 +1826,10 @@ void TimeSeriesProperty<TYPE>::filterWith(
       // this
       // else it is the last value time
       if (nfilterValues > 1 &&
-          m_values.back().time() > filtertimes[nfilterValues - 2])
+          m_values->back().time() > filtertimes[nfilterValues - 2])
         nextLastT = filtertimes[nfilterValues - 2];
       else
-        nextLastT = m_values.back().time();
+        nextLastT = m_values->back().time();
     }
 
     time_duration dtime = lastTime - nextLastT;
@@ -1880,20 +1855,20 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clearFilter() {
 template <typename TYPE> void TimeSeriesProperty<TYPE>::countSize() const {
   if (m_filter.empty()) {
     // 1. Not filter
-    m_size = int(m_values.size());
+    m_size = int(m_values->size());
   } else {
     // 2. With Filter
     if (!m_filterApplied) {
       this->applyFilter();
     }
-    size_t nvalues = m_filterQuickRef.empty() ? m_values.size()
+    size_t nvalues = m_filterQuickRef.empty() ? m_values->size()
                                               : m_filterQuickRef.back().second;
     // The filter logic can end up with the quick ref having a duplicate of the
     // last time and value at the end if the last filter time is past the log
     // time See "If it is out of upper boundary, still record it.  but make the
     // log entry to mP.size()+1" in applyFilter
     // Make the log seem the full size
-    if (nvalues == m_values.size() + 1) {
+    if (nvalues == m_values->size() + 1) {
       --nvalues;
     }
     m_size = static_cast<int>(nvalues);
@@ -1906,9 +1881,17 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::countSize() const {
  */
 template <typename TYPE>
 bool TimeSeriesProperty<TYPE>::isTimeString(const std::string &str) {
-  static const boost::regex re(
-      "^[0-9]{4}.[0-9]{2}.[0-9]{2}.[0-9]{2}.[0-9]{2}.[0-9]{2}");
-  return boost::regex_search(str.begin(), str.end(), re);
+  // Digits in the form "YYYY-MM-DDThh:mm:ss" with any separators. This is
+  // called for every line of a log file so avoids a regular expression.
+  static const char pattern[] = "0000-00-00T00:00:00";
+  constexpr size_t length = sizeof(pattern) - 1;
+  if (str.size() < length)
+    return false;
+  for (size_t i = 0; i < length; ++i) {
+    if (pattern[i] == '0' && (str[i] < '0' || str[i] > '9'))
+      return false;
+  }
+  return true;
 }
 
 /**
@@ -1982,10 +1965,11 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
   // 2. Detect and Remove Duplicated
   size_t numremoved = 0;
 
+  auto &values = mutableValues();
   typename std::vector<TimeValueUnit<TYPE>>::iterator vit;
-  vit = m_values.begin() + 1;
-  Types::Core::DateAndTime prevtime = m_values.begin()->time();
-  while (vit != m_values.end()) {
+  vit = values.begin() + 1;
+  Types::Core::DateAndTime prevtime = values.begin()->time();
+  while (vit != values.end()) {
     Types::Core::DateAndTime currtime = vit->time();
     if (prevtime == currtime) {
       // Print out warning
@@ -1994,7 +1978,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
                     << (vit - 1)->value() << "\n";
 
       // A duplicated entry!
-      vit = m_values.erase(vit - 1);
+      vit = values.erase(vit - 1);
 
       numremoved++;
     }
@@ -2019,8 +2003,8 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 template <typename TYPE>
 std::string TimeSeriesProperty<TYPE>::toString() const {
   std::stringstream ss;
-  for (size_t i = 0; i < m_values.size(); ++i)
-    ss << m_values[i].time() << "\t\t" << m_values[i].value() << "\n";
+  for (size_t i = 0; i < m_values->size(); ++i)
+    ss << (*m_values)[i].time() << "\t\t" << (*m_values)[i].value() << "\n";
 
   return ss.str();
 }
@@ -2037,7 +2021,7 @@ std::string TimeSeriesProperty<TYPE>::toString() const {
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
   if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN) {
-    bool sorted = is_sorted(m_values.begin(), m_values.end());
+    bool sorted = is_sorted(m_values->begin(), m_values->end());
     if (sorted)
       m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
     else
@@ -2047,11 +2031,113 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
   if (m_propSortedFlag == TimeSeriesSortStatus::TSUNSORTED) {
     g_log.information(
         "TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
-    std::stable_sort(m_values.begin(), m_values.end());
+    auto &values = m_values.access();
+    std::stable_sort(values.begin(), values.end());
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   }
 }
 
+/** Running time integrals of a sorted series, treating each value as constant
+ * until the time of the next entry, the first value as constant before the
+ * first entry and the last value as constant after the last entry.
+ *
+ * The integrals are over the deviation of the values from a reference value
+ * and its square, which limits cancellation when computing the standard
+ * deviation.
+ */
+template <typename TYPE> struct TimeSeriesProperty<TYPE>::TimeIntegrals {
+  /// Times of the entries in nanoseconds
+  std::vector<int64_t> times;
+  /// Deviations of the values from the reference value
+  std::vector<double> deviations;
+  /// Integrals of the deviation and its square from the first entry onwards
+  std::vector<std::pair<double, double>> cumulative;
+  /// The reference value, i.e., the arithmetic mean of the values
+  double reference = 0.0;
+
+  /// Integrals of the deviation and its square from the first entry to t
+  std::pair<double, double> fromStart(const DateAndTime &t) const {
+    const int64_t nanoseconds = t.totalNanoseconds();
+    auto it = std::upper_bound(times.cbegin(), times.cend(), nanoseconds);
+    const auto index = static_cast<size_t>(
+        it == times.cbegin() ? 0 : std::distance(times.cbegin(), it) - 1);
+    const double dt = 1e-9 * static_cast<double>(nanoseconds - times[index]);
+    const double deviation = deviations[index];
+    return {cumulative[index].first + deviation * dt,
+            cumulative[index].second + deviation * deviation * dt};
+  }
+
+  /// Integrals of the deviation and its square from start to stop
+  std::pair<double, double> integral(const DateAndTime &start,
+                                     const DateAndTime &stop) const {
+    const auto upper = fromStart(stop);
+    const auto lower = fromStart(start);
+    return {upper.first - lower.first, upper.second - lower.second};
+  }
+};
+
+/** Returns the running time integrals of the values. They are computed on the
+ * first call after a modification and shared by copies of this property, so
+ * time-weighted averages over any interval cost O(log n).
+ */
+template <typename TYPE>
+boost::shared_ptr<const typename TimeSeriesProperty<TYPE>::TimeIntegrals>
+TimeSeriesProperty<TYPE>::timeIntegrals() const {
+  auto integrals = boost::atomic_load(&m_timeIntegrals);
+  if (integrals)
+    return integrals;
+
+  sortIfNecessary();
+  const auto &values = *m_values;
+  auto newIntegrals = boost::make_shared<TimeIntegrals>();
+  const size_t numValues = values.size();
+  newIntegrals->times.resize(numValues);
+  newIntegrals->deviations.resize(numValues);
+  newIntegrals->cumulative.resize(numValues);
+  for (size_t i = 0; i < numValues; ++i) {
+    newIntegrals->times[i] = values[i].time().totalNanoseconds();
+    newIntegrals->reference += static_cast<double>(values[i].value());
+  }
+  if (numValues > 0)
+    newIntegrals->reference /= static_cast<double>(numValues);
+  std::pair<double, double> sum{0.0, 0.0};
+  for (size_t i = 0; i < numValues; ++i) {
+    const double deviation =
+        static_cast<double>(values[i].value()) - newIntegrals->reference;
+    newIntegrals->deviations[i] = deviation;
+    newIntegrals->cumulative[i] = sum;
+    if (i + 1 < numValues) {
+      const double dt = 1e-9 * static_cast<double>(newIntegrals->times[i + 1] -
+                                                   newIntegrals->times[i]);
+      sum.first += deviation * dt;
+      sum.second += deviation * deviation * dt;
+    }
+  }
+  integrals = newIntegrals;
+  boost::atomic_store(&m_timeIntegrals, integrals);
+  return integrals;
+}
+
+/// Function specialization for TimeSeriesProperty<std::string>
+template <>
+boost::shared_ptr<
+    const typename TimeSeriesProperty<std::string>::TimeIntegrals>
+TimeSeriesProperty<std::string>::timeIntegrals() const {
+  throw Exception::NotImplementedError(
+      "TimeSeriesProperty::timeIntegrals is not "
+      "implemented for string properties");
+}
+
+/** Returns the values for modification. Shared values are copied first and
+ * the time integrals are dropped.
+ */
+template <typename TYPE>
+std::vector<TimeValueUnit<TYPE>> &TimeSeriesProperty<TYPE>::mutableValues() {
+  if (m_timeIntegrals)
+    m_timeIntegrals.reset();
+  return m_values.access();
+}
+
 /** Find the index of the entry of time t in the mP vector (sorted)
  *  Return @ if t is within log.begin and log.end, then the index of the log
  * equal or just smaller than t
@@ -2061,25 +2147,25 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
 template <typename TYPE>
 int TimeSeriesProperty<TYPE>::findIndex(Types::Core::DateAndTime t) const {
   // 0. Return with an empty container
-  if (m_values.empty())
+  if (m_values->empty())
     return 0;
 
   // 1. Sort
   sortIfNecessary();
 
   // 2. Extreme value
-  if (t <= m_values[0].time()) {
+  if (t <= (*m_values)[0].time()) {
     return -1;
-  } else if (t >= m_values.back().time()) {
-    return (int(m_values.size()));
+  } else if (t >= m_values->back().time()) {
+    return (int(m_values->size()));
   }
 
   // 3. Find by lower_bound()
   typename std::vector<TimeValueUnit<TYPE>>::const_iterator fid;
-  TimeValueUnit<TYPE> temp(t, m_values[0].value());
-  fid = std::lower_bound(m_values.begin(), m_values.end(), temp);
+  TimeValueUnit<TYPE> temp(t, (*m_values)[0].value());
+  fid = std::lower_bound(m_values->begin(), m_values->end(), temp);
 
-  int newindex = int(fid - m_values.begin());
+  int newindex = int(fid - m_values->begin());
   if (fid->time() > t)
     newindex--;
 
@@ -2099,7 +2185,7 @@ int TimeSeriesProperty<TYPE>::upperBound(Types::Core::DateAndTime t, int istart,
   if (istart < 0) {
     throw std::invalid_argument("Start Index cannot be less than 0");
   }
-  if (iend >= static_cast<int>(m_values.size())) {
+  if (iend >= static_cast<int>(m_values->size())) {
     throw std::invalid_argument("End Index cannot exceed the boundary");
   }
   if (istart > iend) {
@@ -2107,26 +2193,26 @@ int TimeSeriesProperty<TYPE>::upperBound(Types::Core::DateAndTime t, int istart,
   }
 
   // 1. Return instantly if it is out of boundary
-  if (t < (m_values.begin() + istart)->time()) {
+  if (t < (m_values->begin() + istart)->time()) {
     return -1;
   }
-  if (t > (m_values.begin() + iend)->time()) {
-    return static_cast<int>(m_values.size());
+  if (t > (m_values->begin() + iend)->time()) {
+    return static_cast<int>(m_values->size());
   }
 
   // 2. Sort
   sortIfNecessary();
 
   // 3. Construct the pair for comparison and do lower_bound()
-  TimeValueUnit<TYPE> temppair(t, m_values[0].value());
-  typename std::vector<TimeValueUnit<TYPE>>::iterator fid;
-  fid = std::lower_bound((m_values.begin() + istart),
-                         (m_values.begin() + iend + 1), temppair);
-  if (fid == m_values.end())
+  TimeValueUnit<TYPE> temppair(t, (*m_values)[0].value());
+  typename std::vector<TimeValueUnit<TYPE>>::const_iterator fid;
+  fid = std::lower_bound((m_values->begin() + istart),
+                         (m_values->begin() + iend + 1), temppair);
+  if (fid == m_values->end())
     throw std::runtime_error("Cannot find data");
 
   // 4. Calculate return value
-  size_t index = size_t(fid - m_values.begin());
+  size_t index = size_t(fid - m_values->begin());
 
   return int(index);
 }
@@ -2157,9 +2243,9 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::applyFilter() const {
       if (icurlog > 0)
         istart = icurlog - 1;
 
-      if (icurlog < static_cast<int>(m_values.size()))
+      if (icurlog < static_cast<int>(m_values->size()))
         icurlog = this->upperBound(m_filter[ift].first, istart,
-                                   static_cast<int>(m_values.size()) - 1);
+                                   static_cast<int>(m_values->size()) - 1);
 
       if (icurlog < 0) {
         // i. If it is out of lower boundary, add filter time, add 0 time
@@ -2171,14 +2257,14 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::applyFilter() const {
         m_filterQuickRef.emplace_back(0, 0);
 
         icurlog = 0;
-      } else if (icurlog >= static_cast<int>(m_values.size())) {
+      } else if (icurlog >= static_cast<int>(m_values->size())) {
         // ii.  If it is out of upper boundary, still record it.  but make the
         // log entry to mP.size()+1
         size_t ip = 0;
         if (m_filterQuickRef.size() >= 4)
           ip = m_filterQuickRef.back().second;
         m_filterQuickRef.emplace_back(ift, ip);
-        m_filterQuickRef.emplace_back(m_values.size() + 1, ip);
+        m_filterQuickRef.emplace_back(m_values->size() + 1, ip);
       } else {
         // iii. The returned value is in the boundary.
         size_t numintervals = 0;
@@ -2186,7 +2272,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::applyFilter() const {
           numintervals = m_filterQuickRef.back().second;
         }
         if (m_filter[ift].first <
-            m_values[static_cast<std::size_t>(icurlog)].time()) {
+            (*m_values)[static_cast<std::size_t>(icurlog)].time()) {
           if (icurlog == 0) {
             throw std::logic_error("In this case, icurlog won't be zero! ");
           }
@@ -2201,10 +2287,10 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::applyFilter() const {
       // b) Filter == False: indicating the end of a quick reference region
       int ilastlog = icurlog;
 
-      if (ilastlog < static_cast<int>(m_values.size())) {
+      if (ilastlog < static_cast<int>(m_values->size())) {
         // B1: Last TRUE entry is still within log
         icurlog = this->upperBound(m_filter[ift].first, icurlog,
-                                   static_cast<int>(m_values.size()) - 1);
+                                   static_cast<int>(m_values->size()) - 1);
 
         if (icurlog < 0) {
           // i.   Some false filter is before the first log entry.  The previous
@@ -2296,6 +2382,7 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
     return "Could not set value: properties have different type.";
   }
   m_values = prop->m_values;
+  m_timeIntegrals = prop->m_timeIntegrals;
   m_size = prop->m_size;
   m_propSortedFlag = prop->m_propSortedFlag;
   m_filter = prop->m_filter;
@@ -2423,7 +2510,7 @@ void TimeSeriesProperty<TYPE>::histogramData(
 
   double dt = (t1 - t0) / static_cast<double>(nPoints);
 
-  for (auto &ev : m_values) {
+  for (auto &ev : *m_values) {
     auto time = static_cast<double>(ev.time().totalNanoseconds());
     if (time < t0 || time >= t1)
       continue;
@@ -2460,7 +2547,7 @@ std::vector<TYPE> TimeSeriesProperty<TYPE>::filteredValuesAsVector() const {
   sortIfNecessary();
 
   std::vector<TYPE> filteredValues;
-  for (const auto &value : m_values) {
+  for (const auto &value : *m_values) {
     if (isTimeFiltered(value.time())) {
       filteredValues.emplace_back(value.value());
     }
@@ -6,6 +6,13 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidKernel/TimeSplitter.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
 namespace Mantid {
 
 using namespace Types::Core;
@@ -152,19 +159,44 @@ TimeSplitterType operator&(const TimeSplitterType &a,
   if ((a.empty()) || (b.empty()))
     return out;
 
-  TimeSplitterType::const_iterator ait;
-  TimeSplitterType::const_iterator bit;
-
-  // For now, a simple double iteration. Can be made smarter if a and b are
-  // sorted.
-  for (ait = a.begin(); ait != a.end(); ++ait) {
-    for (bit = b.begin(); bit != b.end(); ++bit) {
-      if (ait->overlaps(*bit)) {
+  // If the intervals of b are valid and both their starts and stops are in
+  // order, only the intervals of b between the first stop at or after the
+  // start of an interval of a and the last start at or before its stop can
+  // overlap it. Otherwise fall back to comparing every pair.
+  const bool bOrdered =
+      std::all_of(b.cbegin(), b.cend(),
+                  [](const SplittingInterval &interval) {
+                    return interval.start() <= interval.stop();
+                  }) &&
+      std::adjacent_find(b.cbegin(), b.cend(),
+                         [](const SplittingInterval &lhs,
+                            const SplittingInterval &rhs) {
+                           return rhs.start() < lhs.start() ||
+                                  rhs.stop() < lhs.stop();
+                         }) == b.cend();
+
+  for (const auto &aInterval : a) {
+    auto bit = b.cbegin();
+    auto bit_end = b.cend();
+    if (bOrdered && aInterval.start() <= aInterval.stop()) {
+      bit = std::lower_bound(b.cbegin(), b.cend(), aInterval.start(),
+                             [](const SplittingInterval &interval,
+                                const DateAndTime &time) {
+                               return interval.stop() < time;
+                             });
+      bit_end = std::upper_bound(bit, b.cend(), aInterval.stop(),
+                                 [](const DateAndTime &time,
+                                    const SplittingInterval &interval) {
+                                   return time < interval.start();
+                                 });
+    }
+    for (; bit != bit_end; ++bit) {
+      if (aInterval.overlaps(*bit)) {
         // The & operator for SplittingInterval keeps the index of the
-        // left-hand-side (ait in this case)
+        // left-hand-side (aInterval in this case)
         //  meaning that a has to be the splitter because the b index is
         //  ignored.
-        out.emplace_back(*ait & *bit);
+        out.emplace_back(aInterval & *bit);
       }
     }
   }
@@ -277,5 +309,240 @@ TimeSplitterType operator~(const TimeSplitterType &a) {
   }
   return out;
 }
+
+//------------------------------------------------------------------------------------------------
+/** Constructor from a list of splitting intervals. The intervals need not be
+ * sorted. Empty intervals are ignored and where intervals overlap the one
+ * starting first keeps the overlapping time, as when walking a sorted list of
+ * intervals.
+ *
+ * @param intervals :: the splitting intervals
+ */
+TimeSplitter::TimeSplitter(const TimeSplitterType &intervals) {
+  TimeSplitterType sorted;
+  sorted.reserve(intervals.size());
+  std::copy_if(intervals.cbegin(), intervals.cend(),
+               std::back_inserter(sorted),
+               [](const SplittingInterval &interval) {
+                 return interval.start() < interval.stop();
+               });
+  std::stable_sort(sorted.begin(), sorted.end());
+
+  m_times.reserve(2 * sorted.size());
+  m_targets.reserve(2 * sorted.size());
+  // End of the time covered by the intervals so far
+  auto end = std::numeric_limits<int64_t>::min();
+  for (const auto &interval : sorted) {
+    auto start = interval.start().totalNanoseconds();
+    const auto stop = interval.stop().totalNanoseconds();
+    if (stop <= end)
+      continue;
+    if (start > end)
+      addBoundary(end, NO_TARGET);
+    else
+      start = end;
+    addBoundary(start, interval.index());
+    end = stop;
+  }
+  if (!m_times.empty())
+    addBoundary(end, NO_TARGET);
+  if (!sorted.empty())
+    m_coverageEnd = end;
+}
+
+/** Constructor for a single interval
+ *
+ * @param start :: the start of the interval
+ * @param stop :: the end of the interval, excluded
+ * @param index :: the destination of the interval
+ */
+TimeSplitter::TimeSplitter(const DateAndTime &start, const DateAndTime &stop,
+                           const int index)
+    : TimeSplitter(TimeSplitterType{SplittingInterval(start, stop, index)}) {}
+
+/// @return the destination of a time, or NO_TARGET
+int TimeSplitter::valueAtTime(const DateAndTime &time) const {
+  return valueAtTime(time.totalNanoseconds());
+}
+
+/// @return the destination of a time in nanoseconds, or NO_TARGET
+int TimeSplitter::valueAtTime(const int64_t nanoseconds) const {
+  const auto next = std::upper_bound(m_times.cbegin(), m_times.cend(),
+                                     nanoseconds);
+  if (next == m_times.cbegin())
+    return NO_TARGET;
+  return m_targets[std::distance(m_times.cbegin(), next) - 1];
+}
+
+/// @return the distinct destinations, excluding NO_TARGET
+std::set<int> TimeSplitter::outputIndices() const {
+  std::set<int> indices(m_targets.cbegin(), m_targets.cend());
+  indices.erase(NO_TARGET);
+  return indices;
+}
+
+/// @return the intervals that have a destination, in time order
+TimeSplitterType TimeSplitter::intervals() const {
+  TimeSplitterType out;
+  for (size_t i = 0; i + 1 < m_times.size(); ++i) {
+    if (m_targets[i] != NO_TARGET)
+      out.emplace_back(DateAndTime(m_times[i]), DateAndTime(m_times[i + 1]),
+                       m_targets[i]);
+  }
+  return out;
+}
+
+namespace {
+/// Merge the boundaries of two splitters, combining their destinations
+template <typename Combine>
+std::vector<std::pair<int64_t, int>>
+mergeBoundaries(const std::vector<int64_t> &aTimes,
+                const std::vector<int> &aTargets,
+                const std::vector<int64_t> &bTimes,
+                const std::vector<int> &bTargets, Combine combine) {
+  std::vector<std::pair<int64_t, int>> boundaries;
+  boundaries.reserve(aTimes.size() + bTimes.size());
+  int aTarget = TimeSplitter::NO_TARGET;
+  int bTarget = TimeSplitter::NO_TARGET;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < aTimes.size() || j < bTimes.size()) {
+    int64_t time;
+    if (j == bTimes.size() || (i < aTimes.size() && aTimes[i] <= bTimes[j]))
+      time = aTimes[i];
+    else
+      time = bTimes[j];
+    if (i < aTimes.size() && aTimes[i] == time)
+      aTarget = aTargets[i++];
+    if (j < bTimes.size() && bTimes[j] == time)
+      bTarget = bTargets[j++];
+    boundaries.emplace_back(time, combine(aTarget, bTarget));
+  }
+  return boundaries;
+}
+} // namespace
+
+/** Union of two splitters. Where both have a destination, the destination
+ * of this splitter is kept.
+ *
+ * @param other :: the splitter to add
+ * @return the union of the splitters
+ */
+TimeSplitter TimeSplitter::operator|(const TimeSplitter &other) const {
+  TimeSplitter out;
+  for (const auto &boundary :
+       mergeBoundaries(m_times, m_targets, other.m_times, other.m_targets,
+                       [](const int target, const int otherTarget) {
+                         return target != NO_TARGET ? target : otherTarget;
+                       })) {
+    out.addBoundary(boundary.first, boundary.second);
+  }
+  out.m_coverageEnd = std::max(m_coverageEnd, other.m_coverageEnd);
+  return out;
+}
+
+/** Intersection of this splitter with a filter. Only the times for which
+ * the filter has a destination, whichever it is, are kept.
+ *
+ * @param filter :: the filter to apply
+ * @return the filtered splitter
+ */
+TimeSplitter TimeSplitter::operator&(const TimeSplitter &filter) const {
+  TimeSplitter out;
+  for (const auto &boundary :
+       mergeBoundaries(m_times, m_targets, filter.m_times, filter.m_targets,
+                       [](const int target, const int filterTarget) {
+                         return filterTarget != NO_TARGET ? target
+                                                          : NO_TARGET;
+                       })) {
+    out.addBoundary(boundary.first, boundary.second);
+  }
+  if (hasCoverage() && filter.hasCoverage())
+    out.m_coverageEnd = std::min(m_coverageEnd, filter.m_coverageEnd);
+  return out;
+}
+
+bool TimeSplitter::operator==(const TimeSplitter &other) const {
+  return m_times == other.m_times && m_targets == other.m_targets &&
+         m_coverageEnd == other.m_coverageEnd;
+}
+
+bool TimeSplitter::operator!=(const TimeSplitter &other) const {
+  return !(*this == other);
+}
+
+/** Serialize the splitter as a comma separated list of boundaries, each
+ * written as the time in nanoseconds and the destination separated by a
+ * colon, e.g. "1000:0,2000:-1". If the coverage extends past the last
+ * boundary its end is appended as a further boundary without destination.
+ *
+ * @return the splitter as a string
+ */
+std::string TimeSplitter::toString() const {
+  std::ostringstream out;
+  for (size_t i = 0; i < m_times.size(); ++i) {
+    if (i > 0)
+      out << ',';
+    out << m_times[i] << ':' << m_targets[i];
+  }
+  if (hasCoverage() && (m_times.empty() || m_coverageEnd > m_times.back())) {
+    if (!m_times.empty())
+      out << ',';
+    out << m_coverageEnd << ':' << NO_TARGET;
+  }
+  return out.str();
+}
+
+/** Create a splitter from the output of toString()
+ *
+ * @param text :: the serialized splitter
+ * @return the splitter
+ * @throw std::invalid_argument if the text is not a valid splitter
+ */
+TimeSplitter TimeSplitter::fromString(const std::string &text) {
+  TimeSplitter out;
+  std::istringstream in(text);
+  std::string entry;
+  int lastTarget = NO_TARGET;
+  while (std::getline(in, entry, ',')) {
+    std::istringstream entryStream(entry);
+    int64_t time;
+    char separator;
+    int target;
+    if (!(entryStream >> time >> separator >> target) || separator != ':' ||
+        !(entryStream >> std::ws).eof())
+      throw std::invalid_argument("TimeSplitter: cannot parse boundary '" +
+                                  entry + "'");
+    if (out.hasCoverage() && time <= out.m_coverageEnd)
+      throw std::invalid_argument(
+          "TimeSplitter: boundaries must be strictly increasing");
+    out.addBoundary(time, target);
+    out.m_coverageEnd = time;
+    lastTarget = target;
+  }
+  if (lastTarget != NO_TARGET)
+    throw std::invalid_argument(
+        "TimeSplitter: the last boundary must have no destination");
+  return out;
+}
+
+/** Append a boundary, merging it with the previous one if the destination is
+ * unchanged and replacing the previous one if it is at the same time
+ *
+ * @param time :: the time of the boundary in nanoseconds
+ * @param target :: the destination from the boundary onwards
+ */
+void TimeSplitter::addBoundary(const int64_t time, const int target) {
+  if (!m_times.empty() && m_times.back() == time) {
+    m_times.pop_back();
+    m_targets.pop_back();
+  }
+  const int previous = m_targets.empty() ? NO_TARGET : m_targets.back();
+  if (target == previous)
+    return;
+  m_times.emplace_back(time);
+  m_targets.emplace_back(target);
+}
+
 } // namespace Kernel
 } // namespace Mantid
@@ -0,0 +1,346 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/Tracing.h"
+#include "MantidKernel/Memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Number of spans each thread keeps
+constexpr size_t BUFFER_CAPACITY = 16384;
+
+/// A finished span
+struct Record {
+  int64_t begin;
+  int64_t end;
+  uint64_t bytes;
+  uint64_t events;
+  uint64_t peakMemory;
+  Tracing::Category category;
+  char name[64];
+};
+
+/// The spans of one thread, written only by that thread
+struct ThreadBuffer {
+  explicit ThreadBuffer(const size_t index)
+      : threadIndex(index), records(BUFFER_CAPACITY) {}
+  const size_t threadIndex;
+  std::vector<Record> records;
+  /// Number of spans recorded so far; the newest are kept
+  std::atomic<uint64_t> numWritten{0};
+};
+
+const char *categoryName(const Tracing::Category category) {
+  switch (category) {
+  case Tracing::Category::Algorithm:
+    return "algorithm";
+  case Tracing::Category::ChildAlgorithm:
+    return "child algorithm";
+  case Tracing::Category::Task:
+    return "task";
+  case Tracing::Category::IO:
+    return "io";
+  }
+  return "unknown";
+}
+
+/// Write a string as a JSON string literal
+void writeJSONString(std::ostream &out, const char *str) {
+  out << '"';
+  for (; *str != '\0'; ++str) {
+    const auto c = static_cast<unsigned char>(*str);
+    if (c == '"' || c == '\\')
+      out << '\\' << *str;
+    else if (c < 0x20)
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << static_cast<int>(c) << std::dec << std::setfill(' ');
+    else
+      out << *str;
+  }
+  out << '"';
+}
+
+/// Write a time in ns as microseconds, the unit of the trace format
+void writeMicroseconds(std::ostream &out, const int64_t ns) {
+  out << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000
+      << std::setfill(' ');
+}
+
+/// Write a per-span quantity as a counter track, summed if cumulative
+void writeCounter(std::ostream &out, const char *name,
+                  std::vector<std::pair<int64_t, uint64_t>> values,
+                  const bool cumulative) {
+  std::sort(values.begin(), values.end());
+  uint64_t total = 0;
+  for (const auto &value : values) {
+    total = cumulative ? total + value.second : value.second;
+    out << ",\n{\"name\":";
+    writeJSONString(out, name);
+    out << ",\"ph\":\"C\",\"ts\":";
+    writeMicroseconds(out, value.first);
+    out << ",\"pid\":1,\"args\":{\"value\":" << total << "}}";
+  }
+}
+
+/// Write the spans of the given buffers as a Chrome trace
+void writeTrace(std::ostream &out,
+                const std::vector<std::shared_ptr<ThreadBuffer>> &buffers) {
+  std::vector<std::pair<int64_t, uint64_t>> bytes, events, memory;
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+      << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+      << "\"args\":{\"name\":\"Mantid\"}}";
+  for (const auto &buffer : buffers) {
+    const uint64_t numWritten = buffer->numWritten.load();
+    if (numWritten == 0)
+      continue;
+    const auto tid = buffer->threadIndex;
+    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+        << tid << ",\"args\":{\"name\":\"Thread " << tid << "\"}}";
+    const uint64_t first =
+        numWritten > BUFFER_CAPACITY ? numWritten - BUFFER_CAPACITY : 0;
+    for (uint64_t i = first; i < numWritten; ++i) {
+      const auto &record = buffer->records[i % BUFFER_CAPACITY];
+      out << ",\n{\"name\":";
+      writeJSONString(out, record.name);
+      out << ",\"cat\":\"" << categoryName(record.category)
+          << "\",\"ph\":\"X\",\"ts\":";
+      writeMicroseconds(out, record.begin);
+      out << ",\"dur\":";
+      writeMicroseconds(out, record.end - record.begin);
+      out << ",\"pid\":1,\"tid\":" << tid << ",\"args\":{";
+      const char *separator = "";
+      if (record.bytes > 0) {
+        out << "\"bytes\":" << record.bytes;
+        separator = ",";
+        bytes.emplace_back(record.end, record.bytes);
+      }
+      if (record.events > 0) {
+        out << separator << "\"events\":" << record.events;
+        separator = ",";
+        events.emplace_back(record.end, record.events);
+      }
+      if (record.peakMemory > 0) {
+        out << separator << "\"peak memory\":" << record.peakMemory;
+        memory.emplace_back(record.end, record.peakMemory);
+      }
+      out << "}}";
+    }
+  }
+  writeCounter(out, "bytes read", std::move(bytes), true);
+  writeCounter(out, "events processed", std::move(events), true);
+  writeCounter(out, "peak memory", std::move(memory), false);
+  out << "\n]}\n";
+}
+
+std::atomic<bool> tracingEnabled{false};
+
+/// The buffers of all threads that ever recorded a span
+class Registry {
+public:
+  Registry() : m_start(std::chrono::steady_clock::now()) {}
+  /// Writes the trace at exit unless Tracing::flush() already did
+  ~Registry() {
+    if (m_outputFile.empty() || m_flushed)
+      return;
+    std::ofstream out(m_outputFile);
+    writeTrace(out, m_buffers);
+  }
+
+  /// @return the time in ns since tracing started
+  int64_t now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - m_start)
+        .count();
+  }
+
+  std::shared_ptr<ThreadBuffer> addThread() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.emplace_back(std::make_shared<ThreadBuffer>(m_buffers.size()));
+    return m_buffers.back();
+  }
+
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_buffers;
+  }
+
+  void setOutputFile(const std::string &filename) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_outputFile = filename;
+    m_flushed = false;
+  }
+
+  std::string outputFile() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_outputFile;
+  }
+
+  void setFlushed() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_flushed = true;
+  }
+
+private:
+  const std::chrono::steady_clock::time_point m_start;
+  std::mutex m_mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+  std::string m_outputFile;
+  /// True once the trace was written to m_outputFile
+  bool m_flushed{false};
+};
+
+Registry &registry() {
+  static Registry instance;
+  return instance;
+}
+
+/// @return the buffer of the calling thread, registering it on first use
+ThreadBuffer &threadBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer = registry().addThread();
+  return *buffer;
+}
+
+/// @return the peak resident memory of the process in bytes
+uint64_t peakMemory() {
+  static const MemoryStats stats(MEMORY_STATS_IGNORE_SYSTEM);
+  return stats.getPeakRSS();
+}
+
+} // namespace
+
+/// @return true if spans are being recorded
+bool Tracing::enabled() {
+  return tracingEnabled.load(std::memory_order_relaxed);
+}
+
+/** Switch the recording of spans on or off
+ * @param enable :: true to record spans
+ */
+void Tracing::setEnabled(const bool enable) {
+  // Start the clock before the first span
+  registry();
+  tracingEnabled.store(enable);
+}
+
+/** Enable tracing and set the file that flush() writes the trace to
+ * @param filename :: path of the JSON file; empty to write no file
+ */
+void Tracing::setOutputFile(const std::string &filename) {
+  registry().setOutputFile(filename);
+  if (!filename.empty())
+    setEnabled(true);
+}
+
+/// @return the file that flush() writes the trace to, if any
+std::string Tracing::outputFile() { return registry().outputFile(); }
+
+/// Write the trace to the output file, if one was set. The file is then not
+/// written again at exit.
+void Tracing::flush() {
+  const auto filename = outputFile();
+  if (filename.empty())
+    return;
+  writeChromeTrace(filename);
+  registry().setFlushed();
+}
+
+/// Discard all recorded spans
+void Tracing::clear() {
+  for (const auto &buffer : registry().buffers())
+    buffer->numWritten.store(0);
+}
+
+/** Write all recorded spans in the Chrome trace event format
+ * @param out :: stream to write the JSON document to
+ */
+void Tracing::writeChromeTrace(std::ostream &out) {
+  writeTrace(out, registry().buffers());
+}
+
+/** Write all recorded spans in the Chrome trace event format
+ * @param filename :: path of the JSON file to write
+ * @throw std::runtime_error if the file cannot be written
+ */
+void Tracing::writeChromeTrace(const std::string &filename) {
+  std::ofstream out(filename);
+  if (!out)
+    throw std::runtime_error("Cannot open trace file " + filename);
+  writeChromeTrace(out);
+}
+
+//----------------------------------------------------------------------------
+/** Start a span
+ * @param category :: what the span measures
+ * @param name :: name of the span, truncated to 63 characters
+ */
+TraceSpan::TraceSpan(const Tracing::Category category, const char *name)
+    : m_category(category), m_begin(-1) {
+  if (!Tracing::enabled())
+    return;
+  std::strncpy(m_name, name, NAME_SIZE - 1);
+  m_name[NAME_SIZE - 1] = '\0';
+  m_begin = registry().now();
+}
+
+/** Start a span
+ * @param category :: what the span measures
+ * @param name :: name of the span, truncated to 63 characters
+ */
+TraceSpan::TraceSpan(const Tracing::Category category, const std::string &name)
+    : TraceSpan(category, name.c_str()) {}
+
+/// Ends the span, unless stop() was called
+TraceSpan::~TraceSpan() { stop(); }
+
+/// End the span and record it. Further calls do nothing.
+void TraceSpan::stop() {
+  if (m_begin < 0)
+    return;
+  auto &buffer = threadBuffer();
+  const uint64_t index = buffer.numWritten.load(std::memory_order_relaxed);
+  auto &record = buffer.records[index % BUFFER_CAPACITY];
+  record.begin = m_begin;
+  record.end = registry().now();
+  record.bytes = m_bytes;
+  record.events = m_events;
+  record.peakMemory = m_category == Tracing::Category::Algorithm ||
+                              m_category == Tracing::Category::ChildAlgorithm
+                          ? peakMemory()
+                          : 0;
+  record.category = m_category;
+  static_assert(sizeof(record.name) == NAME_SIZE, "Name sizes differ");
+  std::memcpy(record.name, m_name, NAME_SIZE);
+  buffer.numWritten.store(index + 1, std::memory_order_release);
+  m_begin = -1;
+}
+
+namespace {
+/// Enable tracing at start-up if MANTID_TRACE_FILE is set
+const bool tracingFromEnvironment = []() {
+  const char *filename = std::getenv("MANTID_TRACE_FILE");
+  if (filename && *filename != '\0')
+    Tracing::setOutputFile(filename);
+  return true;
+}();
+} // namespace
+
+} // namespace Kernel
+} // namespace Mantid
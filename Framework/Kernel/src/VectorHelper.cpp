@@ -239,28 +239,18 @@ void rebin(const std::vector<double> &xold, const std::vector<double> &yold,
   }
 }
 
-//-------------------------------------------------------------------------------------------------
-/** Rebins histogram data according to a new output X array. Should be faster
- *than previous one.
- *  @author Laurent Chapon 10/03/2009
- *
- *  @param[in] xold Old X array of data.
- *  @param[in] yold Old Y array of data. Must be 1 element shorter than xold.
- *  @param[in] eold Old error array of data. Must be same length as yold.
- *  @param[in] xnew X array of data to rebin to.
- *  @param[out] ynew Rebinned data. Must be 1 element shorter than xnew.
- *  @param[out] enew Rebinned errors. Must be same length as ynew.
- *  @param[in] addition If true, rebinned values are added to the existing
- *ynew/enew vectors.
- *                      NOTE THAT, IN THIS CASE THE RESULTING enew WILL BE THE
- *SQUARED ERRORS!
- *  @throw runtime_error Thrown if vector sizes are inconsistent
+namespace {
+/** Rebins histogram data taking either errors or variances, see
+ *rebinHistogram and rebinHistogramVariances.
+ *  @param[in] eoldIsVariance If true eold holds variances and enew receives
+ *variances, otherwise eold holds errors.
  **/
-void rebinHistogram(const std::vector<double> &xold,
-                    const std::vector<double> &yold,
-                    const std::vector<double> &eold,
-                    const std::vector<double> &xnew, std::vector<double> &ynew,
-                    std::vector<double> &enew, bool addition) {
+void rebinHistogramImpl(const std::vector<double> &xold,
+                        const std::vector<double> &yold,
+                        const std::vector<double> &eold,
+                        const std::vector<double> &xnew,
+                        std::vector<double> &ynew, std::vector<double> &enew,
+                        const bool addition, const bool eoldIsVariance) {
   // Make sure y and e vectors are of correct sizes
   const size_t size_yold = yold.size();
   if (xold.size() != (size_yold + 1) || size_yold != eold.size())
@@ -298,7 +288,7 @@ void rebinHistogram(const std::vector<double> &xold,
 
   double frac, fracE;
   double oneOverWidth, overlap;
-  double temp;
+  double variance;
 
   // loop over old vector from starting point calculated above
   for (; iold < size_yold; ++iold) {
@@ -306,8 +296,8 @@ void rebinHistogram(const std::vector<double> &xold,
     // If current old bin is fully enclosed by new bin, just unload the counts
     if (xold_of_iold_p_1 <= xnew[inew + 1]) {
       ynew[inew] += yold[iold];
-      temp = eold[iold];
-      enew[inew] += temp * temp;
+      variance = eoldIsVariance ? eold[iold] : eold[iold] * eold[iold];
+      enew[inew] += variance;
       // If the upper bin boundaries were equal, then increment inew
       if (xold_of_iold_p_1 == xnew[inew + 1])
         inew++;
@@ -317,8 +307,8 @@ void rebinHistogram(const std::vector<double> &xold,
       oneOverWidth = 1. / (xold_of_iold_p_1 -
                            xold_of_iold); // cache 1/width to speed things up
       frac = yold[iold] * oneOverWidth;
-      temp = eold[iold];
-      fracE = temp * temp * oneOverWidth;
+      variance = eoldIsVariance ? eold[iold] : eold[iold] * eold[iold];
+      fracE = variance * oneOverWidth;
 
       // Now loop over bins in new vector overlapping with current 'old' bin
       while (inew < size_ynew && xnew[inew + 1] <= xold_of_iold_p_1) {
@@ -339,15 +329,66 @@ void rebinHistogram(const std::vector<double> &xold,
     }
   } // loop over old bins
 
-  if (!addition) // If this used to add at the same time then not necessary
-                 // (should be done externally)
-  {
+  // If this used to add at the same time then not necessary (should be done
+  // externally)
+  if (!addition && !eoldIsVariance) {
     // Now take the root-square of the errors
     using pf = double (*)(double);
     pf uf = std::sqrt;
     std::transform(enew.begin(), enew.end(), enew.begin(), uf);
   }
 }
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+/** Rebins histogram data according to a new output X array. Should be faster
+ *than previous one.
+ *  @author Laurent Chapon 10/03/2009
+ *
+ *  @param[in] xold Old X array of data.
+ *  @param[in] yold Old Y array of data. Must be 1 element shorter than xold.
+ *  @param[in] eold Old error array of data. Must be same length as yold.
+ *  @param[in] xnew X array of data to rebin to.
+ *  @param[out] ynew Rebinned data. Must be 1 element shorter than xnew.
+ *  @param[out] enew Rebinned errors. Must be same length as ynew.
+ *  @param[in] addition If true, rebinned values are added to the existing
+ *ynew/enew vectors.
+ *                      NOTE THAT, IN THIS CASE THE RESULTING enew WILL BE THE
+ *SQUARED ERRORS!
+ *  @throw runtime_error Thrown if vector sizes are inconsistent
+ **/
+void rebinHistogram(const std::vector<double> &xold,
+                    const std::vector<double> &yold,
+                    const std::vector<double> &eold,
+                    const std::vector<double> &xnew, std::vector<double> &ynew,
+                    std::vector<double> &enew, bool addition) {
+  rebinHistogramImpl(xold, yold, eold, xnew, ynew, enew, addition, false);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Rebins histogram data with variances rather than errors according to a new
+ *output X array. Unlike rebinHistogram, the variances of several spectra can be
+ *summed before rebinning them in a single pass, and the result is always
+ *variances.
+ *
+ *  @param[in] xold Old X array of data.
+ *  @param[in] yold Old Y array of data. Must be 1 element shorter than xold.
+ *  @param[in] vold Old variance array of data. Must be same length as yold.
+ *  @param[in] xnew X array of data to rebin to.
+ *  @param[out] ynew Rebinned data. Must be 1 element shorter than xnew.
+ *  @param[out] vnew Rebinned variances. Must be same length as ynew.
+ *  @param[in] addition If true, rebinned values are added to the existing
+ *ynew/vnew vectors.
+ *  @throw runtime_error Thrown if vector sizes are inconsistent
+ **/
+void rebinHistogramVariances(const std::vector<double> &xold,
+                             const std::vector<double> &yold,
+                             const std::vector<double> &vold,
+                             const std::vector<double> &xnew,
+                             std::vector<double> &ynew,
+                             std::vector<double> &vnew, bool addition) {
+  rebinHistogramImpl(xold, yold, vold, xnew, ynew, vnew, addition, true);
+}
 
 //-------------------------------------------------------------------------------------------------
 /**
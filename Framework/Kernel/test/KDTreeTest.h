@@ -0,0 +1,161 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/KDTree.h"
+#include "MantidKernel/V3D.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <random>
+
+using Mantid::Kernel::KDTree;
+using Mantid::Kernel::V3D;
+
+namespace {
+std::vector<KDTree<3>::Point> randomPoints(const size_t n,
+                                           const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  std::vector<KDTree<3>::Point> points(n);
+  for (auto &point : points) {
+    for (auto &coordinate : point) {
+      coordinate = distribution(generator);
+    }
+  }
+  return points;
+}
+
+std::vector<double> sortedDistancesSq(const std::vector<KDTree<3>::Point> &pts,
+                                      const KDTree<3>::Point &pos) {
+  std::vector<double> distances;
+  for (const auto &point : pts) {
+    double sum = 0.;
+    for (size_t d = 0; d < 3; ++d) {
+      sum += (point[d] - pos[d]) * (point[d] - pos[d]);
+    }
+    distances.emplace_back(sum);
+  }
+  std::sort(distances.begin(), distances.end());
+  return distances;
+}
+} // namespace
+
+class KDTreeTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static KDTreeTest *createSuite() { return new KDTreeTest(); }
+  static void destroySuite(KDTreeTest *suite) { delete suite; }
+
+  void test_construct_without_points_throws() {
+    std::vector<KDTree<3>::Point> points;
+    TS_ASSERT_THROWS(KDTree<3> tree(points), const std::invalid_argument &)
+  }
+
+  void test_construct_from_V3D() {
+    std::vector<V3D> points{{0., 0., 0.}, {1., 0., 0.}, {0., 2., 0.}};
+    KDTree<3> tree(points);
+    TS_ASSERT_EQUALS(tree.size(), 3)
+    const auto nearest = tree.nearest({{0.9, 0., 0.}}, 1);
+    TS_ASSERT_EQUALS(nearest.size(), 1)
+    TS_ASSERT_EQUALS(nearest[0].index, 1)
+    TS_ASSERT_DELTA(nearest[0].distanceSq, 0.01, 1e-12)
+  }
+
+  void test_nearest_includes_coincident_point() {
+    std::vector<KDTree<2>::Point> points{{{1., 1.}}, {{2., 2.}}, {{2., 3.}}};
+    KDTree<2> tree(points);
+    const auto nearest = tree.nearest({{2., 2.}}, 2);
+    TS_ASSERT_EQUALS(nearest.size(), 2)
+    TS_ASSERT_EQUALS(nearest[0].index, 1)
+    TS_ASSERT_EQUALS(nearest[0].distanceSq, 0.)
+    TS_ASSERT_EQUALS(nearest[1].index, 2)
+    TS_ASSERT_EQUALS(nearest[1].distanceSq, 1.)
+  }
+
+  void test_nearest_with_more_neighbours_than_points() {
+    std::vector<KDTree<2>::Point> points{{{1., 1.}}, {{2., 2.}}};
+    KDTree<2> tree(points);
+    TS_ASSERT_EQUALS(tree.nearest({{0., 0.}}, 5).size(), 2)
+    TS_ASSERT(tree.nearest({{0., 0.}}, 0).empty())
+  }
+
+  void test_nearest_matches_brute_force() {
+    const auto points = randomPoints(20000, 7);
+    KDTree<3> tree(points);
+    const auto queries = randomPoints(100, 11);
+    for (const auto &query : queries) {
+      const auto expected = sortedDistancesSq(points, query);
+      const auto nearest = tree.nearest(query, 10);
+      TS_ASSERT_EQUALS(nearest.size(), 10)
+      for (size_t i = 0; i < nearest.size(); ++i) {
+        TS_ASSERT_EQUALS(nearest[i].distanceSq, expected[i])
+      }
+    }
+  }
+
+  void test_withinRadius_matches_brute_force() {
+    const auto points = randomPoints(20000, 13);
+    KDTree<3> tree(points);
+    const auto queries = randomPoints(100, 17);
+    const double radius = 0.2;
+    for (const auto &query : queries) {
+      const auto expected = sortedDistancesSq(points, query);
+      const auto count = std::upper_bound(expected.cbegin(), expected.cend(),
+                                          radius * radius) -
+                         expected.cbegin();
+      const auto found = tree.withinRadius(query, radius);
+      TS_ASSERT_EQUALS(found.size(), static_cast<size_t>(count))
+      TS_ASSERT(std::is_sorted(
+          found.cbegin(), found.cend(), [](const auto &a, const auto &b) {
+            return a.distanceSq < b.distanceSq;
+          }))
+    }
+  }
+
+  void test_batched_queries_match_single_queries() {
+    const auto points = randomPoints(5000, 19);
+    KDTree<3> tree(points);
+    const auto queries = randomPoints(50, 23);
+    const auto nearest = tree.batchNearest(queries, 4);
+    const auto within = tree.batchWithinRadius(queries, 0.1);
+    TS_ASSERT_EQUALS(nearest.size(), queries.size())
+    TS_ASSERT_EQUALS(within.size(), queries.size())
+    for (size_t i = 0; i < queries.size(); ++i) {
+      const auto single = tree.nearest(queries[i], 4);
+      TS_ASSERT_EQUALS(nearest[i].size(), single.size())
+      for (size_t j = 0; j < single.size(); ++j) {
+        TS_ASSERT_EQUALS(nearest[i][j].index, single[j].index)
+      }
+      TS_ASSERT_EQUALS(within[i].size(),
+                       tree.withinRadius(queries[i], 0.1).size())
+    }
+  }
+};
+
+class KDTreeTestPerformance : public CxxTest::TestSuite {
+public:
+  static KDTreeTestPerformance *createSuite() {
+    return new KDTreeTestPerformance();
+  }
+  static void destroySuite(KDTreeTestPerformance *suite) { delete suite; }
+
+  KDTreeTestPerformance() : m_points(randomPoints(1000000, 29)) {}
+
+  void test_build() { KDTree<3> tree(m_points); }
+
+  void test_nearest_all_points() {
+    KDTree<3> tree(m_points);
+    const auto neighbours = tree.batchNearest(m_points, 9);
+    TS_ASSERT_EQUALS(neighbours.size(), m_points.size())
+  }
+
+private:
+  std::vector<KDTree<3>::Point> m_points;
+};
@@ -0,0 +1,144 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/ParallelFor.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+using namespace Mantid::Kernel;
+
+class ParallelForTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ParallelForTest *createSuite() { return new ParallelForTest(); }
+  static void destroySuite(ParallelForTest *suite) { delete suite; }
+
+  void tearDown() override { setParallelThreadBudget(0); }
+
+  void test_thread_budget() {
+    TS_ASSERT_LESS_THAN_EQUALS(1, parallelThreadBudget());
+    setParallelThreadBudget(3);
+    TS_ASSERT_EQUALS(parallelThreadBudget(), 3);
+    TS_ASSERT_EQUALS(parallelThreadCount(), 3);
+  }
+
+  void test_thread_count_is_one_in_task_scope() {
+    setParallelThreadBudget(4);
+    {
+      ParallelTaskScope scope;
+      TS_ASSERT_EQUALS(parallelThreadCount(), 1);
+      {
+        ParallelTaskScope nested;
+        TS_ASSERT_EQUALS(parallelThreadCount(), 1);
+      }
+      TS_ASSERT_EQUALS(parallelThreadCount(), 1);
+    }
+    TS_ASSERT_EQUALS(parallelThreadCount(), 4);
+  }
+
+  void test_parallelFor_visits_every_index_once() {
+    setParallelThreadBudget(4);
+    for (const size_t grainSize : {0, 1, 7}) {
+      std::vector<int> visits(1000, 0);
+      parallelFor(10, visits.size(), [&](const size_t i) { ++visits[i]; },
+                  grainSize);
+      const auto firstVisited = visits.cbegin() + 10;
+      TS_ASSERT_EQUALS(std::accumulate(visits.cbegin(), firstVisited, 0), 0);
+      TS_ASSERT_EQUALS(std::count(firstVisited, visits.cend(), 1), 990);
+    }
+  }
+
+  void test_parallelFor_empty_range() {
+    int calls = 0;
+    parallelFor(5, 5, [&](const size_t) { ++calls; });
+    parallelFor(5, 2, [&](const size_t) { ++calls; });
+    TS_ASSERT_EQUALS(calls, 0);
+  }
+
+  void test_parallelFor_rethrows_exception() {
+    setParallelThreadBudget(4);
+    TS_ASSERT_THROWS(parallelFor(0, 100,
+                                 [](const size_t i) {
+                                   if (i == 42)
+                                     throw std::runtime_error("42");
+                                 }),
+                     const std::runtime_error &);
+  }
+
+  void test_nested_parallelFor_runs() {
+    setParallelThreadBudget(4);
+    std::vector<int> visits(100, 0);
+    parallelFor(0, 10, [&](const size_t i) {
+      parallelFor(0, 10, [&](const size_t j) { ++visits[i * 10 + j]; });
+    });
+    TS_ASSERT_EQUALS(std::count(visits.cbegin(), visits.cend(), 1), 100);
+  }
+
+  void test_parallelForWeighted_visits_every_index_once() {
+    setParallelThreadBudget(4);
+    std::vector<size_t> costs(500, 1);
+    costs[3] = 100000;
+    costs[250] = 5000;
+    std::vector<int> visits(costs.size(), 0);
+    parallelForWeighted(costs, [&](const size_t i) { ++visits[i]; });
+    TS_ASSERT_EQUALS(std::count(visits.cbegin(), visits.cend(), 1), 500);
+
+    std::vector<double> zeroCosts(50, 0.);
+    std::vector<int> zeroVisits(zeroCosts.size(), 0);
+    parallelForWeighted(zeroCosts, [&](const size_t i) { ++zeroVisits[i]; });
+    TS_ASSERT_EQUALS(std::count(zeroVisits.cbegin(), zeroVisits.cend(), 1),
+                     50);
+  }
+
+  void test_weightedChunks() {
+    const std::vector<int> costs{1, 1, 8, 1, 1, 1, 1, 2};
+    const auto chunks = ParallelDetail::weightedChunks(costs, 4);
+    // The expensive index fills the first chunk on its own
+    TS_ASSERT_EQUALS(chunks.size(), 3);
+    TS_ASSERT_EQUALS(chunks[0].begin, 0);
+    TS_ASSERT_EQUALS(chunks[0].end, 3);
+    TS_ASSERT_EQUALS(chunks[0].cost, 10.);
+    TS_ASSERT_EQUALS(chunks[1].begin, 3);
+    TS_ASSERT_EQUALS(chunks[1].end, 7);
+    TS_ASSERT_EQUALS(chunks[1].cost, 4.);
+    TS_ASSERT_EQUALS(chunks[2].begin, 7);
+    TS_ASSERT_EQUALS(chunks[2].end, 8);
+  }
+
+  void test_parallelReduce() {
+    setParallelThreadBudget(4);
+    const auto sum = parallelReduce(
+        size_t(1), size_t(100001), size_t(0), [](const size_t i) { return i; },
+        [](const size_t a, const size_t b) { return a + b; });
+    TS_ASSERT_EQUALS(sum, 5000050000);
+    TS_ASSERT_EQUALS(parallelReduce(
+                         3, 3, 7, [](const size_t) { return 1; },
+                         [](const int a, const int b) { return a + b; }),
+                     7);
+  }
+
+  void test_parallelReduce_does_not_depend_on_thread_count() {
+    std::vector<double> values(100000);
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = 1. / static_cast<double>(i + 1);
+    const auto sum = [&values]() {
+      return parallelReduce(
+          0, values.size(), 0., [&values](const size_t i) { return values[i]; },
+          [](const double a, const double b) { return a + b; });
+    };
+    setParallelThreadBudget(1);
+    const double serial = sum();
+    setParallelThreadBudget(3);
+    TS_ASSERT_EQUALS(sum(), serial);
+  }
+};
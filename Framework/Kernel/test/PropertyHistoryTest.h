@@ -6,12 +6,14 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/EmptyValues.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/PropertyHistory.h"
 
 #include <boost/lexical_cast.hpp>
 #include <cxxtest/TestSuite.h>
+#include <numeric>
 #include <sstream>
 
 using namespace Mantid::Kernel;
@@ -49,6 +51,35 @@ public:
     TS_ASSERT_EQUALS(output.str(), correctOutput);
   }
 
+  void testLazyValueIsGeneratedOnceOnFirstUse() {
+    int calls = 0;
+    PropertyHistory lazy(
+        "arg", [&calls]() { return std::to_string(++calls); }, "number",
+        false, Direction::Input);
+    TS_ASSERT_EQUALS(calls, 0);
+    const PropertyHistory copy(lazy);
+    TS_ASSERT_EQUALS(lazy.value(), "1");
+    TS_ASSERT_EQUALS(copy.value(), "1");
+    TS_ASSERT_EQUALS(calls, 1);
+
+    lazy.setValue("5");
+    TS_ASSERT_EQUALS(lazy.value(), "5");
+    TS_ASSERT_EQUALS(copy.value(), "1");
+  }
+
+  void testHistoryOfLongArrayProperty() {
+    std::vector<int> values(2000);
+    std::iota(values.begin(), values.end(), 0);
+    ArrayProperty<int> prop("Indices", values);
+    const auto history = prop.createHistory();
+    // Changing the property does not change its history
+    prop = std::vector<int>{1};
+    TS_ASSERT_EQUALS(history.name(), "Indices");
+    TS_ASSERT_EQUALS(history.value(), "0-1999");
+    TS_ASSERT_EQUALS(history.isDefault(), false);
+    TS_ASSERT_EQUALS(history.direction(), Direction::Input);
+  }
+
   /**
    * Test the isEmptyDefault method returns true for unset default-value
    * properties
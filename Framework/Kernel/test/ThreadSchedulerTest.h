@@ -12,6 +12,7 @@
 
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 
 using namespace Mantid::Kernel;
 
@@ -63,6 +64,10 @@ public:
     do_basic_test(std::make_unique<ThreadSchedulerLargestCost>());
   }
 
+  void test_basic_ThreadSchedulerWorkStealing() {
+    do_basic_test(std::make_unique<ThreadSchedulerWorkStealing>());
+  }
+
   //==================================================================================================
 
   void do_test(ThreadScheduler *sc, double *costs, size_t *poppedIndices) {
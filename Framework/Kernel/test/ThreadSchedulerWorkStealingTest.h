@@ -0,0 +1,122 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Mantid::Kernel;
+
+namespace {
+std::atomic<int> ThreadSchedulerWorkStealingTest_numDestructed{0};
+
+class TaskWithCost : public Task {
+public:
+  explicit TaskWithCost(double cost) : Task(cost) {}
+  ~TaskWithCost() override { ThreadSchedulerWorkStealingTest_numDestructed++; }
+  void run() override {}
+};
+} // namespace
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  void test_constructor() {
+    ThreadSchedulerWorkStealing sc(3);
+    TS_ASSERT_EQUALS(sc.numQueues(), 3);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(sc.pop(0), nullptr);
+    TS_ASSERT_LESS_THAN(0, ThreadSchedulerWorkStealing().numQueues());
+  }
+
+  void test_push_and_clear() {
+    ThreadSchedulerWorkStealing sc(2);
+    sc.push(std::make_shared<TaskWithCost>(2.));
+    sc.push(std::make_shared<TaskWithCost>(3.));
+    sc.push(std::make_shared<TaskWithCost>(4.));
+    TS_ASSERT_EQUALS(sc.size(), 3);
+    TS_ASSERT(!sc.empty());
+    TS_ASSERT_DELTA(sc.totalCost(), 9., 1e-12);
+
+    ThreadSchedulerWorkStealingTest_numDestructed = 0;
+    sc.clear();
+    TS_ASSERT_EQUALS(sc.size(), 0);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(sc.totalCost(), 0.);
+    TS_ASSERT_EQUALS(ThreadSchedulerWorkStealingTest_numDestructed.load(), 3);
+  }
+
+  void test_pop_takes_newest_task_of_own_queue_then_steals_oldest() {
+    ThreadSchedulerWorkStealing sc(3);
+    // Tasks pushed from outside go to the queue with the least queued cost:
+    // queue 0 gets a, queue 1 gets b and d, queue 2 gets c and e
+    std::vector<std::shared_ptr<Task>> tasks;
+    for (const double cost : {5., 1., 1., 1., 3.}) {
+      tasks.emplace_back(std::make_shared<TaskWithCost>(cost));
+      sc.push(tasks.back());
+    }
+    TS_ASSERT_EQUALS(sc.pop(1), tasks[3]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[0]);
+    // Queue 0 is empty now: steal the oldest task of queue 2, the most costly
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[2]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[4]);
+    TS_ASSERT_EQUALS(sc.pop(2), tasks[1]);
+    TS_ASSERT_EQUALS(sc.pop(2), nullptr);
+    TS_ASSERT(sc.empty());
+  }
+
+  void test_task_pushed_by_a_thread_of_the_scheduler_goes_to_its_queue() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto first = std::make_shared<TaskWithCost>(1.);
+    sc.push(first);
+    std::shared_ptr<Task> popped, subtask;
+    std::thread worker([&]() {
+      popped = sc.pop(1);
+      // As if pushed by the task that was just popped
+      subtask = std::make_shared<TaskWithCost>(100.);
+      sc.push(subtask);
+    });
+    worker.join();
+    TS_ASSERT_EQUALS(popped, first);
+    // The subtask is in queue 1, so queue 0 has to steal it
+    TS_ASSERT_EQUALS(sc.size(), 1);
+    std::thread thief([&]() { popped = sc.pop(0); });
+    thief.join();
+    TS_ASSERT_EQUALS(popped, subtask);
+  }
+
+  void test_concurrent_push_and_pop() {
+    const size_t numThreads = 4;
+    const size_t tasksPerThread = 20000;
+    ThreadSchedulerWorkStealing sc(numThreads);
+    for (size_t i = 0; i < numThreads * tasksPerThread / 2; ++i)
+      sc.push(std::make_shared<TaskWithCost>(static_cast<double>(i % 7)));
+
+    std::atomic<size_t> numPopped{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&sc, &numPopped, t, tasksPerThread]() {
+        // Every thread also pushes half of its share while popping
+        for (size_t i = 0; i < tasksPerThread / 2; ++i) {
+          sc.push(std::make_shared<TaskWithCost>(1.));
+          if (sc.pop(t))
+            ++numPopped;
+        }
+        while (sc.pop(t))
+          ++numPopped;
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    TS_ASSERT_EQUALS(numPopped.load(), numThreads * tasksPerThread);
+    TS_ASSERT(sc.empty());
+  }
+};
@@ -18,6 +18,7 @@
 #include <boost/shared_ptr.hpp>
 #include <cmath>
 #include <json/value.h>
+#include <memory>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -701,6 +702,51 @@ public:
     delete intLog;
   }
 
+  void test_averageAndStdDevInFilter_unsorted_with_duplicate_times() {
+    TimeSeriesProperty<double> log("DoubleLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    log.addValue(start + 20.0, 2.0);
+    log.addValue(start, 1.0);
+    log.addValue(start + 10.0, 3.0);
+    log.addValue(start + 10.0, 5.0);
+
+    // 1 in [5, 10), 5 in [10, 20) and 2 in [20, 25]
+    TimeSplitterType filter{SplittingInterval(start + 5.0, start + 25.0)};
+    const auto meanAndStdDev = log.averageAndStdDevInFilter(filter);
+    TS_ASSERT_DELTA(meanAndStdDev.first, 3.25, 1e-12);
+    TS_ASSERT_DELTA(meanAndStdDev.second, std::sqrt(3.1875), 1e-12);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 3.25, 1e-12);
+  }
+
+  void test_averageValueInFilter_updated_after_addValue() {
+    TimeSeriesProperty<double> log("DoubleLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    log.addValue(start, 1.0);
+    log.addValue(start + 10.0, 3.0);
+    TimeSplitterType filter{SplittingInterval(start, start + 20.0)};
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 2.0, 1e-12);
+
+    log.addValue(start + 15.0, 5.0);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 2.5, 1e-12);
+  }
+
+  void test_copy_shares_values_until_modified() {
+    auto log = std::unique_ptr<TimeSeriesProperty<int>>(createIntegerTSP(5));
+    TimeSplitterType filter{SplittingInterval(log->firstTime(),
+                                              log->lastTime() + 10.0)};
+    const double average = log->averageValueInFilter(filter);
+
+    auto copy = std::unique_ptr<TimeSeriesProperty<int>>(log->clone());
+    TS_ASSERT_EQUALS(copy->averageValueInFilter(filter), average);
+    copy->addValue(log->lastTime() + 5.0, 100);
+    TS_ASSERT_EQUALS(copy->realSize(), 6);
+    TS_ASSERT(copy->averageValueInFilter(filter) > average);
+
+    TS_ASSERT_EQUALS(log->realSize(), 5);
+    TS_ASSERT_EQUALS(log->lastValue(), 5);
+    TS_ASSERT_EQUALS(log->averageValueInFilter(filter), average);
+  }
+
   void test_averageValueInFilter_throws_for_string_property() {
     TimeSplitterType splitter;
     TS_ASSERT_THROWS(sProp->averageValueInFilter(splitter),
@@ -15,8 +15,10 @@
 
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/TimeSplitter.h"
+#include <algorithm>
 #include <ctime>
 #include <cxxtest/TestSuite.h>
+#include <set>
 
 using namespace Mantid::Kernel;
 using Mantid::Types::Core::DateAndTime;
@@ -544,4 +546,168 @@ public:
     int index2 = int(sit - b.begin());
     TS_ASSERT_EQUALS(index2, 2);
   }
+
+  //----------------------------------------------------------------------------
+  void test_AND_sorted_matches_all_pairs() {
+    // Touching and nested intervals exercise the edges of the sorted search
+    TimeSplitterType a, b;
+    for (int64_t i = 0; i < 50; ++i) {
+      a.emplace_back(DateAndTime(i * 70), DateAndTime(i * 70 + 45),
+                     static_cast<int>(i % 3));
+      b.emplace_back(DateAndTime(i * 40), DateAndTime(i * 40 + 40), 0);
+    }
+    a.emplace_back(DateAndTime(100), DateAndTime(3000), 7);
+
+    TimeSplitterType expected;
+    for (const auto &ai : a)
+      for (const auto &bi : b)
+        if (ai.overlaps(bi))
+          expected.emplace_back(ai & bi);
+
+    const auto c = a & b;
+    TS_ASSERT_EQUALS(c.size(), expected.size());
+    for (size_t i = 0; i < std::min(c.size(), expected.size()); ++i) {
+      TS_ASSERT_EQUALS(c[i].start(), expected[i].start());
+      TS_ASSERT_EQUALS(c[i].stop(), expected[i].stop());
+      TS_ASSERT_EQUALS(c[i].index(), expected[i].index());
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void test_TimeSplitter_valueAtTime() {
+    TimeSplitterType intervals;
+    intervals.emplace_back(DateAndTime(300), DateAndTime(400), 2);
+    intervals.emplace_back(DateAndTime(100), DateAndTime(200), 1);
+    intervals.emplace_back(DateAndTime(200), DateAndTime(250), 1);
+    TimeSplitter splitter(intervals);
+
+    TS_ASSERT(!splitter.empty());
+    TS_ASSERT_EQUALS(splitter.valueAtTime(int64_t(99)),
+                     TimeSplitter::NO_TARGET);
+    TS_ASSERT_EQUALS(splitter.valueAtTime(int64_t(100)), 1);
+    TS_ASSERT_EQUALS(splitter.valueAtTime(int64_t(249)), 1);
+    TS_ASSERT_EQUALS(splitter.valueAtTime(int64_t(250)),
+                     TimeSplitter::NO_TARGET);
+    TS_ASSERT_EQUALS(splitter.valueAtTime(DateAndTime(300)), 2);
+    TS_ASSERT_EQUALS(splitter.valueAtTime(int64_t(400)),
+                     TimeSplitter::NO_TARGET);
+    TS_ASSERT_EQUALS(splitter.outputIndices(), std::set<int>({1, 2}));
+
+    // The adjacent intervals with the same destination are merged
+    const auto merged = splitter.intervals();
+    TS_ASSERT_EQUALS(merged.size(), 2);
+    TS_ASSERT_EQUALS(merged[0].start(), DateAndTime(100));
+    TS_ASSERT_EQUALS(merged[0].stop(), DateAndTime(250));
+    TS_ASSERT_EQUALS(merged[1].index(), 2);
+    TS_ASSERT_EQUALS(TimeSplitter(merged), splitter);
+  }
+
+  //----------------------------------------------------------------------------
+  void test_TimeSplitter_overlap_is_kept_by_earlier_interval() {
+    TimeSplitterType intervals;
+    intervals.emplace_back(DateAndTime(100), DateAndTime(300), 1);
+    intervals.emplace_back(DateAndTime(200), DateAndTime(400), 2);
+    intervals.emplace_back(DateAndTime(250), DateAndTime(350), 3);
+    intervals.emplace_back(DateAndTime(500), DateAndTime(500), 4);
+    TimeSplitter splitter(intervals);
+
+    TS_ASSERT_EQUALS(splitter.toString(), "100:1,300:2,400:-1");
+    TS_ASSERT(TimeSplitter(TimeSplitterType()).empty());
+  }
+
+  //----------------------------------------------------------------------------
+  void test_TimeSplitter_coverage_includes_trailing_NO_TARGET_interval() {
+    TimeSplitterType intervals;
+    intervals.emplace_back(DateAndTime(100), DateAndTime(200), 1);
+    intervals.emplace_back(DateAndTime(200), DateAndTime(300),
+                           TimeSplitter::NO_TARGET);
+    TimeSplitter splitter(intervals);
+
+    TS_ASSERT(splitter.hasCoverage());
+    TS_ASSERT_EQUALS(splitter.coverageEnd(), 300);
+    TS_ASSERT_EQUALS(splitter.boundaries().back(), 200);
+    TS_ASSERT_EQUALS(splitter.toString(), "100:1,200:-1,300:-1");
+    TS_ASSERT_EQUALS(TimeSplitter::fromString(splitter.toString()), splitter);
+    TS_ASSERT(!TimeSplitter().hasCoverage());
+    TS_ASSERT(!TimeSplitter::fromString("").hasCoverage());
+  }
+
+  //----------------------------------------------------------------------------
+  void test_TimeSplitter_union_and_intersection() {
+    TimeSplitterType intervals;
+    intervals.emplace_back(DateAndTime(100), DateAndTime(200), 0);
+    intervals.emplace_back(DateAndTime(200), DateAndTime(300), 1);
+    TimeSplitter splitter(intervals);
+    TimeSplitter filter(DateAndTime(150), DateAndTime(250));
+    TimeSplitter other(DateAndTime(50), DateAndTime(400), 5);
+
+    TS_ASSERT_EQUALS((splitter & filter).toString(), "150:0,200:1,250:-1");
+    TS_ASSERT_EQUALS((splitter | other).toString(),
+                     "50:5,100:0,200:1,300:5,400:-1");
+    TS_ASSERT_EQUALS((other | splitter), other);
+    TS_ASSERT((splitter & TimeSplitter()).empty());
+    TS_ASSERT_EQUALS((splitter | TimeSplitter()), splitter);
+  }
+
+  //----------------------------------------------------------------------------
+  void test_TimeSplitter_fromString() {
+    const auto splitter = TimeSplitter::fromString("-10:3,20:-1,30:4,40:-1");
+    TS_ASSERT_EQUALS(splitter.valueAtTime(int64_t(-10)), 3);
+    TS_ASSERT_EQUALS(splitter.valueAtTime(int64_t(35)), 4);
+    TS_ASSERT_EQUALS(TimeSplitter::fromString(splitter.toString()), splitter);
+    TS_ASSERT(TimeSplitter::fromString("").empty());
+
+    TS_ASSERT_THROWS(TimeSplitter::fromString("10:1,5:-1"),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(TimeSplitter::fromString("10:1,20:2"),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(TimeSplitter::fromString("10;1,20:-1"),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(TimeSplitter::fromString("10:1x,20:-1"),
+                     const std::invalid_argument &);
+  }
+};
+
+class TimeSplitterTestPerformance : public CxxTest::TestSuite {
+public:
+  static TimeSplitterTestPerformance *createSuite() {
+    return new TimeSplitterTestPerformance();
+  }
+  static void destroySuite(TimeSplitterTestPerformance *suite) {
+    delete suite;
+  }
+
+  TimeSplitterTestPerformance() {
+    for (int64_t i = 0; i < 100000; ++i) {
+      m_splitter.emplace_back(DateAndTime(i * 1000),
+                              DateAndTime(i * 1000 + 600),
+                              static_cast<int>(i % 10));
+      m_filter.emplace_back(DateAndTime(i * 1000 + 300),
+                            DateAndTime(i * 1000 + 900), 0);
+    }
+  }
+
+  void test_AND() {
+    const auto out = m_splitter & m_filter;
+    TS_ASSERT_EQUALS(out.size(), m_splitter.size());
+  }
+
+  void test_TimeSplitter_build_and_find() {
+    TimeSplitter splitter(m_splitter);
+    int64_t found = 0;
+    for (int64_t time = 0; time < 100000000; time += 97) {
+      if (splitter.valueAtTime(time) != TimeSplitter::NO_TARGET)
+        ++found;
+    }
+    TS_ASSERT_LESS_THAN(0, found);
+  }
+
+  void test_TimeSplitter_intersection() {
+    const auto out = TimeSplitter(m_splitter) & TimeSplitter(m_filter);
+    TS_ASSERT_EQUALS(out.intervals().size(), m_splitter.size());
+  }
+
+private:
+  TimeSplitterType m_splitter;
+  TimeSplitterType m_filter;
 };
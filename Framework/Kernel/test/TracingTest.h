@@ -0,0 +1,180 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/Tracing.h"
+
+#include <cxxtest/TestSuite.h>
+#include <json/reader.h>
+#include <json/value.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using Mantid::Kernel::TraceSpan;
+using Mantid::Kernel::Tracing;
+
+namespace {
+Json::Value exportTrace() {
+  std::ostringstream out;
+  Tracing::writeChromeTrace(out);
+  Json::Value root;
+  Json::Reader reader;
+  TS_ASSERT(reader.parse(out.str(), root));
+  return root;
+}
+
+/// @return the events of the given phase, e.g. "X" for spans
+std::vector<Json::Value> eventsOfPhase(const Json::Value &root,
+                                       const std::string &phase) {
+  std::vector<Json::Value> events;
+  for (const auto &event : root["traceEvents"]) {
+    if (event["ph"].asString() == phase)
+      events.emplace_back(event);
+  }
+  return events;
+}
+} // namespace
+
+class TracingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TracingTest *createSuite() { return new TracingTest(); }
+  static void destroySuite(TracingTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_wasEnabled = Tracing::enabled();
+    Tracing::clear();
+  }
+
+  void tearDown() override {
+    Tracing::clear();
+    Tracing::setEnabled(m_wasEnabled);
+  }
+
+  void test_nothing_is_recorded_when_disabled() {
+    Tracing::setEnabled(false);
+    { TraceSpan span(Tracing::Category::Algorithm, "Disabled"); }
+    TS_ASSERT(eventsOfPhase(exportTrace(), "X").empty());
+  }
+
+  void test_span_is_exported() {
+    Tracing::setEnabled(true);
+    {
+      TraceSpan outer(Tracing::Category::Algorithm, std::string("Outer"));
+      TraceSpan inner(Tracing::Category::IO, "Load \"bank\"");
+      inner.addBytes(1024);
+      inner.addEvents(128);
+    }
+    const auto root = exportTrace();
+    const auto spans = eventsOfPhase(root, "X");
+    TS_ASSERT_EQUALS(spans.size(), 2);
+    // Spans are recorded as they end
+    const auto &inner = spans[0];
+    const auto &outer = spans[1];
+    TS_ASSERT_EQUALS(inner["name"].asString(), "Load \"bank\"");
+    TS_ASSERT_EQUALS(inner["cat"].asString(), "io");
+    TS_ASSERT_EQUALS(inner["args"]["bytes"].asUInt64(), 1024);
+    TS_ASSERT_EQUALS(inner["args"]["events"].asUInt64(), 128);
+    TS_ASSERT(!inner["args"].isMember("peak memory"));
+    TS_ASSERT_EQUALS(outer["name"].asString(), "Outer");
+    TS_ASSERT_EQUALS(outer["cat"].asString(), "algorithm");
+    TS_ASSERT(outer["args"].isMember("peak memory"));
+    TS_ASSERT_LESS_THAN_EQUALS(outer["ts"].asDouble(), inner["ts"].asDouble());
+    TS_ASSERT_LESS_THAN_EQUALS(inner["ts"].asDouble() + inner["dur"].asDouble(),
+                               outer["ts"].asDouble() + outer["dur"].asDouble());
+
+    const auto counters = eventsOfPhase(root, "C");
+    TS_ASSERT_EQUALS(counters.size(), 3);
+    TS_ASSERT_EQUALS(counters[0]["name"].asString(), "bytes read");
+    TS_ASSERT_EQUALS(counters[0]["args"]["value"].asUInt64(), 1024);
+  }
+
+  void test_stop_ends_span_once() {
+    Tracing::setEnabled(true);
+    {
+      TraceSpan span(Tracing::Category::Task, "Task");
+      span.stop();
+      span.stop();
+    }
+    TS_ASSERT_EQUALS(eventsOfPhase(exportTrace(), "X").size(), 1);
+  }
+
+  void test_long_name_is_truncated() {
+    Tracing::setEnabled(true);
+    { TraceSpan span(Tracing::Category::Task, std::string(100, 'a')); }
+    const auto spans = eventsOfPhase(exportTrace(), "X");
+    TS_ASSERT_EQUALS(spans.size(), 1);
+    TS_ASSERT_EQUALS(spans[0]["name"].asString(), std::string(63, 'a'));
+  }
+
+  void test_threads_record_into_their_own_buffers() {
+    Tracing::setEnabled(true);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([]() {
+        for (int i = 0; i < 100; ++i) {
+          TraceSpan span(Tracing::Category::Task, "Task");
+          span.addEvents(1);
+        }
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    const auto root = exportTrace();
+    TS_ASSERT_EQUALS(eventsOfPhase(root, "X").size(), 400);
+    const auto counters = eventsOfPhase(root, "C");
+    TS_ASSERT_EQUALS(counters.size(), 400);
+    TS_ASSERT_EQUALS(counters.back()["args"]["value"].asUInt64(), 400);
+  }
+
+  void test_ring_buffer_keeps_newest_spans() {
+    Tracing::setEnabled(true);
+    const size_t numSpans = 20000;
+    for (size_t i = 0; i < numSpans; ++i) {
+      TraceSpan span(Tracing::Category::Task, std::to_string(i));
+    }
+    const auto spans = eventsOfPhase(exportTrace(), "X");
+    TS_ASSERT_LESS_THAN(spans.size(), numSpans);
+    TS_ASSERT_EQUALS(spans.back()["name"].asString(),
+                     std::to_string(numSpans - 1));
+    TS_ASSERT_EQUALS(spans.front()["name"].asString(),
+                     std::to_string(numSpans - spans.size()));
+  }
+
+private:
+  bool m_wasEnabled = false;
+};
+
+class TracingTestPerformance : public CxxTest::TestSuite {
+public:
+  static TracingTestPerformance *createSuite() {
+    return new TracingTestPerformance();
+  }
+  static void destroySuite(TracingTestPerformance *suite) { delete suite; }
+
+  void tearDown() override {
+    Tracing::clear();
+    Tracing::setEnabled(false);
+  }
+
+  void test_disabled_spans() {
+    Tracing::setEnabled(false);
+    for (int i = 0; i < 10000000; ++i) {
+      TraceSpan span(Tracing::Category::Task, "Task");
+    }
+  }
+
+  void test_enabled_spans() {
+    Tracing::setEnabled(true);
+    for (int i = 0; i < 1000000; ++i) {
+      TraceSpan span(Tracing::Category::Task, "Task");
+    }
+  }
+};
@@ -387,6 +387,30 @@ public:
         index = VectorHelper::getBinIndex(m_test_bins, testValue));
     TS_ASSERT_EQUALS(index, 2);
   }
+  void test_rebinHistogramVariances_matches_rebinHistogram() {
+    const std::vector<double> xold{0, 1, 2, 3, 4}, yold{1, 2, 3, 4},
+        eold{1, 2, 3, 4}, vold{1, 4, 9, 16}, xnew{0, 0.5, 2.5, 4};
+    std::vector<double> yErrors(3), eErrors(3), yVariances(3), vVariances(3);
+    VectorHelper::rebinHistogram(xold, yold, eold, xnew, yErrors, eErrors,
+                                 false);
+    VectorHelper::rebinHistogramVariances(xold, yold, vold, xnew, yVariances,
+                                          vVariances, false);
+    for (size_t i = 0; i < yErrors.size(); ++i) {
+      TS_ASSERT_DELTA(yVariances[i], yErrors[i], 1e-12);
+      TS_ASSERT_DELTA(vVariances[i], eErrors[i] * eErrors[i], 1e-12);
+    }
+  }
+
+  void test_rebinHistogramVariances_adds_to_output() {
+    const std::vector<double> xold{0, 1, 2}, yold{1, 2}, vold{3, 4},
+        xnew{0, 2};
+    std::vector<double> ynew{10}, vnew{20};
+    VectorHelper::rebinHistogramVariances(xold, yold, vold, xnew, ynew, vnew,
+                                          true);
+    TS_ASSERT_DELTA(ynew[0], 13, 1e-12);
+    TS_ASSERT_DELTA(vnew[0], 27, 1e-12);
+  }
+
   void test_RunningAveraging() {
     double id[] = {1, 2, 3, 4, 5, 6};
     std::vector<double> inputData(id, id + sizeof(id) / sizeof(double));
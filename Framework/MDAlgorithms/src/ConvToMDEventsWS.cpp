@@ -9,6 +9,8 @@
 
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
 namespace Mantid {
 namespace MDAlgorithms {
 /**function converts particular list of events of type T into MD workspace and
@@ -146,7 +148,7 @@ void ConvToMDEventsWS::appendEventsFromInputWS(
   size_t lastNumBoxes = bc->getTotalNumMDBoxes();
   size_t nEventsInWS = m_OutWSWrapper->pWorkspace()->getNPoints();
   //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
+  Kernel::ThreadScheduler *ts(nullptr);
 
   int nThreads(m_NumThreads);
   if (nThreads < 0)
@@ -157,7 +159,7 @@ void ConvToMDEventsWS::appendEventsFromInputWS(
     runMultithreaded = true;
     // Create the thread pool that will run all of these. It will be deleted by
     // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
+    ts = new Kernel::ThreadSchedulerWorkStealing(nThreads);
     // it will initiate thread pool with number threads or machine's cores (0 in
     // tp constructor)
     pProgress->resetNumSteps(m_NSpectra, 0, 1);
@@ -240,6 +240,7 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
   //// Loop over the spectra
   uint32_t liveDetectorsCount(0);
   const auto &spectrumInfo = inputWS->spectrumInfo();
+  const auto &geometry = spectrumInfo.cachedGeometry();
   for (size_t i = 0; i < nHist; i++) {
     sp2detMap[i] = std::numeric_limits<uint64_t>::quiet_NaN();
     detId[i] = std::numeric_limits<int32_t>::quiet_NaN();
@@ -265,9 +266,9 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
     sp2detMap[i] = liveDetectorsCount;
     detId[liveDetectorsCount] = int32_t(spDet.getID());
     detIDMap[liveDetectorsCount] = i;
-    L2[liveDetectorsCount] = spectrumInfo.l2(i);
+    L2[liveDetectorsCount] = geometry.l2[i];
 
-    double polar = spectrumInfo.twoTheta(i);
+    double polar = geometry.twoTheta[i];
     double azim = spDet.getPhi();
     TwoTheta[liveDetectorsCount] = polar;
     Azimuthal[liveDetectorsCount] = azim;
@@ -26,6 +26,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/optional.hpp>
 #include <boost/regex.hpp>
+#include <cmath>
+#include <map>
 #include <numeric>
 #include <sstream>
 #include <tuple>
@@ -46,6 +48,23 @@ struct Face {
   Eigen::Vector3d v4;
 };
 
+/// Pixel topology and vertices rounded to SHAPE_RESOLUTION, identifying the
+/// pixels of a bank that can share a shape
+using ShapeKey = std::pair<std::vector<uint32_t>, std::vector<int64_t>>;
+using SharedShapes =
+    std::map<ShapeKey, boost::shared_ptr<const Geometry::IObject>>;
+constexpr double SHAPE_RESOLUTION = 1e-9; // m
+
+ShapeKey makeShapeKey(std::vector<uint32_t> topology,
+                      const std::vector<Eigen::Vector3d> &vertices) {
+  std::vector<int64_t> coordinates;
+  coordinates.reserve(3 * vertices.size());
+  for (const auto &vertex : vertices)
+    for (int i = 0; i < 3; ++i)
+      coordinates.emplace_back(std::llround(vertex[i] / SHAPE_RESOLUTION));
+  return {std::move(topology), std::move(coordinates)};
+}
+
 bool isDegrees(const H5std_string &units) {
   using boost::regex;
   // Nexus format inexact on acceptable rotation unit definitions
@@ -370,18 +389,15 @@ private:
     offsetData.resize(3, rowLength);
     offsetData.setZero(3, rowLength);
 
-    if (!xEmpty) {
-      for (int i = 0; i < rowLength; i++)
-        offsetData(0, i) = xValues[i];
-    }
-    if (!yEmpty) {
-      for (int i = 0; i < rowLength; i++)
-        offsetData(1, i) = yValues[i];
-    }
-    if (!zEmpty) {
-      for (int i = 0; i < rowLength; i++)
-        offsetData(2, i) = zValues[i];
-    }
+    if (!xEmpty)
+      offsetData.row(0) = Eigen::Map<const Eigen::RowVectorXd>(xValues.data(),
+                                                               rowLength);
+    if (!yEmpty)
+      offsetData.row(1) = Eigen::Map<const Eigen::RowVectorXd>(yValues.data(),
+                                                               rowLength);
+    if (!zEmpty)
+      offsetData.row(2) = Eigen::Map<const Eigen::RowVectorXd>(zValues.data(),
+                                                               rowLength);
     // Return the coordinate matrix
     return offsetData;
   }
@@ -533,6 +549,7 @@ private:
     if (vPoints.size() % 3 != 0)
       throw std::runtime_error("vertices not divisble by 3. Bad input.");
 
+    SharedShapes shapes;
     for (size_t i = 0; i < cylinderIndexToDetId.size(); i += 2) {
       auto cylinderIndex = cylinderIndexToDetId[i];
       auto detId = cylinderIndexToDetId[i + 1];
@@ -544,14 +561,19 @@ private:
         vSorted(j * 3 + 1) = vPoints[vertexIndex + 1];
         vSorted(j * 3 + 2) = vPoints[vertexIndex + 2];
       }
-      const auto centre = vSorted.col(0);
-      const auto other = vSorted.col(2);
+      const Eigen::Vector3d centre = (vSorted.col(0) + vSorted.col(2)) / 2;
+      // Shapes are relative to the detector position, so pixels of the same
+      // size share one
+      vSorted.colwise() -= centre;
+      auto &shape = shapes[makeShapeKey(
+          {}, {vSorted.col(0), vSorted.col(1), vSorted.col(2)})];
+      if (!shape)
+        shape = NexusShapeFactory::createCylinder(vSorted);
 
       // Note that tube optimisation is not used here. That should be applied as
       // future optimisation.
       builder.addDetectorToLastBank(name + "_" + std::to_string(cylinderIndex),
-                                    detId, (centre + other) / 2,
-                                    NexusShapeFactory::createCylinder(vSorted));
+                                    detId, centre, shape);
     }
   }
 
@@ -592,22 +614,35 @@ private:
                      std::vector<std::vector<uint32_t>> &detFaceIndices,
                      std::vector<std::vector<uint32_t>> &detWindingOrder,
                      std::vector<int32_t> &detIds) {
-    for (size_t i = 0; i < detFaces.size(); i += 2) {
-      const auto faceIndexOfDetector = detFaces[i];
-      const auto faceIndex = faceIndices[faceIndexOfDetector];
+    const auto vertsInFace = [&](const uint32_t faceIndexOfDetector) {
       auto nextFaceIndex = windingOrder.size();
       if (faceIndexOfDetector + 1 < faceIndices.size())
         nextFaceIndex = faceIndices[faceIndexOfDetector + 1];
-      const auto nVertsInFace = nextFaceIndex - faceIndex;
+      return nextFaceIndex - faceIndices[faceIndexOfDetector];
+    };
+    // Count the vertices of each detector first so that its vectors are
+    // allocated once rather than grown face by face
+    std::vector<size_t> nVertsForDet(detFaceVerts.size(), 0);
+    for (size_t i = 0; i < detFaces.size(); i += 2)
+      nVertsForDet[detIdToIndex.at(detFaces[i + 1])] +=
+          vertsInFace(detFaces[i]);
+    for (size_t detIndex = 0; detIndex < nVertsForDet.size(); ++detIndex) {
+      detFaceVerts[detIndex].reserve(nVertsForDet[detIndex]);
+      detWindingOrder[detIndex].reserve(nVertsForDet[detIndex]);
+    }
+
+    for (size_t i = 0; i < detFaces.size(); i += 2) {
+      const auto faceIndexOfDetector = detFaces[i];
+      const auto faceIndex = faceIndices[faceIndexOfDetector];
+      const auto nVertsInFace = vertsInFace(faceIndexOfDetector);
       const auto detID = detFaces[i + 1];
       const auto detIndex = detIdToIndex.at(detID);
       auto &vertsForDet = detFaceVerts[detIndex];
       auto &detWinding = detWindingOrder[detIndex];
-      vertsForDet.reserve(nVertsInFace);
-      detWinding.reserve(nVertsInFace);
+      // Associate face with detector index. The face starts at this position
+      // of the winding order of the detector.
       detFaceIndices[detIndex].emplace_back(
-          faceIndex); // Associate face with detector index
-                      // Use face index to index into winding order.
+          static_cast<uint32_t>(detWinding.size()));
       for (size_t v = 0; v < nVertsInFace; ++v) {
         const auto vi = windingOrder[faceIndex + v] * 3;
         vertsForDet.emplace_back(vertices[vi], vertices[vi + 1],
@@ -635,6 +670,7 @@ private:
                        faceIndices, detFaceVerts, detFaceIndices,
                        detWindingOrder, detIds);
 
+    SharedShapes shapes;
     for (size_t i = 0; i < numDets; ++i) {
       auto &detVerts = detFaceVerts[i];
       const auto &faceIndices = detFaceIndices[i];
@@ -649,10 +685,14 @@ private:
       std::for_each(detVerts.begin(), detVerts.end(),
                     [&centre](Eigen::Vector3d &val) { val -= centre; });
 
-      auto shape = NexusShapeFactory::createFromOFFMesh(faceIndices, detWinding,
-                                                        detVerts);
+      // The winding order of each detector lists its vertices in order, so
+      // the face indices and vertices identify the shape
+      auto &shape = shapes[makeShapeKey(faceIndices, detVerts)];
+      if (!shape)
+        shape = NexusShapeFactory::createFromOFFMesh(faceIndices, detWinding,
+                                                     detVerts);
       builder.addDetectorToLastBank(name + "_" + std::to_string(i), detIds[i],
-                                    centre, std::move(shape));
+                                    centre, shape);
     }
   }
 
@@ -316,6 +316,48 @@ public:
     TS_ASSERT_EQUALS(shape2Cylinder->shapeInfo().height(), 0.3); // 0.3
     TS_ASSERT_EQUALS(shape3Cylinder->shapeInfo().height(), 0.2); // 0.5- 0.3
   }
+  void test_detector_shapes_shared_when_identical() {
+    auto instrument = NexusGeometryParser::createInstrument(
+        instrument_path("unit_testing/DETGEOM_example_5.nxs"),
+        std::make_unique<testing::NiceMock<MockLogger>>());
+    auto beamline = extractBeamline(*instrument);
+    auto &compInfo = *beamline.first;
+    auto &detInfo = *beamline.second;
+    ETS_ASSERT_EQUALS(detInfo.size(), 8);
+
+    // Three square mesh pixels of the same size and a larger one
+    TSM_ASSERT_EQUALS("Same shape, same address", &compInfo.shape(0),
+                      &compInfo.shape(1));
+    TSM_ASSERT_EQUALS("Same shape, same address", &compInfo.shape(0),
+                      &compInfo.shape(2));
+    TSM_ASSERT_DIFFERS("Different shapes, different addresses",
+                       &compInfo.shape(0), &compInfo.shape(3));
+    TS_ASSERT(Kernel::toVector3d(compInfo.relativePosition(1))
+                  .isApprox(Eigen::Vector3d(0.15, 0.05, 0.0)));
+    const auto *mesh =
+        dynamic_cast<const Geometry::MeshObject2D *>(&compInfo.shape(1));
+    ETS_ASSERT(mesh);
+    TS_ASSERT_EQUALS(mesh->numberOfTriangles(), 2);
+    TS_ASSERT_EQUALS(mesh->numberOfVertices(), 4);
+
+    // Three cylinders of the same size along a tube and a wider one
+    TSM_ASSERT_EQUALS("Same shape, same address", &compInfo.shape(4),
+                      &compInfo.shape(5));
+    TSM_ASSERT_EQUALS("Same shape, same address", &compInfo.shape(4),
+                      &compInfo.shape(6));
+    TSM_ASSERT_DIFFERS("Different shapes, different addresses",
+                       &compInfo.shape(4), &compInfo.shape(7));
+    TS_ASSERT(Kernel::toVector3d(compInfo.relativePosition(5))
+                  .isApprox(Eigen::Vector3d(0.0, 0.3, 0.0)));
+    // Cylinders are centred on the detector position
+    const auto boundingBox = compInfo.shape(5).getBoundingBox();
+    TS_ASSERT_DELTA(boundingBox.yMin(), -0.1, 1e-9);
+    TS_ASSERT_DELTA(boundingBox.yMax(), 0.1, 1e-9);
+    const auto *cylinder =
+        dynamic_cast<const Geometry::CSGObject *>(&compInfo.shape(7));
+    ETS_ASSERT(cylinder);
+    TS_ASSERT_DELTA(cylinder->shapeInfo().radius(), 0.1, 1e-9);
+  }
 };
 
 class NexusGeometryParserTestPerformance : public CxxTest::TestSuite {
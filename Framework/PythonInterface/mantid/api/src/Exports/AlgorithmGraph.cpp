@@ -0,0 +1,130 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/IAlgorithm.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidPythonInterface/core/GetPointer.h"
+#include "MantidPythonInterface/core/ReleaseGlobalInterpreterLock.h"
+
+#include <boost/python/class.hpp>
+#include <boost/python/dict.hpp>
+#include <boost/python/extract.hpp>
+#include <boost/python/list.hpp>
+#include <boost/python/make_constructor.hpp>
+
+#include <chrono>
+#include <map>
+
+using Mantid::API::AlgorithmGraph;
+using Mantid::API::IAlgorithm_sptr;
+using Mantid::PythonInterface::ReleaseGlobalInterpreterLock;
+using namespace boost::python;
+
+GET_POINTER_SPECIALIZATION(AlgorithmGraph)
+
+namespace {
+using AlgorithmFuture = std::shared_future<bool>;
+
+/**
+ * Create a graph whose destructor, which waits for the algorithms, releases
+ * the GIL so that Python algorithms can finish
+ * @param numThreads :: number of algorithms to run at the same time
+ * @return the new graph
+ */
+boost::shared_ptr<AlgorithmGraph> createGraph(const int numThreads) {
+  return boost::shared_ptr<AlgorithmGraph>(
+      new AlgorithmGraph(numThreads), [](AlgorithmGraph *graph) {
+        ReleaseGlobalInterpreterLock releaseGlobalInterpreterLock;
+        delete graph;
+      });
+}
+
+/**
+ * Submit an algorithm, setting the given properties first. Workspace names
+ * are passed to the graph, since the workspaces may not exist yet. Other
+ * values are set as typed properties, as setProperty() does, so that e.g.
+ * lists are converted to array properties.
+ * @param self :: the graph
+ * @param algorithm :: the algorithm to run
+ * @param properties :: a dict of property names to values
+ * @return a future holding the result of execute()
+ */
+AlgorithmFuture submit(AlgorithmGraph &self, const IAlgorithm_sptr &algorithm,
+                       const dict &properties) {
+  if (!algorithm)
+    return self.submit(algorithm);
+  std::map<std::string, std::string> workspaceNames;
+  object pyAlgorithm(algorithm);
+  const list items = properties.items();
+  const auto numItems = len(items);
+  for (auto i = decltype(numItems){0}; i < numItems; ++i) {
+    const std::string name = extract<std::string>(items[i][0]);
+    const object value = items[i][1];
+    extract<std::string> workspaceName(value);
+    if (workspaceName.check() &&
+        dynamic_cast<Mantid::API::IWorkspaceProperty *>(
+            algorithm->getPointerToProperty(name))) {
+      workspaceNames.emplace(name, workspaceName());
+    } else {
+      pyAlgorithm.attr("setProperty")(name, value);
+    }
+  }
+  return self.submit(algorithm, workspaceNames);
+}
+
+void wait(AlgorithmGraph &self) {
+  ReleaseGlobalInterpreterLock releaseGlobalInterpreterLock;
+  self.wait();
+}
+
+/**
+ * @param self :: the future
+ * @return the result of execute(); raises the exception of the algorithm
+ */
+bool getResult(const AlgorithmFuture &self) {
+  ReleaseGlobalInterpreterLock releaseGlobalInterpreterLock;
+  return self.get();
+}
+
+void waitForResult(const AlgorithmFuture &self) {
+  ReleaseGlobalInterpreterLock releaseGlobalInterpreterLock;
+  self.wait();
+}
+
+bool isDone(const AlgorithmFuture &self) {
+  return self.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+} // namespace
+
+void export_AlgorithmGraph() {
+  class_<AlgorithmFuture>("AlgorithmFuture", no_init)
+      .def("get", &getResult, arg("self"),
+           "Wait for the algorithm and return the result of execute(). "
+           "Raises the error of the algorithm if it failed or was not run.")
+      .def("wait", &waitForResult, arg("self"),
+           "Wait for the algorithm to finish")
+      .def("done", &isDone, arg("self"),
+           "Returns True if the algorithm has finished");
+
+  class_<AlgorithmGraph, boost::shared_ptr<AlgorithmGraph>,
+         boost::noncopyable>("AlgorithmGraph", no_init)
+      .def("__init__",
+           make_constructor(&createGraph, default_call_policies(),
+                            (arg("numThreads") = 0)),
+           "Create a graph running up to numThreads algorithms at the same "
+           "time. 0 uses the number of cores.")
+      .def("submit", &submit,
+           (arg("self"), arg("algorithm"), arg("properties") = dict()),
+           "Run the algorithm once the algorithms submitted before it that "
+           "use the same workspaces have finished. The properties are set "
+           "first; input workspaces need not exist yet. Returns an "
+           "AlgorithmFuture.")
+      .def("wait", &wait, arg("self"),
+           "Wait for all submitted algorithms to finish")
+      .def("numThreads", &AlgorithmGraph::numThreads, arg("self"),
+           "Returns the number of algorithms that can run at the same time");
+}
@@ -0,0 +1,77 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+#     NScD Oak Ridge National Laboratory, European Spallation Source
+#     & Institut Laue - Langevin
+# SPDX - License - Identifier: GPL - 3.0 +
+from __future__ import (absolute_import, division, print_function)
+
+import unittest
+from mantid.api import (AlgorithmGraph, AlgorithmManager, AnalysisDataService,
+                        FrameworkManagerImpl)
+
+
+class AlgorithmGraphTest(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        FrameworkManagerImpl.Instance()
+
+    def tearDown(self):
+        AnalysisDataService.clear()
+
+    def _submit(self, graph, name, properties):
+        alg = AlgorithmManager.create(name)
+        alg.setRethrows(True)
+        return graph.submit(alg, properties)
+
+    def test_dependent_algorithms_run_in_order(self):
+        graph = AlgorithmGraph(2)
+        created = self._submit(graph, "CreateSampleWorkspace",
+                               {"OutputWorkspace": "graph_ws", "NumBanks": 1,
+                                "BankPixelWidth": 2})
+        scaled = self._submit(graph, "Scale",
+                              {"InputWorkspace": "graph_ws", "Factor": 2,
+                               "OutputWorkspace": "graph_scaled"})
+        self.assertTrue(scaled.get())
+        self.assertTrue(created.done())
+        original = AnalysisDataService.retrieve("graph_ws")
+        result = AnalysisDataService.retrieve("graph_scaled")
+        self.assertAlmostEqual(result.readY(0)[0], 2 * original.readY(0)[0])
+
+    def test_list_property_values(self):
+        graph = AlgorithmGraph(1)
+        self._submit(graph, "CreateSampleWorkspace",
+                     {"OutputWorkspace": "graph_ws", "NumBanks": 1,
+                      "BankPixelWidth": 1, "XMin": 0., "XMax": 1000.,
+                      "BinWidth": 10.})
+        rebinned = self._submit(graph, "Rebin",
+                                {"InputWorkspace": "graph_ws",
+                                 "Params": [0., 100., 1000.],
+                                 "OutputWorkspace": "graph_rebinned"})
+        self.assertTrue(rebinned.get())
+        result = AnalysisDataService.retrieve("graph_rebinned")
+        self.assertEqual(result.blocksize(), 10)
+
+    def test_failed_dependency_raises(self):
+        graph = AlgorithmGraph(1)
+        failed = self._submit(graph, "Scale",
+                              {"InputWorkspace": "graph_missing",
+                               "OutputWorkspace": "graph_ws"})
+        skipped = self._submit(graph, "Scale",
+                               {"InputWorkspace": "graph_ws",
+                                "OutputWorkspace": "graph_scaled"})
+        graph.wait()
+        self.assertRaises(RuntimeError, failed.get)
+        self.assertRaises(RuntimeError, skipped.get)
+        self.assertFalse(AnalysisDataService.doesExist("graph_scaled"))
+
+    def test_invalid_property_value_raises(self):
+        graph = AlgorithmGraph(1)
+        self.assertRaises(ValueError, self._submit, graph,
+                          "CreateSampleWorkspace",
+                          {"OutputWorkspace": "graph_ws", "NumBanks": -1})
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -8,6 +8,7 @@
 
 #include "MantidTypes/DllConfig.h"
 
+#include <cstdint>
 #include <string>
 
 namespace Mantid {
@@ -16,6 +17,8 @@ namespace Core {
 namespace DateAndTimeHelpers {
 MANTID_TYPES_DLL bool stringIsISO8601(const std::string &date);
 MANTID_TYPES_DLL bool stringIsPosix(const std::string &date);
+MANTID_TYPES_DLL bool parseExtendedISO8601(const std::string &date,
+                                           int64_t &nanoseconds);
 } // namespace DateAndTimeHelpers
 } // namespace Core
 } // namespace Types
@@ -2,6 +2,8 @@
 
 #include "MantidTypes/Core/DateAndTimeHelpers.h"
 
+#include <cstdio>
+
 namespace Mantid {
 namespace Types {
 namespace Core {
@@ -25,6 +27,37 @@ const int64_t MIN_SECONDS = -4611686017LL;
 /// Number of nanoseconds in one second
 const int64_t NANO_PER_SEC = 1000000000LL;
 
+/// Number of seconds in one day
+const int64_t SECONDS_PER_DAY = 86400;
+
+/// Days from Jan 1, 1970 to Jan 1, 1990
+const int64_t EPOCH_DAYS = 7305;
+
+/// Division rounding towards minus infinity
+int64_t floorDivide(const int64_t numerator, const int64_t denominator) {
+  const int64_t quotient = numerator / denominator;
+  return (numerator % denominator < 0) ? quotient - 1 : quotient;
+}
+
+/** Date of the proleptic Gregorian calendar from the days since Jan 1, 1970
+ * (H. Hinnant, "chrono-Compatible Low-Level Date Algorithms").
+ */
+void civilFromDays(int64_t days, int64_t &year, int64_t &month,
+                   int64_t &day) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int64_t dayOfEra = days - era * 146097;
+  const int64_t yearOfEra =
+      (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) /
+      365;
+  const int64_t dayOfYear =
+      dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  const int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+  day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+  month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+  year = yearOfEra + era * 400 + (month <= 2);
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Convert time_t to tm as UTC time.
  * Portable implementation of gmtime_r (re-entrant gmtime) that works on Windows
@@ -343,6 +376,12 @@ const DateAndTime &DateAndTime::defaultTime() {
  *               "yyyy-mm-ddThh:mm:ss[Z+-]tz:tz" or "yyy-MMM-dd hh:mm:ss.ssss"
  */
 void DateAndTime::setFromISO8601(const std::string &str) {
+  // Most time stamps are in the form parsed without boost
+  int64_t nanoseconds;
+  if (DateAndTimeHelpers::parseExtendedISO8601(str, nanoseconds)) {
+    _nanoseconds = nanoseconds;
+    return;
+  }
   if (!DateAndTimeHelpers::stringIsISO8601(str) &&
       !DateAndTimeHelpers::stringIsPosix(str)) {
     throw std::invalid_argument("Error interpreting string '" + str +
@@ -464,7 +503,27 @@ std::string DateAndTime::toFormattedString(const std::string format) const {
  *  @return The ISO8601 string
  */
 std::string DateAndTime::toISO8601String() const {
-  return boost::posix_time::to_iso_extended_string(to_ptime());
+  // Formatted directly, in the format of
+  // boost::posix_time::to_iso_extended_string
+  const int64_t totalSeconds = floorDivide(_nanoseconds, NANO_PER_SEC);
+  const int64_t fraction = _nanoseconds - totalSeconds * NANO_PER_SEC;
+  const int64_t days = floorDivide(totalSeconds, SECONDS_PER_DAY);
+  const int64_t secondOfDay = totalSeconds - days * SECONDS_PER_DAY;
+  int64_t year, month, day;
+  civilFromDays(days + EPOCH_DAYS, year, month, day);
+
+  char buffer[32];
+  int length = std::snprintf(
+      buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d",
+      static_cast<int>(year), static_cast<int>(month), static_cast<int>(day),
+      static_cast<int>(secondOfDay / 3600),
+      static_cast<int>(secondOfDay / 60 % 60),
+      static_cast<int>(secondOfDay % 60));
+  if (fraction != 0) {
+    length += std::snprintf(buffer + length, sizeof(buffer) - length, ".%09d",
+                            static_cast<int>(fraction));
+  }
+  return std::string(buffer, length);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -8,6 +8,57 @@
 
 #include <boost/regex.hpp>
 
+namespace {
+/// Number of seconds in one day
+constexpr int64_t SECONDS_PER_DAY = 86400;
+/// Days from Jan 1, 1970 to Jan 1, 1990
+constexpr int64_t EPOCH_DAYS = 7305;
+/// Limits of the seconds a DateAndTime can hold without clamping
+constexpr int64_t MAX_SECONDS = 4611686017LL;
+constexpr int64_t MIN_SECONDS = -4611686017LL;
+
+/**
+ * Read a fixed number of digits
+ * @param str :: the characters
+ * @param count :: number of digits to read
+ * @param value :: set to the value of the digits
+ * @return false if one of the characters is not a digit
+ */
+bool readDigits(const char *str, const size_t count, int &value) {
+  value = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (str[i] < '0' || str[i] > '9')
+      return false;
+    value = value * 10 + (str[i] - '0');
+  }
+  return true;
+}
+
+bool isLeapYear(const int year) {
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(const int year, const int month) {
+  static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+}
+
+/**
+ * Days since Jan 1, 1970 of a date of the proleptic Gregorian calendar
+ * (H. Hinnant, "chrono-Compatible Low-Level Date Algorithms").
+ */
+int64_t daysFromCivil(int64_t year, const int64_t month, const int64_t day) {
+  year -= month <= 2;
+  const int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const int64_t yearOfEra = year - era * 400;
+  const int64_t dayOfYear =
+      (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const int64_t dayOfEra =
+      yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + dayOfEra - 719468;
+}
+} // namespace
+
 namespace Mantid {
 namespace Types {
 namespace Core {
@@ -18,6 +69,10 @@ namespace DateAndTimeHelpers {
  * @return true if the string conforms to ISO 8601, false otherwise.
  */
 bool stringIsISO8601(const std::string &date) {
+  // Most time stamps are in the form parsed without regular expressions
+  int64_t nanoseconds;
+  if (parseExtendedISO8601(date, nanoseconds))
+    return true;
   // Expecting most of Mantid's time stamp strings to be in the
   // extended format --- check it first.
   static const boost::regex extendedFormat(
@@ -41,6 +96,82 @@ bool stringIsPosix(const std::string &date) {
       R"(^\d{4}-[A-Z][a-z]{2}-[0-3]\d\s[0-2]\d:[0-5]\d:\d{2}(.\d+)?$)");
   return boost::regex_match(date, format);
 }
+
+/** Parse the most common ISO8601 form, "YYYY-MM-DDThh:mm:ss", optionally
+ * followed by a fraction of a second of up to 9 digits and by "Z" or a time
+ * zone offset "+hh" or "+hh:mm". A space may separate the date and the time
+ * if there is no time zone. This is much faster than the general parsing done
+ * by DateAndTime::setFromISO8601(), which uses it when it can.
+ *
+ * @param date :: string to parse
+ * @param nanoseconds :: set to the nanoseconds since Jan 1, 1990
+ * @return false if the string is not in this form or the date is invalid or
+ * out of range, in which case nanoseconds is unspecified
+ */
+bool parseExtendedISO8601(const std::string &date, int64_t &nanoseconds) {
+  const size_t size = date.size();
+  if (size < 19)
+    return false;
+  const char *str = date.data();
+  int year, month, day, hour, minute, second;
+  if (!readDigits(str, 4, year) || str[4] != '-' ||
+      !readDigits(str + 5, 2, month) || str[7] != '-' ||
+      !readDigits(str + 8, 2, day) || (str[10] != 'T' && str[10] != ' ') ||
+      !readDigits(str + 11, 2, hour) || str[13] != ':' ||
+      !readDigits(str + 14, 2, minute) || str[16] != ':' ||
+      !readDigits(str + 17, 2, second))
+    return false;
+  if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) ||
+      hour > 23 || minute > 59 || second > 59)
+    return false;
+
+  size_t pos = 19;
+  int64_t fraction = 0;
+  if (pos < size && str[pos] == '.') {
+    const size_t first = ++pos;
+    while (pos < size && str[pos] >= '0' && str[pos] <= '9') {
+      fraction = fraction * 10 + (str[pos] - '0');
+      ++pos;
+    }
+    const size_t digits = pos - first;
+    if (digits == 0 || digits > 9)
+      return false;
+    for (size_t i = digits; i < 9; ++i)
+      fraction *= 10;
+  }
+
+  int64_t offsetMinutes = 0;
+  if (pos < size) {
+    // Time zones are only recognised after a 'T'
+    if (str[10] != 'T')
+      return false;
+    if (str[pos] == 'Z') {
+      ++pos;
+    } else if (str[pos] == '+' || str[pos] == '-') {
+      const int64_t sign = str[pos] == '+' ? 1 : -1;
+      int offsetHours, offsetMins = 0;
+      if (size != pos + 3 && size != pos + 6)
+        return false;
+      if (!readDigits(str + pos + 1, 2, offsetHours))
+        return false;
+      if (size == pos + 6 &&
+          (str[pos + 3] != ':' || !readDigits(str + pos + 4, 2, offsetMins)))
+        return false;
+      offsetMinutes = sign * (offsetHours * 60 + offsetMins);
+      pos = size;
+    }
+    if (pos != size)
+      return false;
+  }
+
+  const int64_t seconds =
+      (daysFromCivil(year, month, day) - EPOCH_DAYS) * SECONDS_PER_DAY +
+      hour * 3600 + minute * 60 + second - offsetMinutes * 60;
+  if (seconds <= MIN_SECONDS || seconds >= MAX_SECONDS)
+    return false;
+  nanoseconds = seconds * 1000000000LL + fraction;
+  return true;
+}
 } // namespace DateAndTimeHelpers
 } // namespace Core
 } // namespace Types
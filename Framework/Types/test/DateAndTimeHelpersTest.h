@@ -9,6 +9,8 @@
 #include "MantidTypes/Core/DateAndTimeHelpers.h"
 #include <cxxtest/TestSuite.h>
 
+#include <boost/date_time/posix_time/posix_time.hpp>
+
 using namespace Mantid::Types::Core::DateAndTimeHelpers;
 
 class DateAndTimeHelpersTest : public CxxTest::TestSuite {
@@ -60,6 +62,46 @@ public:
     TS_ASSERT(!stringIsISO8601("1990-01-02 03:04:02.000Z00:00"))
   }
 
+  void test_parseExtendedISO8601() {
+    const boost::posix_time::ptime epoch(boost::gregorian::date(1990, 1, 1));
+    const auto nanosecondsOf = [&epoch](const std::string &time) {
+      return (boost::posix_time::time_from_string(time) - epoch)
+          .total_nanoseconds();
+    };
+    int64_t nanoseconds;
+    TS_ASSERT(parseExtendedISO8601("1990-01-02T03:04:02", nanoseconds));
+    TS_ASSERT_EQUALS(nanoseconds, nanosecondsOf("1990-01-02 03:04:02"));
+    TS_ASSERT(parseExtendedISO8601("1990-01-02 03:04:02.5", nanoseconds));
+    TS_ASSERT_EQUALS(nanoseconds, nanosecondsOf("1990-01-02 03:04:02.5"));
+    TS_ASSERT(parseExtendedISO8601("2016-02-29T23:59:59.123456789Z",
+                                   nanoseconds));
+    TS_ASSERT_EQUALS(nanoseconds,
+                     nanosecondsOf("2016-02-29 23:59:59.123456789"));
+    TS_ASSERT(parseExtendedISO8601("1989-12-31T23:00:00-01", nanoseconds));
+    TS_ASSERT_EQUALS(nanoseconds, 0);
+    TS_ASSERT(parseExtendedISO8601("1990-01-01T05:30:00+05:30", nanoseconds));
+    TS_ASSERT_EQUALS(nanoseconds, 0);
+    TS_ASSERT(parseExtendedISO8601("1850-06-15T12:00:00", nanoseconds));
+    TS_ASSERT_EQUALS(nanoseconds, nanosecondsOf("1850-06-15 12:00:00"));
+
+    // Valid ISO8601 in other forms are left to the general parser
+    TS_ASSERT(!parseExtendedISO8601("1990-01-02T03:04", nanoseconds));
+    TS_ASSERT(!parseExtendedISO8601("19900102T030402", nanoseconds));
+    TS_ASSERT(!parseExtendedISO8601("1990-01-02T03:04:02+0530", nanoseconds));
+    TS_ASSERT(!parseExtendedISO8601("1990-01-02 03:04:02Z", nanoseconds));
+    TS_ASSERT(
+        !parseExtendedISO8601("1990-01-02T03:04:02.1234567891", nanoseconds));
+    // Invalid dates and times
+    TS_ASSERT(!parseExtendedISO8601("1990-02-29T03:04:02", nanoseconds));
+    TS_ASSERT(!parseExtendedISO8601("1990-13-01T03:04:02", nanoseconds));
+    TS_ASSERT(!parseExtendedISO8601("1990-01-02T24:04:02", nanoseconds));
+    TS_ASSERT(!parseExtendedISO8601("1990-01-02T03:04:02.", nanoseconds));
+    TS_ASSERT(!parseExtendedISO8601("1990-01-02T03:04:02Z00", nanoseconds));
+    TS_ASSERT(!parseExtendedISO8601("1990-Jan-02 03:04:02", nanoseconds));
+    // Out of the range of DateAndTime
+    TS_ASSERT(!parseExtendedISO8601("2200-01-01T00:00:00", nanoseconds));
+  }
+
   void test_stringIsPosix() {
     TS_ASSERT(stringIsPosix("1990-Jan-02 03:04:02.000"));
     TS_ASSERT(stringIsPosix("1990-Jan-02 03:04:02"))
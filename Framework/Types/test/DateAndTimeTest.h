@@ -349,6 +349,20 @@ public:
     delete timeinfo;
   }
 
+  void test_toISO8601String_matches_boost() {
+    for (const int64_t nanoseconds :
+         {int64_t(0), int64_t(1), int64_t(-1), int64_t(951782400123456789),
+          int64_t(-4354819200000000000), int64_t(86399999999999),
+          DateAndTime::maximum().totalNanoseconds(),
+          DateAndTime::minimum().totalNanoseconds()}) {
+      const DateAndTime time(nanoseconds);
+      TS_ASSERT_EQUALS(time.toISO8601String(),
+                       boost::posix_time::to_iso_extended_string(
+                           time.to_ptime()));
+      TS_ASSERT_EQUALS(DateAndTime(time.toISO8601String()), time);
+    }
+  }
+
   void test_ISO8601_string_with_timezones() {
     // Time without timezone : UTC assumed
     DateAndTime time_no_tz = DateAndTime("2010-03-24T14:12:51.562");
@@ -469,4 +483,11 @@ public:
       d.totalNanoseconds();
     }
   }
+
+  void test_toISO8601String() {
+    const DateAndTime time("2010-03-24T14:12:51.562Z");
+    for (size_t i = 0; i < 500000; ++i) {
+      time.toISO8601String();
+    }
+  }
 };
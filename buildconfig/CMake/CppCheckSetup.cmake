@@ -56,8 +56,6 @@ if ( CPPCHECK_EXECUTABLE )
         Framework/ICat/src/ICat4/ICat4GSoapGenerated.cpp
         Framework/ICat/src/GSoap/
         Framework/ICat/src/GSoap.cpp
-        Framework/Kernel/src/ANN/
-        Framework/Kernel/src/ANN_complete.cpp
         Framework/Kernel/src/Math/Optimization/SLSQPMinimizer.cpp
         MantidPlot/src/nrutil.cpp
         MantidPlot/src/origin/OPJFile.cpp